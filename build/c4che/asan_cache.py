@@ -0,0 +1,3 @@
+BINDIR = '/usr/local/bin'
+LIBDIR = '/usr/local/lib64'
+PREFIX = '/usr/local'
@@ -0,0 +1,974 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include <stddef.h>
+#ifndef ZCM_EMBEDDED
+#include <stdio.h>
+#endif
+#include "bench/wide_t.h"
+
+static int __wide_t_hash_computed = 0;
+static uint64_t __wide_t_hash;
+
+uint64_t __wide_t_hash_recursive(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __wide_t_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__wide_t_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x8129c645a3569e29LL
+         + __int64_t_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __int16_t_hash_recursive(&cp)
+         + __boolean_hash_recursive(&cp)
+         + __float_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __wide_t_get_hash(void)
+{
+    if (!__wide_t_hash_computed) {
+        __wide_t_hash = (int64_t)__wide_t_hash_recursive(NULL);
+        __wide_t_hash_computed = 1;
+    }
+
+    return __wide_t_hash;
+}
+
+int __wide_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const wide_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 399) return -1;
+        {
+            uint8_t* run = (uint8_t*) buf + offset + pos;
+            uint32_t a;
+            __int64_t_store(run + 0, p[element].utime);
+            __int32_t_store(run + 8, p[element].seq);
+            __double_store(run + 12, p[element].v0);
+            __double_store(run + 20, p[element].v1);
+            __double_store(run + 28, p[element].v2);
+            __double_store(run + 36, p[element].v3);
+            __double_store(run + 44, p[element].v4);
+            __double_store(run + 52, p[element].v5);
+            __double_store(run + 60, p[element].v6);
+            __double_store(run + 68, p[element].v7);
+            __double_store(run + 76, p[element].v8);
+            __double_store(run + 84, p[element].v9);
+            __double_store(run + 92, p[element].v10);
+            __double_store(run + 100, p[element].v11);
+            __double_store(run + 108, p[element].v12);
+            __double_store(run + 116, p[element].v13);
+            __double_store(run + 124, p[element].v14);
+            __double_store(run + 132, p[element].v15);
+            __double_store(run + 140, p[element].v16);
+            __double_store(run + 148, p[element].v17);
+            __double_store(run + 156, p[element].v18);
+            __double_store(run + 164, p[element].v19);
+            __double_store(run + 172, p[element].v20);
+            __double_store(run + 180, p[element].v21);
+            __double_store(run + 188, p[element].v22);
+            __double_store(run + 196, p[element].v23);
+            __double_store(run + 204, p[element].v24);
+            __double_store(run + 212, p[element].v25);
+            __double_store(run + 220, p[element].v26);
+            __double_store(run + 228, p[element].v27);
+            __double_store(run + 236, p[element].v28);
+            __double_store(run + 244, p[element].v29);
+            __int16_t_store(run + 252, p[element].status);
+            __boolean_store(run + 254, p[element].valid);
+            for (a = 0; a < 36; ++a)
+                __float_store(run + 255 + 4 * a, (&p[element].cov[0][0])[a]);
+        }
+        pos += 399;
+
+    }
+    return pos;
+}
+
+int wide_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const wide_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __wide_t_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __wide_t_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __wide_t_encoded_array_size(const wide_t* p, uint32_t elements)
+{
+    uint32_t size = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        size += __int64_t_encoded_array_size(&(p[element].utime), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].seq), 1);
+
+        size += __double_encoded_array_size(&(p[element].v0), 1);
+
+        size += __double_encoded_array_size(&(p[element].v1), 1);
+
+        size += __double_encoded_array_size(&(p[element].v2), 1);
+
+        size += __double_encoded_array_size(&(p[element].v3), 1);
+
+        size += __double_encoded_array_size(&(p[element].v4), 1);
+
+        size += __double_encoded_array_size(&(p[element].v5), 1);
+
+        size += __double_encoded_array_size(&(p[element].v6), 1);
+
+        size += __double_encoded_array_size(&(p[element].v7), 1);
+
+        size += __double_encoded_array_size(&(p[element].v8), 1);
+
+        size += __double_encoded_array_size(&(p[element].v9), 1);
+
+        size += __double_encoded_array_size(&(p[element].v10), 1);
+
+        size += __double_encoded_array_size(&(p[element].v11), 1);
+
+        size += __double_encoded_array_size(&(p[element].v12), 1);
+
+        size += __double_encoded_array_size(&(p[element].v13), 1);
+
+        size += __double_encoded_array_size(&(p[element].v14), 1);
+
+        size += __double_encoded_array_size(&(p[element].v15), 1);
+
+        size += __double_encoded_array_size(&(p[element].v16), 1);
+
+        size += __double_encoded_array_size(&(p[element].v17), 1);
+
+        size += __double_encoded_array_size(&(p[element].v18), 1);
+
+        size += __double_encoded_array_size(&(p[element].v19), 1);
+
+        size += __double_encoded_array_size(&(p[element].v20), 1);
+
+        size += __double_encoded_array_size(&(p[element].v21), 1);
+
+        size += __double_encoded_array_size(&(p[element].v22), 1);
+
+        size += __double_encoded_array_size(&(p[element].v23), 1);
+
+        size += __double_encoded_array_size(&(p[element].v24), 1);
+
+        size += __double_encoded_array_size(&(p[element].v25), 1);
+
+        size += __double_encoded_array_size(&(p[element].v26), 1);
+
+        size += __double_encoded_array_size(&(p[element].v27), 1);
+
+        size += __double_encoded_array_size(&(p[element].v28), 1);
+
+        size += __double_encoded_array_size(&(p[element].v29), 1);
+
+        size += __int16_t_encoded_array_size(&(p[element].status), 1);
+
+        size += __boolean_encoded_array_size(&(p[element].valid), 1);
+
+        { int a;
+        for (a = 0; a < 6; ++a) {
+            size += __float_encoded_array_size(p[element].cov[a], 6);
+        }
+        }
+
+    }
+    return size;
+}
+
+uint32_t wide_t_encoded_size(const wide_t* p)
+{
+    return 8 + __wide_t_encoded_array_size(p, 1);
+}
+
+uint32_t wide_t_struct_size(void)
+{
+    return sizeof(wide_t);
+}
+
+uint32_t wide_t_num_fields(void)
+{
+    return 35;
+}
+
+int wide_t_get_field(const wide_t* p, uint32_t i, zcm_field_t* f)
+{
+    if (i >= wide_t_num_fields())
+        return 1;
+    
+    switch (i) {
+    
+        case 0: {
+            f->name = "utime";
+            f->type = ZCM_FIELD_INT64_T;
+            f->typestr = "int64_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->utime;
+            return 0;
+        }
+        
+        case 1: {
+            f->name = "seq";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->seq;
+            return 0;
+        }
+        
+        case 2: {
+            f->name = "v0";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v0;
+            return 0;
+        }
+        
+        case 3: {
+            f->name = "v1";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v1;
+            return 0;
+        }
+        
+        case 4: {
+            f->name = "v2";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v2;
+            return 0;
+        }
+        
+        case 5: {
+            f->name = "v3";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v3;
+            return 0;
+        }
+        
+        case 6: {
+            f->name = "v4";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v4;
+            return 0;
+        }
+        
+        case 7: {
+            f->name = "v5";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v5;
+            return 0;
+        }
+        
+        case 8: {
+            f->name = "v6";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v6;
+            return 0;
+        }
+        
+        case 9: {
+            f->name = "v7";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v7;
+            return 0;
+        }
+        
+        case 10: {
+            f->name = "v8";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v8;
+            return 0;
+        }
+        
+        case 11: {
+            f->name = "v9";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v9;
+            return 0;
+        }
+        
+        case 12: {
+            f->name = "v10";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v10;
+            return 0;
+        }
+        
+        case 13: {
+            f->name = "v11";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v11;
+            return 0;
+        }
+        
+        case 14: {
+            f->name = "v12";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v12;
+            return 0;
+        }
+        
+        case 15: {
+            f->name = "v13";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v13;
+            return 0;
+        }
+        
+        case 16: {
+            f->name = "v14";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v14;
+            return 0;
+        }
+        
+        case 17: {
+            f->name = "v15";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v15;
+            return 0;
+        }
+        
+        case 18: {
+            f->name = "v16";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v16;
+            return 0;
+        }
+        
+        case 19: {
+            f->name = "v17";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v17;
+            return 0;
+        }
+        
+        case 20: {
+            f->name = "v18";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v18;
+            return 0;
+        }
+        
+        case 21: {
+            f->name = "v19";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v19;
+            return 0;
+        }
+        
+        case 22: {
+            f->name = "v20";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v20;
+            return 0;
+        }
+        
+        case 23: {
+            f->name = "v21";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v21;
+            return 0;
+        }
+        
+        case 24: {
+            f->name = "v22";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v22;
+            return 0;
+        }
+        
+        case 25: {
+            f->name = "v23";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v23;
+            return 0;
+        }
+        
+        case 26: {
+            f->name = "v24";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v24;
+            return 0;
+        }
+        
+        case 27: {
+            f->name = "v25";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v25;
+            return 0;
+        }
+        
+        case 28: {
+            f->name = "v26";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v26;
+            return 0;
+        }
+        
+        case 29: {
+            f->name = "v27";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v27;
+            return 0;
+        }
+        
+        case 30: {
+            f->name = "v28";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v28;
+            return 0;
+        }
+        
+        case 31: {
+            f->name = "v29";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 0;
+            f->data = (void*) &p->v29;
+            return 0;
+        }
+        
+        case 32: {
+            f->name = "status";
+            f->type = ZCM_FIELD_INT16_T;
+            f->typestr = "int16_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->status;
+            return 0;
+        }
+        
+        case 33: {
+            f->name = "valid";
+            f->type = ZCM_FIELD_BOOLEAN;
+            f->typestr = "boolean";
+            f->num_dim = 0;
+            f->data = (void*) &p->valid;
+            return 0;
+        }
+        
+        case 34: {
+            f->name = "cov";
+            f->type = ZCM_FIELD_FLOAT;
+            f->typestr = "float";
+            f->num_dim = 2;
+            f->dim_size[0] = 6;
+            f->dim_size[1] = 6;
+            f->dim_is_variable[0] = 0;
+            f->dim_is_variable[1] = 0;
+            f->data = (void*) &p->cov;
+            return 0;
+        }
+        
+        default:
+            return 1;
+    }
+}
+
+const zcm_type_info_t* wide_t_get_type_info(void)
+{
+    static int init = 0;
+    static zcm_type_info_t typeinfo;
+    if (!init) {
+        typeinfo.encode         = (zcm_encode_t) wide_t_encode;
+        typeinfo.decode         = (zcm_decode_t) wide_t_decode;
+        typeinfo.decode_cleanup = (zcm_decode_cleanup_t) wide_t_decode_cleanup;
+        typeinfo.encoded_size   = (zcm_encoded_size_t) wide_t_encoded_size;
+        typeinfo.struct_size    = (zcm_struct_size_t)  wide_t_struct_size;
+        typeinfo.num_fields     = (zcm_num_fields_t) wide_t_num_fields;
+        typeinfo.get_field      = (zcm_get_field_t) wide_t_get_field;
+        typeinfo.get_hash       = (zcm_get_hash_t) __wide_t_get_hash;
+    }
+    
+    return &typeinfo;
+}
+
+static const zcm_dim_desc_t __wide_t_dims[] = {
+    { 6, 0 }, /* cov */
+    { 6, 0 }, /* cov */
+};
+
+static const zcm_field_desc_t __wide_t_fields[] = {
+    { "utime", ZCM_FIELD_INT64_T, "int64_t", offsetof(wide_t, utime), 0, NULL, NULL },
+    { "seq", ZCM_FIELD_INT32_T, "int32_t", offsetof(wide_t, seq), 0, NULL, NULL },
+    { "v0", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v0), 0, NULL, NULL },
+    { "v1", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v1), 0, NULL, NULL },
+    { "v2", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v2), 0, NULL, NULL },
+    { "v3", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v3), 0, NULL, NULL },
+    { "v4", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v4), 0, NULL, NULL },
+    { "v5", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v5), 0, NULL, NULL },
+    { "v6", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v6), 0, NULL, NULL },
+    { "v7", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v7), 0, NULL, NULL },
+    { "v8", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v8), 0, NULL, NULL },
+    { "v9", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v9), 0, NULL, NULL },
+    { "v10", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v10), 0, NULL, NULL },
+    { "v11", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v11), 0, NULL, NULL },
+    { "v12", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v12), 0, NULL, NULL },
+    { "v13", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v13), 0, NULL, NULL },
+    { "v14", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v14), 0, NULL, NULL },
+    { "v15", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v15), 0, NULL, NULL },
+    { "v16", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v16), 0, NULL, NULL },
+    { "v17", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v17), 0, NULL, NULL },
+    { "v18", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v18), 0, NULL, NULL },
+    { "v19", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v19), 0, NULL, NULL },
+    { "v20", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v20), 0, NULL, NULL },
+    { "v21", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v21), 0, NULL, NULL },
+    { "v22", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v22), 0, NULL, NULL },
+    { "v23", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v23), 0, NULL, NULL },
+    { "v24", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v24), 0, NULL, NULL },
+    { "v25", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v25), 0, NULL, NULL },
+    { "v26", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v26), 0, NULL, NULL },
+    { "v27", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v27), 0, NULL, NULL },
+    { "v28", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v28), 0, NULL, NULL },
+    { "v29", ZCM_FIELD_DOUBLE, "double", offsetof(wide_t, v29), 0, NULL, NULL },
+    { "status", ZCM_FIELD_INT16_T, "int16_t", offsetof(wide_t, status), 0, NULL, NULL },
+    { "valid", ZCM_FIELD_BOOLEAN, "boolean", offsetof(wide_t, valid), 0, NULL, NULL },
+    { "cov", ZCM_FIELD_FLOAT, "float", offsetof(wide_t, cov), 2, __wide_t_dims + 0, NULL },
+};
+
+const zcm_type_desc_t __wide_t_type_desc = {
+    "wide_t", __wide_t_get_hash, sizeof(wide_t), 0,
+    35, __wide_t_fields
+};
+
+const zcm_type_desc_t* wide_t_get_type_desc(void)
+{
+    return &__wide_t_type_desc;
+}
+int __wide_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, wide_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 399) return -1;
+        {
+            const uint8_t* run = (const uint8_t*) buf + offset + pos;
+            uint32_t a;
+            p[element].utime = __int64_t_load(run + 0);
+            p[element].seq = __int32_t_load(run + 8);
+            p[element].v0 = __double_load(run + 12);
+            p[element].v1 = __double_load(run + 20);
+            p[element].v2 = __double_load(run + 28);
+            p[element].v3 = __double_load(run + 36);
+            p[element].v4 = __double_load(run + 44);
+            p[element].v5 = __double_load(run + 52);
+            p[element].v6 = __double_load(run + 60);
+            p[element].v7 = __double_load(run + 68);
+            p[element].v8 = __double_load(run + 76);
+            p[element].v9 = __double_load(run + 84);
+            p[element].v10 = __double_load(run + 92);
+            p[element].v11 = __double_load(run + 100);
+            p[element].v12 = __double_load(run + 108);
+            p[element].v13 = __double_load(run + 116);
+            p[element].v14 = __double_load(run + 124);
+            p[element].v15 = __double_load(run + 132);
+            p[element].v16 = __double_load(run + 140);
+            p[element].v17 = __double_load(run + 148);
+            p[element].v18 = __double_load(run + 156);
+            p[element].v19 = __double_load(run + 164);
+            p[element].v20 = __double_load(run + 172);
+            p[element].v21 = __double_load(run + 180);
+            p[element].v22 = __double_load(run + 188);
+            p[element].v23 = __double_load(run + 196);
+            p[element].v24 = __double_load(run + 204);
+            p[element].v25 = __double_load(run + 212);
+            p[element].v26 = __double_load(run + 220);
+            p[element].v27 = __double_load(run + 228);
+            p[element].v28 = __double_load(run + 236);
+            p[element].v29 = __double_load(run + 244);
+            p[element].status = __int16_t_load(run + 252);
+            p[element].valid = __boolean_load(run + 254);
+            for (a = 0; a < 36; ++a)
+                (&p[element].cov[0][0])[a] = __float_load(run + 255 + 4 * a);
+        }
+        pos += 399;
+
+    }
+    return pos;
+}
+
+int __wide_t_decode_array_cleanup(wide_t* p, uint32_t elements)
+{
+    uint32_t element;
+    for (element = 0; element < elements; ++element) {
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].seq), 1);
+
+        __double_decode_array_cleanup(&(p[element].v0), 1);
+
+        __double_decode_array_cleanup(&(p[element].v1), 1);
+
+        __double_decode_array_cleanup(&(p[element].v2), 1);
+
+        __double_decode_array_cleanup(&(p[element].v3), 1);
+
+        __double_decode_array_cleanup(&(p[element].v4), 1);
+
+        __double_decode_array_cleanup(&(p[element].v5), 1);
+
+        __double_decode_array_cleanup(&(p[element].v6), 1);
+
+        __double_decode_array_cleanup(&(p[element].v7), 1);
+
+        __double_decode_array_cleanup(&(p[element].v8), 1);
+
+        __double_decode_array_cleanup(&(p[element].v9), 1);
+
+        __double_decode_array_cleanup(&(p[element].v10), 1);
+
+        __double_decode_array_cleanup(&(p[element].v11), 1);
+
+        __double_decode_array_cleanup(&(p[element].v12), 1);
+
+        __double_decode_array_cleanup(&(p[element].v13), 1);
+
+        __double_decode_array_cleanup(&(p[element].v14), 1);
+
+        __double_decode_array_cleanup(&(p[element].v15), 1);
+
+        __double_decode_array_cleanup(&(p[element].v16), 1);
+
+        __double_decode_array_cleanup(&(p[element].v17), 1);
+
+        __double_decode_array_cleanup(&(p[element].v18), 1);
+
+        __double_decode_array_cleanup(&(p[element].v19), 1);
+
+        __double_decode_array_cleanup(&(p[element].v20), 1);
+
+        __double_decode_array_cleanup(&(p[element].v21), 1);
+
+        __double_decode_array_cleanup(&(p[element].v22), 1);
+
+        __double_decode_array_cleanup(&(p[element].v23), 1);
+
+        __double_decode_array_cleanup(&(p[element].v24), 1);
+
+        __double_decode_array_cleanup(&(p[element].v25), 1);
+
+        __double_decode_array_cleanup(&(p[element].v26), 1);
+
+        __double_decode_array_cleanup(&(p[element].v27), 1);
+
+        __double_decode_array_cleanup(&(p[element].v28), 1);
+
+        __double_decode_array_cleanup(&(p[element].v29), 1);
+
+        __int16_t_decode_array_cleanup(&(p[element].status), 1);
+
+        __boolean_decode_array_cleanup(&(p[element].valid), 1);
+
+        { int a;
+        for (a = 0; a < 6; ++a) {
+            __float_decode_array_cleanup(p[element].cov[a], 6);
+        }
+        }
+
+    }
+    return 0;
+}
+
+int wide_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, wide_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __wide_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __wide_t_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int wide_t_decode_cleanup(wide_t* p)
+{
+    return __wide_t_decode_array_cleanup(p, 1);
+}
+
+uint32_t __wide_t_clone_array(const wide_t* p, wide_t* q, uint32_t elements)
+{
+    uint32_t n = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        n += __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        n += __int32_t_clone_array(&(p[element].seq), &(q[element].seq), 1);
+
+        n += __double_clone_array(&(p[element].v0), &(q[element].v0), 1);
+
+        n += __double_clone_array(&(p[element].v1), &(q[element].v1), 1);
+
+        n += __double_clone_array(&(p[element].v2), &(q[element].v2), 1);
+
+        n += __double_clone_array(&(p[element].v3), &(q[element].v3), 1);
+
+        n += __double_clone_array(&(p[element].v4), &(q[element].v4), 1);
+
+        n += __double_clone_array(&(p[element].v5), &(q[element].v5), 1);
+
+        n += __double_clone_array(&(p[element].v6), &(q[element].v6), 1);
+
+        n += __double_clone_array(&(p[element].v7), &(q[element].v7), 1);
+
+        n += __double_clone_array(&(p[element].v8), &(q[element].v8), 1);
+
+        n += __double_clone_array(&(p[element].v9), &(q[element].v9), 1);
+
+        n += __double_clone_array(&(p[element].v10), &(q[element].v10), 1);
+
+        n += __double_clone_array(&(p[element].v11), &(q[element].v11), 1);
+
+        n += __double_clone_array(&(p[element].v12), &(q[element].v12), 1);
+
+        n += __double_clone_array(&(p[element].v13), &(q[element].v13), 1);
+
+        n += __double_clone_array(&(p[element].v14), &(q[element].v14), 1);
+
+        n += __double_clone_array(&(p[element].v15), &(q[element].v15), 1);
+
+        n += __double_clone_array(&(p[element].v16), &(q[element].v16), 1);
+
+        n += __double_clone_array(&(p[element].v17), &(q[element].v17), 1);
+
+        n += __double_clone_array(&(p[element].v18), &(q[element].v18), 1);
+
+        n += __double_clone_array(&(p[element].v19), &(q[element].v19), 1);
+
+        n += __double_clone_array(&(p[element].v20), &(q[element].v20), 1);
+
+        n += __double_clone_array(&(p[element].v21), &(q[element].v21), 1);
+
+        n += __double_clone_array(&(p[element].v22), &(q[element].v22), 1);
+
+        n += __double_clone_array(&(p[element].v23), &(q[element].v23), 1);
+
+        n += __double_clone_array(&(p[element].v24), &(q[element].v24), 1);
+
+        n += __double_clone_array(&(p[element].v25), &(q[element].v25), 1);
+
+        n += __double_clone_array(&(p[element].v26), &(q[element].v26), 1);
+
+        n += __double_clone_array(&(p[element].v27), &(q[element].v27), 1);
+
+        n += __double_clone_array(&(p[element].v28), &(q[element].v28), 1);
+
+        n += __double_clone_array(&(p[element].v29), &(q[element].v29), 1);
+
+        n += __int16_t_clone_array(&(p[element].status), &(q[element].status), 1);
+
+        n += __boolean_clone_array(&(p[element].valid), &(q[element].valid), 1);
+
+        { int a;
+        for (a = 0; a < 6; ++a) {
+            n += __float_clone_array(p[element].cov[a], q[element].cov[a], 6);
+        }
+        }
+
+    }
+    return n;
+}
+
+wide_t* wide_t_copy(const wide_t* p)
+{
+    wide_t* q = (wide_t*) malloc(sizeof(wide_t));
+    __wide_t_clone_array(p, q, 1);
+    return q;
+}
+
+void wide_t_destroy(wide_t* p)
+{
+    __wide_t_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int wide_t_publish(zcm_t* zcm, const char* channel, const wide_t* p)
+{
+      uint32_t max_data_size = wide_t_encoded_size (p);
+      uint8_t* buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = wide_t_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (zcm, channel, buf, (uint32_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _wide_t_subscription_t {
+    wide_t_handler_t user_handler;
+    void* userdata;
+    zcm_sub_t* z_sub;
+};
+static
+void wide_t_handler_stub (const zcm_recv_buf_t* rbuf,
+                            const char* channel, void* userdata)
+{
+    int status;
+    wide_t p;
+    memset(&p, 0, sizeof(wide_t));
+    status = wide_t_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr, "error %d decoding wide_t!!!\n", status);
+        #endif
+        return;
+    }
+
+    wide_t_subscription_t* h = (wide_t_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    wide_t_decode_cleanup (&p);
+}
+
+wide_t_subscription_t* wide_t_subscribe (zcm_t* zcm,
+                    const char* channel,
+                    wide_t_handler_t f, void* userdata)
+{
+    wide_t_subscription_t* n = (wide_t_subscription_t*)
+                       malloc(sizeof(wide_t_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              wide_t_handler_stub, n);
+    if (n->z_sub == NULL) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr,"couldn't reg wide_t ZCM handler!\n");
+        #endif
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int wide_t_unsubscribe(zcm_t* zcm, wide_t_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr,
+           "couldn't unsubscribe wide_t_handler %p!\n", hid);
+        #endif
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,166 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _wide_t_h
+#define _wide_t_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _wide_t wide_t;
+struct _wide_t
+{
+    int64_t    utime;
+    int32_t    seq;
+    double     v0;
+    double     v1;
+    double     v2;
+    double     v3;
+    double     v4;
+    double     v5;
+    double     v6;
+    double     v7;
+    double     v8;
+    double     v9;
+    double     v10;
+    double     v11;
+    double     v12;
+    double     v13;
+    double     v14;
+    double     v15;
+    double     v16;
+    double     v17;
+    double     v18;
+    double     v19;
+    double     v20;
+    double     v21;
+    double     v22;
+    double     v23;
+    double     v24;
+    double     v25;
+    double     v26;
+    double     v27;
+    double     v28;
+    double     v29;
+    int16_t    status;
+    int8_t     valid;
+    float      cov[6][6];
+};
+
+/**
+ * Create a deep copy of a wide_t.
+ * When no longer needed, destroy it with wide_t_destroy()
+ */
+wide_t* wide_t_copy(const wide_t* to_copy);
+
+/**
+ * Destroy an instance of wide_t created by wide_t_copy()
+ */
+void wide_t_destroy(wide_t* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _wide_t_subscription_t wide_t_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * wide_t is received.
+ */
+typedef void(*wide_t_handler_t)(const zcm_recv_buf_t* rbuf,
+             const char* channel, const wide_t* msg, void* userdata);
+
+/**
+ * Publish a message of type wide_t using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int wide_t_publish(zcm_t* zcm, const char* channel, const wide_t* msg);
+
+/**
+ * Subscribe to messages of type wide_t using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to wide_t_unsubscribe.
+ */
+wide_t_subscription_t* wide_t_subscribe(zcm_t* zcm, const char* channel, wide_t_handler_t handler, void* userdata);
+
+/**
+ * Removes and destroys a subscription created by wide_t_subscribe()
+ */
+int wide_t_unsubscribe(zcm_t* zcm, wide_t_subscription_t* hid);
+/**
+ * Encode a message of type wide_t into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to wide_t_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int wide_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const wide_t* p);
+
+/**
+ * Decode a message of type wide_t from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with wide_t_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int wide_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, wide_t* msg);
+
+/**
+ * Release resources allocated by wide_t_decode()
+ * @return 0
+ */
+int wide_t_decode_cleanup(wide_t* p);
+
+/**
+ * Check how many bytes are required to encode a message of type wide_t
+ */
+uint32_t wide_t_encoded_size(const wide_t* p);
+uint32_t wide_t_struct_size(void);
+uint32_t wide_t_num_fields(void);
+int      wide_t_get_field(const wide_t* p, uint32_t i, zcm_field_t* f);
+const zcm_type_info_t* wide_t_get_type_info(void);
+const zcm_type_desc_t* wide_t_get_type_desc(void);
+
+// ZCM support functions. Users should not call these
+int64_t  __wide_t_get_hash(void);
+uint64_t __wide_t_hash_recursive(const __zcm_hash_ptr* p);
+int      __wide_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const wide_t* p, uint32_t elements);
+int      __wide_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, wide_t* p, uint32_t elements);
+int      __wide_t_decode_array_cleanup(wide_t* p, uint32_t elements);
+uint32_t __wide_t_encoded_array_size(const wide_t* p, uint32_t elements);
+uint32_t __wide_t_clone_array(const wide_t* p, wide_t* q, uint32_t elements);
+extern const zcm_type_desc_t __wide_t_type_desc;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,397 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include <stddef.h>
+#ifndef ZCM_EMBEDDED
+#include <stdio.h>
+#endif
+#include "types/arena_elem_t.h"
+
+static int __arena_elem_t_hash_computed = 0;
+static uint64_t __arena_elem_t_hash;
+
+uint64_t __arena_elem_t_hash_recursive(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __arena_elem_t_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__arena_elem_t_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x71820240941eb4e7LL
+         + __string_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __float_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __arena_elem_t_get_hash(void)
+{
+    if (!__arena_elem_t_hash_computed) {
+        __arena_elem_t_hash = (int64_t)__arena_elem_t_hash_recursive(NULL);
+        __arena_elem_t_hash_computed = 1;
+    }
+
+    return __arena_elem_t_hash;
+}
+
+int __arena_elem_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const arena_elem_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &(p[element].label), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].num_values), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __float_encode_array(buf, offset + pos, maxlen - pos, p[element].values, p[element].num_values);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int arena_elem_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const arena_elem_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __arena_elem_t_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __arena_elem_t_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __arena_elem_t_encoded_array_size(const arena_elem_t* p, uint32_t elements)
+{
+    uint32_t size = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        size += __string_encoded_array_size(&(p[element].label), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].num_values), 1);
+
+        size += __float_encoded_array_size(p[element].values, p[element].num_values);
+
+    }
+    return size;
+}
+
+uint32_t arena_elem_t_encoded_size(const arena_elem_t* p)
+{
+    return 8 + __arena_elem_t_encoded_array_size(p, 1);
+}
+
+uint32_t arena_elem_t_struct_size(void)
+{
+    return sizeof(arena_elem_t);
+}
+
+uint32_t arena_elem_t_num_fields(void)
+{
+    return 3;
+}
+
+int arena_elem_t_get_field(const arena_elem_t* p, uint32_t i, zcm_field_t* f)
+{
+    if (i >= arena_elem_t_num_fields())
+        return 1;
+    
+    switch (i) {
+    
+        case 0: {
+            f->name = "label";
+            f->type = ZCM_FIELD_STRING;
+            f->typestr = "string";
+            f->num_dim = 0;
+            f->data = (void*) &p->label;
+            return 0;
+        }
+        
+        case 1: {
+            f->name = "num_values";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->num_values;
+            return 0;
+        }
+        
+        case 2: {
+            f->name = "values";
+            f->type = ZCM_FIELD_FLOAT;
+            f->typestr = "float";
+            f->num_dim = 1;
+            f->dim_size[0] = p->num_values;
+            f->dim_is_variable[0] = 1;
+            f->data = (void*) &p->values;
+            return 0;
+        }
+        
+        default:
+            return 1;
+    }
+}
+
+const zcm_type_info_t* arena_elem_t_get_type_info(void)
+{
+    static int init = 0;
+    static zcm_type_info_t typeinfo;
+    if (!init) {
+        typeinfo.encode         = (zcm_encode_t) arena_elem_t_encode;
+        typeinfo.decode         = (zcm_decode_t) arena_elem_t_decode;
+        typeinfo.decode_cleanup = (zcm_decode_cleanup_t) arena_elem_t_decode_cleanup;
+        typeinfo.encoded_size   = (zcm_encoded_size_t) arena_elem_t_encoded_size;
+        typeinfo.struct_size    = (zcm_struct_size_t)  arena_elem_t_struct_size;
+        typeinfo.num_fields     = (zcm_num_fields_t) arena_elem_t_num_fields;
+        typeinfo.get_field      = (zcm_get_field_t) arena_elem_t_get_field;
+        typeinfo.get_hash       = (zcm_get_hash_t) __arena_elem_t_get_hash;
+    }
+    
+    return &typeinfo;
+}
+
+static const zcm_dim_desc_t __arena_elem_t_dims[] = {
+    { 1, 1 }, /* values.num_values */
+};
+
+static const zcm_field_desc_t __arena_elem_t_fields[] = {
+    { "label", ZCM_FIELD_STRING, "string", offsetof(arena_elem_t, label), 0, NULL, NULL },
+    { "num_values", ZCM_FIELD_INT32_T, "int32_t", offsetof(arena_elem_t, num_values), 0, NULL, NULL },
+    { "values", ZCM_FIELD_FLOAT, "float", offsetof(arena_elem_t, values), 1, __arena_elem_t_dims + 0, NULL },
+};
+
+const zcm_type_desc_t __arena_elem_t_type_desc = {
+    "arena_elem_t", __arena_elem_t_get_hash, sizeof(arena_elem_t), 0,
+    3, __arena_elem_t_fields
+};
+
+const zcm_type_desc_t* arena_elem_t_get_type_desc(void)
+{
+    return &__arena_elem_t_type_desc;
+}
+int __arena_elem_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, &(p[element].label), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].num_values), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].values = (float*) zcm_malloc(sizeof(float) * p[element].num_values);
+        thislen = __float_decode_array(buf, offset + pos, maxlen - pos, p[element].values, p[element].num_values);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __arena_elem_t_decode_array_cleanup(arena_elem_t* p, uint32_t elements)
+{
+    uint32_t element;
+    for (element = 0; element < elements; ++element) {
+
+        __string_decode_array_cleanup(&(p[element].label), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].num_values), 1);
+
+        __float_decode_array_cleanup(p[element].values, p[element].num_values);
+        if (p[element].values) free(p[element].values);
+
+    }
+    return 0;
+}
+
+int arena_elem_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __arena_elem_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena_elem_t_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int arena_elem_t_decode_cleanup(arena_elem_t* p)
+{
+    return __arena_elem_t_decode_array_cleanup(p, 1);
+}
+
+int __arena_elem_t_decode_array_arena(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* p, uint32_t elements, zcm_arena_t* arena)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+    (void) arena;
+
+    for (element = 0; element < elements; ++element) {
+
+        thislen = __string_decode_array_arena(buf, offset + pos, maxlen - pos, &(p[element].label), 1, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].num_values), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        if (__zcm_array_count(1, p[element].num_values) > (maxlen - pos) / 4) return -1;
+        p[element].values = (float*) zcm_arena_alloc(arena, sizeof(float) * p[element].num_values);
+        thislen = __float_decode_array(buf, offset + pos, maxlen - pos, p[element].values, p[element].num_values);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int arena_elem_t_decode_arena(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* p, zcm_arena_t* arena)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __arena_elem_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena_elem_t_decode_array_arena(buf, offset + pos, maxlen - pos, p, 1, arena);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __arena_elem_t_clone_array(const arena_elem_t* p, arena_elem_t* q, uint32_t elements)
+{
+    uint32_t n = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        n += __string_clone_array(&(p[element].label), &(q[element].label), 1);
+
+        n += __int32_t_clone_array(&(p[element].num_values), &(q[element].num_values), 1);
+
+        q[element].values = (float*) zcm_malloc(sizeof(float) * q[element].num_values);
+        n += __float_clone_array(p[element].values, q[element].values, p[element].num_values);
+
+    }
+    return n;
+}
+
+arena_elem_t* arena_elem_t_copy(const arena_elem_t* p)
+{
+    arena_elem_t* q = (arena_elem_t*) malloc(sizeof(arena_elem_t));
+    __arena_elem_t_clone_array(p, q, 1);
+    return q;
+}
+
+void arena_elem_t_destroy(arena_elem_t* p)
+{
+    __arena_elem_t_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int arena_elem_t_publish(zcm_t* zcm, const char* channel, const arena_elem_t* p)
+{
+      static ZCM_THREAD_LOCAL uint8_t* buf = NULL;
+      static ZCM_THREAD_LOCAL uint32_t buf_size = 0;
+      uint32_t max_data_size = arena_elem_t_encoded_size (p);
+      if (max_data_size > buf_size) {
+          uint8_t* newbuf = (uint8_t*) realloc (buf, max_data_size);
+          if (!newbuf) return -1;
+          buf = newbuf;
+          buf_size = max_data_size;
+      }
+      int data_size = arena_elem_t_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) return data_size;
+      return zcm_publish (zcm, channel, buf, (uint32_t)data_size);
+}
+
+struct _arena_elem_t_subscription_t {
+    arena_elem_t_handler_t user_handler;
+    void* userdata;
+    zcm_sub_t* z_sub;
+    zcm_arena_t arena;
+};
+static
+void arena_elem_t_handler_stub (const zcm_recv_buf_t* rbuf,
+                            const char* channel, void* userdata)
+{
+    int status;
+    arena_elem_t p;
+    arena_elem_t_subscription_t* h = (arena_elem_t_subscription_t*) userdata;
+    memset(&p, 0, sizeof(arena_elem_t));
+    status = arena_elem_t_decode_arena (rbuf->data, 0, rbuf->data_size, &p, &h->arena);
+    if (status < 0) {
+        zcm_arena_reset (&h->arena);
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr, "error %d decoding arena_elem_t!!!\n", status);
+        #endif
+        return;
+    }
+
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    zcm_arena_reset (&h->arena);
+}
+
+arena_elem_t_subscription_t* arena_elem_t_subscribe (zcm_t* zcm,
+                    const char* channel,
+                    arena_elem_t_handler_t f, void* userdata)
+{
+    arena_elem_t_subscription_t* n = (arena_elem_t_subscription_t*)
+                       malloc(sizeof(arena_elem_t_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    zcm_arena_init (&n->arena, NULL, 0);
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              arena_elem_t_handler_stub, n);
+    if (n->z_sub == NULL) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr,"couldn't reg arena_elem_t ZCM handler!\n");
+        #endif
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int arena_elem_t_unsubscribe(zcm_t* zcm, arena_elem_t_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr,
+           "couldn't unsubscribe arena_elem_t_handler %p!\n", hid);
+        #endif
+        return -1;
+    }
+    zcm_arena_destroy (&hid->arena);
+    free (hid);
+    return 0;
+}
+
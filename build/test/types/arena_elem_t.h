@@ -0,0 +1,142 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _arena_elem_t_h
+#define _arena_elem_t_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _arena_elem_t arena_elem_t;
+struct _arena_elem_t
+{
+    char*      label;
+    int32_t    num_values;
+    float      *values;
+};
+
+/**
+ * Create a deep copy of a arena_elem_t.
+ * When no longer needed, destroy it with arena_elem_t_destroy()
+ */
+arena_elem_t* arena_elem_t_copy(const arena_elem_t* to_copy);
+
+/**
+ * Destroy an instance of arena_elem_t created by arena_elem_t_copy()
+ */
+void arena_elem_t_destroy(arena_elem_t* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _arena_elem_t_subscription_t arena_elem_t_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * arena_elem_t is received.
+ */
+typedef void(*arena_elem_t_handler_t)(const zcm_recv_buf_t* rbuf,
+             const char* channel, const arena_elem_t* msg, void* userdata);
+
+/**
+ * Publish a message of type arena_elem_t using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int arena_elem_t_publish(zcm_t* zcm, const char* channel, const arena_elem_t* msg);
+
+/**
+ * Subscribe to messages of type arena_elem_t using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to arena_elem_t_unsubscribe.
+ */
+arena_elem_t_subscription_t* arena_elem_t_subscribe(zcm_t* zcm, const char* channel, arena_elem_t_handler_t handler, void* userdata);
+
+/**
+ * Removes and destroys a subscription created by arena_elem_t_subscribe()
+ */
+int arena_elem_t_unsubscribe(zcm_t* zcm, arena_elem_t_subscription_t* hid);
+/**
+ * Encode a message of type arena_elem_t into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to arena_elem_t_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int arena_elem_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const arena_elem_t* p);
+
+/**
+ * Decode a message of type arena_elem_t from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with arena_elem_t_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int arena_elem_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* msg);
+
+/**
+ * Release resources allocated by arena_elem_t_decode()
+ * @return 0
+ */
+int arena_elem_t_decode_cleanup(arena_elem_t* p);
+
+/**
+ * Decode a message of type arena_elem_t from binary form like arena_elem_t_decode(),
+ * but take strings and variable-length arrays from @p arena. They are
+ * released by zcm_arena_reset() instead of arena_elem_t_decode_cleanup().
+ */
+int arena_elem_t_decode_arena(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* msg, zcm_arena_t* arena);
+
+/**
+ * Check how many bytes are required to encode a message of type arena_elem_t
+ */
+uint32_t arena_elem_t_encoded_size(const arena_elem_t* p);
+uint32_t arena_elem_t_struct_size(void);
+uint32_t arena_elem_t_num_fields(void);
+int      arena_elem_t_get_field(const arena_elem_t* p, uint32_t i, zcm_field_t* f);
+const zcm_type_info_t* arena_elem_t_get_type_info(void);
+const zcm_type_desc_t* arena_elem_t_get_type_desc(void);
+
+// ZCM support functions. Users should not call these
+int64_t  __arena_elem_t_get_hash(void);
+uint64_t __arena_elem_t_hash_recursive(const __zcm_hash_ptr* p);
+int      __arena_elem_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const arena_elem_t* p, uint32_t elements);
+int      __arena_elem_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* p, uint32_t elements);
+int      __arena_elem_t_decode_array_cleanup(arena_elem_t* p, uint32_t elements);
+int      __arena_elem_t_decode_array_arena(const void* buf, uint32_t offset, uint32_t maxlen, arena_elem_t* p, uint32_t elements, zcm_arena_t* arena);
+uint32_t __arena_elem_t_encoded_array_size(const arena_elem_t* p, uint32_t elements);
+uint32_t __arena_elem_t_clone_array(const arena_elem_t* p, arena_elem_t* q, uint32_t elements);
+extern const zcm_type_desc_t __arena_elem_t_type_desc;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,575 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include <stddef.h>
+#ifndef ZCM_EMBEDDED
+#include <stdio.h>
+#endif
+#include "types/arena_t.h"
+
+static int __arena_t_hash_computed = 0;
+static uint64_t __arena_t_hash;
+
+uint64_t __arena_t_hash_recursive(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __arena_t_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__arena_t_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0xd5c59bcb2702fe0fLL
+         + __int64_t_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __string_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __arena_elem_t_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __arena_t_get_hash(void)
+{
+    if (!__arena_t_hash_computed) {
+        __arena_t_hash = (int64_t)__arena_t_hash_recursive(NULL);
+        __arena_t_hash_computed = 1;
+    }
+
+    return __arena_t_hash;
+}
+
+int __arena_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const arena_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 16) return -1;
+        {
+            uint8_t* run = (uint8_t*) buf + offset + pos;
+            __int64_t_store(run + 0, p[element].utime);
+            __int32_t_store(run + 8, p[element].rows);
+            __int32_t_store(run + 12, p[element].cols);
+        }
+        pos += 16;
+
+        { int a;
+        for (a = 0; a < p[element].rows; ++a) {
+            thislen = __double_encode_array(buf, offset + pos, maxlen - pos, p[element].grid[a], p[element].cols);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].num_names), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, p[element].names, p[element].num_names);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].num_elems), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __arena_elem_t_encode_array(buf, offset + pos, maxlen - pos, p[element].elems, p[element].num_elems);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int arena_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const arena_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __arena_t_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __arena_t_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __arena_t_encoded_array_size(const arena_t* p, uint32_t elements)
+{
+    uint32_t size = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        size += __int64_t_encoded_array_size(&(p[element].utime), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].rows), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].cols), 1);
+
+        { int a;
+        for (a = 0; a < p[element].rows; ++a) {
+            size += __double_encoded_array_size(p[element].grid[a], p[element].cols);
+        }
+        }
+
+        size += __int32_t_encoded_array_size(&(p[element].num_names), 1);
+
+        size += __string_encoded_array_size(p[element].names, p[element].num_names);
+
+        size += __int32_t_encoded_array_size(&(p[element].num_elems), 1);
+
+        size += __arena_elem_t_encoded_array_size(p[element].elems, p[element].num_elems);
+
+    }
+    return size;
+}
+
+uint32_t arena_t_encoded_size(const arena_t* p)
+{
+    return 8 + __arena_t_encoded_array_size(p, 1);
+}
+
+uint32_t arena_t_struct_size(void)
+{
+    return sizeof(arena_t);
+}
+
+uint32_t arena_t_num_fields(void)
+{
+    return 8;
+}
+
+int arena_t_get_field(const arena_t* p, uint32_t i, zcm_field_t* f)
+{
+    if (i >= arena_t_num_fields())
+        return 1;
+    
+    switch (i) {
+    
+        case 0: {
+            f->name = "utime";
+            f->type = ZCM_FIELD_INT64_T;
+            f->typestr = "int64_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->utime;
+            return 0;
+        }
+        
+        case 1: {
+            f->name = "rows";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->rows;
+            return 0;
+        }
+        
+        case 2: {
+            f->name = "cols";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->cols;
+            return 0;
+        }
+        
+        case 3: {
+            f->name = "grid";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 2;
+            f->dim_size[0] = p->rows;
+            f->dim_size[1] = p->cols;
+            f->dim_is_variable[0] = 1;
+            f->dim_is_variable[1] = 1;
+            f->data = (void*) &p->grid;
+            return 0;
+        }
+        
+        case 4: {
+            f->name = "num_names";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->num_names;
+            return 0;
+        }
+        
+        case 5: {
+            f->name = "names";
+            f->type = ZCM_FIELD_STRING;
+            f->typestr = "string";
+            f->num_dim = 1;
+            f->dim_size[0] = p->num_names;
+            f->dim_is_variable[0] = 1;
+            f->data = (void*) &p->names;
+            return 0;
+        }
+        
+        case 6: {
+            f->name = "num_elems";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->num_elems;
+            return 0;
+        }
+        
+        case 7: {
+            /* arena_elem_t */
+            f->name = "elems";
+            f->type = ZCM_FIELD_USER_TYPE;
+            f->typestr = "arena_elem_t";
+            f->num_dim = 1;
+            f->dim_size[0] = p->num_elems;
+            f->dim_is_variable[0] = 1;
+            f->data = (void*) &p->elems;
+            return 0;
+        }
+        
+        default:
+            return 1;
+    }
+}
+
+const zcm_type_info_t* arena_t_get_type_info(void)
+{
+    static int init = 0;
+    static zcm_type_info_t typeinfo;
+    if (!init) {
+        typeinfo.encode         = (zcm_encode_t) arena_t_encode;
+        typeinfo.decode         = (zcm_decode_t) arena_t_decode;
+        typeinfo.decode_cleanup = (zcm_decode_cleanup_t) arena_t_decode_cleanup;
+        typeinfo.encoded_size   = (zcm_encoded_size_t) arena_t_encoded_size;
+        typeinfo.struct_size    = (zcm_struct_size_t)  arena_t_struct_size;
+        typeinfo.num_fields     = (zcm_num_fields_t) arena_t_num_fields;
+        typeinfo.get_field      = (zcm_get_field_t) arena_t_get_field;
+        typeinfo.get_hash       = (zcm_get_hash_t) __arena_t_get_hash;
+    }
+    
+    return &typeinfo;
+}
+
+static const zcm_dim_desc_t __arena_t_dims[] = {
+    { 1, 1 }, /* grid.rows */
+    { 2, 1 }, /* grid.cols */
+    { 4, 1 }, /* names.num_names */
+    { 6, 1 }, /* elems.num_elems */
+};
+
+static const zcm_field_desc_t __arena_t_fields[] = {
+    { "utime", ZCM_FIELD_INT64_T, "int64_t", offsetof(arena_t, utime), 0, NULL, NULL },
+    { "rows", ZCM_FIELD_INT32_T, "int32_t", offsetof(arena_t, rows), 0, NULL, NULL },
+    { "cols", ZCM_FIELD_INT32_T, "int32_t", offsetof(arena_t, cols), 0, NULL, NULL },
+    { "grid", ZCM_FIELD_DOUBLE, "double", offsetof(arena_t, grid), 2, __arena_t_dims + 0, NULL },
+    { "num_names", ZCM_FIELD_INT32_T, "int32_t", offsetof(arena_t, num_names), 0, NULL, NULL },
+    { "names", ZCM_FIELD_STRING, "string", offsetof(arena_t, names), 1, __arena_t_dims + 2, NULL },
+    { "num_elems", ZCM_FIELD_INT32_T, "int32_t", offsetof(arena_t, num_elems), 0, NULL, NULL },
+    { "elems", ZCM_FIELD_USER_TYPE, "arena_elem_t", offsetof(arena_t, elems), 1, __arena_t_dims + 3, &__arena_elem_t_type_desc },
+};
+
+const zcm_type_desc_t __arena_t_type_desc = {
+    "arena_t", __arena_t_get_hash, sizeof(arena_t), 0,
+    8, __arena_t_fields
+};
+
+const zcm_type_desc_t* arena_t_get_type_desc(void)
+{
+    return &__arena_t_type_desc;
+}
+int __arena_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, arena_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 16) return -1;
+        {
+            const uint8_t* run = (const uint8_t*) buf + offset + pos;
+            p[element].utime = __int64_t_load(run + 0);
+            p[element].rows = __int32_t_load(run + 8);
+            p[element].cols = __int32_t_load(run + 12);
+        }
+        pos += 16;
+
+        p[element].grid = (double**) zcm_malloc(sizeof(double*) * p[element].rows);
+        { int a;
+        for (a = 0; a < p[element].rows; ++a) {
+            p[element].grid[a] = (double*) zcm_malloc(sizeof(double) * p[element].cols);
+            thislen = __double_decode_array(buf, offset + pos, maxlen - pos, p[element].grid[a], p[element].cols);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].num_names), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].names = (char**) zcm_malloc(sizeof(char*) * p[element].num_names);
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, p[element].names, p[element].num_names);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].num_elems), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        p[element].elems = (arena_elem_t*) zcm_malloc(sizeof(arena_elem_t) * p[element].num_elems);
+        thislen = __arena_elem_t_decode_array(buf, offset + pos, maxlen - pos, p[element].elems, p[element].num_elems);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __arena_t_decode_array_cleanup(arena_t* p, uint32_t elements)
+{
+    uint32_t element;
+    for (element = 0; element < elements; ++element) {
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].rows), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].cols), 1);
+
+        { int a;
+        for (a = 0; a < p[element].rows; ++a) {
+            __double_decode_array_cleanup(p[element].grid[a], p[element].cols);
+            if (p[element].grid[a]) free(p[element].grid[a]);
+        }
+        }
+        if (p[element].grid) free(p[element].grid);
+
+        __int32_t_decode_array_cleanup(&(p[element].num_names), 1);
+
+        __string_decode_array_cleanup(p[element].names, p[element].num_names);
+        if (p[element].names) free(p[element].names);
+
+        __int32_t_decode_array_cleanup(&(p[element].num_elems), 1);
+
+        __arena_elem_t_decode_array_cleanup(p[element].elems, p[element].num_elems);
+        if (p[element].elems) free(p[element].elems);
+
+    }
+    return 0;
+}
+
+int arena_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, arena_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __arena_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena_t_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int arena_t_decode_cleanup(arena_t* p)
+{
+    return __arena_t_decode_array_cleanup(p, 1);
+}
+
+int __arena_t_decode_array_arena(const void* buf, uint32_t offset, uint32_t maxlen, arena_t* p, uint32_t elements, zcm_arena_t* arena)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+    (void) arena;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 16) return -1;
+        {
+            const uint8_t* run = (const uint8_t*) buf + offset + pos;
+            p[element].utime = __int64_t_load(run + 0);
+            p[element].rows = __int32_t_load(run + 8);
+            p[element].cols = __int32_t_load(run + 12);
+        }
+        pos += 16;
+
+        if (__zcm_array_count(__zcm_array_count(1, p[element].rows), p[element].cols) > (maxlen - pos) / 8) return -1;
+        p[element].grid = (double**) zcm_arena_alloc(arena, sizeof(double*) * p[element].rows);
+        { int a;
+        for (a = 0; a < p[element].rows; ++a) {
+            p[element].grid[a] = (double*) zcm_arena_alloc(arena, sizeof(double) * p[element].cols);
+            thislen = __double_decode_array(buf, offset + pos, maxlen - pos, p[element].grid[a], p[element].cols);
+            if (thislen < 0) return thislen; else pos += thislen;
+        }
+        }
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].num_names), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        if (__zcm_array_count(1, p[element].num_names) > (maxlen - pos) / 4) return -1;
+        p[element].names = (char**) zcm_arena_alloc(arena, sizeof(char*) * p[element].num_names);
+        thislen = __string_decode_array_arena(buf, offset + pos, maxlen - pos, p[element].names, p[element].num_names, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].num_elems), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        if (__zcm_array_count(1, p[element].num_elems) > maxlen - pos) return -1;
+        p[element].elems = (arena_elem_t*) zcm_arena_alloc(arena, sizeof(arena_elem_t) * p[element].num_elems);
+        thislen = __arena_elem_t_decode_array_arena(buf, offset + pos, maxlen - pos, p[element].elems, p[element].num_elems, arena);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int arena_t_decode_arena(const void* buf, uint32_t offset, uint32_t maxlen, arena_t* p, zcm_arena_t* arena)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __arena_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __arena_t_decode_array_arena(buf, offset + pos, maxlen - pos, p, 1, arena);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __arena_t_clone_array(const arena_t* p, arena_t* q, uint32_t elements)
+{
+    uint32_t n = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        n += __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        n += __int32_t_clone_array(&(p[element].rows), &(q[element].rows), 1);
+
+        n += __int32_t_clone_array(&(p[element].cols), &(q[element].cols), 1);
+
+        q[element].grid = (double**) zcm_malloc(sizeof(double*) * q[element].rows);
+        { int a;
+        for (a = 0; a < p[element].rows; ++a) {
+            q[element].grid[a] = (double*) zcm_malloc(sizeof(double) * q[element].cols);
+            n += __double_clone_array(p[element].grid[a], q[element].grid[a], p[element].cols);
+        }
+        }
+
+        n += __int32_t_clone_array(&(p[element].num_names), &(q[element].num_names), 1);
+
+        q[element].names = (char**) zcm_malloc(sizeof(char*) * q[element].num_names);
+        n += __string_clone_array(p[element].names, q[element].names, p[element].num_names);
+
+        n += __int32_t_clone_array(&(p[element].num_elems), &(q[element].num_elems), 1);
+
+        q[element].elems = (arena_elem_t*) zcm_malloc(sizeof(arena_elem_t) * q[element].num_elems);
+        n += __arena_elem_t_clone_array(p[element].elems, q[element].elems, p[element].num_elems);
+
+    }
+    return n;
+}
+
+arena_t* arena_t_copy(const arena_t* p)
+{
+    arena_t* q = (arena_t*) malloc(sizeof(arena_t));
+    __arena_t_clone_array(p, q, 1);
+    return q;
+}
+
+void arena_t_destroy(arena_t* p)
+{
+    __arena_t_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int arena_t_publish(zcm_t* zcm, const char* channel, const arena_t* p)
+{
+      static ZCM_THREAD_LOCAL uint8_t* buf = NULL;
+      static ZCM_THREAD_LOCAL uint32_t buf_size = 0;
+      uint32_t max_data_size = arena_t_encoded_size (p);
+      if (max_data_size > buf_size) {
+          uint8_t* newbuf = (uint8_t*) realloc (buf, max_data_size);
+          if (!newbuf) return -1;
+          buf = newbuf;
+          buf_size = max_data_size;
+      }
+      int data_size = arena_t_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) return data_size;
+      return zcm_publish (zcm, channel, buf, (uint32_t)data_size);
+}
+
+struct _arena_t_subscription_t {
+    arena_t_handler_t user_handler;
+    void* userdata;
+    zcm_sub_t* z_sub;
+    zcm_arena_t arena;
+};
+static
+void arena_t_handler_stub (const zcm_recv_buf_t* rbuf,
+                            const char* channel, void* userdata)
+{
+    int status;
+    arena_t p;
+    arena_t_subscription_t* h = (arena_t_subscription_t*) userdata;
+    memset(&p, 0, sizeof(arena_t));
+    status = arena_t_decode_arena (rbuf->data, 0, rbuf->data_size, &p, &h->arena);
+    if (status < 0) {
+        zcm_arena_reset (&h->arena);
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr, "error %d decoding arena_t!!!\n", status);
+        #endif
+        return;
+    }
+
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    zcm_arena_reset (&h->arena);
+}
+
+arena_t_subscription_t* arena_t_subscribe (zcm_t* zcm,
+                    const char* channel,
+                    arena_t_handler_t f, void* userdata)
+{
+    arena_t_subscription_t* n = (arena_t_subscription_t*)
+                       malloc(sizeof(arena_t_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    zcm_arena_init (&n->arena, NULL, 0);
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              arena_t_handler_stub, n);
+    if (n->z_sub == NULL) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr,"couldn't reg arena_t ZCM handler!\n");
+        #endif
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int arena_t_unsubscribe(zcm_t* zcm, arena_t_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr,
+           "couldn't unsubscribe arena_t_handler %p!\n", hid);
+        #endif
+        return -1;
+    }
+    zcm_arena_destroy (&hid->arena);
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,452 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#include <stddef.h>
+#ifndef ZCM_EMBEDDED
+#include <stdio.h>
+#endif
+#include "types/example_t.h"
+
+static int __example_t_hash_computed = 0;
+static uint64_t __example_t_hash;
+
+uint64_t __example_t_hash_recursive(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __example_t_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__example_t_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0xf3da973dee888661LL
+         + __int64_t_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __double_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __int16_t_hash_recursive(&cp)
+         + __string_hash_recursive(&cp)
+         + __boolean_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __example_t_get_hash(void)
+{
+    if (!__example_t_hash_computed) {
+        __example_t_hash = (int64_t)__example_t_hash_recursive(NULL);
+        __example_t_hash_computed = 1;
+    }
+
+    return __example_t_hash;
+}
+
+int __example_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const example_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 68) return -1;
+        {
+            uint8_t* run = (uint8_t*) buf + offset + pos;
+            uint32_t a;
+            __int64_t_store(run + 0, p[element].utime);
+            for (a = 0; a < 3; ++a)
+                __double_store(run + 8 + 8 * a, (&p[element].position[0])[a]);
+            for (a = 0; a < 4; ++a)
+                __double_store(run + 32 + 8 * a, (&p[element].orientation[0])[a]);
+            __int32_t_store(run + 64, p[element].num_ranges);
+        }
+        pos += 68;
+
+        thislen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, p[element].ranges, p[element].num_ranges);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __boolean_encode_array(buf, offset + pos, maxlen - pos, &(p[element].enabled), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int example_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const example_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __example_t_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __example_t_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __example_t_encoded_array_size(const example_t* p, uint32_t elements)
+{
+    uint32_t size = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        size += __int64_t_encoded_array_size(&(p[element].utime), 1);
+
+        size += __double_encoded_array_size(p[element].position, 3);
+
+        size += __double_encoded_array_size(p[element].orientation, 4);
+
+        size += __int32_t_encoded_array_size(&(p[element].num_ranges), 1);
+
+        size += __int16_t_encoded_array_size(p[element].ranges, p[element].num_ranges);
+
+        size += __string_encoded_array_size(&(p[element].name), 1);
+
+        size += __boolean_encoded_array_size(&(p[element].enabled), 1);
+
+    }
+    return size;
+}
+
+uint32_t example_t_encoded_size(const example_t* p)
+{
+    return 8 + __example_t_encoded_array_size(p, 1);
+}
+
+uint32_t example_t_struct_size(void)
+{
+    return sizeof(example_t);
+}
+
+uint32_t example_t_num_fields(void)
+{
+    return 7;
+}
+
+int example_t_get_field(const example_t* p, uint32_t i, zcm_field_t* f)
+{
+    if (i >= example_t_num_fields())
+        return 1;
+    
+    switch (i) {
+    
+        case 0: {
+            f->name = "utime";
+            f->type = ZCM_FIELD_INT64_T;
+            f->typestr = "int64_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->utime;
+            return 0;
+        }
+        
+        case 1: {
+            f->name = "position";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 1;
+            f->dim_size[0] = 3;
+            f->dim_is_variable[0] = 0;
+            f->data = (void*) &p->position;
+            return 0;
+        }
+        
+        case 2: {
+            f->name = "orientation";
+            f->type = ZCM_FIELD_DOUBLE;
+            f->typestr = "double";
+            f->num_dim = 1;
+            f->dim_size[0] = 4;
+            f->dim_is_variable[0] = 0;
+            f->data = (void*) &p->orientation;
+            return 0;
+        }
+        
+        case 3: {
+            f->name = "num_ranges";
+            f->type = ZCM_FIELD_INT32_T;
+            f->typestr = "int32_t";
+            f->num_dim = 0;
+            f->data = (void*) &p->num_ranges;
+            return 0;
+        }
+        
+        case 4: {
+            f->name = "ranges";
+            f->type = ZCM_FIELD_INT16_T;
+            f->typestr = "int16_t";
+            f->num_dim = 1;
+            f->dim_size[0] = p->num_ranges;
+            f->dim_is_variable[0] = 1;
+            f->data = (void*) &p->ranges;
+            return 0;
+        }
+        
+        case 5: {
+            f->name = "name";
+            f->type = ZCM_FIELD_STRING;
+            f->typestr = "string";
+            f->num_dim = 0;
+            f->data = (void*) &p->name;
+            return 0;
+        }
+        
+        case 6: {
+            f->name = "enabled";
+            f->type = ZCM_FIELD_BOOLEAN;
+            f->typestr = "boolean";
+            f->num_dim = 0;
+            f->data = (void*) &p->enabled;
+            return 0;
+        }
+        
+        default:
+            return 1;
+    }
+}
+
+const zcm_type_info_t* example_t_get_type_info(void)
+{
+    static int init = 0;
+    static zcm_type_info_t typeinfo;
+    if (!init) {
+        typeinfo.encode         = (zcm_encode_t) example_t_encode;
+        typeinfo.decode         = (zcm_decode_t) example_t_decode;
+        typeinfo.decode_cleanup = (zcm_decode_cleanup_t) example_t_decode_cleanup;
+        typeinfo.encoded_size   = (zcm_encoded_size_t) example_t_encoded_size;
+        typeinfo.struct_size    = (zcm_struct_size_t)  example_t_struct_size;
+        typeinfo.num_fields     = (zcm_num_fields_t) example_t_num_fields;
+        typeinfo.get_field      = (zcm_get_field_t) example_t_get_field;
+        typeinfo.get_hash       = (zcm_get_hash_t) __example_t_get_hash;
+    }
+    
+    return &typeinfo;
+}
+
+static const zcm_dim_desc_t __example_t_dims[] = {
+    { 3, 0 }, /* position */
+    { 4, 0 }, /* orientation */
+    { 3, 1 }, /* ranges.num_ranges */
+};
+
+static const zcm_field_desc_t __example_t_fields[] = {
+    { "utime", ZCM_FIELD_INT64_T, "int64_t", offsetof(example_t, utime), 0, NULL, NULL },
+    { "position", ZCM_FIELD_DOUBLE, "double", offsetof(example_t, position), 1, __example_t_dims + 0, NULL },
+    { "orientation", ZCM_FIELD_DOUBLE, "double", offsetof(example_t, orientation), 1, __example_t_dims + 1, NULL },
+    { "num_ranges", ZCM_FIELD_INT32_T, "int32_t", offsetof(example_t, num_ranges), 0, NULL, NULL },
+    { "ranges", ZCM_FIELD_INT16_T, "int16_t", offsetof(example_t, ranges), 1, __example_t_dims + 2, NULL },
+    { "name", ZCM_FIELD_STRING, "string", offsetof(example_t, name), 0, NULL, NULL },
+    { "enabled", ZCM_FIELD_BOOLEAN, "boolean", offsetof(example_t, enabled), 0, NULL, NULL },
+};
+
+const zcm_type_desc_t __example_t_type_desc = {
+    "example_t", __example_t_get_hash, sizeof(example_t), 0,
+    7, __example_t_fields
+};
+
+const zcm_type_desc_t* example_t_get_type_desc(void)
+{
+    return &__example_t_type_desc;
+}
+int __example_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, example_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        if (maxlen - pos < 68) return -1;
+        {
+            const uint8_t* run = (const uint8_t*) buf + offset + pos;
+            uint32_t a;
+            p[element].utime = __int64_t_load(run + 0);
+            for (a = 0; a < 3; ++a)
+                (&p[element].position[0])[a] = __double_load(run + 8 + 8 * a);
+            for (a = 0; a < 4; ++a)
+                (&p[element].orientation[0])[a] = __double_load(run + 32 + 8 * a);
+            p[element].num_ranges = __int32_t_load(run + 64);
+        }
+        pos += 68;
+
+        p[element].ranges = (int16_t*) zcm_malloc(sizeof(int16_t) * p[element].num_ranges);
+        thislen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, p[element].ranges, p[element].num_ranges);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __string_decode_array(buf, offset + pos, maxlen - pos, &(p[element].name), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __boolean_decode_array(buf, offset + pos, maxlen - pos, &(p[element].enabled), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __example_t_decode_array_cleanup(example_t* p, uint32_t elements)
+{
+    uint32_t element;
+    for (element = 0; element < elements; ++element) {
+
+        __int64_t_decode_array_cleanup(&(p[element].utime), 1);
+
+        __double_decode_array_cleanup(p[element].position, 3);
+
+        __double_decode_array_cleanup(p[element].orientation, 4);
+
+        __int32_t_decode_array_cleanup(&(p[element].num_ranges), 1);
+
+        __int16_t_decode_array_cleanup(p[element].ranges, p[element].num_ranges);
+        if (p[element].ranges) free(p[element].ranges);
+
+        __string_decode_array_cleanup(&(p[element].name), 1);
+
+        __boolean_decode_array_cleanup(&(p[element].enabled), 1);
+
+    }
+    return 0;
+}
+
+int example_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, example_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __example_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __example_t_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int example_t_decode_cleanup(example_t* p)
+{
+    return __example_t_decode_array_cleanup(p, 1);
+}
+
+uint32_t __example_t_clone_array(const example_t* p, example_t* q, uint32_t elements)
+{
+    uint32_t n = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        n += __int64_t_clone_array(&(p[element].utime), &(q[element].utime), 1);
+
+        n += __double_clone_array(p[element].position, q[element].position, 3);
+
+        n += __double_clone_array(p[element].orientation, q[element].orientation, 4);
+
+        n += __int32_t_clone_array(&(p[element].num_ranges), &(q[element].num_ranges), 1);
+
+        q[element].ranges = (int16_t*) zcm_malloc(sizeof(int16_t) * q[element].num_ranges);
+        n += __int16_t_clone_array(p[element].ranges, q[element].ranges, p[element].num_ranges);
+
+        n += __string_clone_array(&(p[element].name), &(q[element].name), 1);
+
+        n += __boolean_clone_array(&(p[element].enabled), &(q[element].enabled), 1);
+
+    }
+    return n;
+}
+
+example_t* example_t_copy(const example_t* p)
+{
+    example_t* q = (example_t*) malloc(sizeof(example_t));
+    __example_t_clone_array(p, q, 1);
+    return q;
+}
+
+void example_t_destroy(example_t* p)
+{
+    __example_t_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int example_t_publish(zcm_t* zcm, const char* channel, const example_t* p)
+{
+      uint32_t max_data_size = example_t_encoded_size (p);
+      uint8_t* buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = example_t_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (zcm, channel, buf, (uint32_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _example_t_subscription_t {
+    example_t_handler_t user_handler;
+    void* userdata;
+    zcm_sub_t* z_sub;
+};
+static
+void example_t_handler_stub (const zcm_recv_buf_t* rbuf,
+                            const char* channel, void* userdata)
+{
+    int status;
+    example_t p;
+    memset(&p, 0, sizeof(example_t));
+    status = example_t_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr, "error %d decoding example_t!!!\n", status);
+        #endif
+        return;
+    }
+
+    example_t_subscription_t* h = (example_t_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    example_t_decode_cleanup (&p);
+}
+
+example_t_subscription_t* example_t_subscribe (zcm_t* zcm,
+                    const char* channel,
+                    example_t_handler_t f, void* userdata)
+{
+    example_t_subscription_t* n = (example_t_subscription_t*)
+                       malloc(sizeof(example_t_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              example_t_handler_stub, n);
+    if (n->z_sub == NULL) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr,"couldn't reg example_t ZCM handler!\n");
+        #endif
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int example_t_unsubscribe(zcm_t* zcm, example_t_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr,
+           "couldn't unsubscribe example_t_handler %p!\n", hid);
+        #endif
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
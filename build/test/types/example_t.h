@@ -0,0 +1,145 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _example_t_h
+#define _example_t_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EXAMPLE_T_test_const_8_max_hex 0xff
+#define EXAMPLE_T_test_const_16_max_hex 0xffff
+#define EXAMPLE_T_test_const_32_max_hex 0xffffffff
+#define EXAMPLE_T_test_const_64_max_hex 0xffffffffffffffffLL
+#define EXAMPLE_T_test_const_float 1e-20
+#define EXAMPLE_T_test_const_double 12.1e200
+
+typedef struct _example_t example_t;
+struct _example_t
+{
+    int64_t    utime;
+    double     position[3];
+    double     orientation[4];
+    int32_t    num_ranges;
+    int16_t    *ranges;
+    char*      name;
+    int8_t     enabled;
+};
+
+/**
+ * Create a deep copy of a example_t.
+ * When no longer needed, destroy it with example_t_destroy()
+ */
+example_t* example_t_copy(const example_t* to_copy);
+
+/**
+ * Destroy an instance of example_t created by example_t_copy()
+ */
+void example_t_destroy(example_t* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _example_t_subscription_t example_t_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * example_t is received.
+ */
+typedef void(*example_t_handler_t)(const zcm_recv_buf_t* rbuf,
+             const char* channel, const example_t* msg, void* userdata);
+
+/**
+ * Publish a message of type example_t using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int example_t_publish(zcm_t* zcm, const char* channel, const example_t* msg);
+
+/**
+ * Subscribe to messages of type example_t using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to example_t_unsubscribe.
+ */
+example_t_subscription_t* example_t_subscribe(zcm_t* zcm, const char* channel, example_t_handler_t handler, void* userdata);
+
+/**
+ * Removes and destroys a subscription created by example_t_subscribe()
+ */
+int example_t_unsubscribe(zcm_t* zcm, example_t_subscription_t* hid);
+/**
+ * Encode a message of type example_t into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to example_t_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int example_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const example_t* p);
+
+/**
+ * Decode a message of type example_t from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with example_t_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int example_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, example_t* msg);
+
+/**
+ * Release resources allocated by example_t_decode()
+ * @return 0
+ */
+int example_t_decode_cleanup(example_t* p);
+
+/**
+ * Check how many bytes are required to encode a message of type example_t
+ */
+uint32_t example_t_encoded_size(const example_t* p);
+uint32_t example_t_struct_size(void);
+uint32_t example_t_num_fields(void);
+int      example_t_get_field(const example_t* p, uint32_t i, zcm_field_t* f);
+const zcm_type_info_t* example_t_get_type_info(void);
+const zcm_type_desc_t* example_t_get_type_desc(void);
+
+// ZCM support functions. Users should not call these
+int64_t  __example_t_get_hash(void);
+uint64_t __example_t_hash_recursive(const __zcm_hash_ptr* p);
+int      __example_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const example_t* p, uint32_t elements);
+int      __example_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, example_t* p, uint32_t elements);
+int      __example_t_decode_array_cleanup(example_t* p, uint32_t elements);
+uint32_t __example_t_encoded_array_size(const example_t* p, uint32_t elements);
+uint32_t __example_t_clone_array(const example_t* p, example_t* q, uint32_t elements);
+extern const zcm_type_desc_t __example_t_type_desc;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
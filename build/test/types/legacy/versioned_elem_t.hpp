@@ -0,0 +1,187 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.
+ *  DO NOT MODIFY BY HAND!!
+ *
+ *  Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+
+#ifndef __legacy_versioned_elem_t_hpp__
+#define __legacy_versioned_elem_t_hpp__
+
+#if __cplusplus > 199711L /* if c++11 */
+#include <zcm/util/Convert.hpp>
+#endif
+
+
+namespace legacy {
+class versioned_elem_t
+{
+    public:
+        int16_t    id;
+
+    public:
+        #if __cplusplus > 199711L /* if c++11 */
+        /// The value of getHash()
+        static constexpr int64_t  ZCM_TYPE_HASH = (int64_t)0x7c0679634130e593LL;
+        /// The value of getEncodedSize(), which is the same for every instance
+        static constexpr uint32_t ZCM_ENCODED_SIZE = 10;
+        #endif
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~versioned_elem_t() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void* buf, uint32_t offset, uint32_t maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline uint32_t getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void* buf, uint32_t offset, uint32_t maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "versioned_elem_t"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int      _encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const;
+        inline uint32_t _getEncodedSizeNoHash() const;
+        inline int      _decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr* p);
+
+        #if __cplusplus > 199711L /* if c++11 */
+        /**
+         * Sets each member that @p other, usually another version of this type, has
+         * under the same name, converting values whose types differ (see
+         * zcm/util/Convert.hpp). Other members are left as they are, except for the sizes
+         * of variable-length arrays, which are kept in line with their arrays.
+         */
+        template <typename Other> inline void _convertFrom(const Other& other);
+
+    private:
+        template <typename Other>
+        inline static auto __convert_id(versioned_elem_t& to, const Other& from, int)
+            -> decltype((void) from.id) { zcm::convert::field(to.id, from.id); }
+        template <typename Other>
+        inline static void __convert_id(versioned_elem_t&, const Other&, long) {}
+        #endif
+};
+
+int versioned_elem_t::encode(void* buf, uint32_t offset, uint32_t maxlen) const
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = (int64_t)getHash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(thislen < 0) return thislen; else pos += thislen;
+
+    thislen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int versioned_elem_t::decode(const void* buf, uint32_t offset, uint32_t maxlen)
+{
+    uint32_t pos = 0;
+    int thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t versioned_elem_t::getEncodedSize() const
+{
+    return 10;
+}
+
+int64_t versioned_elem_t::getHash()
+{
+    return (int64_t)0x7c0679634130e593LL;
+}
+
+const char* versioned_elem_t::getTypeName()
+{
+    return "versioned_elem_t";
+}
+
+int versioned_elem_t::_encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const
+{
+    if(maxlen < 2) return -1;
+    uint8_t* run = (uint8_t*) buf + offset;
+
+    __int16_t_store(run + 0, this->id);
+
+    return 2;
+}
+
+int versioned_elem_t::_decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen)
+{
+    if(maxlen < 2) return -1;
+    const uint8_t* run = (const uint8_t*) buf + offset;
+
+    this->id = __int16_t_load(run + 0);
+
+    return 2;
+}
+
+uint32_t versioned_elem_t::_getEncodedSizeNoHash() const
+{
+    return 2;
+}
+
+uint64_t versioned_elem_t::_computeHash(const __zcm_hash_ptr*)
+{
+    uint64_t hash = (uint64_t)0xbe033cb1a09872c9LL;
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+#if __cplusplus > 199711L /* if c++11 */
+template <typename Other>
+void versioned_elem_t::_convertFrom(const Other& other)
+{
+    __convert_id(*this, other, 0);
+}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,282 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.
+ *  DO NOT MODIFY BY HAND!!
+ *
+ *  Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+
+#ifndef __legacy_versioned_t_hpp__
+#define __legacy_versioned_t_hpp__
+
+#include <vector>
+#include <string>
+#include "types/legacy/versioned_elem_t.hpp"
+#if __cplusplus > 199711L /* if c++11 */
+#include <zcm/util/Convert.hpp>
+#endif
+
+
+namespace legacy {
+/// The previous version of versioned_t, still published by older programs
+class versioned_t
+{
+    public:
+        int64_t    utime;
+
+        float      position[2];
+
+        int16_t    num_ranges;
+
+        std::vector< int16_t > ranges;
+
+        std::string name;
+
+        legacy::versioned_elem_t elem;
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~versioned_t() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void* buf, uint32_t offset, uint32_t maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline uint32_t getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void* buf, uint32_t offset, uint32_t maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "versioned_t"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int      _encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const;
+        inline uint32_t _getEncodedSizeNoHash() const;
+        inline int      _decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr* p);
+
+        #if __cplusplus > 199711L /* if c++11 */
+        /**
+         * Sets each member that @p other, usually another version of this type, has
+         * under the same name, converting values whose types differ (see
+         * zcm/util/Convert.hpp). Other members are left as they are, except for the sizes
+         * of variable-length arrays, which are kept in line with their arrays.
+         */
+        template <typename Other> inline void _convertFrom(const Other& other);
+
+    private:
+        template <typename Other>
+        inline static auto __convert_utime(versioned_t& to, const Other& from, int)
+            -> decltype((void) from.utime) { zcm::convert::field(to.utime, from.utime); }
+        template <typename Other>
+        inline static void __convert_utime(versioned_t&, const Other&, long) {}
+        template <typename Other>
+        inline static auto __convert_position(versioned_t& to, const Other& from, int)
+            -> decltype((void) from.position) { zcm::convert::field(to.position, from.position); }
+        template <typename Other>
+        inline static void __convert_position(versioned_t&, const Other&, long) {}
+        template <typename Other>
+        inline static auto __convert_num_ranges(versioned_t& to, const Other& from, int)
+            -> decltype((void) from.num_ranges) { zcm::convert::field(to.num_ranges, from.num_ranges); }
+        template <typename Other>
+        inline static void __convert_num_ranges(versioned_t&, const Other&, long) {}
+        template <typename Other>
+        inline static auto __convert_ranges(versioned_t& to, const Other& from, int)
+            -> decltype((void) from.ranges) { zcm::convert::field(to.ranges, from.ranges); }
+        template <typename Other>
+        inline static void __convert_ranges(versioned_t&, const Other&, long) {}
+        template <typename Other>
+        inline static auto __convert_name(versioned_t& to, const Other& from, int)
+            -> decltype((void) from.name) { zcm::convert::field(to.name, from.name); }
+        template <typename Other>
+        inline static void __convert_name(versioned_t&, const Other&, long) {}
+        template <typename Other>
+        inline static auto __convert_elem(versioned_t& to, const Other& from, int)
+            -> decltype((void) from.elem) { zcm::convert::field(to.elem, from.elem); }
+        template <typename Other>
+        inline static void __convert_elem(versioned_t&, const Other&, long) {}
+        #endif
+};
+
+int versioned_t::encode(void* buf, uint32_t offset, uint32_t maxlen) const
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = (int64_t)getHash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(thislen < 0) return thislen; else pos += thislen;
+
+    thislen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int versioned_t::decode(const void* buf, uint32_t offset, uint32_t maxlen)
+{
+    uint32_t pos = 0;
+    int thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t versioned_t::getEncodedSize() const
+{
+    return 8 + _getEncodedSizeNoHash();
+}
+
+int64_t versioned_t::getHash()
+{
+    static int64_t hash = _computeHash(NULL);
+    return hash;
+}
+
+const char* versioned_t::getTypeName()
+{
+    return "versioned_t";
+}
+
+int versioned_t::_encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const
+{
+    uint32_t pos = 0;
+    int thislen;
+
+    if(maxlen - pos < 18) return -1;
+    {
+        uint8_t* run = (uint8_t*) buf + offset + pos;
+        __int64_t_store(run + 0, this->utime);
+        for (int a = 0; a < 2; ++a)
+            __float_store(run + 8 + 4 * a, (&this->position[0])[a]);
+        __int16_t_store(run + 16, this->num_ranges);
+    }
+    pos += 18;
+
+    if(this->num_ranges > 0) {
+        thislen = __int16_t_encode_array(buf, offset + pos, maxlen - pos, &this->ranges[0], this->num_ranges);
+        if(thislen < 0) return thislen; else pos += thislen;
+    }
+
+    char* name_cstr = (char*) this->name.c_str();
+    thislen = __string_encode_array(buf, offset + pos, maxlen - pos, &name_cstr, 1);
+    if(thislen < 0) return thislen; else pos += thislen;
+
+    thislen = this->elem._encodeNoHash(buf, offset + pos, maxlen - pos);
+    if(thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int versioned_t::_decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen)
+{
+    uint32_t pos = 0;
+    int thislen;
+
+    if(maxlen - pos < 18) return -1;
+    {
+        const uint8_t* run = (const uint8_t*) buf + offset + pos;
+        this->utime = __int64_t_load(run + 0);
+        for (int a = 0; a < 2; ++a)
+            (&this->position[0])[a] = __float_load(run + 8 + 4 * a);
+        this->num_ranges = __int16_t_load(run + 16);
+    }
+    pos += 18;
+
+    this->ranges.resize(this->num_ranges);
+    if(this->num_ranges > 0) {
+        thislen = __int16_t_decode_array(buf, offset + pos, maxlen - pos, &this->ranges[0], this->num_ranges);
+        if(thislen < 0) return thislen; else pos += thislen;
+    }
+
+    int32_t __name_len__;
+    thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &__name_len__, 1);
+    if(thislen < 0) return thislen; else pos += thislen;
+    if((uint32_t)__name_len__ > maxlen - pos) return -1;
+    this->name.assign(((const char*)buf) + offset + pos, __name_len__ - ZCM_CORETYPES_INT8_NUM_BYTES_ON_BUS);
+    pos += __name_len__;
+
+    thislen = this->elem._decodeNoHash(buf, offset + pos, maxlen - pos);
+    if(thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t versioned_t::_getEncodedSizeNoHash() const
+{
+    uint32_t enc_size = 0;
+    enc_size += 18;
+    enc_size += __int16_t_encoded_array_size(NULL, this->num_ranges);
+    enc_size += this->name.size() + ZCM_CORETYPES_INT32_NUM_BYTES_ON_BUS + ZCM_CORETYPES_INT8_NUM_BYTES_ON_BUS;
+    enc_size += this->elem._getEncodedSizeNoHash();
+    return enc_size;
+}
+
+uint64_t versioned_t::_computeHash(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for(fp = p; fp != NULL; fp = fp->parent)
+        if(fp->v == versioned_t::getHash)
+            return 0;
+    const __zcm_hash_ptr cp = { p, (void*)versioned_t::getHash };
+
+    uint64_t hash = (uint64_t)0x4ba475384b08a833LL +
+         legacy::versioned_elem_t::_computeHash(&cp);
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+#if __cplusplus > 199711L /* if c++11 */
+template <typename Other>
+void versioned_t::_convertFrom(const Other& other)
+{
+    __convert_utime(*this, other, 0);
+    __convert_position(*this, other, 0);
+    __convert_num_ranges(*this, other, 0);
+    __convert_ranges(*this, other, 0);
+    __convert_name(*this, other, 0);
+    __convert_elem(*this, other, 0);
+    this->num_ranges = (int16_t) this->ranges.size();
+}
+#endif
+
+}
+
+#endif
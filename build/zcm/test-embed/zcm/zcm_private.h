@@ -0,0 +1,32 @@
+/*
+ * DO NOT MODIFY THIS FILE BY HAND
+ */
+#undef ZCM_EMBEDDED
+#define ZCM_EMBEDDED
+/* This file hides some internal data structs from public header files */
+#ifndef _ZCM_PRIVATE_H
+#define _ZCM_PRIVATE_H
+
+#include "zcm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A subscription descriptor object */
+struct zcm_sub_t
+{
+    char channel[ZCM_CHANNEL_MAXLEN + 1];
+    int regex;  /* true(1) or false(0) */
+    void *regexobj;
+    void *dispatchobj; /* blocking only: the per-subscription dispatch queue */
+    void *latestobj;   /* the in-place slot of a ZCM_QUEUE_KEEP_LATEST subscription */
+    zcm_msg_handler_t callback;
+    void *usr;
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,389 @@
+/*
+ * DO NOT MODIFY THIS FILE BY HAND
+ */
+#undef ZCM_EMBEDDED
+#define ZCM_EMBEDDED
+#include "zcm/zcm_private.h"
+#include "zcm/transport.h"
+#include "zcm/nonblocking.h"
+
+#include <string.h>
+
+/* TODO remove malloc for preallocated mem and linked-lists */
+#ifndef ZCM_NONBLOCK_SUBS_MAX
+#define ZCM_NONBLOCK_SUBS_MAX 512
+#endif
+
+/* Upper bound on the messages drained from the transport by a single handle call
+   while there are conflating subscriptions */
+#ifndef ZCM_NONBLOCK_DRAIN_MAX
+#define ZCM_NONBLOCK_DRAIN_MAX 256
+#endif
+
+/* Number of messages requested from the transport at once while draining it */
+#ifndef ZCM_NONBLOCK_RECV_BATCH
+#define ZCM_NONBLOCK_RECV_BATCH 16
+#endif
+
+/* The single message slot of a conflating (latest value only) subscription */
+typedef struct latest_slot_t latest_slot_t;
+struct latest_slot_t
+{
+    bool     pending;
+    /* Set while the handler runs on buf. Unsubscribing then only marks the slot
+       released, and the dispatcher frees it once the handler returns */
+    bool     dispatching;
+    bool     released;
+    uint64_t utime;
+    char     channel[ZCM_CHANNEL_MAXLEN + 1];
+    uint8_t* buf;
+    uint32_t len;
+    uint32_t cap;
+};
+
+struct zcm_nonblocking
+{
+    zcm_t* z;
+    zcm_trans_t* zt;
+
+    bool allChannelsEnabled;
+
+    /* TODO speed this up */
+    zcm_sub_t subs[ZCM_NONBLOCK_SUBS_MAX];
+    bool      subInUse[ZCM_NONBLOCK_SUBS_MAX];
+    size_t    subInUseEnd;
+
+    size_t    numLatestSubs;
+};
+
+static bool isRegexChannel(const char* c, size_t clen)
+{
+    /* These chars are considered regex */
+    size_t i;
+    for (i = 0; i < clen; ++i)
+        if (c[i] == '(' || c[i] == ')' || c[i] == '|' ||
+            c[i] == '.' || c[i] == '*' || c[i] == '+') return true;
+
+    return false;
+}
+
+static bool isSupportedRegex(const char* c, size_t clen)
+{
+    /* Currently only support strings formed as such: */
+    /* "[any non-regex character any number of times].*" */
+    if (!isRegexChannel(c, clen)) return true;
+
+    if (clen < 2) return false;
+    if (c[clen - 1] != '*') return false;
+    if (c[clen - 2] != '.') return false;
+
+    size_t i;
+    for (i = 0; i < clen - 2; ++i)
+        if (!((c[i] >= 'a' && c[i] <= 'z') ||
+              (c[i] >= 'A' && c[i] <= 'Z') ||
+              (c[i] >= '0' && c[i] <= '9') ||
+              (c[i] == '_'))) return false;
+
+    return true;
+}
+
+zcm_nonblocking_t* zcm_nonblocking_create(zcm_t* z, zcm_trans_t* zt)
+{
+    zcm_nonblocking_t* zcm;
+
+    zcm = malloc(sizeof(zcm_nonblocking_t));
+    if (!zcm) return NULL;
+    zcm->z = z;
+    zcm->zt = zt;
+    zcm->allChannelsEnabled = false;
+
+    size_t i;
+    for (i = 0; i < ZCM_NONBLOCK_SUBS_MAX; ++i)
+        zcm->subInUse[i] = false;
+
+    zcm->subInUseEnd = 0;
+    zcm->numLatestSubs = 0;
+    return zcm;
+}
+
+static void free_latest_slot(zcm_sub_t* sub)
+{
+    latest_slot_t* slot = (latest_slot_t*) sub->latestobj;
+    if (!slot) return;
+    sub->latestobj = NULL;
+    if (slot->dispatching) {
+        slot->released = true;
+        return;
+    }
+    free(slot->buf);
+    free(slot);
+}
+
+void zcm_nonblocking_destroy(zcm_nonblocking_t* zcm)
+{
+    if (zcm) {
+        size_t i;
+        for (i = 0; i < zcm->subInUseEnd; ++i)
+            if (zcm->subInUse[i]) free_latest_slot(&zcm->subs[i]);
+        if (zcm->zt) zcm_trans_destroy(zcm->zt);
+        free(zcm);
+        zcm = NULL;
+    }
+}
+
+int zcm_nonblocking_publish(zcm_nonblocking_t* z, const char* channel,
+                            const uint8_t* data, uint32_t len)
+{
+    zcm_msg_t msg;
+
+    msg.utime = 0;
+    msg.channel = channel;
+    msg.len = len;
+    /* Casting away constness okay because msg isn't used past end of function */
+    msg.buf = (uint8_t*) data;
+    return zcm_trans_sendmsg(z->zt, msg);
+}
+
+int zcm_nonblocking_publishv(zcm_nonblocking_t* z, const char* channel,
+                             const zcm_iovec_t* iov, uint32_t niov)
+{
+    return zcm_trans_sendmsgv(z->zt, channel, iov, niov);
+}
+
+zcm_sub_t* zcm_nonblocking_subscribe(zcm_nonblocking_t* zcm, const char* channel,
+                                     zcm_msg_handler_t cb, void* usr)
+{
+    int rc;
+    size_t i;
+
+    size_t clen = strlen(channel);
+    bool regex = isRegexChannel(channel, clen);
+    if (regex) {
+        if (!isSupportedRegex(channel, clen)) return NULL;
+        if (!zcm->allChannelsEnabled) {
+            rc = zcm_trans_recvmsg_enable(zcm->zt, NULL, true);
+            zcm->allChannelsEnabled = true;
+        } else {
+            rc = ZCM_EOK;
+        }
+    } else {
+        rc = zcm_trans_recvmsg_enable(zcm->zt, channel, true);
+    }
+
+    if (rc != ZCM_EOK) {
+        return NULL;
+    }
+
+    for (i = 0; i <= zcm->subInUseEnd && i < ZCM_NONBLOCK_SUBS_MAX; ++i) {
+        if (!zcm->subInUse[i]) {
+
+            strncpy(zcm->subs[i].channel, channel, ZCM_CHANNEL_MAXLEN);
+            zcm->subs[i].channel[ZCM_CHANNEL_MAXLEN] = '\0';
+            zcm->subs[i].callback = cb;
+            zcm->subs[i].usr = usr;
+            zcm->subs[i].latestobj = NULL;
+            zcm->subInUse[i] = true;
+
+            if (i == zcm->subInUseEnd) ++zcm->subInUseEnd;
+
+            return &zcm->subs[i];
+        }
+    }
+    return NULL;
+}
+
+#ifndef ZCM_EMBEDDED
+zcm_sub_t* zcm_nonblocking_subscribe_opts(zcm_nonblocking_t* zcm, const char* channel,
+                                          zcm_msg_handler_t cb, void* usr,
+                                          const zcm_sub_opts_t* opts)
+{
+    zcm_sub_t* sub = zcm_nonblocking_subscribe(zcm, channel, cb, usr);
+    if (!sub || !opts || opts->queue_policy != ZCM_QUEUE_KEEP_LATEST) return sub;
+
+    latest_slot_t* slot = calloc(1, sizeof(latest_slot_t));
+    if (!slot) {
+        zcm_nonblocking_unsubscribe(zcm, sub);
+        return NULL;
+    }
+    sub->latestobj = slot;
+    ++zcm->numLatestSubs;
+    return sub;
+}
+#endif
+
+int zcm_nonblocking_unsubscribe(zcm_nonblocking_t* zcm, zcm_sub_t* sub)
+{
+    size_t i;
+    int    match_idx = sub - zcm->subs;
+    size_t num_chan_matches = 0;
+    int rc = ZCM_EOK;
+    for (i = 0; i < zcm->subInUseEnd; ++i) {
+        /* Note: it would be nice if we didn't have to do a string comp to unsubscribe, but
+                 we need to count the number of channel matches so we know when we can disable
+                 the transport's recvmsg_enable */
+        if (strncmp(sub->channel, zcm->subs[i].channel,
+                    sizeof(zcm->subs[i].channel)/sizeof(zcm->subs[i].channel[0])) == 0) {
+            ++num_chan_matches;
+        }
+    }
+
+    if (0 <= match_idx && match_idx < zcm->subInUseEnd) {
+        if (num_chan_matches <= 1) {
+            rc = zcm_trans_recvmsg_enable(zcm->zt, sub->channel, false);
+        }
+
+        if (sub->latestobj) {
+            free_latest_slot(sub);
+            --zcm->numLatestSubs;
+        }
+        zcm->subInUse[match_idx] = false;
+        while (zcm->subInUseEnd > 0 && !zcm->subInUse[zcm->subInUseEnd - 1]) {
+            --zcm->subInUseEnd;
+        }
+    } else {
+        rc = ZCM_EINVALID;
+    }
+
+    return rc;
+}
+
+/* Copies the message over the slot, reusing its buffer when it is large enough.
+   If the buffer cannot grow, the slot keeps its previous message */
+static void write_latest_slot(latest_slot_t* slot, zcm_msg_t* msg)
+{
+    if (msg->len > slot->cap) {
+        uint8_t* buf = realloc(slot->buf, msg->len);
+        if (!buf) return;
+        slot->buf = buf;
+        slot->cap = msg->len;
+    }
+    memcpy(slot->buf, msg->buf, msg->len);
+    slot->len = msg->len;
+    slot->utime = msg->utime;
+    strncpy(slot->channel, msg->channel, ZCM_CHANNEL_MAXLEN);
+    slot->channel[ZCM_CHANNEL_MAXLEN] = '\0';
+    slot->pending = true;
+}
+
+static void deliver(zcm_nonblocking_t* zcm, zcm_sub_t* sub, zcm_msg_t* msg)
+{
+    zcm_recv_buf_t rbuf;
+
+    if (sub->latestobj) {
+        write_latest_slot((latest_slot_t*) sub->latestobj, msg);
+        return;
+    }
+
+    rbuf.zcm = zcm->z;
+    rbuf.data = msg->buf;
+    rbuf.data_size = msg->len;
+    rbuf.recv_utime = msg->utime;
+
+    sub->callback(&rbuf, msg->channel, sub->usr);
+}
+
+static void dispatch_message(zcm_nonblocking_t* zcm, zcm_msg_t* msg)
+{
+    size_t i;
+    for (i = 0; i < zcm->subInUseEnd; ++i) {
+        if (!zcm->subInUse[i]) continue;
+
+        size_t subsChanLen = strlen(zcm->subs[i].channel);
+        if (isRegexChannel(zcm->subs[i].channel, subsChanLen)) {
+            size_t msgLen = strlen(msg->channel);
+            /* This only works because isSupportedRegex() is called on subscribe */
+            if (msgLen > 2 &&
+                strncmp(zcm->subs[i].channel, msg->channel, subsChanLen - 2) == 0) {
+                deliver(zcm, &zcm->subs[i], msg);
+            }
+        } else {
+            if (strcmp(zcm->subs[i].channel, msg->channel) == 0) {
+                deliver(zcm, &zcm->subs[i], msg);
+            }
+        }
+    }
+}
+
+/* Returns true if any conflating subscription had a message waiting */
+static bool dispatch_latest(zcm_nonblocking_t* zcm)
+{
+    zcm_recv_buf_t rbuf;
+    bool dispatched = false;
+
+    size_t i;
+    for (i = 0; i < zcm->subInUseEnd; ++i) {
+        if (!zcm->subInUse[i]) continue;
+
+        zcm_sub_t* sub = &zcm->subs[i];
+        latest_slot_t* slot = (latest_slot_t*) sub->latestobj;
+        if (!slot || !slot->pending) continue;
+
+        /* Note: the handler may unsubscribe, which leaves the slot for us to free */
+        slot->pending = false;
+        slot->dispatching = true;
+        rbuf.zcm = zcm->z;
+        rbuf.data = slot->buf;
+        rbuf.data_size = slot->len;
+        rbuf.recv_utime = slot->utime;
+        sub->callback(&rbuf, slot->channel, sub->usr);
+        slot->dispatching = false;
+        if (slot->released) {
+            free(slot->buf);
+            free(slot);
+        }
+        dispatched = true;
+    }
+    return dispatched;
+}
+
+/* Receives and dispatches up to 'maxmsgs' messages that the transport already has,
+   returning how many there were. '*ret' is the code of the receive that came up empty */
+static size_t drain(zcm_nonblocking_t* zcm, size_t maxmsgs, int* ret)
+{
+    zcm_msg_t msgs[ZCM_NONBLOCK_RECV_BATCH];
+    size_t n = 0, nrecv, i;
+
+    *ret = ZCM_EOK;
+    while (n < maxmsgs) {
+        size_t want = maxmsgs - n;
+        if (want > ZCM_NONBLOCK_RECV_BATCH) want = ZCM_NONBLOCK_RECV_BATCH;
+        if ((*ret = zcm_trans_recvmsg_batch(zcm->zt, msgs, want, &nrecv, 0)) != ZCM_EOK)
+            break;
+        for (i = 0; i < nrecv; ++i) dispatch_message(zcm, &msgs[i]);
+        n += nrecv;
+    }
+    return n;
+}
+
+int zcm_nonblocking_handle_nonblock(zcm_nonblocking_t* zcm)
+{
+    int ret;
+    zcm_msg_t msg;
+
+    /* Perform any required traansport-level updates */
+    zcm_trans_update(zcm->zt);
+
+    /* Try to receive a messages from the transport and dispatch them */
+    if (zcm->numLatestSubs == 0) {
+        if ((ret = zcm_trans_recvmsg(zcm->zt, &msg, 0)) != ZCM_EOK) return ret;
+        dispatch_message(zcm, &msg);
+        return ZCM_EOK;
+    }
+
+    /* With conflating subscriptions, drain what the transport has so far so that each of
+       them is dispatched at most once, with its newest message */
+    size_t n = drain(zcm, ZCM_NONBLOCK_DRAIN_MAX, &ret);
+    if (dispatch_latest(zcm)) return ZCM_EOK;
+    return n > 0 ? ZCM_EOK : ret;
+}
+
+void zcm_nonblocking_flush(zcm_nonblocking_t* zcm)
+{
+    /* Call twice because we need to make sure publish and subscribe are both handled */
+    zcm_trans_update(zcm->zt);
+    zcm_trans_update(zcm->zt);
+
+    int ret;
+    drain(zcm, SIZE_MAX, &ret);
+    dispatch_latest(zcm);
+}
@@ -0,0 +1,594 @@
+/*
+ * DO NOT MODIFY THIS FILE BY HAND
+ */
+#undef ZCM_EMBEDDED
+#define ZCM_EMBEDDED
+#include "zcm/zcm.h"
+#include "zcm/transport.h"
+#include "generic_serial_transport.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ZCM_GENERIC_SERIAL_ESCAPE_CHAR
+#define ZCM_GENERIC_SERIAL_ESCAPE_CHAR (0xcc)
+#endif
+
+#define ASSERT(x)
+
+// Framing (size = 9 + chan_len + data_len)
+//   0xCC
+//   0x00
+//   chan_len
+//   data_len  (4 bytes)
+//   *chan
+//   *data
+//   sum1(*chan, *data)
+//   sum2(*chan, *data)
+#define FRAME_BYTES 9
+#define HEADER_BYTES (FRAME_BYTES - 2)
+
+// Defining ZCM_GENERIC_SERIAL_STATIC_MTU selects a build with no heap use at all:
+// every transport's buffers are sized at compile time and instances come from a
+// static pool of ZCM_GENERIC_SERIAL_STATIC_INSTANCES.
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+#ifndef ZCM_GENERIC_SERIAL_STATIC_BUFSIZE
+#define ZCM_GENERIC_SERIAL_STATIC_BUFSIZE (2 * (FRAME_BYTES + ZCM_GENERIC_SERIAL_STATIC_MTU))
+#endif
+#ifndef ZCM_GENERIC_SERIAL_STATIC_INSTANCES
+#define ZCM_GENERIC_SERIAL_STATIC_INSTANCES 1
+#endif
+#endif
+
+// Note: there is little to no error checking in this, misuse will cause problems
+typedef struct circBuffer_t circBuffer_t;
+struct circBuffer_t
+{
+    uint8_t* data;
+    size_t capacity;
+    size_t front;
+    size_t back;
+};
+
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+void cb_init_static(circBuffer_t* cb, uint8_t* data, size_t sz)
+{
+    cb->data = data;
+    cb->capacity = sz;
+    cb->front = 0;
+    cb->back  = 0;
+}
+#else
+bool cb_init(circBuffer_t* cb, size_t sz)
+{
+    cb->capacity = sz;
+    cb->front = 0;
+    cb->back  = 0;
+    if (cb->capacity == 0) return false;
+    cb->data = malloc(cb->capacity * sizeof(uint8_t));
+    if (cb->data == NULL) {
+        cb->capacity = 0;
+        return false;
+    }
+    return true;
+}
+
+void cb_deinit(circBuffer_t* cb)
+{
+    free(cb->data);
+    cb->data = NULL;
+    cb->capacity = 0;
+}
+#endif
+
+size_t cb_size(circBuffer_t* cb)
+{
+    if (cb->back >= cb->front) return cb->back - cb->front;
+    else                       return cb->capacity - (cb->front - cb->back);
+}
+
+size_t cb_room(circBuffer_t* cb)
+{
+    return cb->capacity - 1 - cb_size(cb);
+}
+
+void cb_push(circBuffer_t* cb, uint8_t d)
+{
+    ASSERT((cb->capacity > cb_size(cb) + 1) && "cb_push 1");
+    ASSERT((cb_room(cb) > 0) && "cb_push 2");
+    cb->data[cb->back++] = d;
+    ASSERT((cb->back <= cb->capacity) && "cb_push 3");
+    if (cb->back == cb->capacity) cb->back = 0;
+}
+
+uint8_t cb_top(circBuffer_t* cb, size_t offset)
+{
+    ASSERT((cb_size(cb) > offset) && "cb_top 1");
+    size_t idx = cb->front + offset;
+    if (idx >= cb->capacity) idx -= cb->capacity;
+    return cb->data[idx];
+}
+
+void cb_pop(circBuffer_t* cb, size_t num)
+{
+    ASSERT((cb_size(cb) >= num) && "cb_pop 1");
+    cb->front += num;
+    if (cb->front >= cb->capacity) cb->front -= cb->capacity;
+}
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+size_t cb_flush_out(circBuffer_t* cb,
+                    size_t (*write)(const uint8_t* data, size_t num, void* usr),
+                    void* usr)
+{
+	size_t written = 0;
+	size_t n;
+    size_t sz = cb_size(cb);
+
+    if (sz == 0) return 0;
+
+    size_t contiguous = MIN(cb->capacity - cb->front, sz);
+    size_t wrapped    = sz - contiguous;
+
+    n = write(cb->data + cb->front, contiguous, usr);
+    written += n;
+    cb_pop(cb, n);
+
+    // If we failed to write everything we tried to write, or if there's nothing
+    // left to write, return.
+    if (written != contiguous || wrapped == 0) return written;
+
+    n = write(cb->data, wrapped, usr);
+    written += n;
+    cb_pop(cb, n);
+    return written;
+}
+
+// NOTE: This function should never be called w/ bytes > cb_room(cb)
+size_t cb_flush_in(circBuffer_t* cb, size_t bytes,
+                   size_t (*read)(uint8_t* data, size_t num, void* usr),
+                   void* usr)
+{
+    ASSERT((bytes <= cb_room(cb)) && "cb_flush_in 1");
+	size_t bytesRead = 0;
+	size_t n;
+
+    // Find out how much room is left between back and end of buffer or back and front
+    // of buffer. Because we already know there's room for whatever we're about to place,
+    // if back < front, we can just read in every byte starting at "back".
+    if (cb->back < cb->front) {
+    	bytesRead += read(cb->data + cb->back, bytes, usr);
+        ASSERT((bytesRead <= bytes) && "cb_flush_in 2");
+        cb->back += bytesRead;
+        return bytesRead;
+    }
+
+    // Otherwise, we need to be a bit more careful about overflowing the back of the buffer.
+    size_t contiguous = MIN(cb->capacity - cb->back, bytes);
+    size_t wrapped    = bytes - contiguous;
+
+    n = read(cb->data + cb->back, contiguous, usr);
+    ASSERT((n <= contiguous) && "cb_flush_in 3");
+    bytesRead += n;
+    ASSERT((bytesRead <= bytes) && "cb_flush_in 4");
+    cb->back += n;
+    if (n != contiguous) return bytesRead; // back could NOT have hit BUFFER_SIZE in this case
+
+    // may need to wrap back here (if bytes >= BUFFER_SIZE - cb->back) but not otherwise
+    ASSERT((cb->back <= cb->capacity) && "cb_flush_in 5");
+    if (cb->back == cb->capacity) cb->back = 0;
+    if (wrapped == 0) return bytesRead;
+
+    n = read(cb->data, wrapped, usr);
+    ASSERT((n <= wrapped) && "cb_flush_in 6");
+    bytesRead += n;
+    ASSERT((bytesRead <= bytes) && "cb_flush_in 7");
+    cb->back += n;
+    return bytesRead;
+}
+
+// NOTE: This function should never be called w/ num > cb_room(cb)
+void cb_push_bytes(circBuffer_t* cb, const uint8_t* d, size_t num)
+{
+    ASSERT((num <= cb_room(cb)) && "cb_push_bytes 1");
+    size_t contiguous = MIN(cb->capacity - cb->back, num);
+    memcpy(cb->data + cb->back, d, contiguous);
+    memcpy(cb->data, d + contiguous, num - contiguous);
+    cb->back += num;
+    if (cb->back >= cb->capacity) cb->back -= cb->capacity;
+}
+
+// Pushes d, doubling every escape char. Runs between escape chars are found with
+// memchr and copied in bulk.
+// NOTE: This function should never be called w/ num + (number of escapes) > cb_room(cb)
+void cb_push_escaped(circBuffer_t* cb, const uint8_t* d, size_t num)
+{
+    while (num > 0) {
+        const uint8_t* esc = memchr(d, ZCM_GENERIC_SERIAL_ESCAPE_CHAR, num);
+        size_t run = esc ? (size_t)(esc - d) + 1 : num;
+        cb_push_bytes(cb, d, run);
+        if (esc) cb_push(cb, ZCM_GENERIC_SERIAL_ESCAPE_CHAR);
+        d   += run;
+        num -= run;
+    }
+}
+
+#define CB_READ_OK         0
+#define CB_READ_AGAIN      1
+#define CB_READ_BAD_ESCAPE 2
+
+// Unescapes bytes into d until *nread reaches num, starting *offset bytes past the
+// front of the buffer and never looking at or past byte 'avail'. Both *offset and
+// *nread are advanced past everything read, so a call that returns CB_READ_AGAIN can
+// be picked up where it left off once more data arrives. On CB_READ_BAD_ESCAPE,
+// *offset is left pointing at the offending escape char.
+int cb_read_escaped(circBuffer_t* cb, size_t* offset, size_t avail,
+                    uint8_t* d, size_t* nread, size_t num)
+{
+    d   += *nread;
+    num -= *nread;
+    while (num > 0) {
+        if (*offset >= avail) return CB_READ_AGAIN;
+
+        size_t idx = cb->front + *offset;
+        if (idx >= cb->capacity) idx -= cb->capacity;
+        size_t span = MIN(MIN(cb->capacity - idx, avail - *offset), num);
+
+        const uint8_t* src = cb->data + idx;
+        const uint8_t* esc = memchr(src, ZCM_GENERIC_SERIAL_ESCAPE_CHAR, span);
+        size_t run = esc ? (size_t)(esc - src) : span;
+        memcpy(d, src, run);
+        d       += run;
+        num     -= run;
+        *nread  += run;
+        *offset += run;
+
+        if (esc) {
+            if (*offset + 1 >= avail) return CB_READ_AGAIN;
+            if (cb_top(cb, *offset + 1) != ZCM_GENERIC_SERIAL_ESCAPE_CHAR)
+                return CB_READ_BAD_ESCAPE;
+            *d++ = ZCM_GENERIC_SERIAL_ESCAPE_CHAR;
+            --num;
+            ++*nread;
+            *offset += 2;
+        }
+    }
+    return CB_READ_OK;
+}
+#undef MIN
+
+// Fletcher-16 with end-around carry. Folding after every byte keeps both sums in
+// [1, 255] (they start at 0xff and never reach 0), which is just v mod 255 with 255
+// standing in for 0. So the sums can be accumulated in 32 bits and folded once per
+// block instead; 4096 bytes is the largest block sumHigh can take without overflowing.
+#define FLETCHER_BLOCK 4096
+
+static uint16_t fletcherUpdate(const uint8_t* d, size_t num, uint16_t prevSum)
+{
+    uint32_t sumHigh = (prevSum >> 8) & 0xff;
+    uint32_t sumLow  =  prevSum       & 0xff;
+
+    while (num > 0) {
+        size_t n = num < FLETCHER_BLOCK ? num : FLETCHER_BLOCK;
+        num -= n;
+        while (n--) {
+            sumLow  += *d++;
+            sumHigh += sumLow;
+        }
+        sumLow  = 1 + (sumLow  - 1) % 255;
+        sumHigh = 1 + (sumHigh - 1) % 255;
+    }
+
+    return (uint16_t)((sumHigh << 8) | sumLow);
+}
+
+typedef struct zcm_trans_generic_serial_t zcm_trans_generic_serial_t;
+struct zcm_trans_generic_serial_t
+{
+    zcm_trans_t trans; // This must be first to preserve pointer casting
+
+    circBuffer_t sendBuffer;
+    circBuffer_t recvBuffer;
+    uint8_t      recvChanName[ZCM_CHANNEL_MAXLEN + 1];
+    size_t       mtu;
+    uint8_t*     recvMsgData;
+
+    // Incremental parse of the frame at the front of recvBuffer. recvOffset counts the
+    // bytes past the front that have already been validated (0 until a header has been
+    // accepted) and recvNRead counts the unescaped chan + data bytes copied out so far.
+    size_t       recvOffset;
+    size_t       recvNRead;
+    uint8_t      recvChanLen;
+    uint32_t     recvLen;
+
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+    bool         inUse;
+    uint8_t      sendData[ZCM_GENERIC_SERIAL_STATIC_BUFSIZE];
+    uint8_t      recvData[ZCM_GENERIC_SERIAL_STATIC_BUFSIZE];
+    uint8_t      recvMsgStorage[ZCM_GENERIC_SERIAL_STATIC_MTU];
+#endif
+
+    size_t (*get)(uint8_t* data, size_t nData, void* usr);
+    size_t (*put)(const uint8_t* data, size_t nData, void* usr);
+    void* put_get_usr;
+
+    uint64_t (*time)(void* usr);
+    void* time_usr;
+};
+
+static zcm_trans_generic_serial_t *cast(zcm_trans_t *zt);
+
+size_t serial_get_mtu(zcm_trans_generic_serial_t *zt)
+{ return zt->mtu; }
+
+static size_t countEscapes(const uint8_t* d, size_t num)
+{
+    size_t n = 0;
+    const uint8_t* esc;
+    while ((esc = memchr(d, ZCM_GENERIC_SERIAL_ESCAPE_CHAR, num)) != NULL) {
+        ++n;
+        num -= (size_t)(esc - d) + 1;
+        d = esc + 1;
+    }
+    return n;
+}
+
+int serial_sendmsg(zcm_trans_generic_serial_t *zt, zcm_msg_t msg)
+{
+    const uint8_t* chan = (const uint8_t*) msg.channel;
+    size_t chan_len = strlen(msg.channel);
+
+    if (chan_len > ZCM_CHANNEL_MAXLEN)                               return ZCM_EINVALID;
+    if (msg.len > zt->mtu)                                           return ZCM_EINVALID;
+    if (FRAME_BYTES + chan_len + msg.len > cb_room(&zt->sendBuffer)) return ZCM_EAGAIN;
+
+    // Escape chars go out twice, so only start pushing once the whole frame is known to fit
+    size_t nEscapes = countEscapes(chan, chan_len) + countEscapes(msg.buf, msg.len);
+    if (FRAME_BYTES + chan_len + msg.len + nEscapes > cb_room(&zt->sendBuffer))
+        return ZCM_EAGAIN;
+
+    uint32_t len = (uint32_t)msg.len;
+    uint8_t header[FRAME_BYTES - 2] = {
+        ZCM_GENERIC_SERIAL_ESCAPE_CHAR, 0x00, (uint8_t) chan_len,
+        (len>>24)&0xff, (len>>16)&0xff, (len>>8)&0xff, (len>>0)&0xff,
+    };
+    cb_push_bytes(&zt->sendBuffer, header, sizeof(header));
+    cb_push_escaped(&zt->sendBuffer, chan, chan_len);
+    cb_push_escaped(&zt->sendBuffer, msg.buf, msg.len);
+
+    uint16_t checksum = 0xffff;
+    checksum = fletcherUpdate(chan, chan_len, checksum);
+    checksum = fletcherUpdate(msg.buf, msg.len, checksum);
+
+    cb_push(&zt->sendBuffer, (checksum >> 8) & 0xff);
+    cb_push(&zt->sendBuffer,  checksum       & 0xff);
+
+    return ZCM_EOK;
+}
+
+int serial_recvmsg_enable(zcm_trans_generic_serial_t *zt, const char *channel, bool enable)
+{
+    // NOTE: not implemented because it is unlikely that a microprocessor is
+    //       going to be hearing messages on a USB comms that it doesn't want
+    //       to hear
+    return ZCM_EOK;
+}
+
+// Drops the first n received bytes along with any partially parsed frame
+static void serial_recv_resync(zcm_trans_generic_serial_t *zt, size_t n)
+{
+    cb_pop(&zt->recvBuffer, n);
+    zt->recvOffset = 0;
+    zt->recvNRead  = 0;
+}
+
+int serial_recvmsg(zcm_trans_generic_serial_t *zt, zcm_msg_t *msg, int timeout)
+{
+    uint64_t utime = zt->time(zt->time_usr);
+    circBuffer_t* cb = &zt->recvBuffer;
+
+    for (;;) {
+        size_t incomingSize = cb_size(cb);
+
+        if (zt->recvOffset == 0) {
+            if (incomingSize < FRAME_BYTES) return ZCM_EAGAIN;
+
+            // Sync
+            if (cb_top(cb, 0) != ZCM_GENERIC_SERIAL_ESCAPE_CHAR) { serial_recv_resync(zt, 1); continue; }
+            if (cb_top(cb, 1) != 0x00)                           { serial_recv_resync(zt, 2); continue; }
+
+            // Msg sizes
+            zt->recvChanLen  = cb_top(cb, 2);
+            zt->recvLen      = (uint32_t) cb_top(cb, 3) << 24;
+            zt->recvLen     |= (uint32_t) cb_top(cb, 4) << 16;
+            zt->recvLen     |= (uint32_t) cb_top(cb, 5) << 8;
+            zt->recvLen     |= (uint32_t) cb_top(cb, 6);
+
+            if (zt->recvChanLen > ZCM_CHANNEL_MAXLEN || zt->recvLen > zt->mtu) {
+                serial_recv_resync(zt, HEADER_BYTES);
+                continue;
+            }
+
+            zt->recvOffset = HEADER_BYTES;
+            zt->recvNRead  = 0;
+        }
+
+        // Channel, then data. Only the bytes that arrived since the last call are scanned.
+        int ret = CB_READ_OK;
+        if (zt->recvNRead < zt->recvChanLen) {
+            ret = cb_read_escaped(cb, &zt->recvOffset, incomingSize,
+                                  zt->recvChanName, &zt->recvNRead, zt->recvChanLen);
+        }
+        if (ret == CB_READ_OK) {
+            size_t nData = zt->recvNRead - zt->recvChanLen;
+            ret = cb_read_escaped(cb, &zt->recvOffset, incomingSize,
+                                  zt->recvMsgData, &nData, zt->recvLen);
+            zt->recvNRead = zt->recvChanLen + nData;
+        }
+        if (ret == CB_READ_AGAIN) return ZCM_EAGAIN;
+        if (ret == CB_READ_BAD_ESCAPE) {
+            serial_recv_resync(zt, zt->recvOffset);
+            continue;
+        }
+
+        // Checksum (never escaped)
+        if (zt->recvOffset + 2 > incomingSize) return ZCM_EAGAIN;
+
+        uint16_t checksum = 0xffff;
+        checksum = fletcherUpdate(zt->recvChanName, zt->recvChanLen, checksum);
+        checksum = fletcherUpdate(zt->recvMsgData, zt->recvLen, checksum);
+
+        uint16_t receivedCS = (cb_top(cb, zt->recvOffset) << 8) |
+                               cb_top(cb, zt->recvOffset + 1);
+        size_t consumed = zt->recvOffset + 2;
+        if (receivedCS != checksum) {
+            serial_recv_resync(zt, consumed);
+            continue;
+        }
+
+        zt->recvChanName[zt->recvChanLen] = '\0';
+        msg->channel = (char*) zt->recvChanName;
+        msg->buf     = zt->recvMsgData;
+        msg->len     = zt->recvLen;
+        msg->utime   = utime;
+        serial_recv_resync(zt, consumed);
+        // Note: because this is a nonblocking transport, timeout is ignored
+        return ZCM_EOK;
+    }
+}
+
+int serial_update_rx(zcm_trans_t *_zt)
+{
+    zcm_trans_generic_serial_t* zt = cast(_zt);
+    cb_flush_in(&zt->recvBuffer, cb_room(&zt->recvBuffer), zt->get, zt->put_get_usr);
+    return ZCM_EOK;
+}
+
+int serial_update_tx(zcm_trans_t *_zt)
+{
+    zcm_trans_generic_serial_t* zt = cast(_zt);
+    cb_flush_out(&zt->sendBuffer, zt->put, zt->put_get_usr);
+    return ZCM_EOK;
+}
+
+/********************** STATICS **********************/
+static size_t _serial_get_mtu(zcm_trans_t *zt)
+{ return serial_get_mtu(cast(zt)); }
+
+static int _serial_sendmsg(zcm_trans_t *zt, zcm_msg_t msg)
+{ return serial_sendmsg(cast(zt), msg); }
+
+static int _serial_recvmsg_enable(zcm_trans_t *zt, const char *channel, bool enable)
+{ return serial_recvmsg_enable(cast(zt), channel, enable); }
+
+static int _serial_recvmsg(zcm_trans_t *zt, zcm_msg_t *msg, int timeout)
+{ return serial_recvmsg(cast(zt), msg, timeout); }
+
+static int _serial_update(zcm_trans_t *zt)
+{
+    int rxRet = serial_update_rx(zt);
+    int txRet = serial_update_tx(zt);
+    return rxRet == ZCM_EOK ? txRet : rxRet;
+}
+
+static zcm_trans_methods_t methods = {
+    &_serial_get_mtu,
+    &_serial_sendmsg,
+    &_serial_recvmsg_enable,
+    &_serial_recvmsg,
+    &_serial_update,
+    &zcm_trans_generic_serial_destroy,
+};
+
+static zcm_trans_generic_serial_t *cast(zcm_trans_t *zt)
+{
+    assert(zt->vtbl == &methods);
+    return (zcm_trans_generic_serial_t*)zt;
+}
+
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+static zcm_trans_generic_serial_t instances[ZCM_GENERIC_SERIAL_STATIC_INSTANCES];
+#endif
+
+zcm_trans_t *zcm_trans_generic_serial_create(
+        size_t (*get)(uint8_t* data, size_t nData, void* usr),
+        size_t (*put)(const uint8_t* data, size_t nData, void* usr),
+        void* put_get_usr,
+        uint64_t (*timestamp_now)(void* usr),
+        void* time_usr,
+        size_t MTU,
+        size_t bufSize)
+{
+    if (MTU == 0 || bufSize < FRAME_BYTES + MTU) return NULL;
+
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+    if (MTU > ZCM_GENERIC_SERIAL_STATIC_MTU)         return NULL;
+    if (bufSize > ZCM_GENERIC_SERIAL_STATIC_BUFSIZE) return NULL;
+
+    zcm_trans_generic_serial_t *zt = NULL;
+    size_t i;
+    for (i = 0; i < ZCM_GENERIC_SERIAL_STATIC_INSTANCES; ++i) {
+        if (!instances[i].inUse) {
+            zt = &instances[i];
+            break;
+        }
+    }
+    if (zt == NULL) return NULL;
+    zt->inUse = true;
+    zt->mtu = MTU;
+    zt->recvMsgData = zt->recvMsgStorage;
+    cb_init_static(&zt->sendBuffer, zt->sendData, bufSize);
+    cb_init_static(&zt->recvBuffer, zt->recvData, bufSize);
+#else
+    zcm_trans_generic_serial_t *zt = malloc(sizeof(zcm_trans_generic_serial_t));
+    if (zt == NULL) return NULL;
+    zt->mtu = MTU;
+    zt->recvMsgData = malloc(zt->mtu * sizeof(uint8_t));
+    if (zt->recvMsgData == NULL) {
+        free(zt);
+        return NULL;
+    }
+
+    if (!cb_init(&zt->sendBuffer, bufSize)) {
+        free(zt->recvMsgData);
+        free(zt);
+        return NULL;
+    }
+    if (!cb_init(&zt->recvBuffer, bufSize)) {
+        cb_deinit(&zt->sendBuffer);
+        free(zt->recvMsgData);
+        free(zt);
+        return NULL;
+    }
+#endif
+
+    zt->trans.trans_type = ZCM_NONBLOCKING;
+    zt->trans.vtbl = &methods;
+
+    zt->recvOffset = 0;
+    zt->recvNRead = 0;
+
+    zt->get = get;
+    zt->put = put;
+    zt->put_get_usr = put_get_usr;
+
+    zt->time = timestamp_now;
+    zt->time_usr = time_usr;
+
+    return (zcm_trans_t*) zt;
+}
+
+void zcm_trans_generic_serial_destroy(zcm_trans_t* _zt)
+{
+    zcm_trans_generic_serial_t *zt = cast(_zt);
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+    zt->inUse = false;
+#else
+    cb_deinit(&zt->recvBuffer);
+    cb_deinit(&zt->sendBuffer);
+    free(zt->recvMsgData);
+    free(zt);
+#endif
+}
@@ -0,0 +1,274 @@
+/*
+ * DO NOT MODIFY THIS FILE BY HAND
+ */
+#undef ZCM_EMBEDDED
+#define ZCM_EMBEDDED
+#ifndef _ZCM_H
+#define _ZCM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include <assert.h>
+#define ZCM_ASSERT(X) assert(X)
+
+#ifndef ZCM_EMBEDDED
+#include "eventlog.h"
+#endif
+
+/* Important hardcoded values */
+#define ZCM_CHANNEL_MAXLEN 32
+enum zcm_type {
+    ZCM_BLOCKING,
+    ZCM_NONBLOCKING
+};
+
+#define ZCM_RETURN_CODES \
+    X(ZCM_EOK,              0, "Okay, no errors"                       ) \
+    X(ZCM_EINVALID,         1, "Invalid arguments"                     ) \
+    X(ZCM_EAGAIN  ,         2, "Resource unavailable, try again"       ) \
+    X(ZCM_ECONNECT,         3, "Transport connection failed"           ) \
+    X(ZCM_EINTR   ,         4, "Operation was unexpectedly interrupted") \
+    X(ZCM_EUNKNOWN,         5, "Unknown error"                         ) \
+    X(ZCM_EMEMORY,          6, "Out of memory"                         ) \
+    X(ZCM_NUM_RETURN_CODES, 7, "Invalid return code"                   )
+
+/* Return codes */
+enum zcm_return_codes {
+    #define X(n, v, s) n = v,
+    ZCM_RETURN_CODES
+    #undef X
+};
+
+#ifndef ZCM_EMBEDDED
+/* Overflow behavior of a subscription's dispatch queue once it is full */
+enum zcm_queue_policy {
+    ZCM_QUEUE_BLOCK,       /* stall the receiver until the handler makes room */
+    ZCM_QUEUE_DROP_OLDEST, /* discard the oldest queued message to make room */
+    ZCM_QUEUE_DROP_NEWEST, /* discard the incoming message */
+    ZCM_QUEUE_KEEP_LATEST  /* conflate: keep only the newest message, regardless of depth */
+};
+
+typedef struct zcm_sub_opts_t  zcm_sub_opts_t;
+typedef struct zcm_sub_stats_t zcm_sub_stats_t;
+
+/* Dispatch queue configuration of a single subscription */
+struct zcm_sub_opts_t
+{
+    uint32_t              queue_depth;  /* 0 means follow zcm_set_queue_size() */
+    enum zcm_queue_policy queue_policy;
+};
+
+/* Dispatch queue counters of a single subscription */
+struct zcm_sub_stats_t
+{
+    uint64_t received;   /* messages handed to this subscription by the transport */
+    uint64_t dispatched; /* messages delivered to the handler */
+    uint64_t dropped;    /* messages discarded by the queue policy */
+    uint32_t queued;     /* messages currently waiting for dispatch */
+    uint32_t high_water; /* most messages that were ever waiting at once */
+    uint32_t depth;      /* current bound of the queue */
+};
+#endif
+
+/* Forward typedef'd structs */
+typedef struct zcm_trans_t    zcm_trans_t;
+typedef struct zcm_t          zcm_t;
+typedef struct zcm_recv_buf_t zcm_recv_buf_t;
+typedef struct zcm_sub_t      zcm_sub_t;
+typedef struct zcm_iovec_t    zcm_iovec_t;
+
+/* Generic message handler function type */
+typedef void (*zcm_msg_handler_t)(const zcm_recv_buf_t* rbuf,
+                                  const char* channel, void* usr);
+
+/* Note: some language bindings depend on the specific memory layout
+ *       of ZCM structures. If you change these, be sure to update
+ *       language bindings to match. */
+
+/* Primary ZCM object that handles all top-level interactions including
+   delegation between blocking and non-blocking interfaces */
+struct zcm_t
+{
+    enum zcm_type type;
+    void*         impl;
+    int           err; /* the last error code */
+};
+
+/* ZCM Receive buffer for one message */
+struct zcm_recv_buf_t
+{
+    int64_t  recv_utime;
+    zcm_t*   zcm;
+    uint8_t* data; /* NOTE: do not free, the library manages this memory */
+    uint32_t data_size;
+};
+
+/* One piece of a message payload that is scattered across several buffers */
+struct zcm_iovec_t
+{
+    const uint8_t* base;
+    uint32_t       len;
+};
+
+#ifndef ZCM_EMBEDDED
+int zcm_retcode_name_to_enum(const char* zcm_retcode_name);
+#endif
+
+/* Standard create/destroy functions. These will malloc() and free() the zcm_t object.
+   Sets zcm errno on failure */
+#ifndef ZCM_EMBEDDED
+zcm_t* zcm_create(const char* url);
+#endif
+zcm_t* zcm_create_trans(zcm_trans_t* zt);
+void   zcm_destroy(zcm_t* zcm);
+
+#ifndef ZCM_EMBEDDED
+/* Initialize a zcm object allocated by caller
+   Returns 0 on success, and -1 on failure
+   Sets zcm errno on failure */
+int zcm_init(zcm_t* zcm, const char* url);
+#endif
+
+/* Initialize a zcm instance allocated by caller using a transport provided by caller
+   Returns 0 on success, and -1 on failure
+   Sets zcm errno on failure */
+int zcm_init_trans(zcm_t* zcm, zcm_trans_t* zt);
+
+/* Cleanup a zcm object allocated by caller */
+void zcm_cleanup(zcm_t* zcm);
+
+/* Return the last error: a valid from enum zcm_return_codes */
+int zcm_errno(const zcm_t* zcm);
+
+/* Return the last error in string format */
+const char* zcm_strerror(const zcm_t* zcm);
+
+/* Returns the error string from the error number */
+const char* zcm_strerrno(int err);
+
+/* Subscribe to zcm messages
+   Returns a subscription object on success, and NULL on failure
+   Does NOT set zcm errno on failure */
+zcm_sub_t* zcm_subscribe(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb, void* usr);
+
+/* Subscribe to zcm messages
+   Returns a subscription object on success, and NULL on failure.
+   Can fail to subscribe if zcm is already running
+   Does NOT set zcm errno on failure */
+zcm_sub_t* zcm_try_subscribe(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb, void* usr);
+
+#ifndef ZCM_EMBEDDED
+/* Subscribe to zcm messages with a custom dispatch queue (NULL opts uses the defaults)
+   A ZCM_QUEUE_KEEP_LATEST subscription holds a single slot that each new message is
+   copied over in place, and its handler sees at most the newest message once per
+   dispatch. Nonblocking zcm only honors queue_policy, and only for ZCM_QUEUE_KEEP_LATEST:
+   zcm_handle_nonblock() then drains the transport each call and dispatches every such
+   subscription at most once.
+   Returns a subscription object on success, and NULL on failure
+   Does NOT set zcm errno on failure */
+zcm_sub_t* zcm_subscribe_opts(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb,
+                              void* usr, const zcm_sub_opts_t* opts);
+#endif
+
+/* Unsubscribe to zcm messages, freeing the subscription object
+   Returns ZCM_EOK on success, error code on failure
+   Does NOT set zcm errno on failure */
+int zcm_unsubscribe(zcm_t* zcm, zcm_sub_t* sub);
+
+/* Unsubscribe to zcm messages, freeing the subscription object
+   Returns ZCM_EOK on success, error code on failure
+   Can fail to subscribe if zcm is already running
+   Does NOT set zcm errno on failure */
+int zcm_try_unsubscribe(zcm_t* zcm, zcm_sub_t* sub);
+
+/* Publish a zcm message buffer. Note: the message may not be completely
+   sent after this call has returned. To block until the messages are transmitted,
+   call the zcm_flush() method.
+   Returns 0 on success, error code on failure
+   Sets zcm errno on failure */
+int zcm_publish(zcm_t* zcm, const char* channel, const uint8_t* data, uint32_t len);
+
+/* Publish a message whose payload is the concatenation of 'niov' buffers, without
+   having to gather them into one buffer first. Same return values as zcm_publish() */
+int zcm_publishv(zcm_t* zcm, const char* channel, const zcm_iovec_t* iov, uint32_t niov);
+
+/* Block until all published messages have been sent even if the underlying
+   transport is nonblocking. Additionally, dispatches all messages that have
+   already been received sequentially in this thread. */
+void zcm_flush(zcm_t* zcm);
+
+/* Nonblocking version of flush (ZCM_EAGAIN if fail, ZCM_EOK if success) as defined
+   above. If you want to guarantee that this function returns ZCM_EOK at some point,
+   you should zcm_pause() first. */
+int  zcm_try_flush(zcm_t* zcm);
+
+#ifndef ZCM_EMBEDDED
+/* Blocking Mode Only: Functions for controlling the message dispatch loop */
+void zcm_run(zcm_t* zcm);
+void zcm_start(zcm_t* zcm);
+void zcm_stop(zcm_t* zcm);
+int  zcm_try_stop(zcm_t* zcm); /* returns ZCM_EOK on success, error code on failure */
+void zcm_pause(zcm_t* zcm); /* pauses message dispatch and publishing, not transport */
+void zcm_resume(zcm_t* zcm);
+int  zcm_handle(zcm_t* zcm); /* returns ZCM_EOK normally, error code on failure. */
+/* Determines how many messages can be stored from the transport without being dispatched
+   to each subscription (unless the subscription chose its own queue depth) as well as
+   the number of messages that may be stored from the user without being
+   transmitted by the transport. Normal operation does not require the user to modify
+   this, but if the user is using zcm_pause() and forcing dispatches/transmission through
+   calls to zcm_flush(), it will be important to set an appropriate queue size based on
+   traffic and flush frequency. Note that if either queue reaches maximum capacity,
+   messages will not be read from / sent to the transport, which could cause significant
+   issues depending on the transport. */
+void zcm_set_queue_size(zcm_t* zcm, uint32_t numMsgs);
+int  zcm_try_set_queue_size(zcm_t* zcm, uint32_t numMsgs); /* returns ZCM_EOK or ZCM_EAGAIN */
+/* The queue of published messages starts at the zcm_set_queue_size() capacity and grows
+   on demand, so bursts of publishes do not immediately fail with ZCM_EAGAIN. This caps
+   how many messages it may grow to (default 1024; never less than zcm_set_queue_size()).
+   The send thread hands everything that is queued to the transport in one go.
+   Returns ZCM_EOK on success, ZCM_EINVALID if numMsgs is 0 */
+int  zcm_set_send_queue_limit(zcm_t* zcm, uint32_t numMsgs);
+/* Sets the number of threads used to dispatch messages to subscription handlers when
+   using zcm_run() or zcm_start(). The default (0) dispatches every message from a single
+   handler thread, in the order the messages arrived across all subscriptions. With
+   nthreads > 1, each subscription still receives its messages in order, but handlers of
+   different subscriptions may run concurrently, so any state shared between handlers
+   must be protected by the user. Idle dispatch threads steal work from busy ones. Can
+   only be called while zcm is not running.
+   Returns ZCM_EOK on success, ZCM_EINVALID if zcm is running */
+int  zcm_set_dispatch_threads(zcm_t* zcm, uint32_t nthreads);
+/* Every subscription has its own queue of messages waiting for dispatch, so a flood on
+   one channel cannot hold back the others. These bound the number of messages that may
+   be waiting for a subscription (depth 0 follows zcm_set_queue_size()) and choose what
+   happens when a message arrives while that many are waiting. Subscriptions default to
+   the zcm_set_queue_size() depth with ZCM_QUEUE_BLOCK.
+   Returns ZCM_EOK on success, ZCM_EINVALID on invalid arguments */
+int  zcm_set_sub_queue(zcm_t* zcm, zcm_sub_t* sub, uint32_t depth,
+                       enum zcm_queue_policy policy);
+int  zcm_get_sub_stats(zcm_t* zcm, zcm_sub_t* sub, zcm_sub_stats_t* stats);
+#endif
+
+/* Non-Blocking Mode Only: Functions checking and dispatching messages
+   Returns ZCM_EOK if a message was dispatched, ZCM_EAGAIN if no messages,
+   error code otherwise */
+int zcm_handle_nonblock(zcm_t* zcm);
+
+/*
+ * Version: M.m.u
+ *   M: Major
+ *   m: Minor
+ *   u: Micro
+ */
+#define ZCM_MAJOR_VERSION 1
+#define ZCM_MINOR_VERSION 0
+#define ZCM_MICRO_VERSION 0
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZCM_H */
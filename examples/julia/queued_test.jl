@@ -0,0 +1,43 @@
+unshift!(LOAD_PATH, "../build/types")
+
+using ZCM
+using _example_t
+
+numReceived = 0
+function handler(rbuf, channel::String, msg::example_t)
+    global numReceived
+    @assert (numReceived == msg.timestamp) "Received message with incorrect timestamp"
+    numReceived = numReceived + 1
+end
+
+zcm = Zcm("inproc")
+if (!good(zcm))
+    error("Unable to initialize zcm");
+end
+
+# Messages are queued for the Julia event loop, which handles all of the ones that
+# piled up each time it wakes up, rather than one handshake per message
+sub = subscribe(zcm, "EXAMPLE", handler, example_t; queued=true, max_queued=16)
+
+msg = example_t()
+
+start(zcm)
+
+for i = 0:999
+    msg.timestamp = i
+    while (publish(zcm, "EXAMPLE", msg) != 0)
+        yield()
+    end
+end
+
+for i = 1:50
+    numReceived == 1000 && break
+    sleep(0.1)
+end
+stop(zcm)
+
+unsubscribe(zcm, sub)
+
+@assert (numReceived == 1000) "Didn't receive proper number of messages"
+
+println("Success!")
@@ -0,0 +1,146 @@
+unshift!(LOAD_PATH, "../build/types")
+
+using ZCM
+using _example_t
+using _arrays_t
+using _multidim_t
+using _little_endian_t
+
+# Encodes and decodes messages without a transport, including malformed ones
+
+function example(num::Int64, depth::Int64 = 1)
+    ex = example_t()
+    ex.timestamp   = num
+    ex.position    = [ 1.0, 2.0, 3.0 ] * num
+    ex.orientation = [ 1.0, 2.0, 3.0, 4.0 ]
+    ex.num_ranges  = num
+    ex.ranges      = [ i for i=1:num ]
+    ex.name        = "example $num"
+    ex.enabled     = isodd(num)
+    n = depth > 0 ? 2 : 0
+    ex.nExamples1  = n
+    ex.nExamples2  = n + 1
+    ex.subExamples = [ example(i + j, depth - 1) for i=1:n, j=1:n+1 ]
+    ex.subStrings  = [ "sub $i $j" for i=1:n, j=1:n+1 ]
+    return ex
+end
+
+# A message decodes to one that encodes to the same bytes
+function roundtrip(msg)
+    data = encode(msg)
+    decoded = decode(typeof(msg), data)
+    @assert (encode(decoded) == data) "Encode/decode mismatch"
+    return decoded
+end
+
+function expect_error(f)
+    try
+        f()
+    catch err
+        return err
+    end
+    error("Decoded a malformed message")
+end
+
+ex = roundtrip(example(3))
+@assert (ex.timestamp == 3 && ex.ranges == [1, 2, 3] && ex.name == "example 3") "Wrong data"
+@assert (size(ex.subExamples) == (2, 3) && ex.subStrings[2, 3] == "sub 2 3") "Wrong data"
+roundtrip(example(0, 0))
+
+arr = arrays_t()
+arr.m = 2
+arr.n = 3
+arr.prim_onedim_static             = [ isodd(i) for i=1:3             ]
+arr.prim_onedim_dynamic            = [ i        for i=1:arr.n         ]
+arr.prim_twodim_static_static      = [ (i*j)    for i=1:3,     j=1:3     ]
+arr.prim_twodim_static_dynamic     = [ (i*j)    for i=1:3,     j=1:arr.n ]
+arr.prim_twodim_dynamic_static     = [ (i*j)    for i=1:arr.n, j=1:3     ]
+arr.prim_twodim_dynamic_dynamic    = [ (i*j)    for i=1:arr.m, j=1:arr.n ]
+arr.nonprim_onedim_static          = [ example(i, 0) for i=1:3             ]
+arr.nonprim_onedim_dynamic         = [ example(i, 0) for i=1:arr.n         ]
+arr.nonprim_twodim_static_static   = [ example(i, 0) for i=1:3,     j=1:3     ]
+arr.nonprim_twodim_static_dynamic  = [ example(j, 0) for i=1:3,     j=1:arr.n ]
+arr.nonprim_twodim_dynamic_static  = [ example(i, 0) for i=1:arr.n, j=1:3     ]
+arr.nonprim_twodim_dynamic_dynamic = [ example(j, 0) for i=1:arr.m, j=1:arr.n ]
+arr = roundtrip(arr)
+@assert (arr.prim_twodim_dynamic_dynamic == [ (i*j) for i=1:2, j=1:3 ]) "Wrong data"
+@assert (arr.nonprim_twodim_static_dynamic[1, 3].timestamp == 3) "Wrong data"
+@assert (arr.prim_onedim_static == [ true, false, true ]) "Wrong data"
+
+# Booleans decode from any nonzero byte
+data = encode(arr)
+@assert (data[11:13] == [ 0x01, 0x00, 0x01 ]) "Wrong boolean encoding"
+data[11] = 0x02
+@assert (decode(arrays_t, data).prim_onedim_static == [ true, false, true ]) "Wrong data"
+
+mat = multidim_t()
+mat.rows = 2
+mat.jk   = 3
+mat.mat  = [ 100i + 10j + k for i=1:2, j=1:2, k=1:3 ]
+mat = roundtrip(mat)
+@assert (mat.mat[2, 1, 3] == 213) "Wrong data"
+
+# Little endian types encode everything but the hash little endian
+le = little_endian_t()
+le.timestamp   = 0x0102030405060708
+le.position    = [ 1.0, 2.0, 3.0 ]
+le.orientation = [ 1.0, 2.0, 3.0, 4.0 ]
+le.num_ranges  = 3
+le.ranges      = Int16[ 1, -2, 0x0304 ]
+le.name        = "little"
+le.enabled     = true
+data = encode(le)
+@assert (data[9:16] == [ 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 ]) "Not little endian"
+le = roundtrip(le)
+@assert (le.ranges == Int16[ 1, -2, 0x0304 ] && le.name == "little" && le.enabled) "Wrong data"
+
+# Through an IOBuffer, which holds more bytes than have been written to it
+body = encode(example(2))[9:end]
+buf = IOBuffer()
+write(buf, body)
+write(buf, body)
+seekstart(buf)
+@assert (ZCM._decode_one(example_t, buf).timestamp == 2) "Wrong data"
+@assert (position(buf) == length(body)) "Decode did not stop at the end of the message"
+@assert (ZCM._decode_one(example_t, buf).name == "example 2") "Wrong data"
+@assert (eof(buf)) "Decode did not stop at the end of the message"
+
+truncate(buf, length(body) + 10)
+seek(buf, length(body))
+@assert (expect_error(() -> ZCM._decode_one(example_t, buf)) == "Decode error: message too short") "Wrong error"
+
+# Truncated anywhere, including inside strings and multidimensional and boolean arrays
+for (T, msg) in [ (example_t, example(2)), (arrays_t, arr), (multidim_t, mat),
+                  (little_endian_t, le) ]
+    data = encode(msg)
+    for len=0:length(data) - 1
+        err = expect_error(() -> decode(T, data[1:len]))
+        @assert (err == "Decode error: message too short") "Wrong error"
+    end
+end
+
+# A string length that runs past the end of the message
+data = encode(example(0, 0))
+namePos = 8 + 8 + 3 * 8 + 4 * 8 + 4 + 1
+data[namePos:namePos + 3] = reinterpret(UInt8, [ hton(Int32(length(data))) ])
+@assert (expect_error(() -> decode(example_t, data)) == "Decode error: message too short") "Wrong error"
+
+# Negative lengths, even ones whose product is positive and in bounds
+mat = multidim_t()
+mat.rows = 0
+mat.jk   = 0
+mat.mat  = Array{Float64}(0, 2, 0)
+data = [ encode(mat); zeros(UInt8, 2 * 2 * 3 * 8) ]
+data[9] = reinterpret(UInt8, Int8(-2))
+data[10:13] = reinterpret(UInt8, [ hton(Int32(-3)) ])
+@assert (expect_error(() -> decode(multidim_t, data)) == "Decode error: negative length") "Wrong error"
+
+data = encode(example(0, 0))
+namePos = 8 + 8 + 3 * 8 + 4 * 8 + 4 + 1
+@assert (data[namePos + 3] == length("example 0") + 1) "Wrong name position"
+for len in [ -1, 0 ]
+    data[namePos:namePos + 3] = reinterpret(UInt8, [ hton(Int32(len)) ])
+    @assert (expect_error(() -> decode(example_t, data)) == "Decode error: negative length") "Wrong error"
+end
+
+println("Success!")
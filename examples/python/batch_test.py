@@ -0,0 +1,80 @@
+#!/usr/bin/python
+
+from zcm import ZCM
+import sys
+sys.path.insert(0, '../build/types/')
+from example_t import example_t
+import time
+
+numReceived = 0
+numBatches = 0
+def handler(batch):
+    global numReceived, numBatches
+    numBatches = numBatches + 1
+    for channel, msg in batch:
+        assert channel == "TEST"
+        assert msg.timestamp == numReceived
+        numReceived = numReceived + 1
+
+zcm = ZCM("block-inproc")
+if not zcm.good():
+    print("Unable to initialize zcm")
+    exit()
+
+# The handler gets everything that queued up while python was busy elsewhere, so
+# the GIL is taken once per batch rather than once per message
+subs = zcm.subscribe_batch("TEST", example_t, handler)
+zcm.start()
+
+msg = example_t()
+for i in range(10000):
+    msg.timestamp = i
+    while zcm.publish("TEST", msg) != 0:
+        time.sleep(0)
+
+for i in range(50):
+    if numReceived == 10000:
+        break
+    time.sleep(0.1)
+
+assert numReceived == 10000, "Didn't receive proper number of messages"
+print("Received %d messages in %d batches" % (numReceived, numBatches))
+
+# A handler that raises loses its batch, not the subscription, and raw messages it
+# kept a buffer of must not change when the subscription's buffers are reused
+rawBatches = 0
+rawReceived = []
+kept = []
+def rawHandler(batch):
+    global rawBatches
+    rawBatches = rawBatches + 1
+    if rawBatches == 1:
+        raise RuntimeError("Expected failure")
+    for channel, data in batch:
+        rawReceived.append(bytes(data))
+        if len(kept) < 100:
+            kept.append((bytes(data), memoryview(data)))
+
+rawSubs = zcm.subscribe_batch_raw("RAW", rawHandler, 4096)
+zcm.publishRaw("RAW", b"x", 1)
+for i in range(50):
+    if rawBatches == 1:
+        break
+    time.sleep(0.1)
+for i in range(2000):
+    data = b"%08d" % i * 16
+    while zcm.publishRaw("RAW", data, len(data)) != 0:
+        time.sleep(0)
+for i in range(50):
+    if len(rawReceived) == 2000:
+        break
+    time.sleep(0.1)
+
+zcm.stop()
+zcm.unsubscribe(subs)
+zcm.unsubscribe(rawSubs)
+
+assert len(rawReceived) == 2000, "Raw handler stopped after an exception"
+for data, view in kept:
+    assert bytes(view) == data, "Kept message was overwritten"
+print("Success")
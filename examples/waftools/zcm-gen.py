@@ -51,6 +51,21 @@ def configure(ctx):
 #                 default = ''
 #   littleEndian: True or false based on desired endianess of output. Should almost always
 #                 be false. Don't use this option unless you really know what you're doing
+#   cArena:       True to generate C types with <type>_decode_arena() and _publish/_subscribe
+#                 that reuse their buffers (see zcm-gen --c-arena). Types that are nested in
+#                 one another must all be generated with the same setting.
+#                 default = False
+#   cppFixedCapacity: If nonzero, generate C++ types whose variable-length arrays and strings
+#                 are zcm::FixedVector and zcm::FixedString of this capacity instead of
+#                 std::vector and std::string (see zcm-gen --cpp-fixed-capacity).
+#                 default = 0
+#   cppConvert:   True to generate C++ types with _convertFrom(), which converts from other
+#                 versions of the same type (see zcm-gen --cpp-convert and
+#                 zcm/util/TypeRegistry.hpp). Requires c++11.
+#                 default = False
+#   pythonNumpy:  True to generate python types that decode arrays of numbers into numpy
+#                 arrays (see zcm-gen --python-numpy)
+#                 default = False
 #   javapkg:      name of the java package
 #                 default = 'zcmtypes' (though it is encouraged to name it something more unique
 #                                       to avoid library naming conflicts)
@@ -202,6 +217,10 @@ def zcmgen(ctx, **kw):
     building      = kw.get('build',        True)
     pkgPrefix     = kw.get('pkgPrefix',    '')
     littleEndian  = kw.get('littleEndian', False)
+    cArena        = kw.get('cArena',       False)
+    cppFixedCapacity = kw.get('cppFixedCapacity', 0)
+    cppConvert    = kw.get('cppConvert',   False)
+    pythonNumpy   = kw.get('pythonNumpy',  False)
     javapkg       = kw.get('javapkg',      'zcmtypes')
     juliapkg      = kw.get('juliapkg',     '')
     juliagenpkgs  = kw.get('juliagenpkgs', False)
@@ -255,6 +274,10 @@ def zcmgen(ctx, **kw):
              lang         = lang,
              pkgPrefix    = pkgPrefix,
              littleEndian = littleEndian,
+             cArena       = cArena,
+             cppFixedCapacity = cppFixedCapacity,
+             cppConvert   = cppConvert,
+             pythonNumpy  = pythonNumpy,
              juliapkg     = juliapkg,
              javapkg      = javapkg)
     for s in tg.source:
@@ -363,12 +386,20 @@ class zcmgen(Task.Task):
         if ('c_stlib' in gen.lang) or ('c_shlib' in gen.lang):
             cmd['c'] = '--c --c-typeinfo --c-cpath %s --c-hpath %s --c-include %s' % \
                          (bld, bld, inc)
+            if gen.cArena:
+                cmd['c'] += ' --c-arena'
         if 'cpp' in gen.lang:
             cmd['cpp'] = '--cpp --cpp-hpath %s --cpp-include %s' % (bld, inc)
+            if gen.cppFixedCapacity:
+                cmd['cpp'] += ' --cpp-fixed-capacity %d' % gen.cppFixedCapacity
+            if gen.cppConvert:
+                cmd['cpp'] += ' --cpp-convert'
         if 'java' in gen.lang:
             cmd['java'] = '--java --jpath %s --jpkgprefix %s' % (bld + '/java', gen.javapkg)
         if 'python' in gen.lang:
             cmd['python'] = '--python --ppath %s' % (bld)
+            if gen.pythonNumpy:
+                cmd['python'] += ' --python-numpy'
         if 'julia' in gen.lang:
             cmd['julia'] = '--julia --julia-path %s' % (bld)
             if (gen.juliapkg):
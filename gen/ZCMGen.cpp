@@ -770,6 +770,92 @@ ZCMConstant* ZCMStruct::findConst(const string& name)
     return nullptr;
 }
 
+const ZCMStruct* ZCMGen::findStruct(const string& fullname) const
+{
+    for (auto& zs : structs)
+        if (zs.structname.fullname == fullname)
+            return &zs;
+    return nullptr;
+}
+
+// Mirrors the generated _computeHash() functions, "parents" breaks recursive types
+static bool getRecursiveHash(const ZCMGen& zcmgen, const ZCMStruct& zs,
+                             vector<const ZCMStruct*>& parents, u64& ret)
+{
+    if (std::find(parents.begin(), parents.end(), &zs) != parents.end()) {
+        ret = 0;
+        return true;
+    }
+
+    parents.push_back(&zs);
+    u64 hash = zs.hash;
+    for (auto& zm : zs.members) {
+        if (ZCMGen::isPrimitiveType(zm.type.fullname))
+            continue;
+        const ZCMStruct* other = zcmgen.findStruct(zm.type.fullname);
+        u64 otherHash;
+        if (!other || !getRecursiveHash(zcmgen, *other, parents, otherHash)) {
+            parents.pop_back();
+            return false;
+        }
+        hash += otherHash;
+    }
+    parents.pop_back();
+
+    ret = (hash << 1) + ((hash >> 63) & 1);
+    return true;
+}
+
+bool ZCMGen::getRecursiveHash(const ZCMStruct& zs, u64& hash) const
+{
+    vector<const ZCMStruct*> parents;
+    return ::getRecursiveHash(*this, zs, parents, hash);
+}
+
+static bool getFixedEncodedSize(const ZCMGen& zcmgen, const ZCMStruct& zs,
+                                vector<const ZCMStruct*>& parents, u64& ret)
+{
+    // A type that contains itself is never of fixed size
+    if (std::find(parents.begin(), parents.end(), &zs) != parents.end())
+        return false;
+
+    parents.push_back(&zs);
+    u64 size = 0;
+    for (auto& zm : zs.members) {
+        auto& mtn = zm.type.fullname;
+        if (mtn == "string" || !zm.isConstantSizeArray()) {
+            parents.pop_back();
+            return false;
+        }
+
+        u64 count = 1, memberSize;
+        for (auto& dim : zm.dimensions)
+            count *= strtoull(dim.size.c_str(), NULL, 0);
+
+        if (zm.isFixedSizePrimitive(count, memberSize)) {
+            size += memberSize;
+        } else {
+            const ZCMStruct* other = zcmgen.findStruct(mtn);
+            u64 otherSize;
+            if (!other || !getFixedEncodedSize(zcmgen, *other, parents, otherSize)) {
+                parents.pop_back();
+                return false;
+            }
+            size += count * otherSize;
+        }
+    }
+    parents.pop_back();
+
+    ret = size;
+    return true;
+}
+
+bool ZCMGen::getFixedEncodedSize(const ZCMStruct& zs, u64& size) const
+{
+    vector<const ZCMStruct*> parents;
+    return ::getFixedEncodedSize(*this, zs, parents, size);
+}
+
 bool ZCMGen::needsGeneration(const string& declaringfile, const string& outfile) const
 {
     struct stat instat, outstat;
@@ -804,3 +890,16 @@ bool ZCMMember::isConstantSizeArray() const
 
     return true;
 }
+
+bool ZCMMember::isFixedSizePrimitive(u64& count, u64& size) const
+{
+    if (!ZCMGen::isPrimitiveType(type.fullname) || type.fullname == "string" ||
+        !isConstantSizeArray())
+        return false;
+
+    count = 1;
+    for (auto& dim : dimensions)
+        count *= strtoull(dim.size.c_str(), NULL, 0);
+    size = count * ZCMGen::getPrimitiveTypeSize(type.fullname);
+    return true;
+}
@@ -72,6 +72,10 @@ struct ZCMMember
     // Are all of the dimensions of this array constant? (scalars return true)
     bool isConstantSizeArray() const;
 
+    // Is this a primitive other than a string with constant dimensions? If so, returns the
+    // total number of elements and the number of bytes they take on the wire.
+    bool isFixedSizePrimitive(u64& count, u64& size) const;
+
     // Returns { conflicting tokens }
     unordered_set<string>
         getConflictingTokens(const unordered_set<string>& reservedTokens) const;
@@ -167,6 +171,18 @@ struct ZCMGen
     // parse the provided file
     int handleFile(const string& path);
 
+    // Returns the parsed struct with the given full name, NULL if it was not part of
+    // this run of zcm-gen
+    const ZCMStruct* findStruct(const string& fullname) const;
+
+    // Computes the hash that the generated code computes at runtime (every member
+    // type included). Returns false if a member type was not part of this run.
+    bool getRecursiveHash(const ZCMStruct& zs, u64& hash) const;
+
+    // Returns true if every instance of the struct encodes to the same number of
+    // bytes and sets "size" to that number, which excludes the leading hash
+    bool getFixedEncodedSize(const ZCMStruct& zs, u64& size) const;
+
     // Returns true if the argument is a built-in type (e.g., "int64_t", "float").
     static bool isPrimitiveType(const string& t);
 
@@ -17,6 +17,9 @@
 // flags for emit_c_array_loops_end
 #define FLAG_EMIT_FREES   2
 
+// flags for emit_c_array_loops_start, allocating from "arena" instead of the heap
+#define FLAG_EMIT_ARENA_MALLOCS 4
+
 static string dotsToSlashes(const string& s)
 {
     return StringUtil::replace(s, '.', '/');
@@ -312,6 +315,15 @@ struct EmitHeader : public Emit
         emit(0, " */");
         emit(0,"int %s_decode_cleanup(%s* p);", tn_, tn_);
         emit(0, "");
+        if (zcm.gopt->getBool("c-arena")) {
+            emit(0, "/**");
+            emit(0, " * Decode a message of type %s from binary form like %s_decode(),", tn_, tn_);
+            emit(0, " * but take strings and variable-length arrays from @p arena. They are");
+            emit(0, " * released by zcm_arena_reset() instead of %s_decode_cleanup().", tn_);
+            emit(0, " */");
+            emit(0,"int %s_decode_arena(const void* buf, uint32_t offset, uint32_t maxlen, %s* msg, zcm_arena_t* arena);", tn_, tn_);
+            emit(0, "");
+        }
         emit(0, "/**");
         emit(0, " * Check how many bytes are required to encode a message of type %s", tn_);
         emit(0, " */");
@@ -321,6 +333,7 @@ struct EmitHeader : public Emit
             emit(0,"uint32_t %s_num_fields(void);", tn_);
             emit(0,"int      %s_get_field(const %s* p, uint32_t i, zcm_field_t* f);", tn_, tn_);
             emit(0,"const zcm_type_info_t* %s_get_type_info(void);", tn_);
+            emit(0,"const zcm_type_desc_t* %s_get_type_desc(void);", tn_);
         }
         emit(0,"");
 
@@ -330,8 +343,12 @@ struct EmitHeader : public Emit
         emit(0,"int      __%s_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const %s* p, uint32_t elements);", tn_, tn_);
         emit(0,"int      __%s_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, %s* p, uint32_t elements);", tn_, tn_);
         emit(0,"int      __%s_decode_array_cleanup(%s* p, uint32_t elements);", tn_, tn_);
+        if (zcm.gopt->getBool("c-arena"))
+            emit(0,"int      __%s_decode_array_arena(const void* buf, uint32_t offset, uint32_t maxlen, %s* p, uint32_t elements, zcm_arena_t* arena);", tn_, tn_);
         emit(0,"uint32_t __%s_encoded_array_size(const %s* p, uint32_t elements);", tn_, tn_);
         emit(0,"uint32_t __%s_clone_array(const %s* p, %s* q, uint32_t elements);", tn_, tn_, tn_);
+        if (zcm.gopt->getBool("c-typeinfo"))
+            emit(0,"extern const zcm_type_desc_t __%s_type_desc;", tn_);
         emit(0,"");
     }
 };
@@ -346,6 +363,8 @@ struct EmitSource : public Emit
         const char* tn_ = zs.structname.nameUnderscoreCStr();
         string package = dotsToSlashes(zs.structname.package);
         emit(0, "#include <string.h>");
+        if (zcm.gopt->getBool("c-typeinfo"))
+            emit(0, "#include <stddef.h>");
         emit(0, "#ifndef ZCM_EMBEDDED");
         emit(0, "#include <stdio.h>");
         emit(0, "#endif");
@@ -401,20 +420,55 @@ struct EmitSource : public Emit
         emit(0, "");
     }
 
+    // The fewest bytes one element of the member can encode to. Nested types are assumed
+    // to take at least one, unless they are known to have no members.
+    size_t getMinEncodedSize(const ZCMMember& zm)
+    {
+        auto& tn = zm.type.fullname;
+        if (tn == "string") return 4;
+        if (ZCMGen::isPrimitiveType(tn)) return ZCMGen::getPrimitiveTypeSize(tn);
+        for (auto& s : zcm.structs)
+            if (s.structname.fullname == tn && s.members.empty()) return 0;
+        return 1;
+    }
+
+    // Emits a check that all elements of the array fit into the rest of the buffer, so
+    // that no arena allocation for it is sized by a corrupt dimension
+    void emitCArrayFitsCheck(const ZCMMember& zm, const string& n, int indent)
+    {
+        size_t minSize = getMinEncodedSize(zm);
+        if (minSize == 0) return;
+
+        string count = "1";
+        for (size_t i = 0; i < zm.dimensions.size(); ++i)
+            count = "__zcm_array_count(" + count + ", " + makeArraySize(zm, n, i) + ")";
+        if (minSize == 1)
+            emit(indent, "if (%s > maxlen - pos) return -1;", count.c_str());
+        else
+            emit(indent, "if (%s > (maxlen - pos) / %zu) return -1;", count.c_str(), minSize);
+    }
+
     void emitCArrayLoopsStart(const ZCMMember& zm, const string& n, int flags)
     {
         if (zm.dimensions.size() == 0)
             return;
 
+        const char* alloc = (flags & FLAG_EMIT_ARENA_MALLOCS) ? "zcm_arena_alloc(arena, " : "zcm_malloc(";
+        if (flags & FLAG_EMIT_ARENA_MALLOCS) {
+            emitCArrayFitsCheck(zm, n, 2);
+            flags |= FLAG_EMIT_MALLOCS;
+        }
+
         for (size_t i = 0; i < zm.dimensions.size() - 1; ++i) {
             char var = 'a' + i;
 
             if (flags & FLAG_EMIT_MALLOCS) {
                 string stars = string(zm.dimensions.size()-1-i, '*');
-                emit(2+i, "%s = (%s%s*) zcm_malloc(sizeof(%s%s) * %s);",
+                emit(2+i, "%s = (%s%s*) %ssizeof(%s%s) * %s);",
                      makeAccessor(zm, n, i).c_str(),
                      mapTypeName(zm.type.fullname).c_str(),
                      stars.c_str(),
+                     alloc,
                      mapTypeName(zm.type.fullname).c_str(),
                      stars.c_str(),
                      makeArraySize(zm, n, i).c_str());
@@ -425,9 +479,10 @@ struct EmitSource : public Emit
         }
 
         if (flags & FLAG_EMIT_MALLOCS) {
-            emit(2 + (int)zm.dimensions.size() - 1, "%s = (%s*) zcm_malloc(sizeof(%s) * %s);",
+            emit(2 + (int)zm.dimensions.size() - 1, "%s = (%s*) %ssizeof(%s) * %s);",
                  makeAccessor(zm, n, zm.dimensions.size() - 1).c_str(),
                  mapTypeName(zm.type.fullname).c_str(),
+                 alloc,
                  mapTypeName(zm.type.fullname).c_str(),
                  makeArraySize(zm, n, zm.dimensions.size() - 1).c_str());
         }
@@ -455,6 +510,82 @@ struct EmitSource : public Emit
         }
     }
 
+    // Consecutive primitive members of constant size are bounds checked once and then
+    // converted with unchecked loads and stores at offsets known ahead of time. Returns the
+    // index of the member after the run, which is "first" itself unless there are at least
+    // two members to fuse.
+    size_t emitCPrimitiveRun(size_t first, bool encode)
+    {
+        const char* le = zcm.gopt->getBool("little-endian-encoding") ? "_little_endian" : "";
+
+        u64 count, size, total = 0;
+        size_t end = first;
+        bool hasArrays = false;
+        while (end < zs.members.size() && zs.members[end].isFixedSizePrimitive(count, size)) {
+            hasArrays |= zs.members[end].dimensions.size() > 0;
+            total += size;
+            ++end;
+        }
+        if (end - first < 2)
+            return first;
+
+        emit(2, "if (maxlen - pos < %" PRIu64 ") return -1;", total);
+        emit(2, "{");
+        if (encode)
+            emit(3, "uint8_t* run = (uint8_t*) buf + offset + pos;");
+        else
+            emit(3, "const uint8_t* run = (const uint8_t*) buf + offset + pos;");
+        if (hasArrays)
+            emit(3, "uint32_t a;");
+        u64 pos = 0;
+        for (size_t i = first; i < end; ++i) {
+            auto& zm = zs.members[i];
+            zm.isFixedSizePrimitive(count, size);
+            const char* tn = zm.type.nameUnderscoreCStr();
+            u64 elemSize = size / count;
+
+            if (zm.dimensions.size() == 0) {
+                if (encode)
+                    emit(3, "__%s_store%s(run + %" PRIu64 ", p[element].%s);",
+                         tn, le, pos, zm.membername.c_str());
+                else
+                    emit(3, "p[element].%s = __%s_load%s(run + %" PRIu64 ");",
+                         zm.membername.c_str(), tn, le, pos);
+            } else {
+                // Multidimensional arrays are contiguous, so they are converted in one loop
+                string elems = "(&p[element]." + zm.membername;
+                for (size_t d = 0; d < zm.dimensions.size(); ++d)
+                    elems += "[0]";
+                elems += ")[a]";
+
+                emit(3, "for (a = 0; a < %" PRIu64 "; ++a)", count);
+                if (encode)
+                    emit(4, "__%s_store%s(run + %" PRIu64 " + %" PRIu64 " * a, %s);",
+                         tn, le, pos, elemSize, elems.c_str());
+                else
+                    emit(4, "%s = __%s_load%s(run + %" PRIu64 " + %" PRIu64 " * a);",
+                         elems.c_str(), tn, le, pos, elemSize);
+            }
+            pos += size;
+        }
+        emit(2, "}");
+        emit(2, "pos += %" PRIu64 ";", total);
+        emit(0, "");
+        return end;
+    }
+
+    // Does any member get converted on its own, outside of a run from emitCPrimitiveRun()?
+    bool hasUnfusedMembers()
+    {
+        u64 count, size;
+        if (zs.members.size() == 1)
+            return true;
+        for (auto& zm : zs.members)
+            if (!zm.isFixedSizePrimitive(count, size))
+                return true;
+        return false;
+    }
+
     void emitCEncodeArray()
     {
         const char* tn_ = zs.structname.nameUnderscoreCStr();
@@ -462,13 +593,20 @@ struct EmitSource : public Emit
         emit(0,"int __%s_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const %s* p, uint32_t elements)", tn_, tn_);
         emit(0,"{");
         emit(1,    "uint32_t pos = 0, element;");
-        if (zs.members.size() > 0) {
+        if (hasUnfusedMembers()) {
             emit(1, "int thislen;");
         }
         emit(0,"");
         emit(1,    "for (element = 0; element < elements; ++element) {");
         emit(0,"");
-        for (auto& zm : zs.members) {
+        for (size_t i = 0; i < zs.members.size(); ++i) {
+            size_t next = emitCPrimitiveRun(i, true);
+            if (next != i) {
+                i = next - 1;
+                continue;
+            }
+
+            auto& zm = zs.members[i];
             emitCArrayLoopsStart(zm, "p", FLAG_NONE);
 
             int indent = 2+std::max(0, (int)zm.dimensions.size() - 1);
@@ -516,11 +654,20 @@ struct EmitSource : public Emit
         emit(0,"int __%s_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, %s* p, uint32_t elements)", tn_, tn_);
         emit(0,"{");
         emit(1,    "uint32_t pos = 0, element;");
-        emit(1,    "int thislen;");
+        if (hasUnfusedMembers()) {
+            emit(1, "int thislen;");
+        }
         emit(0,"");
         emit(1,    "for (element = 0; element < elements; ++element) {");
         emit(0,"");
-        for (auto& zm : zs.members) {
+        for (size_t i = 0; i < zs.members.size(); ++i) {
+            size_t next = emitCPrimitiveRun(i, false);
+            if (next != i) {
+                i = next - 1;
+                continue;
+            }
+
+            auto& zm = zs.members[i];
             emitCArrayLoopsStart(zm, "p", zm.isConstantSizeArray() ? FLAG_NONE : FLAG_EMIT_MALLOCS);
 
             int indent = 2+std::max(0, (int)zm.dimensions.size() - 1);
@@ -590,6 +737,74 @@ struct EmitSource : public Emit
         emit(0,"");
     }
 
+    void emitCDecodeArrayArena()
+    {
+        const char* tn_ = zs.structname.nameUnderscoreCStr();
+        const char* le = zcm.gopt->getBool("little-endian-encoding") ? "little_endian_" : "";
+
+        emit(0,"int __%s_decode_array_arena(const void* buf, uint32_t offset, uint32_t maxlen, %s* p, uint32_t elements, zcm_arena_t* arena)", tn_, tn_);
+        emit(0,"{");
+        emit(1,    "uint32_t pos = 0, element;");
+        if (hasUnfusedMembers()) {
+            emit(1, "int thislen;");
+        }
+        emit(1,    "(void) arena;");
+        emit(0,"");
+        emit(1,    "for (element = 0; element < elements; ++element) {");
+        emit(0,"");
+        for (size_t i = 0; i < zs.members.size(); ++i) {
+            size_t next = emitCPrimitiveRun(i, false);
+            if (next != i) {
+                i = next - 1;
+                continue;
+            }
+
+            auto& zm = zs.members[i];
+            emitCArrayLoopsStart(zm, "p", zm.isConstantSizeArray() ? FLAG_NONE : FLAG_EMIT_ARENA_MALLOCS);
+
+            // Only strings and nested types allocate
+            bool allocates = zm.type.fullname == "string" ||
+                             !ZCMGen::isPrimitiveType(zm.type.fullname);
+            int indent = 2+std::max(0, (int)zm.dimensions.size() - 1);
+            emit(indent, "thislen = __%s_decode_%sarray%s(buf, offset + pos, maxlen - pos, %s, %s%s);",
+                 zm.type.nameUnderscoreCStr(), le, allocates ? "_arena" : "",
+                 makeAccessor(zm, "p", (int)zm.dimensions.size() - 1).c_str(),
+                 makeArraySize(zm, "p", (int)zm.dimensions.size() - 1).c_str(),
+                 allocates ? ", arena" : "");
+            emit(indent, "if (thislen < 0) return thislen; else pos += thislen;");
+
+            emitCArrayLoopsEnd(zm, "p", FLAG_NONE);
+            emit(0,"");
+        }
+        emit(1,   "}");
+        emit(1, "return pos;");
+        emit(0,"}");
+        emit(0,"");
+    }
+
+    void emitCDecodeArena()
+    {
+        const char* tn_ = zs.structname.nameUnderscoreCStr();
+
+        emit(0,"int %s_decode_arena(const void* buf, uint32_t offset, uint32_t maxlen, %s* p, zcm_arena_t* arena)", tn_, tn_);
+        emit(0,"{");
+        emit(1,    "uint32_t pos = 0;");
+        emit(1,    "int thislen;");
+        emit(1,    "int64_t hash = __%s_get_hash();", tn_);
+        emit(0,"");
+        emit(1,    "int64_t this_hash;");
+        emit(1,    "thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);");
+        emit(1,    "if (thislen < 0) return thislen; else pos += thislen;");
+        emit(1,    "if (this_hash != hash) return -1;");
+        emit(0,"");
+        emit(1,    "thislen = __%s_decode_array_arena(buf, offset + pos, maxlen - pos, p, 1, arena);", tn_);
+        emit(1,    "if (thislen < 0) return thislen; else pos += thislen;");
+        emit(0,"");
+        emit(1, "return pos;");
+        emit(0,"}");
+        emit(0,"");
+    }
+
     void emitCDecodeCleanup()
     {
         const char* tn_ = zs.structname.nameUnderscoreCStr();
@@ -748,6 +963,71 @@ struct EmitSource : public Emit
         emit(0,"}");
     }
 
+    void emitCTypeDesc()
+    {
+        const char* tn_ = zs.structname.nameUnderscoreCStr();
+
+        emit(0,"");
+
+        unordered_map<string, size_t> fieldIndex;
+        for (size_t i = 0; i < zs.members.size(); ++i)
+            fieldIndex[zs.members[i].membername] = i;
+
+        // All dimensions go in one table that the fields point into
+        bool hasDims = false;
+        for (auto& zm : zs.members)
+            hasDims |= !zm.dimensions.empty();
+        if (hasDims) {
+            emit(0,"static const zcm_dim_desc_t __%s_dims[] = {", tn_);
+            for (auto& zm : zs.members) {
+                for (auto& zd : zm.dimensions) {
+                    if (zd.mode == ZCM_VAR)
+                        emit(1,"{ %zu, 1 }, /* %s.%s */", fieldIndex[zd.size], zm.membername.c_str(), zd.size.c_str());
+                    else
+                        emit(1,"{ %s, 0 }, /* %s */", zd.size.c_str(), zm.membername.c_str());
+                }
+            }
+            emit(0,"};");
+            emit(0,"");
+        }
+
+        if (!zs.members.empty()) {
+            emit(0,"static const zcm_field_desc_t __%s_fields[] = {", tn_);
+            size_t dim = 0;
+            for (auto& zm : zs.members) {
+                bool primitive = ZCMGen::isPrimitiveType(zm.type.fullname);
+                string type = primitive ? "ZCM_FIELD_" + StringUtil::toUpper(zm.type.shortname)
+                                        : "ZCM_FIELD_USER_TYPE";
+                string dims = "NULL";
+                if (!zm.dimensions.empty())
+                    dims = "__" + string(tn_) + "_dims + " + std::to_string(dim);
+                dim += zm.dimensions.size();
+                string subtype = primitive ? "NULL" : "&__" + mapTypeName(zm.type.fullname) + "_type_desc";
+                emit(1,"{ \"%s\", %s, \"%s\", offsetof(%s, %s), %zu, %s, %s },",
+                     zm.membername.c_str(), type.c_str(), zm.type.fullname.c_str(),
+                     tn_, zm.membername.c_str(), zm.dimensions.size(), dims.c_str(), subtype.c_str());
+            }
+            emit(0,"};");
+            emit(0,"");
+        }
+
+        emit(0,"const zcm_type_desc_t __%s_type_desc = {", tn_);
+        emit(1,"\"%s\", __%s_get_hash, sizeof(%s), %d,",
+             zs.structname.fullname.c_str(), tn_, tn_,
+             zcm.gopt->getBool("little-endian-encoding") ? 1 : 0);
+        if (zs.members.empty())
+            emit(1,"0, NULL");
+        else
+            emit(1,"%zu, __%s_fields", zs.members.size(), tn_);
+        emit(0,"};");
+        emit(0,"");
+
+        emit(0,"const zcm_type_desc_t* %s_get_type_desc(void)", tn_);
+        emit(0,"{");
+        emit(1,"return &__%s_type_desc;", tn_);
+        emit(0,"}");
+    }
+
     void emitCCloneArray()
     {
         const char* tn_ = zs.structname.nameUnderscoreCStr();
@@ -808,6 +1088,24 @@ struct EmitSource : public Emit
 
         emit(0, "int %s_publish(zcm_t* zcm, const char* channel, const %s* p)", tn_, tn_);
         emit(0, "{");
+        if (zcm.gopt->getBool("c-arena")) {
+            // Encode into a per-thread scratch buffer that only ever grows
+            emit(0, "      static ZCM_THREAD_LOCAL uint8_t* buf = NULL;");
+            emit(0, "      static ZCM_THREAD_LOCAL uint32_t buf_size = 0;");
+            emit(0, "      uint32_t max_data_size = %s_encoded_size (p);", tn_);
+            emit(0, "      if (max_data_size > buf_size) {");
+            emit(0, "          uint8_t* newbuf = (uint8_t*) realloc (buf, max_data_size);");
+            emit(0, "          if (!newbuf) return -1;");
+            emit(0, "          buf = newbuf;");
+            emit(0, "          buf_size = max_data_size;");
+            emit(0, "      }");
+            emit(0, "      int data_size = %s_encode (buf, 0, max_data_size, p);", tn_);
+            emit(0, "      if (data_size < 0) return data_size;");
+            emit(0, "      return zcm_publish (zcm, channel, buf, (uint32_t)data_size);");
+            emit(0, "}");
+            emit(0, "");
+            return;
+        }
         emit(0, "      uint32_t max_data_size = %s_encoded_size (p);", tn_);
         emit(0, "      uint8_t* buf = (uint8_t*) malloc (max_data_size);");
         emit(0, "      if (!buf) return -1;");
@@ -827,10 +1125,14 @@ struct EmitSource : public Emit
     {
         const char* tn_ = zs.structname.nameUnderscoreCStr();
 
+        bool arena = zcm.gopt->getBool("c-arena");
+
         emit(0, "struct _%s_subscription_t {", tn_);
         emit(0, "    %s_handler_t user_handler;", tn_);
         emit(0, "    void* userdata;");
         emit(0, "    zcm_sub_t* z_sub;");
+        if (arena)
+            emit(0, "    zcm_arena_t arena;");
         emit(0, "};");
         emit(0, "static");
         emit(0, "void %s_handler_stub (const zcm_recv_buf_t* rbuf,", tn_);
@@ -838,19 +1140,31 @@ struct EmitSource : public Emit
         emit(0, "{");
         emit(0, "    int status;");
         emit(0, "    %s p;", tn_);
+        if (arena)
+            emit(0, "    %s_subscription_t* h = (%s_subscription_t*) userdata;", tn_, tn_);
         emit(0, "    memset(&p, 0, sizeof(%s));", tn_);
-        emit(0, "    status = %s_decode (rbuf->data, 0, rbuf->data_size, &p);", tn_);
+        if (arena)
+            emit(0, "    status = %s_decode_arena (rbuf->data, 0, rbuf->data_size, &p, &h->arena);", tn_);
+        else
+            emit(0, "    status = %s_decode (rbuf->data, 0, rbuf->data_size, &p);", tn_);
         emit(0, "    if (status < 0) {");
+        if (arena)
+            emit(0, "        zcm_arena_reset (&h->arena);");
         emit(0, "        #ifndef ZCM_EMBEDDED");
         emit(0, "        fprintf (stderr, \"error %%d decoding %s!!!\\n\", status);", tn_);
         emit(0, "        #endif");
         emit(0, "        return;");
         emit(0, "    }");
         emit(0, "");
-        emit(0, "    %s_subscription_t* h = (%s_subscription_t*) userdata;", tn_, tn_);
+        if (!arena)
+            emit(0, "    %s_subscription_t* h = (%s_subscription_t*) userdata;", tn_, tn_);
         emit(0, "    h->user_handler (rbuf, channel, &p, h->userdata);");
         emit(0, "");
-        emit(0, "    %s_decode_cleanup (&p);", tn_);
+        // The arena is emptied, not freed, so steady state decoding does not allocate
+        if (arena)
+            emit(0, "    zcm_arena_reset (&h->arena);");
+        else
+            emit(0, "    %s_decode_cleanup (&p);", tn_);
         emit(0, "}");
         emit(0, "");
         emit(0, "%s_subscription_t* %s_subscribe (zcm_t* zcm,", tn_, tn_);
@@ -870,6 +1184,8 @@ struct EmitSource : public Emit
         emit(0, "                       malloc(sizeof(%s_subscription_t));", tn_);
         emit(0, "    n->user_handler = f;");
         emit(0, "    n->userdata = userdata;");
+        if (arena)
+            emit(0, "    zcm_arena_init (&n->arena, NULL, 0);");
         emit(0, "    n->z_sub = zcm_subscribe (zcm, channel,");
         emit(0, "                              %s_handler_stub, n);", tn_);
         emit(0, "    if (n->z_sub == NULL) {");
@@ -898,6 +1214,8 @@ struct EmitSource : public Emit
         emit(0, "        #endif");
         emit(0, "        return -1;");
         emit(0, "    }");
+        if (arena)
+            emit(0, "    zcm_arena_destroy (&hid->arena);");
         emit(0, "    free (hid);");
         emit(0, "    return 0;");
         emit(0, "}\n");
@@ -939,6 +1257,7 @@ static int emitStructSource(const ZCMGen& zcm, const ZCMStruct& zs, const string
         E.emitCNumFields();
         E.emitCGetField();
         E.emitCGetTypeInfo();
+        E.emitCTypeDesc();
     }
 
     E.emitCDecodeArray();
@@ -946,6 +1265,11 @@ static int emitStructSource(const ZCMGen& zcm, const ZCMStruct& zs, const string
     E.emitCDecode();
     E.emitCDecodeCleanup();
 
+    if(zcm.gopt->getBool("c-arena")) {
+        E.emitCDecodeArrayArena();
+        E.emitCDecodeArena();
+    }
+
     E.emitCCloneArray();
     E.emitCCopy();
     E.emitCDestroy();
@@ -965,6 +1289,7 @@ void setupOptionsC(GetOpt& gopt)
     gopt.addString(0, "c-include",   "",       "Generated #include lines reference this folder");
     gopt.addBool(0, "c-no-pubsub",   0,     "Do not generate _publish and _subscribe functions");
     gopt.addBool(0, "c-typeinfo",   0,      "Generate typeinfo functions for each type");
+    gopt.addBool(0, "c-arena",      0,      "Generate _decode_arena and make _publish/_subscribe reuse their buffers");
 }
 
 int emitC(const ZCMGen& zcm)
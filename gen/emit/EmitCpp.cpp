@@ -67,15 +67,113 @@ void setupOptionsCpp(GetOpt& gopt)
 {
     gopt.addString(0, "cpp-hpath",    ".",      "Location for .hpp files");
     gopt.addString(0, "cpp-include",   "",       "Generated #include lines reference this folder");
+    gopt.addInt(   0, "cpp-fixed-capacity", "0",  "Map variable-length arrays and strings to zcm::FixedVector "
+                                                  "and zcm::FixedString of this capacity");
+    gopt.addString(0, "cpp-array-template", "",   "Template for variable-length arrays, used as TEMPLATE< T > "
+                                                  "(default std::vector)");
+    gopt.addString(0, "cpp-string-type",    "",   "Type for strings (default std::string)");
+    gopt.addString(0, "cpp-container-include", "", "Header declaring --cpp-array-template and --cpp-string-type");
+    gopt.addBool(  0, "cpp-convert",        0,    "Generate _convertFrom(), which converts from other versions "
+                                                  "of a type (c++11)");
 }
 
-struct Emit : public Emitter
+struct EmitCppType : public Emitter
 {
     const ZCMGen& zcm;
     const ZCMStruct& zs;
 
-    Emit(const ZCMGen& zcm, const ZCMStruct& zs, const string& fname):
-        Emitter(fname), zcm(zcm), zs(zs) {}
+    // How variable-length arrays and strings are stored. Anything other than
+    // std::vector and std::string gets its capacity checked while decoding.
+    string arrayOpen = "std::vector< ";
+    string arrayClose = " >";
+    string stringType = "std::string";
+    string containerInclude;
+    bool customContainers = false;
+
+    // What zcm-gen can work out ahead of time, given the types it was run on
+    bool hashKnown = false;
+    u64 hash = 0;
+    bool fixedSize = false;
+    u64 encodedSize = 0; // excluding the hash
+
+    EmitCppType(const ZCMGen& zcm, const ZCMStruct& zs, const string& fname):
+        Emitter(fname), zcm(zcm), zs(zs)
+    {
+        int capacity = zcm.gopt->getInt("cpp-fixed-capacity");
+        if (capacity > 0) {
+            arrayOpen = "zcm::FixedVector< ";
+            arrayClose = ", " + std::to_string(capacity) + " >";
+            stringType = "zcm::FixedString< " + std::to_string(capacity) + " >";
+            containerInclude = "<zcm/util/FixedContainers.hpp>";
+            customContainers = true;
+        }
+
+        const string& arrayTemplate = zcm.gopt->getString("cpp-array-template");
+        if (arrayTemplate != "") {
+            arrayOpen = arrayTemplate + "< ";
+            arrayClose = " >";
+            customContainers = true;
+        }
+        if (zcm.gopt->getString("cpp-string-type") != "") {
+            stringType = zcm.gopt->getString("cpp-string-type");
+            customContainers = true;
+        }
+        if (zcm.gopt->getString("cpp-container-include") != "")
+            containerInclude = "\"" + zcm.gopt->getString("cpp-container-include") + "\"";
+
+        hashKnown = zcm.getRecursiveHash(zs, hash);
+        fixedSize = zcm.getFixedEncodedSize(zs, encodedSize) && encodedSize > 0;
+        for (auto& zm : zs.members) {
+            u64 size, count;
+            if (fixedSize && !getMemberFixedSize(zm, size, count)) fixedSize = false;
+        }
+    }
+
+    // Returns true if the member always encodes to the same number of bytes
+    bool getMemberFixedSize(const ZCMMember& zm, u64& size, u64& count)
+    {
+        auto& mtn = zm.type.fullname;
+        if (ZCMGen::isPrimitiveType(mtn))
+            return zm.isFixedSizePrimitive(count, size);
+        if (!zm.isConstantSizeArray())
+            return false;
+
+        count = 1;
+        for (auto& dim : zm.dimensions)
+            count *= strtoull(dim.size.c_str(), NULL, 0);
+
+        const ZCMStruct* other = zcm.findStruct(mtn);
+        u64 elemSize;
+        if (!other || !zcm.getFixedEncodedSize(*other, elemSize))
+            return false;
+        size = count * elemSize;
+        return true;
+    }
+
+    // "&this->member[0][0]" for arrays, "&this->member" for scalars
+    string firstElement(const ZCMMember& zm)
+    {
+        string ret = "&this->" + zm.membername;
+        for (size_t i = 0; i < zm.dimensions.size(); ++i)
+            ret += "[0]";
+        return ret;
+    }
+
+    string mapMemberTypeName(const string& t)
+    {
+        return t == "string" ? stringType : mapTypeName(t);
+    }
+
+    // Fail decoding when an array or string does not fit its container
+    void emitCapacityCheck(int indent, const ZCMMember& zm, int depth, const string& size)
+    {
+        if (!customContainers)
+            return;
+        emitStart(indent, "if((size_t)(%s) > this->%s", size.c_str(), zm.membername.c_str());
+        for(int i = 0; i < depth; ++i)
+            emitContinue("[a%d]", i);
+        emitEnd(".max_size()) return -1;");
+    }
 
     void emitAutoGeneratedWarning()
     {
@@ -141,17 +239,24 @@ struct Emit : public Emitter
         // do we need to #include <vector> and/or <string>?
         bool emitIncludeVector = false;
         bool emitIncludeString = false;
+        bool emitIncludeContainers = false;
         for (auto& zm : zs.members) {
-            if (!emitIncludeVector &&
-                zm.dimensions.size() != 0 && !zm.isConstantSizeArray()) {
+            bool isArray = zm.dimensions.size() != 0 && !zm.isConstantSizeArray();
+            bool isString = zm.type.fullname == "string";
+            if (!emitIncludeVector && isArray && arrayOpen == "std::vector< ") {
                 emit(0, "#include <vector>");
                 emitIncludeVector = true;
             }
-            if (!emitIncludeString &&
-                zm.type.fullname == "string") {
+            if (!emitIncludeString && isString && stringType == "std::string") {
                 emit(0, "#include <string>");
                 emitIncludeString = true;
             }
+            if (!emitIncludeContainers && containerInclude != "" &&
+                ((isArray && arrayOpen != "std::vector< ") ||
+                 (isString && stringType != "std::string"))) {
+                emit(0, "#include %s", containerInclude.c_str());
+                emitIncludeContainers = true;
+            }
         }
 
         // include header files for other ZCM types
@@ -165,6 +270,12 @@ struct Emit : public Emitter
             }
         }
 
+        if (zcm.gopt->getBool("cpp-convert")) {
+            emit(0, "#if __cplusplus > 199711L /* if c++11 */");
+            emit(0, "#include <zcm/util/Convert.hpp>");
+            emit(0, "#endif");
+        }
+
         emit(0, "\n");
         emitPackageNamespaceStart();
 
@@ -179,7 +290,7 @@ struct Emit : public Emitter
             for (auto& zm : zs.members) {
                 auto& mtn = zm.type.fullname;
                 emitComment(2, zm.comment);
-                string mappedTypename = mapTypeName(mtn);
+                string mappedTypename = mapMemberTypeName(mtn);
                 int ndim = (int)zm.dimensions.size();
                 if (ndim == 0) {
                     emit(2, "%-10s %s;", mappedTypename.c_str(), zm.membername.c_str());
@@ -192,10 +303,10 @@ struct Emit : public Emitter
                     } else {
                         emitStart(2, "");
                         for (int d = 0; d < ndim; ++d)
-                            emitContinue("std::vector< ");
+                            emitContinue("%s", arrayOpen.c_str());
                         emitContinue("%s", mappedTypename.c_str());
                         for (int d = 0; d < ndim; ++d)
-                            emitContinue(" >");
+                            emitContinue("%s", arrayClose.c_str());
                         emitEnd(" %s;", zm.membername.c_str());
                     }
                 }
@@ -227,6 +338,21 @@ struct Emit : public Emitter
             emit(0, "");
         }
 
+        if (hashKnown || fixedSize) {
+            emit(1, "public:");
+            emit(2, "#if __cplusplus > 199711L /* if c++11 */");
+            if (hashKnown) {
+                emit(2, "/// The value of getHash()");
+                emit(2, "static constexpr int64_t  ZCM_TYPE_HASH = (int64_t)0x%016" PRIx64 "LL;", hash);
+            }
+            if (fixedSize) {
+                emit(2, "/// The value of getEncodedSize(), which is the same for every instance");
+                emit(2, "static constexpr uint32_t ZCM_ENCODED_SIZE = %" PRIu64 ";", 8 + encodedSize);
+            }
+            emit(2, "#endif");
+            emit(0, "");
+        }
+
         emit(1, "public:");
         emit(2, "/**");
         emit(2, " * Destructs a message properly if anything inherits from it");
@@ -278,10 +404,94 @@ struct Emit : public Emitter
         emit(2, "inline uint32_t _getEncodedSizeNoHash() const;");
         emit(2, "inline int      _decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen);");
         emit(2, "inline static uint64_t _computeHash(const __zcm_hash_ptr* p);");
+        if (zcm.gopt->getBool("cpp-convert"))
+            emitConvertFromDeclarations();
         emit(0, "};");
         emit(0, "");
     }
 
+    void emitConvertFromDeclarations()
+    {
+        const char* sn = zs.structname.shortname.c_str();
+
+        emit(0, "");
+        emit(2, "#if __cplusplus > 199711L /* if c++11 */");
+        emit(2, "/**");
+        emit(2, " * Sets each member that @p other, usually another version of this type, has");
+        emit(2, " * under the same name, converting values whose types differ (see");
+        emit(2, " * zcm/util/Convert.hpp). Other members are left as they are, except for the sizes");
+        emit(2, " * of variable-length arrays, which are kept in line with their arrays.");
+        emit(2, " */");
+        emit(2, "template <typename Other> inline void _convertFrom(const Other& other);");
+        if (zs.members.size() > 0) {
+            emit(0, "");
+            emit(1, "private:");
+            // Overload resolution picks the first of each pair when Other has the member
+            for (auto& zm : zs.members) {
+                const char* mn = zm.membername.c_str();
+                emit(2, "template <typename Other>");
+                emit(2, "inline static auto __convert_%s(%s& to, const Other& from, int)", mn, sn);
+                emit(3,     "-> decltype((void) from.%s) { zcm::convert::field(to.%s, from.%s); }", mn, mn, mn);
+                emit(2, "template <typename Other>");
+                emit(2, "inline static void __convert_%s(%s&, const Other&, long) {}", mn, sn);
+            }
+        }
+        emit(2, "#endif");
+    }
+
+    void emitConvertFrom()
+    {
+        const char* sn = zs.structname.shortname.c_str();
+
+        emit(0, "#if __cplusplus > 199711L /* if c++11 */");
+        emit(0, "template <typename Other>");
+        if (zs.members.size() == 0) {
+            emit(0, "void %s::_convertFrom(const Other&)", sn);
+            emit(0, "{");
+            emit(0, "}");
+            emit(0, "#endif");
+            emit(0, "");
+            return;
+        }
+        emit(0, "void %s::_convertFrom(const Other& other)", sn);
+        emit(0, "{");
+        for (auto& zm : zs.members)
+            emit(1, "__convert_%s(*this, other, 0);", zm.membername.c_str());
+
+        // Sizes follow the first array that they are the size of
+        unordered_set<string> sized;
+        for (auto& zm : zs.members) {
+            for (size_t d = 0; d < zm.dimensions.size(); ++d) {
+                auto& dim = zm.dimensions[d];
+                if (dim.mode != ZCM_VAR || sized.count(dim.size))
+                    continue;
+                sized.insert(dim.size);
+
+                const ZCMMember* sizeMember = nullptr;
+                for (auto& other : zs.members)
+                    if (other.membername == dim.size)
+                        sizeMember = &other;
+                assert(sizeMember);
+                string sizeType = mapTypeName(sizeMember->type.fullname);
+
+                string outer = "this->" + zm.membername;
+                string nonEmpty;
+                for (size_t i = 0; i < d; ++i) {
+                    nonEmpty += string(nonEmpty.empty() ? "" : " && ") + outer + ".size() > 0";
+                    outer += "[0]";
+                }
+                if (nonEmpty.empty())
+                    emit(1, "this->%s = (%s) %s.size();", dim.size.c_str(), sizeType.c_str(), outer.c_str());
+                else
+                    emit(1, "if (%s) this->%s = (%s) %s.size();",
+                         nonEmpty.c_str(), dim.size.c_str(), sizeType.c_str(), outer.c_str());
+            }
+        }
+        emit(0, "}");
+        emit(0, "#endif");
+        emit(0, "");
+    }
+
     void emitHeaderEnd()
     {
         emitPackageNamespaceClose();
@@ -313,7 +523,10 @@ struct Emit : public Emitter
         const char* sn = zs.structname.shortname.c_str();
         emit(0,"uint32_t %s::getEncodedSize() const", sn);
         emit(0,"{");
-        emit(1, "return 8 + _getEncodedSizeNoHash();");
+        if (fixedSize)
+            emit(1, "return %" PRIu64 ";", 8 + encodedSize);
+        else
+            emit(1, "return 8 + _getEncodedSizeNoHash();");
         emit(0,"}");
         emit(0,"");
     }
@@ -344,8 +557,12 @@ struct Emit : public Emitter
         const char* sn = zs.structname.shortname.c_str();
         emit(0, "int64_t %s::getHash()", sn);
         emit(0, "{");
-        emit(1,     "static int64_t hash = _computeHash(NULL);");
-        emit(1,     "return hash;");
+        if (hashKnown) {
+            emit(1,     "return (int64_t)0x%016" PRIx64 "LL;", hash);
+        } else {
+            emit(1,     "static int64_t hash = _computeHash(NULL);");
+            emit(1,     "return hash;");
+        }
         emit(0, "}");
         emit(0, "");
     }
@@ -453,6 +670,122 @@ struct Emit : public Emitter
         emit(indent, "}");
     }
 
+    // Every member sits at an offset known ahead of time, so the bounds are checked once
+    // up front and the members are encoded/decoded straight through
+    void emitFixedSizeCodec(bool encode)
+    {
+        const char* sn = zs.structname.shortname.c_str();
+        const char* op = encode ? "encode" : "decode";
+
+        bool hasPrimitives = false;
+        for (auto& zm : zs.members) {
+            u64 size, count;
+            if (zm.isFixedSizePrimitive(count, size) && size > 0)
+                hasPrimitives = true;
+        }
+
+        if (encode)
+            emit(0, "int %s::_encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const", sn);
+        else
+            emit(0, "int %s::_decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen)", sn);
+        emit(0, "{");
+        emit(1,     "if(maxlen < %" PRIu64 ") return -1;", encodedSize);
+        if (hasPrimitives) {
+            if (encode)
+                emit(1, "uint8_t* run = (uint8_t*) buf + offset;");
+            else
+                emit(1, "const uint8_t* run = (const uint8_t*) buf + offset;");
+        }
+        emit(0, "");
+
+        u64 pos = 0;
+        for (auto& zm : zs.members) {
+            auto& mtn = zm.type.fullname;
+            u64 size, count;
+            getMemberFixedSize(zm, size, count);
+            if (size == 0) continue;
+
+            if (ZCMGen::isPrimitiveType(mtn)) {
+                emitPrimitiveConversion(1, zm, pos, encode);
+            } else if (count == 1) {
+                emit(1, "this->%s._%sNoHash(buf, offset + %" PRIu64 ", %" PRIu64 ");",
+                     zm.membername.c_str(), op, pos, encodedSize - pos);
+            } else {
+                u64 elemSize = size / count;
+                emit(1, "for (int a = 0; a < %" PRIu64 "; ++a)", count);
+                emit(2,     "(%s)[a]._%sNoHash(buf, offset + %" PRIu64 " + a * %" PRIu64 ", %" PRIu64 ");",
+                     firstElement(zm).c_str(), op, pos, elemSize, elemSize);
+            }
+            pos += size;
+        }
+        emit(0, "");
+        emit(1, "return %" PRIu64 ";", encodedSize);
+        emit(0, "}");
+        emit(0, "");
+    }
+
+    // Converts a primitive member of constant size with unchecked loads and stores at "pos"
+    // bytes into "run", which the caller has bounds checked and declared
+    void emitPrimitiveConversion(int indent, const ZCMMember& zm, u64 pos, bool encode)
+    {
+        const char* le = zcm.gopt->getBool("little-endian-encoding") ? "_little_endian" : "";
+        const char* mtn = zm.type.fullname.c_str();
+        const char* mn = zm.membername.c_str();
+
+        u64 count, size;
+        zm.isFixedSizePrimitive(count, size);
+        if (zm.dimensions.size() == 0) {
+            if (encode)
+                emit(indent, "__%s_store%s(run + %" PRIu64 ", this->%s);", mtn, le, pos, mn);
+            else
+                emit(indent, "this->%s = __%s_load%s(run + %" PRIu64 ");", mn, mtn, le, pos);
+            return;
+        }
+
+        // Multidimensional arrays are contiguous, so they are converted in one loop
+        string elems = "(" + firstElement(zm) + ")[a]";
+        emit(indent, "for (int a = 0; a < %" PRIu64 "; ++a)", count);
+        if (encode)
+            emit(indent + 1, "__%s_store%s(run + %" PRIu64 " + %" PRIu64 " * a, %s);",
+                 mtn, le, pos, size / count, elems.c_str());
+        else
+            emit(indent + 1, "%s = __%s_load%s(run + %" PRIu64 " + %" PRIu64 " * a);",
+                 elems.c_str(), mtn, le, pos, size / count);
+    }
+
+    // Consecutive primitive members of constant size are bounds checked once and then
+    // converted with unchecked loads and stores at offsets known ahead of time. Returns the
+    // index of the member after the run, which is "first" itself unless there are at least
+    // two members to fuse.
+    size_t emitPrimitiveRun(size_t first, bool encode)
+    {
+        u64 count, size, total = 0;
+        size_t end = first;
+        while (end < zs.members.size() && zs.members[end].isFixedSizePrimitive(count, size)) {
+            total += size;
+            ++end;
+        }
+        if (end - first < 2)
+            return first;
+
+        emit(1, "if(maxlen - pos < %" PRIu64 ") return -1;", total);
+        emit(1, "{");
+        if (encode)
+            emit(2, "uint8_t* run = (uint8_t*) buf + offset + pos;");
+        else
+            emit(2, "const uint8_t* run = (const uint8_t*) buf + offset + pos;");
+        u64 pos = 0;
+        for (size_t i = first; i < end; ++i) {
+            zs.members[i].isFixedSizePrimitive(count, size);
+            emitPrimitiveConversion(2, zs.members[i], pos, encode);
+            pos += size;
+        }
+        emit(1, "}");
+        emit(1, "pos += %" PRIu64 ";", total);
+        emit(0, "");
+        return end;
+    }
+
     void emitEncodeNohash()
     {
         const char* sn = zs.structname.shortname.c_str();
@@ -464,13 +797,23 @@ struct Emit : public Emitter
             emit(0, "");
             return;
         }
+        if (fixedSize) {
+            emitFixedSizeCodec(true);
+            return;
+        }
         emit(0, "int %s::_encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const", sn);
         emit(0, "{");
         emit(1,     "uint32_t pos = 0;");
         emit(1,     "int thislen;");
         emit(0, "");
-        for (auto& zm : zs.members) {
+        for (size_t i = 0; i < zs.members.size(); ++i) {
+            size_t next = emitPrimitiveRun(i, true);
+            if (next != i) {
+                i = next - 1;
+                continue;
+            }
 
+            auto& zm = zs.members[i];
             auto& mtn = zm.type.fullname;
             auto* mn = zm.membername.c_str();
 
@@ -525,12 +868,30 @@ struct Emit : public Emitter
             emit(0,"");
             return;
         }
+        if (fixedSize) {
+            emit(1,     "return %" PRIu64 ";", encodedSize);
+            emit(0,"}");
+            emit(0,"");
+            return;
+        }
         emit(1,     "uint32_t enc_size = 0;");
+        // Runs of members that are always the same size are added up ahead of time
+        u64 fixedRun = 0;
         for (auto& zm : zs.members) {
             auto& mtn = zm.type.fullname;
             auto* mn = zm.membername.c_str();
             int ndim = (int)zm.dimensions.size();
 
+            u64 size, count;
+            if (getMemberFixedSize(zm, size, count)) {
+                fixedRun += size;
+                continue;
+            }
+            if (fixedRun > 0) {
+                emit(1, "enc_size += %" PRIu64 ";", fixedRun);
+                fixedRun = 0;
+            }
+
             if (ZCMGen::isPrimitiveType(mtn) && mtn != "string") {
                 emitStart(1, "enc_size += ");
                 for(int n = 0; n < ndim-1; ++n) {
@@ -563,6 +924,8 @@ struct Emit : public Emitter
                 }
             }
         }
+        if (fixedRun > 0)
+            emit(1, "enc_size += %" PRIu64 ";", fixedRun);
         emit(1, "return enc_size;");
         emit(0,"}");
         emit(0,"");
@@ -581,11 +944,13 @@ struct Emit : public Emitter
             auto& dim = zm.dimensions[depth];
             int decodeIndent = 1 + depth;
             if(!zm.isConstantSizeArray()) {
-                emit(1 + depth, "if(%s > 0) {", dimSizeAccessor(dim.size).c_str());
-                emitStart(2 + depth, "this->%s", mn);
+                // Always resize, an empty array must not keep what was decoded before
+                emitCapacityCheck(1 + depth, zm, depth, dimSizeAccessor(dim.size));
+                emitStart(1 + depth, "this->%s", mn);
                 for(int i = 0; i < depth; ++i)
                     emitContinue("[a%d]", i);
                 emitEnd(".resize(%s);", dimSizeAccessor(dim.size).c_str());
+                emit(1 + depth, "if(%s > 0) {", dimSizeAccessor(dim.size).c_str());
                 ++decodeIndent;
             }
 
@@ -607,6 +972,7 @@ struct Emit : public Emitter
                                 zcm.gopt->getBool("little-endian-encoding") ? "little_endian_" : "");
                 emit(1 + depth, "if(thislen < 0) return thislen; else pos += thislen;");
                 emit(1 + depth, "if((uint32_t)__elem_len > maxlen - pos) return -1;");
+                emitCapacityCheck(1 + depth, zm, depth, "__elem_len - ZCM_CORETYPES_INT8_NUM_BYTES_ON_BUS");
                 emitStart(1 + depth, "this->%s", mn);
                 for(int i = 0; i < depth; ++i)
                     emitContinue("[a%d]", i);
@@ -622,6 +988,7 @@ struct Emit : public Emitter
         } else {
             auto& dim = zm.dimensions[depth];
             if(!zm.isConstantSizeArray()) {
+                emitCapacityCheck(1 + depth, zm, depth, dimSizeAccessor(dim.size));
                 emitStart(1+depth, "this->%s", mn);
                 for(int i = 0; i < depth; ++i) {
                     emitContinue("[a%d]", i);
@@ -648,12 +1015,23 @@ struct Emit : public Emitter
             emit(0, "");
             return;
         }
+        if (fixedSize) {
+            emitFixedSizeCodec(false);
+            return;
+        }
         emit(0, "int %s::_decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen)", sn);
         emit(0, "{");
         emit(1,     "uint32_t pos = 0;");
         emit(1,     "int thislen;");
         emit(0, "");
-        for (auto& zm : zs.members) {
+        for (size_t i = 0; i < zs.members.size(); ++i) {
+            size_t next = emitPrimitiveRun(i, false);
+            if (next != i) {
+                i = next - 1;
+                continue;
+            }
+
+            auto& zm = zs.members[i];
             auto& mtn = zm.type.fullname;
             auto* mn = zm.membername.c_str();
 
@@ -666,6 +1044,7 @@ struct Emit : public Emitter
                             mn);
                     emit(1, "if(thislen < 0) return thislen; else pos += thislen;");
                     emit(1, "if((uint32_t)__%s_len__ > maxlen - pos) return -1;", mn);
+                    emitCapacityCheck(1, zm, 0, "__" + zm.membername + "_len__ - ZCM_CORETYPES_INT8_NUM_BYTES_ON_BUS");
                     emit(1, "this->%s.assign(((const char*)buf) + offset + pos, __%s_len__ - ZCM_CORETYPES_INT8_NUM_BYTES_ON_BUS);", mn, mn);
                     emit(1, "pos += __%s_len__;", mn);
                 } else {
@@ -698,6 +1077,8 @@ struct Emit : public Emitter
         emitDecodeNohash();
         emitEncodedSizeNohash();
         emitComputeHash();
+        if (zcm.gopt->getBool("cpp-convert"))
+            emitConvertFrom();
         emitHeaderEnd();
     }
 };
@@ -715,7 +1096,7 @@ int emitCpp(const ZCMGen& zcm)
         // generate code if needed
         if (zcm.needsGeneration(zs.zcmfile, headerName)) {
             FileUtil::makeDirsForFile(headerName);
-            Emit E{zcm, zs, headerName};
+            EmitCppType E{zcm, zs, headerName};
             if (!E.good())
                 return -1;
             E.emitHeader();
@@ -761,5 +1142,7 @@ unordered_set<string> getReservedKeywordsCpp()
              "switch", "synchronized", "template", "this", "thread_local",
              "throw", "true", "try", "typedef", "typeid", "typename", "union",
              "unsigned", "using", "virtual", "void", "volatile", "wchar_t",
-             "while", "xor", "xor_eq" };
+             "while", "xor", "xor_eq",
+             // generated constants
+             "ZCM_TYPE_HASH", "ZCM_ENCODED_SIZE" };
 }
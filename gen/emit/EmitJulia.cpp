@@ -537,87 +537,137 @@ struct EmitJuliaType : public Emitter
         emit(0, "");
     }
 
-    void emitDecodeSingleMember(const ZCMMember& zm, const string& accessor_,
-                                int indent, const string& sfx_)
+    // Emits the decoding of one member (or array element) at pos, leaving pos just after it
+    void emitDecodeSingleMember(const ZCMMember& zm, const string& accessor_, int indent)
     {
         auto& tn = zm.type.fullname;
         string mappedTypename = mapTypeName(tn, pkgPrefix);
 
         auto* accessor = accessor_.c_str();
-        auto* sfx = sfx_.c_str();
 
         if (tn == "string") {
-            emit(indent, "%sString(read(buf, %s(reinterpret(UInt32, read(buf, 4))[1])))[1:end-1]%s",
-                         accessor, ntoh.c_str(), sfx);
-        } else if (tn == "byte"    || tn == "boolean" || tn == "int8_t") {
-            auto typeSize = ZCMGen::getPrimitiveTypeSize(tn);
-            emit(indent, "%sreinterpret(%s, read(buf, %u))[1]%s",
-                         accessor, mappedTypename.c_str(), typeSize, sfx);
-        } else if (tn == "int16_t" || tn == "int32_t" || tn == "int64_t" ||
-                   tn == "float"   || tn == "double") {
-            auto typeSize = ZCMGen::getPrimitiveTypeSize(tn);
-            emit(indent, "%s%s(reinterpret(%s, read(buf, %u))[1])%s",
-                         accessor, ntoh.c_str(), mappedTypename.c_str(), typeSize, sfx);
+            emit(indent, "ZCM._check_bounds(data, pos, 4)");
+            emit(indent, "len = Int(%s(ZCM._load(Int32, data, pos)))", ntoh.c_str());
+            emit(indent, "ZCM._check_length(len - 1)");
+            emit(indent, "ZCM._check_bounds(data, pos + 4, len)");
+            emit(indent, "%s = String(data[pos + 4:pos + 2 + len])", accessor);
+            emit(indent, "pos += 4 + len");
+        } else if (zcm.isPrimitiveType(tn)) {
+            emitDecodeScalars({ &zm }, { accessor_ }, indent);
         } else {
-            emit(indent, "%sZCM._decode_one(%s,buf)%s", accessor, mappedTypename.c_str(), sfx);
+            emit(indent, "%s, pos = ZCM._decode_one(%s, data, pos)",
+                         accessor, mappedTypename.c_str());
         }
     }
 
-    void emitDecodeListMember(const ZCMMember& zm, const string& accessor_, int indent,
-                              bool isFirst, const string& len_, bool fixedLen)
+    // Emits the decoding of fixed size primitives that are adjacent in the encoding,
+    // reading each at a known offset from pos after a single bounds check
+    void emitDecodeScalars(const vector<const ZCMMember*>& members,
+                           const vector<string>& accessors, int indent)
     {
-        auto& tn = zm.type.fullname;
-        string mappedTypename = mapTypeName(tn, pkgPrefix);
-        const char* suffix = isFirst ? "" : ")";
-        auto* accessor = accessor_.c_str();
-        auto* len = len_.c_str();
-
-        if (tn == "byte" || tn == "boolean" || tn == "int8_t" ) {
-            if (fixedLen) {
-                emit(indent, "%sreinterpret(%s, read(buf, %d))%s",
-                     accessor, mappedTypename.c_str(),
-                     atoi(len) * ZCMGen::getPrimitiveTypeSize(tn),
-                     suffix);
+        size_t size = 0;
+        for (auto* zm : members) size += ZCMGen::getPrimitiveTypeSize(zm->type.fullname);
+
+        emit(indent, "ZCM._check_bounds(data, pos, %zu)", size);
+        size_t offset = 0;
+        for (size_t i = 0; i < members.size(); ++i) {
+            auto& tn = members[i]->type.fullname;
+            string at = offset == 0 ? "pos" : "pos + " + to_string(offset);
+            auto* accessor = accessors[i].c_str();
+
+            if (tn == "boolean") {
+                emit(indent, "%s = ZCM._load(UInt8, data, %s) != 0x00", accessor, at.c_str());
+            } else if (tn == "byte" || tn == "int8_t") {
+                emit(indent, "%s = ZCM._load(%s, data, %s)",
+                             accessor, mapTypeName(tn).c_str(), at.c_str());
             } else {
-                emit(indent, "%sreinterpret(%s, read(buf, (msg.%s) * %lu))%s",
-                     accessor, mappedTypename.c_str(),
-                     len, ZCMGen::getPrimitiveTypeSize(tn),
-                     suffix);
-            }
-        } else if (tn == "int16_t" || tn == "int32_t" || tn == "int64_t" ||
-                   tn == "float"   || tn == "double") {
-            if (fixedLen) {
-                emit(indent, "%s%s.(reinterpret(%s, read(buf, %d)))%s",
-                     accessor, ntoh.c_str(), mappedTypename.c_str(),
-                     atoi(len) * ZCMGen::getPrimitiveTypeSize(tn),
-                     suffix);
-            } else {
-                emit(indent, "%s%s.(reinterpret(%s, read(buf, (msg.%s) * %lu)))%s",
-                     accessor, ntoh.c_str(), mappedTypename.c_str(),
-                     len, ZCMGen::getPrimitiveTypeSize(tn),
-                     suffix);
+                emit(indent, "%s = %s(ZCM._load(%s, data, %s))",
+                             accessor, ntoh.c_str(), mapTypeName(tn).c_str(), at.c_str());
             }
+            offset += ZCMGen::getPrimitiveTypeSize(tn);
+        }
+        emit(indent, "pos += %zu", size);
+    }
+
+    // Emits the decoding of an array of fixed size primitives with one copy out of the
+    // message. Julia arrays are column major, so multidimensional arrays are read with
+    // their dimensions reversed and then transposed.
+    void emitDecodeListMember(const ZCMMember& zm, int indent)
+    {
+        auto& tn = zm.type.fullname;
+        size_t ndims = zm.dimensions.size();
+
+        vector<string> dims;
+        for (auto& dim : zm.dimensions) {
+            if (dim.mode == ZCM_CONST) dims.push_back(dim.size);
+            else                       dims.push_back("Int(msg." + dim.size + ")");
+        }
+
+        emit(indent, "len = %s", StringUtil::join(dims, " * ").c_str());
+        string load = "ZCM._load_array(" + mapTypeName(tn) + ", " + ntoh + ", data, pos, len)";
+        if (ndims == 1) {
+            emit(indent, "msg.%s = %s", zm.membername.c_str(), load.c_str());
         } else {
-            assert(0);
+            string shape, perm;
+            for (size_t n = 0; n < ndims; ++n) {
+                if (n > 0) {
+                    shape += ", ";
+                    perm += ", ";
+                }
+                shape += dims[ndims - 1 - n];
+                perm += to_string(ndims - n);
+            }
+            emit(indent, "msg.%s = permutedims(reshape(%s, (%s)), (%s))",
+                         zm.membername.c_str(), load.c_str(), shape.c_str(), perm.c_str());
         }
+        emit(indent, "pos += len * %u", ZCMGen::getPrimitiveTypeSize(tn));
     }
 
     void emitDecodeOne()
     {
         auto* sn = zs.structname.shortname.c_str();
 
-        emit(0, "function ZCM._decode_one(::Type{%s}, buf)", sn);
+        emit(0, "function ZCM._decode_one(::Type{%s}, data::Vector{UInt8}, pos::Int)", sn);
         emit(1,     "msg = %s();", sn);
 
+        vector<const ZCMMember*> scalars;
+        vector<string> scalarAccessors;
+        auto flushScalars = [&]() {
+            if (scalars.empty()) return;
+            emitDecodeScalars(scalars, scalarAccessors, 1);
+            scalars.clear();
+            scalarAccessors.clear();
+        };
+
+        set<string> checked;
         for (auto& zm : zs.members) {
+            auto& mtn = zm.type.fullname;
+            bool fixedSizePrimitive = zcm.isPrimitiveType(mtn) && mtn != "string";
+
+            // Each dimension on its own, as the product of two negative ones is positive
+            if (zm.dimensions.size() != 0) {
+                flushScalars();
+                for (auto& dim : zm.dimensions)
+                    if (dim.mode != ZCM_CONST && checked.insert(dim.size).second)
+                        emit(1, "ZCM._check_length(msg.%s)", dim.size.c_str());
+            }
+
             if (zm.dimensions.size() == 0) {
-                string accessor = "msg." + zm.membername + " = ";
-                emitDecodeSingleMember(zm, accessor.c_str(), 1, "");
+                if (fixedSizePrimitive) {
+                    scalars.push_back(&zm);
+                    scalarAccessors.push_back("msg." + zm.membername);
+                    continue;
+                }
+                flushScalars();
+                emitDecodeSingleMember(zm, "msg." + zm.membername, 1);
+            } else if (fixedSizePrimitive) {
+                flushScalars();
+                emitDecodeListMember(zm, 1);
             } else {
+                flushScalars();
                 string accessor = "msg." + zm.membername;
                 size_t n = 0;
 
-                auto& mtn = zm.type.fullname;
                 string mappedTypename;
                 if (zcm.isPrimitiveType(mtn)) mappedTypename = mapTypeName(mtn);
                 else                          mappedTypename = "ZCM.AbstractZcmType";
@@ -646,36 +696,17 @@ struct EmitJuliaType : public Emitter
                     if (n > 0) accessor += ",";
                     accessor += "i" + to_string(n);
                 }
-                accessor += "] = ";
+                accessor += "]";
 
-                emitDecodeSingleMember(zm, accessor, n + 1, "");
+                emitDecodeSingleMember(zm, accessor, n + 1);
 
                 for (n = 0; n < zm.dimensions.size(); ++n)
                     emit(zm.dimensions.size() - n, "end");
-
-
-                /* TODO: probably can make use of decoding more than 1 element at once for prims
-                // last dimension.
-                auto& lastDim = zm.dimensions[zm.dimensions.size()-1];
-                bool lastDimFixedLen = (lastDim.mode == ZCM_CONST);
-
-                if (ZCMGen::isPrimitiveType(zm.type.fullname) &&
-                    zm.type.fullname != "string") {
-                    // member is a primitive non-string type.  Emit code to
-                    // decode a full array in one call to struct.unpack
-                    if(n == 0) {
-                        accessor += " = ";
-                    } else {
-                        accessor += ".append(";
-                    }
-
-                    emitDecodeListMember(zm, accessor, n + 1, n==0,
-                                         lastDim.size, lastDimFixedLen);
-                }
-                */
             }
         }
-        emit(1, "return msg");
+        flushScalars();
+
+        emit(1, "return msg, pos");
         emit(0, "end");
         emit(0, "");
     }
@@ -685,11 +716,11 @@ struct EmitJuliaType : public Emitter
         auto* sn = zs.structname.shortname.c_str();
 
         emit(0, "function ZCM.decode(::Type{%s}, data::Vector{UInt8})", sn);
-        emit(1,     "buf = IOBuffer(data)");
-        emit(1,     "if ntoh(reinterpret(Int64, read(buf, 8))[1]) != ZCM.getHash(%s)", sn);
+        emit(1,     "ZCM._check_bounds(data, 1, 8)");
+        emit(1,     "if ntoh(ZCM._load(Int64, data, 1)) != ZCM.getHash(%s)", sn);
         emit(2,         "throw(\"Decode error\")");
         emit(1,     "end");
-        emit(1,     "return ZCM._decode_one(%s, buf)", sn);
+        emit(1,     "return ZCM._decode_one(%s, data, 9)[1]", sn);
         emit(0, "end");
         emit(0, "");
     }
@@ -9,12 +9,17 @@ using std::to_string;
 #include <queue>
 using std::queue;
 
+#include <map>
+using std::map;
+
 #include <iostream>
 using std::cerr;
 
 void setupOptionsPython(GetOpt& gopt)
 {
     gopt.addString(0, "ppath", "", "Python destination directory");
+    gopt.addBool(  0, "python-numpy", 0, "Decode arrays of numbers into numpy arrays (array.array "
+                                         "when numpy is not installed)");
 }
 
 static char getStructFormat(const ZCMMember& zm)
@@ -31,13 +36,34 @@ static char getStructFormat(const ZCMMember& zm)
     return 0;
 }
 
+// numpy dtype and array.array typecode of a primitive array element
+static const char* getNumpyDtype(const ZCMMember& zm)
+{
+    auto& tn = zm.type.fullname;
+    if (tn == "boolean") return "?";
+    if (tn == "int8_t")  return "i1";
+    if (tn == "int16_t") return ">i2";
+    if (tn == "int32_t") return ">i4";
+    if (tn == "int64_t") return ">i8";
+    if (tn == "float")   return ">f4";
+    if (tn == "double")  return ">f8";
+    return nullptr;
+}
+
 struct PyEmitStruct : public Emitter
 {
     const ZCMGen& zcm;
     const ZCMStruct& zs;
+    bool numpy;
+
+    // struct.Struct objects for runs of primitive members, by format
+    map<string, string> structNames;
 
     PyEmitStruct(const ZCMGen& zcm, const ZCMStruct& zs, const string& fname):
-        Emitter(fname), zcm(zcm), zs(zs) {}
+        Emitter(fname), zcm(zcm), zs(zs), numpy(zcm.gopt->getBool("python-numpy")) {}
+
+    bool isNumberArray(const ZCMMember& zm) const
+    { return zm.dimensions.size() > 0 && getNumpyDtype(zm) != nullptr; }
 
     void emitStruct()
     {
@@ -55,7 +81,13 @@ struct PyEmitStruct : public Emitter
              "    from io import BytesIO\n"
              "import struct\n");
 
+        bool hasNumberArrays = false;
+        for (auto& zm : zs.members)
+            if (isNumberArray(zm)) hasNumberArrays = true;
+        if (numpy && hasNumberArrays) emitArrayHelpers();
+
         emitPythonDependencies();
+        emitStructFormats();
 
         emit(0, "class %s(object):", sn);
         emitStart(0, "    __slots__ = [");
@@ -83,6 +115,79 @@ struct PyEmitStruct : public Emitter
         emitPythonFingerprint();
     }
 
+    void emitArrayHelpers()
+    {
+        emit(0, "try:");
+        emit(0, "    import numpy");
+        emit(0, "except ImportError:");
+        emit(0, "    numpy = None");
+        emit(0, "import array");
+        emit(0, "import sys");
+        emit(0, "");
+        emit(0, "def _decode_array(data, dtype, code, shape):");
+        emit(1,     "if numpy is not None:");
+        emit(2,         "return numpy.frombuffer(data, dtype).reshape(shape)");
+        emit(1,     "values = array.array(code, data)");
+        emit(1,     "if sys.byteorder == 'little' and values.itemsize > 1:");
+        emit(2,         "values.byteswap()");
+        emit(1,     "if dtype == '?':");
+        emit(2,         "values = [v != 0 for v in values]");
+        emit(1,     "for n in reversed(shape[1:]):");
+        emit(2,         "values = [values[i:i + n] for i in range(0, len(values), n)]");
+        emit(1,     "return values");
+        emit(0, "");
+        // Like struct.pack, refuse arrays that do not match their dimensions rather than
+        // encode a message that is short or truncated
+        emit(0, "def _encode_array(values, dtype, code, shape):");
+        emit(1,     "if numpy is not None:");
+        emit(2,         "try:");
+        emit(3,             "values = numpy.asarray(values, dtype)");
+        emit(2,         "except ValueError as e:");
+        emit(3,             "raise struct.error(str(e))");
+        emit(2,         "if values.shape != tuple(shape):");
+        emit(3,             "raise struct.error('array of shape %%s where %%s is expected' %% "
+                                               "(values.shape, tuple(shape)))");
+        emit(2,         "return values.tobytes()");
+        emit(1,     "rows = [values]");
+        emit(1,     "for d, n in enumerate(shape):");
+        emit(2,         "for r in rows:");
+        emit(3,             "if len(r) != n:");
+        emit(4,                 "raise struct.error('dimension %%d has %%d elements where %%d are "
+                                                   "expected' %% (d, len(r), n))");
+        emit(2,         "if d < len(shape) - 1:");
+        emit(3,             "rows = [row for r in rows for row in r]");
+        emit(1,     "values = array.array(code)");
+        emit(1,     "for r in rows:");
+        emit(2,         "values.extend(r)");
+        emit(1,     "if sys.byteorder == 'little' and values.itemsize > 1:");
+        emit(2,         "values.byteswap()");
+        emit(1,     "return values.tobytes()");
+        emit(0, "");
+    }
+
+    // One precompiled struct.Struct per run of primitive members, shared by encode and decode
+    void emitStructFormats()
+    {
+        string fmt;
+        auto flush = [&]() {
+            if (fmt.empty() || structNames.count(fmt)) {
+                fmt.clear();
+                return;
+            }
+            string name = "_struct" + to_string(structNames.size());
+            emit(0, "%s = struct.Struct(\">%s\")", name.c_str(), fmt.c_str());
+            structNames[fmt] = name;
+            fmt.clear();
+        };
+        for (auto& zm : zs.members) {
+            char f = getStructFormat(zm);
+            if (f && zm.dimensions.size() == 0) fmt += f;
+            else flush();
+        }
+        flush();
+        if (!structNames.empty()) emit(0, "");
+    }
+
     void emitDecodeOne(const ZCMMember& zm, const string& accessor_, int indent, const string& sfx_)
     {
         auto& tn = zm.type.fullname;
@@ -133,15 +238,21 @@ struct PyEmitStruct : public Emitter
         if (tn == "byte") {
             emit(indent, "%sbuf.read(%s%s)%s",
                   accessor, fixedLen ? "" : "self.", len, suffix);
+        } else if (numpy) {
+            string n = fixedLen ? len_ : "self." + len_;
+            int size = ZCMGen::getPrimitiveTypeSize(tn);
+            emit(indent, "%s_decode_array(buf.read(%s%s), '%s', '%c', (%s,))%s",
+                 accessor, n.c_str(), size > 1 ? (" * " + to_string(size)).c_str() : "",
+                 getNumpyDtype(zm), getStructFormat(zm), n.c_str(), suffix);
         } else if (tn == "boolean") {
             if(fixedLen) {
-                emit(indent, "%smap(bool, struct.unpack('>%s%c', buf.read(%d)))%s",
+                emit(indent, "%slist(map(bool, struct.unpack('>%s%c', buf.read(%d))))%s",
                      accessor, len, getStructFormat(zm),
                      atoi(len) * ZCMGen::getPrimitiveTypeSize(tn),
                      suffix);
             } else {
                 emit(indent,
-                     "%smap(bool, struct.unpack('>%%d%c' %% self.%s, buf.read(self.%s)))%s",
+                     "%slist(map(bool, struct.unpack('>%%d%c' %% self.%s, buf.read(self.%s))))%s",
                      accessor, getStructFormat(zm), len, len, suffix);
             }
         } else if (tn == "int8_t" || tn == "int16_t" || tn == "int32_t" || tn == "int64_t" ||
@@ -173,6 +284,13 @@ struct PyEmitStruct : public Emitter
         if (nfmts == 0)
             return;
 
+        string fmt;
+        while (formats.size() > 0) {
+            fmt += (char) formats.front();
+            formats.pop();
+        }
+
+        vector<const ZCMMember*> bools;
         emitStart(0, "        ");
         int fmtsize = 0;
         while (members.size() > 0) {
@@ -181,19 +299,37 @@ struct PyEmitStruct : public Emitter
             if (members.size() > 0)
                 emitContinue (", ");
             fmtsize += ZCMGen::getPrimitiveTypeSize(zm->type.fullname);
+            if (zm->type.fullname == "boolean") bools.push_back(zm);
         }
-        emitContinue (" = struct.unpack(\">");
-        while (formats.size() > 0) {
-            int f = formats.front(); formats.pop();
-            emitContinue("%c", f);
-        }
-        emitEnd("\", buf.read(%d))%s", fmtsize, nfmts == 1 ? "[0]" : "");
+        emitEnd(" = %s.unpack(buf.read(%d))%s",
+                structNames.at(fmt).c_str(), fmtsize, nfmts == 1 ? "[0]" : "");
+        for (auto* zm : bools)
+            emit(2, "self.%s = bool(self.%s)", zm->membername.c_str(), zm->membername.c_str());
+    }
+
+    static bool hasConstInnerDims(const ZCMMember& zm)
+    {
+        for (size_t i = 1; i < zm.dimensions.size(); ++i)
+            if (zm.dimensions[i].mode != ZCM_CONST) return false;
+        return true;
+    }
+
+    // Python tuple of the array's dimensions
+    static string arrayShape(const ZCMMember& zm)
+    {
+        string shape;
+        for (auto& dim : zm.dimensions)
+            shape += (shape.empty() ? "" : ", ") +
+                     (dim.mode == ZCM_CONST ? dim.size : "self." + dim.size);
+        return "(" + shape + (zm.dimensions.size() == 1 ? ",)" : ")");
     }
 
     void emitPythonDecodeOne()
     {
+        // Every member is assigned below, so skip __init__ and its default values
         emit(1, "def _decode_one(buf):");
-        emit(2, "self = %s()", zs.structname.shortname.c_str());
+        emit(2, "self = %s.__new__(%s)",
+             zs.structname.shortname.c_str(), zs.structname.shortname.c_str());
 
         std::queue<int> structFmt;
         std::queue<const ZCMMember*> structMembers;
@@ -202,7 +338,7 @@ struct PyEmitStruct : public Emitter
             char fmt = getStructFormat(zm);
 
             if (zm.dimensions.size() == 0) {
-                if (fmt && zm.type.fullname != "boolean") {
+                if (fmt) {
                     structFmt.push((int)fmt);
                     structMembers.push(&zm);
                 } else {
@@ -210,6 +346,18 @@ struct PyEmitStruct : public Emitter
                     string accessor = "self." + zm.membername + " = ";
                     emitDecodeOne(zm, accessor.c_str(), 2, "");
                 }
+            } else if (numpy && isNumberArray(zm) && hasConstInnerDims(zm)) {
+                // the whole array is one contiguous block
+                flushReadStructFmt(structFmt, structMembers);
+                string count;
+                for (auto& dim : zm.dimensions)
+                    count += (dim.mode == ZCM_CONST ? dim.size : "self." + dim.size) + " * ";
+                int size = ZCMGen::getPrimitiveTypeSize(zm.type.fullname);
+                if (size > 1) count += to_string(size);
+                else          count.resize(count.size() - 3);
+                emit(2, "self.%s = _decode_array(buf.read(%s), '%s', '%c', %s)",
+                     zm.membername.c_str(), count.c_str(),
+                     getNumpyDtype(zm), getStructFormat(zm), arrayShape(zm).c_str());
             } else {
                 flushReadStructFmt(structFmt, structMembers);
                 string accessor = "self." + zm.membername;
@@ -342,6 +490,10 @@ struct PyEmitStruct : public Emitter
             emit(indent, "buf.write(bytearray(%s[:%s%s]))",
                  accessor, (fixedLen ? "" : "self."), len);
             return;
+        } else if (numpy) {
+            emit(indent, "buf.write(_encode_array(%s, '%s', '%c', (%s%s,)))",
+                 accessor, getNumpyDtype(zm), getStructFormat(zm),
+                 (fixedLen ? "" : "self."), len);
         } else if (tn == "boolean" || tn == "int8_t" || tn == "int16_t" || tn == "int32_t" ||
                    tn == "int64_t" || tn == "float"  || tn == "double") {
             if (fixedLen) {
@@ -363,12 +515,13 @@ struct PyEmitStruct : public Emitter
         if (nfmts == 0)
             return;
 
-        emitStart(2, "buf.write(struct.pack(\">");
+        string fmt;
         while (formats.size() > 0) {
-            int f = formats.front(); formats.pop();
-            emitContinue("%c", f);
+            fmt += (char) formats.front();
+            formats.pop();
         }
-        emitContinue ("\", ");
+
+        emitStart(2, "buf.write(%s.pack(", structNames.at(fmt).c_str());
         while (members.size() > 0) {
             auto* zm = members.front(); members.pop();
             emitContinue("self.%s", zm->membername.c_str());
@@ -399,6 +552,11 @@ struct PyEmitStruct : public Emitter
                     flushWriteStructFmt(structFmt, structMembers);
                     emitEncodeOne (zm, "self."+zm.membername, 2);
                 }
+            } else if (numpy && isNumberArray(zm) && hasConstInnerDims(zm)) {
+                flushWriteStructFmt(structFmt, structMembers);
+                emit(2, "buf.write(_encode_array(self.%s, '%s', '%c', %s))",
+                     zm.membername.c_str(), getNumpyDtype(zm), getStructFormat(zm),
+                     arrayShape(zm).c_str());
             } else {
                 flushWriteStructFmt(structFmt, structMembers);
                 string accessor = "self." + zm.membername;
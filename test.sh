@@ -21,7 +21,13 @@ run   coretest        ./build/test/zcm/coretest
 run   sub-unsub-c     ./build/test/zcm/sub_unsub_c
 run   sub-unsub-cpp   ./build/test/zcm/sub_unsub_cpp
 run   api-retcodes    ./build/test/zcm/api_retcodes
+run   arena-pubsub    ./build/test/zcm/arena_pubsub
+run   fixed-containers ./build/test/zcm/fixed_containers
+run   type-registry   ./build/test/zcm/type_registry
+run   type-desc       ./build/test/zcm/type_desc
+run   exporter-roundtrip ./build/test/zcm/exporter_roundtrip
 run   dispatch-loop   ./build/test/zcm/dispatch_loop
+run   dispatch-pool   ./build/test/zcm/dispatch_pool
 run   forking         ./build/test/zcm/forking
 run   forking2        ./build/test/zcm/forking2
 run   flushing        ./build/test/zcm/flushing
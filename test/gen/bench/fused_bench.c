@@ -0,0 +1,152 @@
+#include "bench/wide_t.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Compares the generated wide_t encode/decode, which converts runs of primitive members
+ * under a single bounds check, against the same conversions done one member at a time
+ * with a check and offset update after each, as zcm-gen used to generate them. */
+
+#define NITER   200000
+#define NROUNDS 10
+
+#define FOR_EACH_V(X) \
+    X(v0)  X(v1)  X(v2)  X(v3)  X(v4)  X(v5)  X(v6)  X(v7)  X(v8)  X(v9)  \
+    X(v10) X(v11) X(v12) X(v13) X(v14) X(v15) X(v16) X(v17) X(v18) X(v19) \
+    X(v20) X(v21) X(v22) X(v23) X(v24) X(v25) X(v26) X(v27) X(v28) X(v29)
+
+#define STEP(call) \
+    thislen = call; \
+    if (thislen < 0) return thislen; else pos += thislen;
+
+static int encode_per_member(void* buf, uint32_t offset, uint32_t maxlen, const wide_t* p)
+{
+    uint32_t pos = 0;
+    int thislen, a;
+    int64_t hash = __wide_t_get_hash();
+
+    STEP(__int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1));
+    STEP(__int64_t_encode_array(buf, offset + pos, maxlen - pos, &p->utime, 1));
+    STEP(__int32_t_encode_array(buf, offset + pos, maxlen - pos, &p->seq, 1));
+#define ENCODE_V(v) STEP(__double_encode_array(buf, offset + pos, maxlen - pos, &p->v, 1));
+    FOR_EACH_V(ENCODE_V)
+    STEP(__int16_t_encode_array(buf, offset + pos, maxlen - pos, &p->status, 1));
+    STEP(__boolean_encode_array(buf, offset + pos, maxlen - pos, &p->valid, 1));
+    for (a = 0; a < 6; ++a) {
+        STEP(__float_encode_array(buf, offset + pos, maxlen - pos, p->cov[a], 6));
+    }
+    return pos;
+}
+
+static int decode_per_member(const void* buf, uint32_t offset, uint32_t maxlen, wide_t* p)
+{
+    uint32_t pos = 0;
+    int thislen, a;
+    int64_t hash;
+
+    STEP(__int64_t_decode_array(buf, offset + pos, maxlen - pos, &hash, 1));
+    if (hash != __wide_t_get_hash()) return -1;
+    STEP(__int64_t_decode_array(buf, offset + pos, maxlen - pos, &p->utime, 1));
+    STEP(__int32_t_decode_array(buf, offset + pos, maxlen - pos, &p->seq, 1));
+#define DECODE_V(v) STEP(__double_decode_array(buf, offset + pos, maxlen - pos, &p->v, 1));
+    FOR_EACH_V(DECODE_V)
+    STEP(__int16_t_decode_array(buf, offset + pos, maxlen - pos, &p->status, 1));
+    STEP(__boolean_decode_array(buf, offset + pos, maxlen - pos, &p->valid, 1));
+    for (a = 0; a < 6; ++a) {
+        STEP(__float_decode_array(buf, offset + pos, maxlen - pos, p->cov[a], 6));
+    }
+    return pos;
+}
+
+static double min(double a, double b) { return a < b ? a : b; }
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* Keeps the compiler from optimizing the loops away */
+static volatile int sink;
+
+static void report(const char* what, double fused, double perMember)
+{
+    printf("%-7s fused %6.1f ns/msg   per member %6.1f ns/msg   speedup %.2fx\n",
+           what, fused * 1e9 / NITER, perMember * 1e9 / NITER, perMember / fused);
+}
+
+int main()
+{
+    static uint8_t fusedBuf[1024], refBuf[1024];
+    wide_t msg, out;
+    int i, r, c, len, refLen;
+    double start, fusedTime, refTime;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.utime = 1234567890;
+    msg.seq = 42;
+#define FILL_V(v) msg.v = i++ * 0.25;
+    i = 0;
+    FOR_EACH_V(FILL_V)
+    msg.status = -3;
+    msg.valid = 1;
+    for (r = 0; r < 6; ++r)
+        for (c = 0; c < 6; ++c)
+            msg.cov[r][c] = r == c ? 1.0f : 0.01f * (r + c);
+
+    len = wide_t_encode(fusedBuf, 0, sizeof(fusedBuf), &msg);
+    refLen = encode_per_member(refBuf, 0, sizeof(refBuf), &msg);
+    if (len != wide_t_encoded_size(&msg) || len != refLen || memcmp(fusedBuf, refBuf, len) != 0) {
+        fprintf(stderr, "Fused and per member encodings differ\n");
+        return 1;
+    }
+    if (wide_t_encode(fusedBuf, 0, len - 1, &msg) >= 0 ||
+        wide_t_decode(fusedBuf, 0, len - 1, &out) >= 0) {
+        fprintf(stderr, "Fused conversion ignored maxlen\n");
+        return 1;
+    }
+    if (wide_t_decode(fusedBuf, 0, len, &out) != len || out.v29 != msg.v29 ||
+        out.cov[5][4] != msg.cov[5][4]) {
+        fprintf(stderr, "Fused decode failed\n");
+        return 1;
+    }
+
+    /* Best of a few rounds, alternating between the two, to keep noise out */
+    fusedTime = refTime = 1e9;
+    for (r = 0; r < NROUNDS; ++r) {
+        start = now();
+        for (i = 0; i < NITER; ++i) {
+            msg.seq = i;
+            sink = wide_t_encode(fusedBuf, 0, sizeof(fusedBuf), &msg);
+        }
+        fusedTime = min(fusedTime, now() - start);
+        start = now();
+        for (i = 0; i < NITER; ++i) {
+            msg.seq = i;
+            sink = encode_per_member(refBuf, 0, sizeof(refBuf), &msg);
+        }
+        refTime = min(refTime, now() - start);
+    }
+    report("encode", fusedTime, refTime);
+
+    fusedTime = refTime = 1e9;
+    for (r = 0; r < NROUNDS; ++r) {
+        start = now();
+        for (i = 0; i < NITER; ++i) {
+            fusedBuf[19] = i;
+            sink = wide_t_decode(fusedBuf, 0, len, &out);
+        }
+        fusedTime = min(fusedTime, now() - start);
+        start = now();
+        for (i = 0; i < NITER; ++i) {
+            refBuf[19] = i;
+            sink = decode_per_member(refBuf, 0, len, &out);
+        }
+        refTime = min(refTime, now() - start);
+    }
+    report("decode", fusedTime, refTime);
+
+    return 0;
+}
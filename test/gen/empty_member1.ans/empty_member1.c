@@ -0,0 +1,260 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#ifndef ZCM_EMBEDDED
+#include <stdio.h>
+#endif
+#include "empty_member1.h"
+
+static int __empty_member1_hash_computed = 0;
+static uint64_t __empty_member1_hash;
+
+uint64_t __empty_member1_hash_recursive(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __empty_member1_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__empty_member1_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x1486a47ad30423b3LL
+         + __empty_t_hash_recursive(&cp)
+         + __int32_t_hash_recursive(&cp)
+         + __empty_t_hash_recursive(&cp)
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __empty_member1_get_hash(void)
+{
+    if (!__empty_member1_hash_computed) {
+        __empty_member1_hash = (int64_t)__empty_member1_hash_recursive(NULL);
+        __empty_member1_hash_computed = 1;
+    }
+
+    return __empty_member1_hash;
+}
+
+int __empty_member1_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const empty_member1* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        thislen = __empty_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].e), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_encode_array(buf, offset + pos, maxlen - pos, &(p[element].val), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __empty_t_encode_array(buf, offset + pos, maxlen - pos, p[element].es, 3);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int empty_member1_encode(void* buf, uint32_t offset, uint32_t maxlen, const empty_member1* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __empty_member1_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __empty_member1_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __empty_member1_encoded_array_size(const empty_member1* p, uint32_t elements)
+{
+    uint32_t size = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        size += __empty_t_encoded_array_size(&(p[element].e), 1);
+
+        size += __int32_t_encoded_array_size(&(p[element].val), 1);
+
+        size += __empty_t_encoded_array_size(p[element].es, 3);
+
+    }
+    return size;
+}
+
+uint32_t empty_member1_encoded_size(const empty_member1* p)
+{
+    return 8 + __empty_member1_encoded_array_size(p, 1);
+}
+
+int __empty_member1_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, empty_member1* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+
+        thislen = __empty_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].e), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __int32_t_decode_array(buf, offset + pos, maxlen - pos, &(p[element].val), 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        thislen = __empty_t_decode_array(buf, offset + pos, maxlen - pos, p[element].es, 3);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+    }
+    return pos;
+}
+
+int __empty_member1_decode_array_cleanup(empty_member1* p, uint32_t elements)
+{
+    uint32_t element;
+    for (element = 0; element < elements; ++element) {
+
+        __empty_t_decode_array_cleanup(&(p[element].e), 1);
+
+        __int32_t_decode_array_cleanup(&(p[element].val), 1);
+
+        __empty_t_decode_array_cleanup(p[element].es, 3);
+
+    }
+    return 0;
+}
+
+int empty_member1_decode(const void* buf, uint32_t offset, uint32_t maxlen, empty_member1* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __empty_member1_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __empty_member1_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int empty_member1_decode_cleanup(empty_member1* p)
+{
+    return __empty_member1_decode_array_cleanup(p, 1);
+}
+
+uint32_t __empty_member1_clone_array(const empty_member1* p, empty_member1* q, uint32_t elements)
+{
+    uint32_t n = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+        n += __empty_t_clone_array(&(p[element].e), &(q[element].e), 1);
+
+        n += __int32_t_clone_array(&(p[element].val), &(q[element].val), 1);
+
+        n += __empty_t_clone_array(p[element].es, q[element].es, 3);
+
+    }
+    return n;
+}
+
+empty_member1* empty_member1_copy(const empty_member1* p)
+{
+    empty_member1* q = (empty_member1*) malloc(sizeof(empty_member1));
+    __empty_member1_clone_array(p, q, 1);
+    return q;
+}
+
+void empty_member1_destroy(empty_member1* p)
+{
+    __empty_member1_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int empty_member1_publish(zcm_t* zcm, const char* channel, const empty_member1* p)
+{
+      uint32_t max_data_size = empty_member1_encoded_size (p);
+      uint8_t* buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = empty_member1_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (zcm, channel, buf, (uint32_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _empty_member1_subscription_t {
+    empty_member1_handler_t user_handler;
+    void* userdata;
+    zcm_sub_t* z_sub;
+};
+static
+void empty_member1_handler_stub (const zcm_recv_buf_t* rbuf,
+                            const char* channel, void* userdata)
+{
+    int status;
+    empty_member1 p;
+    memset(&p, 0, sizeof(empty_member1));
+    status = empty_member1_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr, "error %d decoding empty_member1!!!\n", status);
+        #endif
+        return;
+    }
+
+    empty_member1_subscription_t* h = (empty_member1_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    empty_member1_decode_cleanup (&p);
+}
+
+empty_member1_subscription_t* empty_member1_subscribe (zcm_t* zcm,
+                    const char* channel,
+                    empty_member1_handler_t f, void* userdata)
+{
+    empty_member1_subscription_t* n = (empty_member1_subscription_t*)
+                       malloc(sizeof(empty_member1_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              empty_member1_handler_stub, n);
+    if (n->z_sub == NULL) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr,"couldn't reg empty_member1 ZCM handler!\n");
+        #endif
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int empty_member1_unsubscribe(zcm_t* zcm, empty_member1_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr,
+           "couldn't unsubscribe empty_member1_handler %p!\n", hid);
+        #endif
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,130 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <zcm/zcm_coretypes.h>
+#include <zcm/zcm.h>
+
+#ifndef _empty_member1_h
+#define _empty_member1_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "empty_t.h"
+#include "empty_t.h"
+typedef struct _empty_member1 empty_member1;
+struct _empty_member1
+{
+    empty_t    e;
+    int32_t    val;
+    empty_t    es[3];
+};
+
+/**
+ * Create a deep copy of a empty_member1.
+ * When no longer needed, destroy it with empty_member1_destroy()
+ */
+empty_member1* empty_member1_copy(const empty_member1* to_copy);
+
+/**
+ * Destroy an instance of empty_member1 created by empty_member1_copy()
+ */
+void empty_member1_destroy(empty_member1* to_destroy);
+
+/**
+ * Identifies a single subscription.  This is an opaque data type.
+ */
+typedef struct _empty_member1_subscription_t empty_member1_subscription_t;
+
+/**
+ * Prototype for a callback function invoked when a message of type
+ * empty_member1 is received.
+ */
+typedef void(*empty_member1_handler_t)(const zcm_recv_buf_t* rbuf,
+             const char* channel, const empty_member1* msg, void* userdata);
+
+/**
+ * Publish a message of type empty_member1 using ZCM.
+ *
+ * @param zcm The ZCM instance to publish with.
+ * @param channel The channel to publish on.
+ * @param msg The message to publish.
+ * @return 0 on success, <0 on error.  Success means ZCM has transferred
+ * responsibility of the message data to the OS.
+ */
+int empty_member1_publish(zcm_t* zcm, const char* channel, const empty_member1* msg);
+
+/**
+ * Subscribe to messages of type empty_member1 using ZCM.
+ *
+ * @param zcm The ZCM instance to subscribe with.
+ * @param channel The channel to subscribe to.
+ * @param handler The callback function invoked by ZCM when a message is received.
+ *                This function is invoked by ZCM during calls to zcm_handle() and
+ *                zcm_handle_timeout().
+ * @param userdata An opaque pointer passed to @p handler when it is invoked.
+ * @return pointer to subscription type, NULL if failure. Must clean up
+ *         dynamic memory by passing the pointer to empty_member1_unsubscribe.
+ */
+empty_member1_subscription_t* empty_member1_subscribe(zcm_t* zcm, const char* channel, empty_member1_handler_t handler, void* userdata);
+
+/**
+ * Removes and destroys a subscription created by empty_member1_subscribe()
+ */
+int empty_member1_unsubscribe(zcm_t* zcm, empty_member1_subscription_t* hid);
+/**
+ * Encode a message of type empty_member1 into binary form.
+ *
+ * @param buf The output buffer.
+ * @param offset Encoding starts at this byte offset into @p buf.
+ * @param maxlen Maximum number of bytes to write.  This should generally
+ *               be equal to empty_member1_encoded_size().
+ * @param msg The message to encode.
+ * @return The number of bytes encoded, or <0 if an error occured.
+ */
+int empty_member1_encode(void* buf, uint32_t offset, uint32_t maxlen, const empty_member1* p);
+
+/**
+ * Decode a message of type empty_member1 from binary form.
+ * When decoding messages containing strings or variable-length arrays, this
+ * function may allocate memory.  When finished with the decoded message,
+ * release allocated resources with empty_member1_decode_cleanup().
+ *
+ * @param buf The buffer containing the encoded message
+ * @param offset The byte offset into @p buf where the encoded message starts.
+ * @param maxlen The maximum number of bytes to read while decoding.
+ * @param msg Output parameter where the decoded message is stored
+ * @return The number of bytes decoded, or <0 if an error occured.
+ */
+int empty_member1_decode(const void* buf, uint32_t offset, uint32_t maxlen, empty_member1* msg);
+
+/**
+ * Release resources allocated by empty_member1_decode()
+ * @return 0
+ */
+int empty_member1_decode_cleanup(empty_member1* p);
+
+/**
+ * Check how many bytes are required to encode a message of type empty_member1
+ */
+uint32_t empty_member1_encoded_size(const empty_member1* p);
+
+// ZCM support functions. Users should not call these
+int64_t  __empty_member1_get_hash(void);
+uint64_t __empty_member1_hash_recursive(const __zcm_hash_ptr* p);
+int      __empty_member1_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const empty_member1* p, uint32_t elements);
+int      __empty_member1_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, empty_member1* p, uint32_t elements);
+int      __empty_member1_decode_array_cleanup(empty_member1* p, uint32_t elements);
+uint32_t __empty_member1_encoded_array_size(const empty_member1* p, uint32_t elements);
+uint32_t __empty_member1_clone_array(const empty_member1* p, empty_member1* q, uint32_t elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/** THIS IS AN AUTOMATICALLY GENERATED FILE.
+ *  DO NOT MODIFY BY HAND!!
+ *
+ *  Generated by zcm-gen
+ **/
+
+#include <zcm/zcm_coretypes.h>
+
+#ifndef __empty_member1_hpp__
+#define __empty_member1_hpp__
+
+#include "empty_t.hpp"
+#include "empty_t.hpp"
+
+
+class empty_member1
+{
+    public:
+        empty_t    e;
+
+        int32_t    val;
+
+        empty_t    es[3];
+
+    public:
+        #if __cplusplus > 199711L /* if c++11 */
+        /// The value of getHash()
+        static constexpr int64_t  ZCM_TYPE_HASH = (int64_t)0x6438b47a6d18aa86LL;
+        /// The value of getEncodedSize(), which is the same for every instance
+        static constexpr uint32_t ZCM_ENCODED_SIZE = 12;
+        #endif
+
+    public:
+        /**
+         * Destructs a message properly if anything inherits from it
+        */
+        virtual ~empty_member1() {}
+
+        /**
+         * Encode a message into binary form.
+         *
+         * @param buf The output buffer.
+         * @param offset Encoding starts at thie byte offset into @p buf.
+         * @param maxlen Maximum number of bytes to write.  This should generally be
+         *  equal to getEncodedSize().
+         * @return The number of bytes encoded, or <0 on error.
+         */
+        inline int encode(void* buf, uint32_t offset, uint32_t maxlen) const;
+
+        /**
+         * Check how many bytes are required to encode this message.
+         */
+        inline uint32_t getEncodedSize() const;
+
+        /**
+         * Decode a message from binary form into this instance.
+         *
+         * @param buf The buffer containing the encoded message.
+         * @param offset The byte offset into @p buf where the encoded message starts.
+         * @param maxlen The maximum number of bytes to reqad while decoding.
+         * @return The number of bytes decoded, or <0 if an error occured.
+         */
+        inline int decode(const void* buf, uint32_t offset, uint32_t maxlen);
+
+        /**
+         * Retrieve the 64-bit fingerprint identifying the structure of the message.
+         * Note that the fingerprint is the same for all instances of the same
+         * message type, and is a fingerprint on the message type definition, not on
+         * the message contents.
+         */
+        inline static int64_t getHash();
+
+        /**
+         * Returns "empty_member1"
+         */
+        inline static const char* getTypeName();
+
+        // ZCM support functions. Users should not call these
+        inline int      _encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const;
+        inline uint32_t _getEncodedSizeNoHash() const;
+        inline int      _decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen);
+        inline static uint64_t _computeHash(const __zcm_hash_ptr* p);
+};
+
+int empty_member1::encode(void* buf, uint32_t offset, uint32_t maxlen) const
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = (int64_t)getHash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if(thislen < 0) return thislen; else pos += thislen;
+
+    thislen = this->_encodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int empty_member1::decode(const void* buf, uint32_t offset, uint32_t maxlen)
+{
+    uint32_t pos = 0;
+    int thislen;
+
+    int64_t msg_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &msg_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (msg_hash != getHash()) return -1;
+
+    thislen = this->_decodeNoHash(buf, offset + pos, maxlen - pos);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t empty_member1::getEncodedSize() const
+{
+    return 12;
+}
+
+int64_t empty_member1::getHash()
+{
+    return (int64_t)0x6438b47a6d18aa86LL;
+}
+
+const char* empty_member1::getTypeName()
+{
+    return "empty_member1";
+}
+
+int empty_member1::_encodeNoHash(void* buf, uint32_t offset, uint32_t maxlen) const
+{
+    if(maxlen < 4) return -1;
+    uint8_t* run = (uint8_t*) buf + offset;
+
+    __int32_t_store(run + 0, this->val);
+
+    return 4;
+}
+
+int empty_member1::_decodeNoHash(const void* buf, uint32_t offset, uint32_t maxlen)
+{
+    if(maxlen < 4) return -1;
+    const uint8_t* run = (const uint8_t*) buf + offset;
+
+    this->val = __int32_t_load(run + 0);
+
+    return 4;
+}
+
+uint32_t empty_member1::_getEncodedSizeNoHash() const
+{
+    return 4;
+}
+
+uint64_t empty_member1::_computeHash(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for(fp = p; fp != NULL; fp = fp->parent)
+        if(fp->v == empty_member1::getHash)
+            return 0;
+    const __zcm_hash_ptr cp = { p, (void*)empty_member1::getHash };
+
+    uint64_t hash = (uint64_t)0x1486a47ad30423b3LL +
+         empty_t::_computeHash(&cp) +
+         empty_t::_computeHash(&cp);
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+#endif
@@ -0,0 +1,219 @@
+// THIS IS AN AUTOMATICALLY GENERATED FILE.
+// DO NOT MODIFY BY HAND!!
+//
+// Generated by zcm-gen
+
+#include <string.h>
+#ifndef ZCM_EMBEDDED
+#include <stdio.h>
+#endif
+#include "empty_t.h"
+
+static int __empty_t_hash_computed = 0;
+static uint64_t __empty_t_hash;
+
+uint64_t __empty_t_hash_recursive(const __zcm_hash_ptr* p)
+{
+    const __zcm_hash_ptr* fp;
+    for (fp = p; fp != NULL; fp = fp->parent)
+        if (fp->v == __empty_t_get_hash)
+            return 0;
+
+    __zcm_hash_ptr cp;
+    cp.parent =  p;
+    cp.v = (void*)__empty_t_get_hash;
+    (void) cp;
+
+    uint64_t hash = (uint64_t)0x07656d7098e20c64LL
+        ;
+
+    return (hash<<1) + ((hash>>63)&1);
+}
+
+int64_t __empty_t_get_hash(void)
+{
+    if (!__empty_t_hash_computed) {
+        __empty_t_hash = (int64_t)__empty_t_hash_recursive(NULL);
+        __empty_t_hash_computed = 1;
+    }
+
+    return __empty_t_hash;
+}
+
+int __empty_t_encode_array(void* buf, uint32_t offset, uint32_t maxlen, const empty_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+
+    for (element = 0; element < elements; ++element) {
+
+    }
+    return pos;
+}
+
+int empty_t_encode(void* buf, uint32_t offset, uint32_t maxlen, const empty_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __empty_t_get_hash();
+
+    thislen = __int64_t_encode_array(buf, offset + pos, maxlen - pos, &hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    thislen = __empty_t_encode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+uint32_t __empty_t_encoded_array_size(const empty_t* p, uint32_t elements)
+{
+    uint32_t size = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+    }
+    return size;
+}
+
+uint32_t empty_t_encoded_size(const empty_t* p)
+{
+    return 8 + __empty_t_encoded_array_size(p, 1);
+}
+
+int __empty_t_decode_array(const void* buf, uint32_t offset, uint32_t maxlen, empty_t* p, uint32_t elements)
+{
+    uint32_t pos = 0, element;
+
+    for (element = 0; element < elements; ++element) {
+
+    }
+    return pos;
+}
+
+int __empty_t_decode_array_cleanup(empty_t* p, uint32_t elements)
+{
+    uint32_t element;
+    for (element = 0; element < elements; ++element) {
+
+    }
+    return 0;
+}
+
+int empty_t_decode(const void* buf, uint32_t offset, uint32_t maxlen, empty_t* p)
+{
+    uint32_t pos = 0;
+    int thislen;
+    int64_t hash = __empty_t_get_hash();
+
+    int64_t this_hash;
+    thislen = __int64_t_decode_array(buf, offset + pos, maxlen - pos, &this_hash, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+    if (this_hash != hash) return -1;
+
+    thislen = __empty_t_decode_array(buf, offset + pos, maxlen - pos, p, 1);
+    if (thislen < 0) return thislen; else pos += thislen;
+
+    return pos;
+}
+
+int empty_t_decode_cleanup(empty_t* p)
+{
+    return __empty_t_decode_array_cleanup(p, 1);
+}
+
+uint32_t __empty_t_clone_array(const empty_t* p, empty_t* q, uint32_t elements)
+{
+    uint32_t n = 0, element;
+    for (element = 0; element < elements; ++element) {
+
+    }
+    return n;
+}
+
+empty_t* empty_t_copy(const empty_t* p)
+{
+    empty_t* q = (empty_t*) malloc(sizeof(empty_t));
+    __empty_t_clone_array(p, q, 1);
+    return q;
+}
+
+void empty_t_destroy(empty_t* p)
+{
+    __empty_t_decode_array_cleanup(p, 1);
+    free(p);
+}
+
+int empty_t_publish(zcm_t* zcm, const char* channel, const empty_t* p)
+{
+      uint32_t max_data_size = empty_t_encoded_size (p);
+      uint8_t* buf = (uint8_t*) malloc (max_data_size);
+      if (!buf) return -1;
+      int data_size = empty_t_encode (buf, 0, max_data_size, p);
+      if (data_size < 0) {
+          free (buf);
+          return data_size;
+      }
+      int status = zcm_publish (zcm, channel, buf, (uint32_t)data_size);
+      free (buf);
+      return status;
+}
+
+struct _empty_t_subscription_t {
+    empty_t_handler_t user_handler;
+    void* userdata;
+    zcm_sub_t* z_sub;
+};
+static
+void empty_t_handler_stub (const zcm_recv_buf_t* rbuf,
+                            const char* channel, void* userdata)
+{
+    int status;
+    empty_t p;
+    memset(&p, 0, sizeof(empty_t));
+    status = empty_t_decode (rbuf->data, 0, rbuf->data_size, &p);
+    if (status < 0) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr, "error %d decoding empty_t!!!\n", status);
+        #endif
+        return;
+    }
+
+    empty_t_subscription_t* h = (empty_t_subscription_t*) userdata;
+    h->user_handler (rbuf, channel, &p, h->userdata);
+
+    empty_t_decode_cleanup (&p);
+}
+
+empty_t_subscription_t* empty_t_subscribe (zcm_t* zcm,
+                    const char* channel,
+                    empty_t_handler_t f, void* userdata)
+{
+    empty_t_subscription_t* n = (empty_t_subscription_t*)
+                       malloc(sizeof(empty_t_subscription_t));
+    n->user_handler = f;
+    n->userdata = userdata;
+    n->z_sub = zcm_subscribe (zcm, channel,
+                              empty_t_handler_stub, n);
+    if (n->z_sub == NULL) {
+        #ifndef ZCM_EMBEDDED
+        fprintf (stderr,"couldn't reg empty_t ZCM handler!\n");
+        #endif
+        free (n);
+        return NULL;
+    }
+    return n;
+}
+
+int empty_t_unsubscribe(zcm_t* zcm, empty_t_subscription_t* hid)
+{
+    int status = zcm_unsubscribe (zcm, hid->z_sub);
+    if (0 != status) {
+        #ifndef ZCM_EMBEDDED
+        fprintf(stderr,
+           "couldn't unsubscribe empty_t_handler %p!\n", hid);
+        #endif
+        return -1;
+    }
+    free (hid);
+    return 0;
+}
+
@@ -0,0 +1,111 @@
+/* ZCM type definition class file
+ * This file was automatically generated by zcm-gen
+ * DO NOT MODIFY BY HAND!!!!
+ */
+
+package zcmtypes;
+ 
+import java.io.*;
+import java.util.*;
+import zcm.zcm.*;
+ 
+public final class empty_member1 implements zcm.zcm.ZCMEncodable
+{
+    public zcmtypes.empty_t e;
+    public int val;
+    public zcmtypes.empty_t es[];
+ 
+    public empty_member1()
+    {
+        es = new zcmtypes.empty_t[3];
+    }
+ 
+    public static final long ZCM_FINGERPRINT;
+    public static final long ZCM_FINGERPRINT_BASE = 0x1486a47ad30423b3L;
+ 
+    static {
+        ZCM_FINGERPRINT = _hashRecursive(new ArrayList<Class<?>>());
+    }
+ 
+    public static long _hashRecursive(ArrayList<Class<?>> classes)
+    {
+        if (classes.contains(zcmtypes.empty_member1.class))
+            return 0L;
+ 
+        classes.add(zcmtypes.empty_member1.class);
+        long hash = ZCM_FINGERPRINT_BASE
+             + zcmtypes.empty_t._hashRecursive(classes)
+             + zcmtypes.empty_t._hashRecursive(classes)
+            ;
+        classes.remove(classes.size() - 1);
+        return (hash<<1) + ((hash>>>63)&1);
+    }
+ 
+    public void encode(DataOutput outs) throws IOException
+    {
+        outs.writeLong(ZCM_FINGERPRINT);
+        _encodeRecursive(outs);
+    }
+ 
+    public void _encodeRecursive(DataOutput outs) throws IOException
+    {
+        this.e._encodeRecursive(outs); 
+ 
+        outs.writeInt(this.val); 
+ 
+        for (int a = 0; a < 3; ++a) {
+            this.es[a]._encodeRecursive(outs); 
+        }
+ 
+    }
+ 
+    public empty_member1(byte[] data) throws IOException
+    {
+        this(new ZCMDataInputStream(data));
+    }
+ 
+    public empty_member1(DataInput ins) throws IOException
+    {
+        if (ins.readLong() != ZCM_FINGERPRINT)
+            throw new IOException("ZCM Decode error: bad fingerprint");
+ 
+        _decodeRecursive(ins);
+    }
+ 
+    public static zcmtypes.empty_member1 _decodeRecursiveFactory(DataInput ins) throws IOException
+    {
+        zcmtypes.empty_member1 o = new zcmtypes.empty_member1();
+        o._decodeRecursive(ins);
+        return o;
+    }
+ 
+    public void _decodeRecursive(DataInput ins) throws IOException
+    {
+        this.e = zcmtypes.empty_t._decodeRecursiveFactory(ins);
+ 
+        this.val = ins.readInt();
+ 
+        this.es = new zcmtypes.empty_t[(int) 3];
+        for (int a = 0; a < 3; ++a) {
+            this.es[a] = zcmtypes.empty_t._decodeRecursiveFactory(ins);
+        }
+ 
+    }
+ 
+    public zcmtypes.empty_member1 copy()
+    {
+        zcmtypes.empty_member1 outobj = new zcmtypes.empty_member1();
+        outobj.e = this.e.copy();
+ 
+        outobj.val = this.val;
+ 
+        outobj.es = new zcmtypes.empty_t[(int) 3];
+        for (int a = 0; a < 3; ++a) {
+            outobj.es[a] = this.es[a].copy();
+        }
+ 
+        return outobj;
+    }
+ 
+}
+
@@ -0,0 +1,136 @@
+#include <zcm/zcm.h>
+#include <zcm/transport/generic_serial_transport.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Loopback benchmark of the generic serial transport framing: every byte the
+ * transport puts on the "wire" is handed straight back to it as received data.
+ * Also checks that the on-wire frame format has not changed. */
+
+#define MTU     4096
+#define BUFSIZE (4 * MTU)
+#define WIRESZ  (1 << 16)
+#define CHANNEL "LOOPBACK"
+#define N       200000
+
+static uint8_t wire[WIRESZ];
+static size_t  wireFront = 0;
+static size_t  wireBack = 0;
+
+static uint8_t captured[256];
+static size_t  ncaptured = 0;
+static int     capturing = 0;
+
+static size_t get(uint8_t* data, size_t nData, void* usr)
+{
+    size_t n = wireBack - wireFront;
+    if (n > nData) n = nData;
+    memcpy(data, wire + wireFront, n);
+    wireFront += n;
+    if (wireFront == wireBack) wireFront = wireBack = 0;
+    return n;
+}
+
+static size_t put(const uint8_t* data, size_t nData, void* usr)
+{
+    if (capturing) {
+        memcpy(captured + ncaptured, data, nData);
+        ncaptured += nData;
+        return nData;
+    }
+    if (wireFront > 0) {
+        memmove(wire, wire + wireFront, wireBack - wireFront);
+        wireBack -= wireFront;
+        wireFront = 0;
+    }
+    size_t n = WIRESZ - wireBack;
+    if (n > nData) n = nData;
+    memcpy(wire + wireBack, data, n);
+    wireBack += n;
+    return n;
+}
+
+static uint64_t utime(void* usr)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static const uint8_t goldenData[] = { 0x01, 0xcc, 0x02, 0xcc, 0xcc, 0xff, 0x00 };
+static const uint8_t goldenFrame[] = {
+    0xcc, 0x00, 0x03, 0x00, 0x00, 0x00, 0x07,  /* sync, chan_len, data_len */
+    0x41, 0xcc, 0xcc, 0x42,                    /* "A\xccB", escaped */
+    0x01, 0xcc, 0xcc, 0x02, 0xcc, 0xcc, 0xcc, 0xcc, 0xff, 0x00,
+    0x49, 0xb9,                                /* checksum */
+};
+
+static int check_golden(zcm_t* zcm, zcm_trans_t* trans)
+{
+    capturing = 1;
+    zcm_publish(zcm, "A\xcc" "B", goldenData, sizeof(goldenData));
+    serial_update_tx(trans);
+    capturing = 0;
+
+    if (ncaptured != sizeof(goldenFrame) || memcmp(captured, goldenFrame, ncaptured) != 0) {
+        size_t i;
+        printf("Frame format changed:");
+        for (i = 0; i < ncaptured; ++i) printf(" %02x", captured[i]);
+        printf("\n");
+        return 1;
+    }
+    return 0;
+}
+
+static size_t nrecv = 0;
+static size_t nbad = 0;
+static uint8_t* expected;
+
+static void handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    if (rbuf->data_size != MTU || memcmp(rbuf->data, expected, MTU) != 0) ++nbad;
+    ++nrecv;
+}
+
+int main(int argc, char* argv[])
+{
+    zcm_trans_t* trans = zcm_trans_generic_serial_create(get, put, NULL, utime, NULL,
+                                                         MTU, BUFSIZE);
+    zcm_t* zcm = zcm_create_trans(trans);
+    if (!zcm) {
+        printf("Failed to create the transport\n");
+        return 1;
+    }
+
+    if (check_golden(zcm, trans)) return 1;
+
+    /* Random payload, so about 1 in 256 bytes needs escaping */
+    size_t i;
+    expected = malloc(MTU);
+    srand(42);
+    for (i = 0; i < MTU; ++i) expected[i] = (uint8_t) rand();
+
+    zcm_subscribe(zcm, CHANNEL, handler, NULL);
+
+    uint64_t start = utime(NULL);
+    size_t nsent = 0;
+    while (nrecv < N) {
+        if (nsent < N && zcm_publish(zcm, CHANNEL, expected, MTU) == ZCM_EOK) ++nsent;
+        zcm_handle_nonblock(zcm);
+    }
+    uint64_t elapsed = utime(NULL) - start;
+
+    printf("%d msgs of %d bytes in %.3f s: %.1f MB/s\n", N, MTU, elapsed / 1e6,
+           (double) N * MTU / elapsed);
+
+    zcm_destroy(zcm);
+    free(expected);
+
+    if (nbad != 0) {
+        printf("%zu messages were corrupted\n", nbad);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Throughput and latency of the blocking inproc transport with many publishing threads.
+// Every message carries its publish time so the subscriber can measure the delay until
+// its handler runs.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "zcm/zcm.h"
+
+#define NMSGS 400000
+#define MSG_SIZE 64
+#define TIMEOUT_US 30000000
+
+using namespace std;
+
+static uint64_t nowNs()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static vector<uint64_t> latencies;
+static atomic<int> numrecv {0};
+
+static void handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    uint64_t sent;
+    memcpy(&sent, rbuf->data, sizeof(sent));
+    latencies[numrecv] = nowNs() - sent;
+    ++numrecv;
+}
+
+static void publisher(zcm_t* zcm, int nmsgs)
+{
+    uint8_t buf[MSG_SIZE] = {};
+    for (int i = 0; i < nmsgs; ) {
+        uint64_t now = nowNs();
+        memcpy(buf, &now, sizeof(now));
+        if (zcm_publish(zcm, "BENCH", buf, sizeof(buf)) == ZCM_EOK) ++i;
+        else usleep(10);
+    }
+}
+
+static int run(int npub)
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    if (!zcm) {
+        printf("Failed to create block-inproc\n");
+        return 1;
+    }
+    zcm_subscribe(zcm, "BENCH", handler, NULL);
+    zcm_start(zcm);
+
+    numrecv = 0;
+    latencies.assign(NMSGS, 0);
+    int total = NMSGS / npub * npub;
+
+    uint64_t start = nowNs();
+    vector<thread> pubs;
+    for (int i = 0; i < npub; ++i) pubs.emplace_back(publisher, zcm, total / npub);
+    for (auto& t : pubs) t.join();
+    while (numrecv < total && nowNs() - start < TIMEOUT_US * 1000ull) usleep(100);
+    uint64_t elapsed = nowNs() - start;
+
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+
+    if (numrecv < total) {
+        printf("%2d publishers: timed out (recv %d/%d)\n", npub, numrecv.load(), total);
+        return 1;
+    }
+
+    sort(latencies.begin(), latencies.begin() + total);
+    printf("%2d publishers: %9.0f msgs/s  latency p50 %8.1f us  p99 %8.1f us\n", npub,
+           total * 1e9 / elapsed,
+           latencies[total / 2] / 1e3, latencies[(size_t) total * 99 / 100] / 1e3);
+    return 0;
+}
+
+int main()
+{
+    int ret = 0;
+    for (int npub : { 1, 2, 4, 8, 16 }) ret |= run(npub);
+    return ret;
+}
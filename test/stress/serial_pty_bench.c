@@ -0,0 +1,150 @@
+#define _XOPEN_SOURCE 600
+#include <zcm/zcm.h>
+#include <zcm/transport/generic_serial_transport.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* Throughput and round trip latency of the serial transport over a pseudo terminal, so
+ * no hardware is needed. The far end of the pty runs the generic serial framing on a
+ * nonblocking zcm. Run once with the default tty reads and once with the I/O thread. */
+
+#define MTU   1024
+#define NMSGS 2000
+#define NPING 500
+#define TIMEOUT_US 20000000
+
+static int master = -1;
+
+static size_t get(uint8_t* data, size_t nData, void* usr)
+{
+    ssize_t n = read(master, data, nData);
+    return n < 0 ? 0 : (size_t) n;
+}
+
+static size_t put(const uint8_t* data, size_t nData, void* usr)
+{
+    ssize_t n = write(master, data, nData);
+    return n < 0 ? 0 : (size_t) n;
+}
+
+static uint64_t utime(void* usr)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static volatile int nrecv = 0;
+static volatile int npong = 0;
+
+static void data_handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    ++nrecv;
+}
+
+static void ping_handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    zcm_publish((zcm_t*) usr, "PONG", rbuf->data, rbuf->data_size);
+}
+
+static void pong_handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    ++npong;
+}
+
+static int cmp_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+    return x < y ? -1 : x > y;
+}
+
+static int run(const char* slave, const char* opts)
+{
+    char url[256];
+    snprintf(url, sizeof(url), "serial://%s?%s", slave, opts);
+
+    zcm_t* zcm = zcm_create(url);
+    if (!zcm) {
+        printf("Failed to create %s\n", url);
+        return 1;
+    }
+    zcm_trans_t* trans = zcm_trans_generic_serial_create(get, put, NULL, utime, NULL,
+                                                         MTU, 16 * MTU);
+    zcm_t* far = zcm_create_trans(trans);
+
+    nrecv = npong = 0;
+    zcm_subscribe(zcm, "DATA", data_handler, NULL);
+    zcm_subscribe(zcm, "PING", ping_handler, zcm);
+    zcm_subscribe(far, "PONG", pong_handler, NULL);
+    zcm_start(zcm);
+
+    uint8_t* buf = calloc(1, MTU);
+    int i, ret = 0;
+
+    /* Throughput: the far end streams as fast as the pty accepts */
+    uint64_t start = utime(NULL);
+    for (i = 0; i < NMSGS; ) {
+        if (zcm_publish(far, "DATA", buf, MTU) == ZCM_EOK) ++i;
+        serial_update_tx(trans);
+    }
+    while (nrecv < NMSGS && utime(NULL) - start < TIMEOUT_US) {
+        serial_update_tx(trans);
+        usleep(10);
+    }
+    uint64_t elapsed = utime(NULL) - start;
+
+    /* Latency: small messages bounced off the transport under test */
+    uint64_t rtt[NPING];
+    for (i = 0; i < NPING && ret == 0; ++i) {
+        uint64_t t0 = utime(NULL);
+        int want = npong + 1;
+        zcm_publish(far, "PING", buf, 8);
+        while (npong < want) {
+            zcm_handle_nonblock(far);
+            if (utime(NULL) - t0 > TIMEOUT_US) { ret = 1; break; }
+        }
+        rtt[i] = utime(NULL) - t0;
+    }
+
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+    zcm_destroy(far);
+    free(buf);
+
+    if (nrecv < NMSGS || ret != 0) {
+        printf("%-28s timed out (recv %d/%d, pongs %d/%d)\n",
+               opts, nrecv, NMSGS, npong, NPING);
+        return 1;
+    }
+
+    qsort(rtt, NPING, sizeof(rtt[0]), cmp_u64);
+    printf("%-28s %7.2f MB/s  rtt p50 %5lu us  p99 %5lu us\n", opts,
+           (double) NMSGS * MTU / elapsed,
+           (unsigned long) rtt[NPING / 2], (unsigned long) rtt[NPING * 99 / 100]);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    /* Keep the serial lock files out of /var/lock */
+    if (!getenv("ZCM_LOCK_DIR")) setenv("ZCM_LOCK_DIR", "/tmp", 1);
+
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        printf("Failed to open a pty: %s\n", strerror(errno));
+        return 1;
+    }
+    const char* slave = ptsname(master);
+
+    int ret = 0;
+    ret |= run(slave, "io_thread=false");
+    ret |= run(slave, "io_thread=true");
+
+    close(master);
+    return ret;
+}
@@ -0,0 +1,201 @@
+#include "zcm/zcm.h"
+#include "types/arena_t.h"
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_MSGS 100
+
+static int retval = 0;
+
+#define check(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        ++retval; \
+    } \
+} while(0)
+
+static char* names[] = { "alpha", "bravo", "charlie", "delta" };
+static char* labels[] = { "x", "yy", "zzz" };
+
+// Message i gets sizes that cycle, so decoding needs different amounts of memory
+static void fill(arena_t* msg, int i)
+{
+    int r, c, e, v;
+    msg->utime = i;
+    msg->rows = 1 + i % 3;
+    msg->cols = 1 + i % 5;
+    msg->grid = malloc(msg->rows * sizeof(double*));
+    for (r = 0; r < msg->rows; ++r) {
+        msg->grid[r] = malloc(msg->cols * sizeof(double));
+        for (c = 0; c < msg->cols; ++c) msg->grid[r][c] = i + r * 10 + c;
+    }
+    msg->num_names = i % 4;
+    msg->names = names;
+    msg->num_elems = i % 3;
+    msg->elems = malloc(3 * sizeof(arena_elem_t));
+    for (e = 0; e < msg->num_elems; ++e) {
+        msg->elems[e].label = labels[e];
+        msg->elems[e].num_values = e + i % 7;
+        msg->elems[e].values = malloc((e + 7) * sizeof(float));
+        for (v = 0; v < msg->elems[e].num_values; ++v) msg->elems[e].values[v] = i + v;
+    }
+}
+
+static void release(arena_t* msg)
+{
+    int r, e;
+    for (r = 0; r < msg->rows; ++r) free(msg->grid[r]);
+    free(msg->grid);
+    for (e = 0; e < msg->num_elems; ++e) free(msg->elems[e].values);
+    free(msg->elems);
+}
+
+static void verify(const arena_t* msg)
+{
+    int i = (int) msg->utime, r, c, e, v;
+    check(msg->rows == 1 + i % 3 && msg->cols == 1 + i % 5, "%d: bad grid size", i);
+    for (r = 0; r < msg->rows; ++r)
+        for (c = 0; c < msg->cols; ++c)
+            check(msg->grid[r][c] == i + r * 10 + c, "%d: bad grid[%d][%d]", i, r, c);
+    check(msg->num_names == i % 4, "%d: bad num_names", i);
+    for (e = 0; e < msg->num_names; ++e)
+        check(strcmp(msg->names[e], names[e]) == 0, "%d: bad name %d", i, e);
+    check(msg->num_elems == i % 3, "%d: bad num_elems", i);
+    for (e = 0; e < msg->num_elems; ++e) {
+        check(strcmp(msg->elems[e].label, labels[e]) == 0, "%d: bad label %d", i, e);
+        check(msg->elems[e].num_values == e + i % 7, "%d: bad num_values %d", i, e);
+        for (v = 0; v < msg->elems[e].num_values; ++v)
+            check(msg->elems[e].values[v] == i + v, "%d: bad value %d %d", i, e, v);
+    }
+}
+
+static int num_received = 0;
+static void handler(const zcm_recv_buf_t* rbuf, const char* channel,
+                    const arena_t* msg, void* usr)
+{
+    check(msg->utime == num_received, "received %d out of order", (int) msg->utime);
+    verify(msg);
+    ++num_received;
+}
+
+static void test_decode_arena()
+{
+    uint8_t buf[4096];
+    uint64_t block[16];
+    zcm_arena_t arena;
+    uint32_t size = 0;
+    int i;
+
+    // Start on a buffer that is too small, it is replaced at the first reset
+    zcm_arena_init(&arena, block, sizeof(block));
+
+    for (i = 0; i < 3 * NUM_MSGS; ++i) {
+        arena_t in, out;
+        fill(&in, i % NUM_MSGS);
+        int len = arena_t_encode(buf, 0, sizeof(buf), &in);
+        check(len > 0, "encode failed");
+        release(&in);
+
+        memset(&out, 0, sizeof(out));
+        check(arena_t_decode_arena(buf, 0, len, &out, &arena) == len, "decode_arena failed");
+        verify(&out);
+        zcm_arena_reset(&arena);
+
+        // Once every message size has been seen the block is big enough for all of them
+        if (i == NUM_MSGS) size = arena.size;
+        if (i > NUM_MSGS) check(arena.size == size, "arena grew in steady state");
+        check(arena.overflow == NULL, "arena kept overflow blocks");
+    }
+    check(arena.owned && arena.data != (uint8_t*) block, "arena never outgrew its buffer");
+
+    zcm_arena_destroy(&arena);
+}
+
+static void put_int32(uint8_t* p, int32_t v)
+{
+    p[0] = (uint8_t) (v >> 24);
+    p[1] = (uint8_t) (v >> 16);
+    p[2] = (uint8_t) (v >> 8);
+    p[3] = (uint8_t) v;
+}
+
+// Corrupt lengths fail the decode before the arena is asked for more than the message
+static void test_corrupt_lengths()
+{
+    uint8_t buf[4096], bad[4096];
+    zcm_arena_t arena;
+    arena_t in, out;
+    int i;
+
+    // rows 3, cols 1, names "alpha", 2 elems
+    fill(&in, 5);
+    int len = arena_t_encode(buf, 0, sizeof(buf), &in);
+    release(&in);
+    check(len > 0 && buf[19] == 3 && buf[51] == 1 && buf[55] == 6 && buf[65] == 2,
+          "unexpected encoding");
+
+    struct { int offset; int32_t value; } corrupt[] = {
+        { 16, 0x40000000 }, // rows
+        { 16, -1 },
+        { 20, 0x7fffffff }, // cols
+        { 48, 0x7fffffff }, // num_names
+        { 52, 0x7fffffff }, // length of names[0]
+        { 52, -6 },
+        { 62, 0x7fffffff }, // num_elems
+    };
+
+    zcm_arena_init(&arena, NULL, 0);
+    for (i = 0; i < (int) (sizeof(corrupt) / sizeof(corrupt[0])); ++i) {
+        memcpy(bad, buf, len);
+        put_int32(bad + corrupt[i].offset, corrupt[i].value);
+        memset(&out, 0, sizeof(out));
+        check(arena_t_decode_arena(bad, 0, len, &out, &arena) < 0,
+              "decoded a corrupt length at %d", corrupt[i].offset);
+        check(arena.needed <= (uint32_t) len * 2,
+              "corrupt length at %d asked the arena for %u bytes",
+              corrupt[i].offset, arena.needed);
+        zcm_arena_reset(&arena);
+    }
+    zcm_arena_destroy(&arena);
+}
+
+static void test_pubsub()
+{
+    int i;
+    zcm_t* zcm = zcm_create("block-inproc");
+    if (!zcm) {
+        fprintf(stderr, "Failed to create zcm\n");
+        ++retval;
+        return;
+    }
+
+    arena_t_subscription_t* sub = arena_t_subscribe(zcm, "ARENA", handler, NULL);
+    zcm_start(zcm);
+
+    for (i = 0; i < NUM_MSGS; ++i) {
+        arena_t msg;
+        fill(&msg, i);
+        while (arena_t_publish(zcm, "ARENA", &msg) != ZCM_EOK) usleep(1000);
+        release(&msg);
+    }
+
+    for (i = 0; i < 100 && num_received < NUM_MSGS; ++i) usleep(10000);
+    zcm_stop(zcm);
+    arena_t_unsubscribe(zcm, sub);
+    zcm_destroy(zcm);
+
+    check(num_received == NUM_MSGS, "received %d of %d messages", num_received, NUM_MSGS);
+}
+
+int main(int argc, const char* argv[])
+{
+    test_decode_arena();
+    test_corrupt_lengths();
+    test_pubsub();
+    if (retval == 0) printf("Success!\n");
+    return retval;
+}
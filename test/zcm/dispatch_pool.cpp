@@ -0,0 +1,466 @@
+// Test cases for per-subscription dispatch queues and multiple handler threads
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
+#include "zcm/zcm.h"
+#include "util/TimeUtil.hpp"
+
+#define NCHANNELS 8
+#define NMSGS 200
+#define NTHREADS 4
+static constexpr u64 TIMEOUT = 5000000; // 5 sec
+
+struct ChannelState
+{
+    uint32_t next = 0;
+    bool     outOfOrder = false;
+};
+
+static ChannelState chans[NCHANNELS];
+static std::atomic<int> numrecv {0};
+static std::atomic<int> numActive {0};
+static std::atomic<int> maxActive {0};
+
+static void handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    int active = ++numActive;
+    int prev = maxActive;
+    while (active > prev && !maxActive.compare_exchange_weak(prev, active)) {}
+
+    ChannelState* c = (ChannelState*) usr;
+    uint32_t seq;
+    memcpy(&seq, rbuf->data, sizeof(seq));
+    if (seq != c->next) c->outOfOrder = true;
+    c->next = seq + 1;
+
+    usleep(100);
+    --numActive;
+    ++numrecv;
+}
+
+static bool waitForAll(int n)
+{
+    u64 start = TimeUtil::utime();
+    while (numrecv < n) {
+        if (TimeUtil::utime() - start > TIMEOUT) return false;
+        usleep(1000);
+    }
+    return true;
+}
+
+static void publishAll(zcm_t* zcm)
+{
+    char channel[32];
+    for (uint32_t i = 0; i < NMSGS; ++i) {
+        for (int c = 0; c < NCHANNELS; ++c) {
+            snprintf(channel, sizeof(channel), "CHAN_%d", c);
+            while (zcm_publish(zcm, channel, (uint8_t*) &i, sizeof(i)) != ZCM_EOK)
+                usleep(100);
+        }
+    }
+}
+
+static int test_ordering()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    assert(zcm);
+
+    assert(zcm_set_dispatch_threads(zcm, NTHREADS) == ZCM_EOK);
+
+    char channel[32];
+    for (int c = 0; c < NCHANNELS; ++c) {
+        snprintf(channel, sizeof(channel), "CHAN_%d", c);
+        assert(zcm_subscribe(zcm, channel, handler, &chans[c]));
+    }
+
+    zcm_start(zcm);
+    assert(zcm_set_dispatch_threads(zcm, 1) == ZCM_EINVALID);
+
+    publishAll(zcm);
+    bool done = waitForAll(NCHANNELS * NMSGS);
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+
+    if (!done) {
+        printf("Received %d/%d\n", numrecv.load(), NCHANNELS * NMSGS);
+        return 1;
+    }
+    for (int c = 0; c < NCHANNELS; ++c) {
+        if (chans[c].outOfOrder) {
+            printf("Messages on CHAN_%d were dispatched out of order\n", c);
+            return 1;
+        }
+    }
+    if (maxActive < 2) {
+        printf("Handlers never ran concurrently\n");
+        return 1;
+    }
+    return 0;
+}
+
+static uint32_t arrivals[NCHANNELS * NMSGS];
+static std::atomic<int> numarrived {0};
+
+static void arrivalHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    uint32_t seq;
+    memcpy(&seq, rbuf->data, sizeof(seq));
+    arrivals[numarrived++] = seq * NCHANNELS + (uint32_t) (uintptr_t) usr;
+}
+
+// With the default single handler thread, messages on different channels are
+// handled in the order they arrived
+static int test_arrival_order()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    assert(zcm);
+
+    char channel[32];
+    for (int c = 0; c < NCHANNELS; ++c) {
+        snprintf(channel, sizeof(channel), "CHAN_%d", c);
+        assert(zcm_subscribe(zcm, channel, arrivalHandler, (void*) (uintptr_t) c));
+    }
+
+    // Everything is queued before the handler thread starts taking messages
+    publishAll(zcm);
+    zcm_start(zcm);
+    u64 start = TimeUtil::utime();
+    while (numarrived < NCHANNELS * NMSGS && TimeUtil::utime() - start < TIMEOUT) usleep(1000);
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+
+    if (numarrived != NCHANNELS * NMSGS) {
+        printf("Received %d/%d\n", numarrived.load(), NCHANNELS * NMSGS);
+        return 1;
+    }
+    for (int i = 0; i < NCHANNELS * NMSGS; ++i) {
+        if (arrivals[i] != (uint32_t) i) {
+            printf("Message %d was handled out of arrival order\n", i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static std::atomic<bool> release {false};
+static std::atomic<int> numkept {0};
+static uint8_t kept[16];
+
+static void blockingHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    while (!release) usleep(1000);
+    kept[numkept++] = rbuf->data[0];
+}
+
+// Publishes 11 messages to a subscription whose handler is stuck on the first one
+static void publishOverflow(zcm_t* zcm, const char* channel)
+{
+    release = false;
+    numkept = 0;
+    for (uint8_t i = 0; i < 11; ++i) {
+        zcm_publish(zcm, channel, &i, 1);
+        usleep(10000);
+    }
+    release = true;
+    usleep(100000);
+}
+
+static int test_drop_policy()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    assert(zcm);
+
+    assert(zcm_set_dispatch_threads(zcm, 2) == ZCM_EOK);
+    zcm_sub_opts_t opts = { 4, ZCM_QUEUE_DROP_OLDEST };
+    zcm_sub_t* sub = zcm_subscribe_opts(zcm, "DROP", blockingHandler, NULL, &opts);
+    assert(sub);
+
+    zcm_start(zcm);
+    publishOverflow(zcm, "DROP");
+
+    zcm_sub_stats_t stats;
+    assert(zcm_get_sub_stats(zcm, sub, &stats) == ZCM_EOK);
+
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+
+    if (numkept != 5 || kept[0] != 0 || kept[1] != 7 || kept[4] != 10) {
+        printf("Unexpected messages survived a depth 4 drop-oldest queue\n");
+        return 1;
+    }
+    if (stats.received != 11 || stats.dispatched != 5 || stats.dropped != 6 ||
+        stats.queued != 0 || stats.high_water != 4 || stats.depth != 4) {
+        printf("Unexpected subscription stats: recv %lu disp %lu drop %lu hw %u\n",
+               (unsigned long) stats.received, (unsigned long) stats.dispatched,
+               (unsigned long) stats.dropped, stats.high_water);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_keep_latest()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    assert(zcm);
+
+    // Default single handler thread; a slow subscription must not hold up a fast one
+    zcm_sub_t* slow = zcm_subscribe(zcm, "SLOW", blockingHandler, NULL);
+    assert(slow);
+    assert(zcm_set_sub_queue(zcm, slow, 0, ZCM_QUEUE_KEEP_LATEST) == ZCM_EOK);
+
+    zcm_start(zcm);
+    publishOverflow(zcm, "SLOW");
+
+    zcm_sub_stats_t stats;
+    assert(zcm_get_sub_stats(zcm, slow, &stats) == ZCM_EOK);
+
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+
+    if (numkept != 2 || kept[0] != 0 || kept[1] != 10) {
+        printf("Keep-latest subscription did not collapse to the newest message\n");
+        return 1;
+    }
+    if (stats.received != 11 || stats.dropped != 9 || stats.high_water != 1) {
+        printf("Unexpected keep-latest stats\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int numlatest = 0;
+static int numall = 0;
+static uint8_t lastlatest = 0;
+
+static void latestHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    ++numlatest;
+    lastlatest = rbuf->data[0];
+}
+
+static void allHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    ++numall;
+}
+
+static int test_nonblock_latest()
+{
+    zcm_t* zcm = zcm_create("nonblock-inproc");
+    assert(zcm);
+
+    zcm_sub_opts_t opts = { 0, ZCM_QUEUE_KEEP_LATEST };
+    assert(zcm_subscribe_opts(zcm, "LATEST", latestHandler, NULL, &opts));
+    assert(zcm_subscribe(zcm, "ALL", allHandler, NULL));
+
+    for (uint8_t i = 0; i < 10; ++i) {
+        zcm_publish(zcm, "LATEST", &i, 1);
+        zcm_publish(zcm, "ALL", &i, 1);
+    }
+
+    // One handle cycle drains the transport but only dispatches the newest LATEST message
+    int rc = zcm_handle_nonblock(zcm);
+    int rc2 = zcm_handle_nonblock(zcm);
+    zcm_destroy(zcm);
+
+    if (rc != ZCM_EOK || rc2 != ZCM_EAGAIN ||
+        numlatest != 1 || lastlatest != 9 || numall != 10) {
+        printf("Nonblocking keep-latest subscription was not conflated\n");
+        return 1;
+    }
+    return 0;
+}
+
+static std::atomic<int> numburst {0};
+static std::atomic<bool> burstOutOfOrder {false};
+
+static void burstHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    int seq;
+    memcpy(&seq, rbuf->data, sizeof(seq));
+    if (seq != numburst) burstOutOfOrder = true;
+    ++numburst;
+}
+
+// The inproc transport holds a bounded number of messages. Publishing beyond that is
+// refused until the receiver catches up, and a publisher that retries loses nothing.
+static int test_publish_bound()
+{
+    zcm_t* zcm = zcm_create("nonblock-inproc");
+    assert(zcm);
+    assert(zcm_subscribe(zcm, "BURST", burstHandler, NULL));
+    numburst = 0;
+
+    const int nmsgs = 10000;
+    int naccepted = 0;
+    for (int i = 0; i < nmsgs; ++i)
+        if (zcm_publish(zcm, "BURST", (uint8_t*) &naccepted, sizeof(naccepted)) == ZCM_EOK)
+            ++naccepted;
+    while (zcm_handle_nonblock(zcm) == ZCM_EOK) {}
+    zcm_destroy(zcm);
+
+    if (naccepted == nmsgs || naccepted < 1024 || numburst != naccepted || burstOutOfOrder) {
+        printf("Nonblocking inproc accepted %d and delivered %d/%d messages\n",
+               naccepted, numburst.load(), nmsgs);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_publish_burst()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    assert(zcm);
+    assert(zcm_subscribe(zcm, "BURST", burstHandler, NULL));
+    numburst = 0;
+
+    const int nmsgs = 100000;
+    int nrefused = 0;
+    zcm_start(zcm);
+    for (int i = 0; i < nmsgs; ++i) {
+        while (zcm_publish(zcm, "BURST", (uint8_t*) &i, sizeof(i)) != ZCM_EOK) {
+            ++nrefused;
+            usleep(10);
+        }
+    }
+    u64 start = TimeUtil::utime();
+    while (numburst < nmsgs && TimeUtil::utime() - start < TIMEOUT) usleep(1000);
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+
+    if (numburst != nmsgs || burstOutOfOrder) {
+        printf("Burst publish was refused %d times and delivered %d/%d messages\n",
+               nrefused, numburst.load(), nmsgs);
+        return 1;
+    }
+    return 0;
+}
+
+static zcm_sub_t* selfsub = nullptr;
+static int numself = 0;
+static uint8_t lastself = 0;
+
+static void unsubscribingHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    ++numself;
+    if (zcm_unsubscribe(rbuf->zcm, selfsub) != ZCM_EOK) return;
+    // The message must still be readable after the subscription is gone
+    lastself = rbuf->data[0];
+    if (strcmp(channel, "SELF") != 0) lastself = 0xff;
+}
+
+static int test_nonblock_latest_unsubscribe()
+{
+    zcm_t* zcm = zcm_create("nonblock-inproc");
+    assert(zcm);
+
+    zcm_sub_opts_t opts = { 0, ZCM_QUEUE_KEEP_LATEST };
+    selfsub = zcm_subscribe_opts(zcm, "SELF", unsubscribingHandler, NULL, &opts);
+    assert(selfsub);
+
+    for (uint8_t i = 0; i < 3; ++i) zcm_publish(zcm, "SELF", &i, 1);
+    int rc = zcm_handle_nonblock(zcm);
+
+    for (uint8_t i = 0; i < 3; ++i) zcm_publish(zcm, "SELF", &i, 1);
+    zcm_handle_nonblock(zcm);
+    zcm_destroy(zcm);
+
+    if (rc != ZCM_EOK || numself != 1 || lastself != 2) {
+        printf("Keep-latest handler could not unsubscribe itself\n");
+        return 1;
+    }
+    return 0;
+}
+
+static zcm_sub_t* othersub = nullptr;
+static std::atomic<bool> inHandler {false};
+static std::atomic<bool> unsubscribed {false};
+
+static void nopHandler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr) {}
+
+static void unsubscribingOtherHandler(const zcm_recv_buf_t* rbuf, const char* channel,
+                                      void* usr)
+{
+    if (inHandler.exchange(true)) return;
+    // Give the main thread time to start unsubscribing this subscription
+    usleep(100000);
+    zcm_unsubscribe(rbuf->zcm, othersub);
+}
+
+// A blocking unsubscribe waits for a running handler, which may unsubscribe as well
+static int test_unsubscribe_running()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    assert(zcm);
+    zcm_sub_t* sub = zcm_subscribe(zcm, "RUNNING", unsubscribingOtherHandler, NULL);
+    othersub = zcm_subscribe(zcm, "OTHER", nopHandler, NULL);
+    assert(sub && othersub);
+
+    zcm_start(zcm);
+    uint8_t b = 0;
+    zcm_publish(zcm, "RUNNING", &b, 1);
+    u64 start = TimeUtil::utime();
+    while (!inHandler && TimeUtil::utime() - start < TIMEOUT) usleep(1000);
+
+    std::thread t([&]() {
+        zcm_unsubscribe(zcm, sub);
+        unsubscribed = true;
+    });
+    t.detach();
+    start = TimeUtil::utime();
+    while (!unsubscribed && TimeUtil::utime() - start < TIMEOUT) usleep(1000);
+    if (!unsubscribed) {
+        printf("Unsubscribing deadlocked with a handler that unsubscribes\n");
+        return 1;
+    }
+
+    zcm_stop(zcm);
+    zcm_destroy(zcm);
+    return 0;
+}
+
+// Unsubscribing a subscription that isn't there must leave it working
+static int test_unsubscribe_invalid()
+{
+    zcm_t* zcm = zcm_create("block-inproc");
+    zcm_t* other = zcm_create("block-inproc");
+    assert(zcm && other);
+    numburst = 0;
+    zcm_sub_t* sub = zcm_subscribe(zcm, "INVALID", burstHandler, NULL);
+    assert(sub);
+
+    int rc = zcm_unsubscribe(other, sub);
+    zcm_start(zcm);
+    int seq = 0;
+    zcm_publish(zcm, "INVALID", (uint8_t*) &seq, sizeof(seq));
+    u64 start = TimeUtil::utime();
+    while (numburst == 0 && TimeUtil::utime() - start < TIMEOUT) usleep(1000);
+    zcm_stop(zcm);
+    zcm_destroy(other);
+    zcm_destroy(zcm);
+
+    if (rc != ZCM_EINVALID || numburst != 1) {
+        printf("Unsubscribing from the wrong zcm returned %d and broke the subscription\n", rc);
+        return 1;
+    }
+    return 0;
+}
+
+int main()
+{
+    if (test_ordering()) return 1;
+    if (test_arrival_order()) return 1;
+    if (test_drop_policy()) return 1;
+    if (test_keep_latest()) return 1;
+    if (test_nonblock_latest()) return 1;
+    if (test_nonblock_latest_unsubscribe()) return 1;
+    if (test_unsubscribe_running()) return 1;
+    if (test_unsubscribe_invalid()) return 1;
+    if (test_publish_bound()) return 1;
+    if (test_publish_burst()) return 1;
+    printf("Success!\n");
+    return 0;
+}
@@ -0,0 +1,293 @@
+// Exports zcmtypes to an Arrow file through the log exporter's columns and writer, then
+// reads the file back with a minimal reader of the IPC format and checks that every
+// dictionary comes before the batches using it and that the values come back out
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Columns.hpp"
+#include "ArrowWriter.hpp"
+
+#include "types/arena_t.h"
+
+using namespace std;
+
+static int retval = 0;
+
+#define check(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        ++retval; \
+    } \
+} while(0)
+
+template <typename T>
+static T rd(const uint8_t* p)
+{
+    T v;
+    memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+// Just enough of flatbuffers to read the Arrow metadata back
+struct FbTable
+{
+    const uint8_t* p;
+
+    const uint8_t* field(uint16_t id) const
+    {
+        const uint8_t* vtable = p - rd<int32_t>(p);
+        if (4 + 2 * id >= rd<uint16_t>(vtable)) return nullptr;
+        uint16_t off = rd<uint16_t>(vtable + 4 + 2 * id);
+        return off ? p + off : nullptr;
+    }
+
+    template <typename T>
+    T scalar(uint16_t id) const
+    {
+        const uint8_t* f = field(id);
+        return f ? rd<T>(f) : 0;
+    }
+
+    FbTable table(uint16_t id) const
+    {
+        const uint8_t* f = field(id);
+        return { f + rd<uint32_t>(f) };
+    }
+
+    // Structs of 8 byte members
+    vector<int64_t> structs(uint16_t id, uint32_t membersPerStruct) const
+    {
+        const uint8_t* f = field(id);
+        const uint8_t* v = f + rd<uint32_t>(f);
+        vector<int64_t> ret(rd<uint32_t>(v) * membersPerStruct);
+        for (size_t i = 0; i < ret.size(); ++i) ret[i] = rd<int64_t>(v + 4 + 8 * i);
+        return ret;
+    }
+};
+
+static FbTable root(const uint8_t* buf) { return { buf + rd<uint32_t>(buf) }; }
+
+// The buffers of one record batch, taken in the order their columns use them
+struct BatchReader
+{
+    const uint8_t* body;
+    vector<int64_t> nodes, buffers;
+    size_t node = 0, buffer = 0;
+
+    BatchReader(FbTable rb, const uint8_t* body) :
+        body(body), nodes(rb.structs(1, 2)), buffers(rb.structs(2, 2)) {}
+
+    int64_t nextNode() { return nodes[2 * node++]; }
+
+    const uint8_t* nextBuffer() { return body + buffers[2 * buffer++]; }
+};
+
+enum : uint8_t { HEADER_SCHEMA = 1, HEADER_DICTIONARY_BATCH = 2, HEADER_RECORD_BATCH = 3 };
+
+// What the file says each row holds
+struct Row
+{
+    int64_t timestamp;
+    int64_t utime;
+    vector<string> names;
+    vector<string> labels;
+};
+
+// Reads the strings of a list of dictionary encoded strings for each row
+static vector<vector<string>> readStringLists(BatchReader& br, int64_t rows,
+                                              const vector<string>& dict)
+{
+    br.nextNode();
+    br.nextBuffer();
+    const uint8_t* offsets = br.nextBuffer();
+    int64_t n = br.nextNode();
+    br.nextBuffer();
+    const uint8_t* indices = br.nextBuffer();
+
+    vector<vector<string>> ret(rows);
+    for (int64_t r = 0; r < rows; ++r) {
+        for (int32_t i = rd<int32_t>(offsets + 4 * r); i < rd<int32_t>(offsets + 4 * (r + 1)); ++i) {
+            int32_t idx = rd<int32_t>(indices + 4 * i);
+            check(i < n && idx >= 0 && (size_t) idx < dict.size(), "string index out of range");
+            ret[r].push_back(idx >= 0 && (size_t) idx < dict.size() ? dict[idx] : "");
+        }
+    }
+    return ret;
+}
+
+static vector<Row> readFile(const string& path, const vector<ColumnSpec>& columns)
+{
+    vector<Row> rows;
+    FILE* f = fopen(path.c_str(), "rb");
+    check(f, "unable to open %s", path.c_str());
+    if (!f) return rows;
+    vector<uint8_t> file;
+    uint8_t chunk[4096];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) file.insert(file.end(), chunk, chunk + got);
+    fclose(f);
+
+    check(file.size() > 16 && memcmp(file.data(), "ARROW1", 6) == 0 &&
+          memcmp(&file[file.size() - 6], "ARROW1", 6) == 0, "not an Arrow file");
+
+    map<int64_t, vector<string>> dicts;
+    vector<int64_t> dictOffsets, batchOffsets;
+    bool sawSchema = false;
+    size_t pos = 8;
+    while (pos + 8 <= file.size()) {
+        check(rd<uint32_t>(&file[pos]) == 0xFFFFFFFF, "no continuation marker at %zu", pos);
+        uint32_t metaLen = rd<uint32_t>(&file[pos + 4]);
+        if (metaLen == 0) break;
+
+        FbTable msg = root(&file[pos + 8]);
+        const uint8_t* body = &file[pos + 8 + metaLen];
+        uint8_t headerType = msg.scalar<uint8_t>(1);
+        FbTable header = msg.table(2);
+
+        if (headerType == HEADER_SCHEMA) {
+            check(!sawSchema && dictOffsets.empty() && batchOffsets.empty(), "schema is not first");
+            sawSchema = true;
+        } else if (headerType == HEADER_DICTIONARY_BATCH) {
+            dictOffsets.push_back(pos);
+            int64_t id = header.scalar<int64_t>(0);
+            bool isDelta = header.scalar<uint8_t>(2);
+            check(isDelta == (dicts.count(id) > 0), "dictionary %ld: only later ones are deltas",
+                  (long) id);
+            BatchReader br(header.table(1), body);
+            int64_t n = br.nextNode();
+            br.nextBuffer();
+            const uint8_t* offsets = br.nextBuffer();
+            const uint8_t* data = br.nextBuffer();
+            vector<string>& dict = dicts[id];
+            for (int64_t i = 0; i < n; ++i) {
+                int32_t start = rd<int32_t>(offsets + 4 * i);
+                dict.emplace_back((const char*) data + start, rd<int32_t>(offsets + 4 * (i + 1)) - start);
+            }
+        } else if (headerType == HEADER_RECORD_BATCH) {
+            batchOffsets.push_back(pos);
+            BatchReader br(header, body);
+            int64_t n = header.scalar<int64_t>(0);
+            vector<Row> batch(n);
+
+            br.nextNode();
+            br.nextBuffer();
+            const uint8_t* timestamps = br.nextBuffer();
+            for (int64_t r = 0; r < n; ++r) batch[r].timestamp = rd<int64_t>(timestamps + 8 * r);
+
+            for (size_t c = 0; c < columns.size(); ++c) {
+                const ColumnSpec& spec = columns[c];
+                if (spec.name == "utime") {
+                    br.nextNode();
+                    br.nextBuffer();
+                    const uint8_t* values = br.nextBuffer();
+                    for (int64_t r = 0; r < n; ++r) batch[r].utime = rd<int64_t>(values + 8 * r);
+                } else if (spec.name == "names" || spec.name == "elems.label") {
+                    static const vector<string> none;
+                    auto dict = dicts.find(c);
+                    check(dict != dicts.end(), "batch at %zu uses dictionary %zu before it was written",
+                          pos, c);
+                    auto lists = readStringLists(br, n, dict != dicts.end() ? dict->second : none);
+                    for (int64_t r = 0; r < n; ++r)
+                        (spec.name == "names" ? batch[r].names : batch[r].labels) = lists[r];
+                } else {
+                    for (uint32_t d = 0; d <= spec.listDepth; ++d) {
+                        br.nextNode();
+                        br.nextBuffer();
+                        br.nextBuffer();
+                    }
+                }
+            }
+            rows.insert(rows.end(), batch.begin(), batch.end());
+        }
+        pos += 8 + metaLen + msg.scalar<int64_t>(3);
+    }
+    check(sawSchema, "no schema");
+
+    // The footer lists the same messages in the same order
+    int32_t footerLen = rd<int32_t>(&file[file.size() - 10]);
+    FbTable footer = root(&file[file.size() - 10 - footerLen]);
+    vector<int64_t> blocks = footer.structs(2, 3);
+    check(blocks.size() == 3 * dictOffsets.size(), "footer lists %zu dictionaries, not %zu",
+          blocks.size() / 3, dictOffsets.size());
+    for (size_t i = 0; i < blocks.size() / 3 && i < dictOffsets.size(); ++i)
+        check(blocks[3 * i] == dictOffsets[i], "footer dictionary %zu is misplaced", i);
+    blocks = footer.structs(3, 3);
+    check(blocks.size() == 3 * batchOffsets.size(), "footer lists %zu batches, not %zu",
+          blocks.size() / 3, batchOffsets.size());
+    for (size_t i = 0; i < blocks.size() / 3 && i < batchOffsets.size(); ++i)
+        check(blocks[3 * i] == batchOffsets[i], "footer batch %zu is misplaced", i);
+
+    return rows;
+}
+
+int main()
+{
+    const int N = 40, BATCH = 6;
+    const string path = "/tmp/zcm-exporter-roundtrip.arrow";
+    static uint8_t buf[4096];
+
+    ColumnLayout layout(*arena_t_get_type_desc());
+    vector<Row> expected;
+    {
+        ArrowFileWriter writer(path, layout.columns());
+        check(writer.good(), "unable to create %s", path.c_str());
+
+        Batch batch;
+        unique_ptr<BatchBuilder> builder(new BatchBuilder(layout, batch));
+        for (int i = 0; i < N; ++i) {
+            // New strings keep showing up, but not in every batch
+            Row row;
+            row.timestamp = 1000000 + i;
+            row.utime = -i * 1000;
+            for (int n = 0; n < i % 4; ++n) row.names.push_back("name" + to_string((i / 10) * 3 + n));
+            for (int e = 0; e < i % 3; ++e) row.labels.push_back(i < 20 ? "" : "label" + to_string(e));
+            expected.push_back(row);
+
+            vector<char*> names, labels;
+            for (auto& s : row.names) names.push_back((char*) s.c_str());
+            vector<arena_elem_t> elems(row.labels.size());
+            for (size_t e = 0; e < elems.size(); ++e) {
+                elems[e].label = (char*) row.labels[e].c_str();
+                elems[e].num_values = 0;
+                elems[e].values = nullptr;
+            }
+
+            arena_t msg;
+            msg.utime = row.utime;
+            msg.rows = 0;
+            msg.cols = 0;
+            msg.grid = nullptr;
+            msg.num_names = names.size();
+            msg.names = names.data();
+            msg.num_elems = elems.size();
+            msg.elems = elems.data();
+
+            int len = arena_t_encode(buf, 0, sizeof(buf), &msg);
+            check(len > 0 && builder->add(row.timestamp, buf, len), "message %d not added", i);
+
+            if (batch.rows == BATCH || i == N - 1) {
+                check(writer.write(batch), "batch not written");
+                batch = Batch();
+                builder.reset(new BatchBuilder(layout, batch));
+            }
+        }
+        check(writer.close(), "file not closed");
+    }
+
+    vector<Row> rows = readFile(path, layout.columns());
+    check(rows.size() == expected.size(), "read %zu rows, not %zu", rows.size(), expected.size());
+    for (size_t i = 0; i < rows.size() && i < expected.size(); ++i) {
+        check(rows[i].timestamp == expected[i].timestamp && rows[i].utime == expected[i].utime &&
+              rows[i].names == expected[i].names && rows[i].labels == expected[i].labels,
+              "row %zu differs", i);
+    }
+    remove(path.c_str());
+
+    if (retval == 0) printf("Success!\n");
+    return retval;
+}
@@ -0,0 +1,90 @@
+// Round trips zcmtypes generated with --cpp-fixed-capacity and checks that decoding
+// them does not touch the heap
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "types/arena_t.hpp"
+
+using namespace std;
+
+static size_t numAllocs = 0;
+
+void* operator new(size_t sz)
+{
+    ++numAllocs;
+    void* p = malloc(sz ? sz : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
+static int retval = 0;
+
+#define check(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        ++retval; \
+    } \
+} while(0)
+
+static const char* names[] = { "alpha", "bravo", "charlie", "delta" };
+static const char* labels[] = { "x", "yy", "zzz" };
+
+static void fill(arena_t& msg, int i)
+{
+    msg.utime = i;
+    msg.rows = 1 + i % 3;
+    msg.cols = 1 + i % 5;
+    msg.grid.resize(msg.rows);
+    for (int r = 0; r < msg.rows; ++r) {
+        msg.grid[r].resize(msg.cols);
+        for (int c = 0; c < msg.cols; ++c) msg.grid[r][c] = i + r * 10 + c;
+    }
+    msg.num_names = i % 4;
+    msg.names.resize(msg.num_names);
+    for (int n = 0; n < msg.num_names; ++n) msg.names[n] = names[n];
+    msg.num_elems = i % 3;
+    msg.elems.resize(msg.num_elems);
+    for (int e = 0; e < msg.num_elems; ++e) {
+        msg.elems[e].label = labels[e];
+        msg.elems[e].num_values = e + i % 7;
+        msg.elems[e].values.resize(msg.elems[e].num_values);
+        for (int v = 0; v < msg.elems[e].num_values; ++v) msg.elems[e].values[v] = i + v;
+    }
+}
+
+int main()
+{
+    static uint8_t buf[4096];
+    static arena_t in, out;
+
+    numAllocs = 0;
+    for (int i = 0; i < 1000; ++i) {
+        fill(in, i);
+        int len = in.encode(buf, 0, sizeof(buf));
+        check(len > 0 && (uint32_t) len == in.getEncodedSize(), "%d: encode failed", i);
+        check(out.decode(buf, 0, len) == len, "%d: decode failed", i);
+        check(out.utime == i && out.grid == in.grid && out.names == in.names,
+              "%d: decoded message differs", i);
+        for (int e = 0; e < in.num_elems; ++e)
+            check(out.elems[e].label == in.elems[e].label &&
+                  out.elems[e].values == in.elems[e].values,
+                  "%d: decoded elem %d differs", i, e);
+    }
+    check(numAllocs == 0, "encoding and decoding allocated %zu times", numAllocs);
+
+    // Claim more rows than fit, decoding has to fail rather than overflow
+    fill(in, 2);
+    int len = in.encode(buf, 0, sizeof(buf));
+    check(len > 0, "encode failed");
+    uint32_t rows = 17;
+    buf[16] = rows >> 24; buf[17] = rows >> 16; buf[18] = rows >> 8; buf[19] = rows;
+    check(out.decode(buf, 0, sizeof(buf)) < 0, "decoded more rows than capacity");
+
+    if (retval == 0) printf("Success!\n");
+    return retval;
+}
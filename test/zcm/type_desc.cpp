@@ -0,0 +1,129 @@
+// Walks encoded zcmtypes through their generated type descriptors and checks that every
+// value comes out as the generated C decoder sees it
+#include <cstdio>
+#include <string>
+
+#include "zcm/util/TypeDesc.hpp"
+
+#include "types/arena_t.h"
+
+using namespace std;
+
+static int retval = 0;
+
+#define check(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        ++retval; \
+    } \
+} while(0)
+
+// Writes out everything it is handed, so walks can be compared as strings
+struct Printer : public zcm::TypeDescVisitor
+{
+    string out;
+
+    void beginStruct(const zcm_type_desc_t& type, const zcm_field_desc_t*)
+    { out += string(type.name) + "{"; }
+    void endStruct(const zcm_type_desc_t&, const zcm_field_desc_t*)
+    { out += "}"; }
+    void beginArray(const zcm_field_desc_t&, uint32_t, uint32_t n)
+    { out += "[" + to_string(n) + ":"; }
+    void endArray(const zcm_field_desc_t&, uint32_t)
+    { out += "]"; }
+    void integer(const zcm_field_desc_t& field, int64_t v)
+    { out += string(field.name) + "=" + to_string(v) + " "; }
+    void real(const zcm_field_desc_t& field, double v)
+    { out += string(field.name) + "=" + to_string(v) + " "; }
+    void text(const zcm_field_desc_t& field, const char* s, uint32_t len)
+    { out += string(field.name) + "=\"" + string(s, len) + "\" "; }
+};
+
+// The same, written out by hand from the decoded message
+static string expected(const arena_t& msg)
+{
+    string out = "arena_t{";
+    out += "utime=" + to_string(msg.utime) + " ";
+    out += "rows=" + to_string(msg.rows) + " ";
+    out += "cols=" + to_string(msg.cols) + " ";
+    out += "[" + to_string(msg.rows) + ":";
+    for (int r = 0; r < msg.rows; ++r) {
+        out += "[" + to_string(msg.cols) + ":";
+        for (int c = 0; c < msg.cols; ++c) out += "grid=" + to_string(msg.grid[r][c]) + " ";
+        out += "]";
+    }
+    out += "]";
+    out += "num_names=" + to_string(msg.num_names) + " ";
+    out += "[" + to_string(msg.num_names) + ":";
+    for (int n = 0; n < msg.num_names; ++n) out += "names=\"" + string(msg.names[n]) + "\" ";
+    out += "]";
+    out += "num_elems=" + to_string(msg.num_elems) + " ";
+    out += "[" + to_string(msg.num_elems) + ":";
+    for (int e = 0; e < msg.num_elems; ++e) {
+        const arena_elem_t& elem = msg.elems[e];
+        out += "arena_elem_t{label=\"" + string(elem.label) + "\" ";
+        out += "num_values=" + to_string(elem.num_values) + " ";
+        out += "[" + to_string(elem.num_values) + ":";
+        for (int v = 0; v < elem.num_values; ++v) out += "values=" + to_string(elem.values[v]) + " ";
+        out += "]}";
+    }
+    out += "]}";
+    return out;
+}
+
+int main()
+{
+    static uint8_t buf[4096];
+    double grid[3][5], *rows[3];
+    char* names[] = { (char*) "alpha", (char*) "", (char*) "charlie" };
+    float values[2][7];
+    arena_elem_t elems[2];
+
+    for (int r = 0; r < 3; ++r) {
+        rows[r] = grid[r];
+        for (int c = 0; c < 5; ++c) grid[r][c] = r * 10 + c + 0.5;
+    }
+    for (int e = 0; e < 2; ++e) {
+        elems[e].label = names[e];
+        elems[e].num_values = 3 + e * 4;
+        elems[e].values = values[e];
+        for (int v = 0; v < 7; ++v) values[e][v] = -v * 0.25f;
+    }
+
+    arena_t msg;
+    msg.utime = -1234567890123;
+    msg.rows = 3;
+    msg.cols = 5;
+    msg.grid = rows;
+    msg.num_names = 3;
+    msg.names = names;
+    msg.num_elems = 2;
+    msg.elems = elems;
+
+    int len = arena_t_encode(buf, 0, sizeof(buf), &msg);
+    check(len > 0, "encode failed");
+
+    const zcm_type_desc_t* desc = arena_t_get_type_desc();
+    check(desc->num_fields == arena_t_num_fields() && desc->struct_size == sizeof(arena_t),
+          "descriptor does not match the type info");
+
+    zcm::TypeDescReader reader;
+    Printer printer;
+    check(reader.read(*desc, buf, len, printer) == len, "walk did not read the whole message");
+    check(printer.out == expected(msg), "walk differs:\n%s\n%s",
+          printer.out.c_str(), expected(msg).c_str());
+
+    // Read it again, the reader must not carry anything over
+    printer.out.clear();
+    check(reader.read(*desc, buf, len, printer) == len && printer.out == expected(msg),
+          "second walk differs");
+
+    for (int cut = 0; cut < len; ++cut)
+        check(reader.read(*desc, buf, cut, printer) < 0, "walked a message cut to %d bytes", cut);
+    check(reader.read(*arena_elem_t_get_type_desc(), buf, len, printer) < 0,
+          "walked a message of another type");
+
+    if (retval == 0) printf("Success!\n");
+    return retval;
+}
@@ -0,0 +1,115 @@
+// Checks that a TypeRegistry decodes the current version of a zcmtype as usual, converts
+// a registered prior version into it and still rejects other types
+#include <cstdio>
+
+#include "zcm/util/TypeRegistry.hpp"
+
+#include "types/versioned_t.hpp"
+#include "types/legacy/versioned_t.hpp"
+
+using namespace std;
+
+static int retval = 0;
+
+#define check(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        ++retval; \
+    } \
+} while(0)
+
+static void fill(legacy::versioned_t& old, int i)
+{
+    old.utime = i;
+    old.position[0] = 1.5f;
+    old.position[1] = -2.5f;
+    old.num_ranges = i % 4;
+    old.ranges.resize(old.num_ranges);
+    for (int r = 0; r < old.num_ranges; ++r) old.ranges[r] = -r;
+    old.name = "legacy";
+    old.elem.id = -7;
+}
+
+static void checkConverted(const versioned_t& msg, const legacy::versioned_t& old)
+{
+    check(msg.utime == old.utime, "utime %ld != %ld", (long) msg.utime, (long) old.utime);
+    check(msg.position[0] == 1.5 && msg.position[1] == -2.5 && msg.position[2] == 0,
+          "position not converted");
+    check(msg.num_ranges == old.num_ranges && msg.ranges.size() == old.ranges.size(),
+          "num_ranges %d != %d", msg.num_ranges, old.num_ranges);
+    for (int r = 0; r < old.num_ranges && r < msg.num_ranges; ++r)
+        check(msg.ranges[r] == (float) old.ranges[r], "range %d not converted", r);
+    check(msg.name == old.name, "name not converted");
+    check(msg.elem.id == -7 && msg.elem.value == 0, "elem not converted");
+    check(msg.quality == 0, "member missing from the prior version was not reset");
+}
+
+int main()
+{
+    static uint8_t buf[1024];
+
+    zcm::TypeRegistry registry;
+    registry.addPriorVersion<versioned_t, legacy::versioned_t>();
+    zcm::TypeRegistry::Decoder<versioned_t> decoder(registry);
+
+    // Alternate versions, so the cached resolution has to follow the hash
+    for (int i = 0; i < 10; ++i) {
+        versioned_t msg;
+        if (i % 2) {
+            legacy::versioned_t old;
+            fill(old, i);
+            int len = old.encode(buf, 0, sizeof(buf));
+            msg.quality = 3;
+            check(decoder.decode(buf, len, msg) == len, "%d: prior version not decoded", i);
+            checkConverted(msg, old);
+            check(msg.decode(buf, 0, len) < 0, "%d: generated decode took the prior version", i);
+        } else {
+            versioned_t cur = versioned_t();
+            cur.utime = i;
+            cur.num_ranges = 1;
+            cur.ranges.push_back(0.5f);
+            cur.quality = 9;
+            int len = cur.encode(buf, 0, sizeof(buf));
+            check(decoder.decode(buf, len, msg) == len, "%d: current version not decoded", i);
+            check(msg.utime == i && msg.ranges == cur.ranges && msg.quality == 9,
+                  "%d: current version decoded wrong", i);
+        }
+    }
+
+    versioned_elem_t other = versioned_elem_t();
+    int len = other.encode(buf, 0, sizeof(buf));
+    versioned_t msg;
+    check(decoder.decode(buf, len, msg) < 0, "decoded an unregistered type");
+    check(decoder.decode(buf, 4, msg) < 0, "decoded a truncated message");
+
+    // And through a subscription, with a custom conversion this time
+    zcm::TypeRegistry custom;
+    custom.addPriorVersion<versioned_t, legacy::versioned_t>(
+        [](const legacy::versioned_t& old, versioned_t& msg) {
+            msg._convertFrom(old);
+            msg.quality = -1;
+        });
+
+    zcm::ZCM zcm("nonblock-inproc");
+    if (!zcm.good()) {
+        fprintf(stderr, "Failed to create zcm\n");
+        return 1;
+    }
+    int received = 0;
+    legacy::versioned_t old;
+    fill(old, 5);
+    zcm::Subscription* sub = custom.subscribe<versioned_t>(zcm, "VERSIONED",
+        [&](const zcm::ReceiveBuffer*, const string&, const versioned_t* msg) {
+            check(msg->utime == 5 && msg->quality == -1, "custom conversion not used");
+            ++received;
+        });
+    zcm.publish("VERSIONED", &old);
+    zcm.publish("VERSIONED", &other);
+    while (zcm.handleNonblock() == ZCM_EOK) {}
+    custom.unsubscribe(zcm, sub);
+    check(received == 1, "received %d messages, expected 1", received);
+
+    if (retval == 0) printf("Success!\n");
+    return retval;
+}
@@ -0,0 +1,460 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "ArrowWriter.hpp"
+
+using namespace std;
+
+// Just enough of flatbuffers (https://flatbuffers.dev/internals/) to write the Arrow
+// metadata. Objects are laid out front to back with children after their parents, as
+// flatbuffer offsets only ever point forward.
+namespace {
+
+struct Fb;
+typedef shared_ptr<Fb> FbPtr;
+
+struct Fb
+{
+    enum Kind { TABLE, TABLES, STRUCTS, STRING };
+
+    struct Field
+    {
+        uint16_t id;
+        uint8_t  size;
+        uint64_t value;
+        FbPtr    child;
+    };
+
+    Kind kind;
+    vector<Field> fields; // TABLE
+    vector<FbPtr> elems;  // TABLES
+    vector<uint8_t> data; // STRUCTS, STRING
+    uint32_t count = 0;   // STRUCTS
+
+    Fb(Kind kind) : kind(kind) {}
+
+    Fb& add(uint16_t id, uint8_t size, uint64_t value)
+    { fields.push_back({ id, size, value, nullptr }); return *this; }
+
+    Fb& add(uint16_t id, const FbPtr& child)
+    { fields.push_back({ id, 4, 0, child }); return *this; }
+};
+
+static FbPtr table() { return make_shared<Fb>(Fb::TABLE); }
+
+static FbPtr tables(const vector<FbPtr>& elems)
+{
+    FbPtr fb = make_shared<Fb>(Fb::TABLES);
+    fb->elems = elems;
+    return fb;
+}
+
+static FbPtr str(const string& s)
+{
+    FbPtr fb = make_shared<Fb>(Fb::STRING);
+    fb->data.assign(s.begin(), s.end());
+    return fb;
+}
+
+// Each of the structs has to be made of 8 byte members in this file
+static FbPtr structs(const vector<int64_t>& members, uint32_t membersPerStruct)
+{
+    FbPtr fb = make_shared<Fb>(Fb::STRUCTS);
+    fb->count = members.size() / membersPerStruct;
+    for (int64_t m : members)
+        for (int i = 0; i < 8; ++i) fb->data.push_back((uint64_t) m >> (8 * i));
+    return fb;
+}
+
+class FbWriter
+{
+    vector<uint8_t>& buf;
+
+    void pad(size_t align) { while (buf.size() % align) buf.push_back(0); }
+
+    void put(size_t at, uint64_t v, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i) buf[at + i] = v >> (8 * i);
+    }
+
+    size_t append(uint64_t v, size_t size)
+    {
+        size_t at = buf.size();
+        buf.resize(at + size);
+        put(at, v, size);
+        return at;
+    }
+
+    size_t write(const Fb& fb)
+    {
+        switch (fb.kind) {
+            case Fb::TABLE:   return writeTable(fb);
+            case Fb::TABLES:  return writeTables(fb);
+            case Fb::STRUCTS: return writeStructs(fb);
+            case Fb::STRING:  return writeString(fb);
+        }
+        return 0;
+    }
+
+    size_t writeTable(const Fb& fb)
+    {
+        // Largest fields first keeps the padding down
+        vector<const Fb::Field*> fields;
+        uint16_t numIds = 0;
+        size_t align = 4;
+        for (auto& f : fb.fields) {
+            fields.push_back(&f);
+            numIds = max<uint16_t>(numIds, f.id + 1);
+            align = max<size_t>(align, f.size);
+        }
+        stable_sort(fields.begin(), fields.end(),
+                    [](const Fb::Field* a, const Fb::Field* b) { return a->size > b->size; });
+
+        pad(2);
+        size_t vtable = buf.size();
+        buf.resize(vtable + 4 + 2 * numIds, 0);
+        pad(align);
+        size_t start = append(buf.size() - vtable, 4);
+
+        vector<pair<size_t, const FbPtr*>> children;
+        for (auto* f : fields) {
+            pad(f->size);
+            size_t at = append(f->value, f->size);
+            put(vtable + 4 + 2 * f->id, at - start, 2);
+            if (f->child) children.emplace_back(at, &f->child);
+        }
+        put(vtable, 4 + 2 * numIds, 2);
+        put(vtable + 2, buf.size() - start, 2);
+
+        for (auto& c : children) put(c.first, write(**c.second) - c.first, 4);
+        return start;
+    }
+
+    size_t writeTables(const Fb& fb)
+    {
+        pad(4);
+        size_t start = append(fb.elems.size(), 4);
+        for (size_t i = 0; i < fb.elems.size(); ++i) append(0, 4);
+        for (size_t i = 0; i < fb.elems.size(); ++i) {
+            size_t at = start + 4 + 4 * i;
+            put(at, write(*fb.elems[i]) - at, 4);
+        }
+        return start;
+    }
+
+    size_t writeStructs(const Fb& fb)
+    {
+        pad(4);
+        if ((buf.size() + 4) % 8) append(0, 4);
+        size_t start = append(fb.count, 4);
+        buf.insert(buf.end(), fb.data.begin(), fb.data.end());
+        return start;
+    }
+
+    size_t writeString(const Fb& fb)
+    {
+        pad(4);
+        size_t start = append(fb.data.size(), 4);
+        buf.insert(buf.end(), fb.data.begin(), fb.data.end());
+        buf.push_back(0);
+        return start;
+    }
+
+  public:
+    FbWriter(vector<uint8_t>& buf) : buf(buf) {}
+
+    void finish(const Fb& root)
+    {
+        buf.clear();
+        append(0, 4);
+        put(0, write(root), 4);
+        pad(8);
+    }
+};
+
+static vector<uint8_t> serialize(const FbPtr& root)
+{
+    vector<uint8_t> buf;
+    FbWriter(buf).finish(*root);
+    return buf;
+}
+
+// Values from Arrow's format/Schema.fbs and format/Message.fbs
+enum : uint8_t { TYPE_INT = 2, TYPE_FLOAT = 3, TYPE_UTF8 = 5, TYPE_BOOL = 6,
+                 TYPE_TIMESTAMP = 10, TYPE_LIST = 12 };
+enum : uint8_t { HEADER_SCHEMA = 1, HEADER_DICTIONARY_BATCH = 2, HEADER_RECORD_BATCH = 3 };
+static const uint16_t METADATA_V5 = 4;
+
+static FbPtr intType(int bits, bool isSigned)
+{
+    FbPtr t = table();
+    t->add(0, 4, bits).add(1, 1, isSigned);
+    return t;
+}
+
+static FbPtr field(const string& name, uint8_t typeType, const FbPtr& type,
+                   const vector<FbPtr>& children, const FbPtr& dictionary = nullptr)
+{
+    FbPtr f = table();
+    f->add(0, str(name)).add(2, 1, typeType).add(3, type).add(5, tables(children));
+    if (dictionary) f->add(4, dictionary);
+    return f;
+}
+
+static FbPtr columnField(const ColumnSpec& spec, size_t dictId)
+{
+    uint8_t typeType;
+    FbPtr type = table(), dictionary;
+    switch (spec.type) {
+        case ZCM_FIELD_INT8_T:  typeType = TYPE_INT; type = intType(8, true);   break;
+        case ZCM_FIELD_BYTE:    typeType = TYPE_INT; type = intType(8, false);  break;
+        case ZCM_FIELD_INT16_T: typeType = TYPE_INT; type = intType(16, true);  break;
+        case ZCM_FIELD_INT32_T: typeType = TYPE_INT; type = intType(32, true);  break;
+        case ZCM_FIELD_INT64_T: typeType = TYPE_INT; type = intType(64, true);  break;
+        case ZCM_FIELD_FLOAT:   typeType = TYPE_FLOAT; type->add(0, 2, 1);      break;
+        case ZCM_FIELD_DOUBLE:  typeType = TYPE_FLOAT; type->add(0, 2, 2);      break;
+        case ZCM_FIELD_BOOLEAN: typeType = TYPE_BOOL;                           break;
+        default:
+            typeType = TYPE_UTF8;
+            dictionary = table();
+            dictionary->add(0, 8, dictId).add(1, intType(32, true));
+            break;
+    }
+
+    FbPtr f = field(spec.listDepth ? "item" : spec.name, typeType, type, {}, dictionary);
+    for (uint32_t d = spec.listDepth; d > 0; --d)
+        f = field(d == 1 ? spec.name : "item", TYPE_LIST, table(), { f });
+    return f;
+}
+
+static FbPtr schema(const vector<ColumnSpec>& columns)
+{
+    FbPtr timestamp = table();
+    timestamp->add(0, 2, 2); // Microseconds
+    vector<FbPtr> fields { field("timestamp", TYPE_TIMESTAMP, timestamp, {}) };
+    for (size_t c = 0; c < columns.size(); ++c)
+        fields.push_back(columnField(columns[c], c));
+
+    uint16_t endianness = 1;
+    uint8_t first = *(uint8_t*) &endianness;
+    FbPtr s = table();
+    s->add(0, 2, first ? 0 : 1).add(1, tables(fields));
+    return s;
+}
+
+static FbPtr message(uint8_t headerType, const FbPtr& header, int64_t bodyLength)
+{
+    FbPtr m = table();
+    m->add(0, 2, METADATA_V5).add(1, 1, headerType).add(2, header).add(3, 8, bodyLength);
+    return m;
+}
+
+static size_t padded(size_t len) { return (len + 7) & ~(size_t) 7; }
+
+// Lays the buffers of a record batch out one after the other, each 8 byte aligned
+struct Body
+{
+    vector<int64_t> nodes;   // Length and null count of each
+    vector<int64_t> buffers; // Offset and length of each
+    int64_t length = 0;
+
+    void node(int64_t len) { nodes.push_back(len); nodes.push_back(0); }
+
+    void buffer(size_t len)
+    {
+        buffers.push_back(length);
+        buffers.push_back(len);
+        length += padded(len);
+    }
+
+    FbPtr recordBatch(int64_t rows) const
+    {
+        FbPtr rb = table();
+        rb->add(0, 8, rows).add(1, structs(nodes, 2)).add(2, structs(buffers, 2));
+        return rb;
+    }
+};
+
+}
+
+ArrowFileWriter::ArrowFileWriter(const string& path, const vector<ColumnSpec>& columns) :
+    columns(columns)
+{
+    f = fopen(path.c_str(), "wb");
+    if (!f) return;
+
+    static const char magic[8] = "ARROW1";
+    writeBytes(magic, sizeof(magic));
+
+    vector<uint8_t> metadata = serialize(message(HEADER_SCHEMA, schema(columns), 0));
+    writeMessage(HEADER_SCHEMA, metadata, {}, nullptr);
+}
+
+ArrowFileWriter::~ArrowFileWriter()
+{
+    close();
+}
+
+bool ArrowFileWriter::writeBytes(const void* data, size_t len)
+{
+    if (len && fwrite(data, 1, len, f) != len) ok = false;
+    pos += len;
+    return ok;
+}
+
+bool ArrowFileWriter::writeMessage(uint8_t headerType, const vector<uint8_t>& metadata,
+                                   const vector<Segment>& body, Block* block)
+{
+    static const uint8_t zeros[8] = {};
+    int64_t start = pos;
+
+    uint32_t prefix[2] = { 0xFFFFFFFF, (uint32_t) metadata.size() };
+    writeBytes(prefix, sizeof(prefix));
+    writeBytes(metadata.data(), metadata.size());
+
+    int64_t bodyLength = 0;
+    for (auto& s : body) {
+        writeBytes(s.data, s.len);
+        writeBytes(zeros, padded(s.len) - s.len);
+        bodyLength += padded(s.len);
+    }
+
+    if (block) *block = { start, (int32_t) (8 + metadata.size()), bodyLength };
+    return ok;
+}
+
+bool ArrowFileWriter::write(const Batch& batch)
+{
+    if (!f) return false;
+
+    Body body;
+    vector<Segment> segments;
+    vector<vector<uint8_t>> scratch;
+    auto add = [&](const void* data, size_t len) {
+        body.buffer(len);
+        segments.push_back({ data, len });
+    };
+
+    // Readers need the dictionaries before the batches that use them, so the strings that
+    // are new in this batch go out first, as deltas to the column's dictionary
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (columns[c].type != ZCM_FIELD_STRING) continue;
+        Dictionary& dict = dicts[c];
+        for (auto& s : batch.columns[c].dict)
+            if (dict.index.emplace(s, (int32_t) dict.values.size()).second)
+                dict.values.push_back(s);
+        if (!writeDictionary(c)) return false;
+    }
+
+    body.node(batch.rows);
+    add(nullptr, 0);
+    add(batch.timestamps.data(), batch.timestamps.size() * sizeof(int64_t));
+
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const ColumnSpec& spec = columns[c];
+        const ColumnData& col = batch.columns[c];
+
+        int64_t count = batch.rows;
+        for (auto& offs : col.offsets) {
+            body.node(count);
+            add(nullptr, 0);
+            add(offs.data(), offs.size() * sizeof(int32_t));
+            count = offs.back();
+        }
+
+        body.node(count);
+        add(nullptr, 0);
+        if (spec.type == ZCM_FIELD_STRING) {
+            // Switch to the file's dictionary
+            Dictionary& dict = dicts[c];
+            vector<int32_t> remap(col.dict.size());
+            for (size_t i = 0; i < col.dict.size(); ++i) remap[i] = dict.index[col.dict[i]];
+            scratch.emplace_back(col.indices.size() * sizeof(int32_t));
+            int32_t* indices = (int32_t*) scratch.back().data();
+            for (size_t i = 0; i < col.indices.size(); ++i) indices[i] = remap[col.indices[i]];
+            add(indices, scratch.back().size());
+        } else if (spec.type == ZCM_FIELD_BOOLEAN) {
+            scratch.emplace_back((count + 7) / 8, 0);
+            uint8_t* bits = scratch.back().data();
+            for (int64_t i = 0; i < count; ++i)
+                if (col.values[i]) bits[i / 8] |= 1 << (i % 8);
+            add(bits, scratch.back().size());
+        } else {
+            add(col.values.data(), col.values.size());
+        }
+    }
+
+    Block block;
+    vector<uint8_t> metadata = serialize(message(HEADER_RECORD_BATCH,
+                                                 body.recordBatch(batch.rows), body.length));
+    if (!writeMessage(HEADER_RECORD_BATCH, metadata, segments, &block)) return false;
+    batchBlocks.push_back(block);
+    return true;
+}
+
+bool ArrowFileWriter::writeDictionary(size_t column)
+{
+    // The first dictionary of a column is written even when empty, as the batch refers to it
+    Dictionary& dict = dicts[column];
+    if (dict.sent && dict.written == dict.values.size()) return ok;
+
+    vector<int32_t> offsets(1, 0);
+    string data;
+    for (size_t i = dict.written; i < dict.values.size(); ++i) {
+        data += dict.values[i];
+        offsets.push_back(data.size());
+    }
+    size_t count = dict.values.size() - dict.written;
+
+    Body body;
+    vector<Segment> segments;
+    body.node(count);
+    body.buffer(0);
+    segments.push_back({ nullptr, 0 });
+    body.buffer(offsets.size() * sizeof(int32_t));
+    segments.push_back({ offsets.data(), offsets.size() * sizeof(int32_t) });
+    body.buffer(data.size());
+    segments.push_back({ data.data(), data.size() });
+
+    FbPtr batch = table();
+    batch->add(0, 8, column).add(1, body.recordBatch(count)).add(2, 1, dict.sent);
+
+    Block block;
+    vector<uint8_t> metadata = serialize(message(HEADER_DICTIONARY_BATCH, batch, body.length));
+    if (!writeMessage(HEADER_DICTIONARY_BATCH, metadata, segments, &block)) return false;
+    dictBlocks.push_back(block);
+    dict.written = dict.values.size();
+    dict.sent = true;
+    return true;
+}
+
+bool ArrowFileWriter::close()
+{
+    if (!f) return false;
+
+    static const uint32_t eos[2] = { 0xFFFFFFFF, 0 };
+    writeBytes(eos, sizeof(eos));
+
+    auto blocks = [](const vector<Block>& blocks) {
+        vector<int64_t> members;
+        for (auto& b : blocks) {
+            members.push_back(b.offset);
+            members.push_back((uint32_t) b.metaDataLength);
+            members.push_back(b.bodyLength);
+        }
+        return structs(members, 3);
+    };
+    FbPtr footer = table();
+    footer->add(0, 2, METADATA_V5).add(1, schema(columns))
+           .add(2, blocks(dictBlocks)).add(3, blocks(batchBlocks));
+    vector<uint8_t> fb = serialize(footer);
+    int32_t fbLength = fb.size();
+    writeBytes(fb.data(), fb.size());
+    writeBytes(&fbLength, sizeof(fbLength));
+    writeBytes("ARROW1", 6);
+
+    if (fclose(f) != 0) ok = false;
+    f = nullptr;
+    return ok;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Columns.hpp"
+
+// Writes Arrow IPC files (https://arrow.apache.org/docs/format/Columnar.html), which
+// pyarrow, polars, DuckDB and most other analytics tools read directly, without
+// depending on the Arrow libraries. The first column is the event "timestamp" in
+// microseconds, followed by the columns of a ColumnLayout. Strings are dictionary
+// encoded, with one dictionary per column for the whole file. Each record batch is
+// preceded by dictionary deltas holding the strings it adds.
+class ArrowFileWriter
+{
+  public:
+    ArrowFileWriter(const std::string& path, const std::vector<ColumnSpec>& columns);
+    ~ArrowFileWriter();
+
+    bool good() const { return f != nullptr; }
+
+    // Writes the batch as one record batch
+    bool write(const Batch& batch);
+
+    // Writes the footer. Also done on destruction.
+    bool close();
+
+  private:
+    struct Block
+    {
+        int64_t offset;
+        int32_t metaDataLength;
+        int64_t bodyLength;
+    };
+
+    struct Segment
+    {
+        const void* data;
+        size_t len;
+    };
+
+    struct Dictionary
+    {
+        std::vector<std::string> values;
+        std::unordered_map<std::string, int32_t> index;
+        size_t written = 0; // values already in the file
+        bool sent = false;
+    };
+
+    bool writeBytes(const void* data, size_t len);
+    bool writeDictionary(size_t column);
+    bool writeMessage(uint8_t headerType, const std::vector<uint8_t>& metadata,
+                      const std::vector<Segment>& body, Block* block);
+
+    std::vector<ColumnSpec> columns;
+    std::unordered_map<size_t, Dictionary> dicts; // By column
+    std::vector<Block> dictBlocks, batchBlocks;
+    FILE* f;
+    int64_t pos = 0;
+    bool ok = true;
+};
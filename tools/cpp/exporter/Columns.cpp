@@ -0,0 +1,134 @@
+#include <cstring>
+
+#include "Columns.hpp"
+
+using namespace std;
+
+ColumnLayout::ColumnLayout(const zcm_type_desc_t& type) : desc(&type)
+{
+    add(rootNode, type, "", 0);
+}
+
+void ColumnLayout::add(Node& node, const zcm_type_desc_t& type, const string& prefix,
+                       uint32_t depth)
+{
+    node.firstColumn = specs.size();
+    node.children.resize(type.num_fields);
+    for (uint32_t i = 0; i < type.num_fields; ++i) {
+        const zcm_field_desc_t& field = type.fields[i];
+        Node& child = node.children[i];
+        string name = prefix + field.name;
+        child.listDepth = depth;
+        if (field.type == ZCM_FIELD_USER_TYPE) {
+            add(child, *field.subtype, name + ".", depth + field.num_dim);
+        } else {
+            child.firstColumn = specs.size();
+            child.column = specs.size();
+            specs.push_back({ name, field.type, depth + field.num_dim });
+            child.endColumn = specs.size();
+        }
+    }
+    node.endColumn = specs.size();
+}
+
+BatchBuilder::BatchBuilder(const ColumnLayout& layout, Batch& batch) :
+    layout(layout), batch(batch)
+{
+    auto& specs = layout.columns();
+    batch.columns.resize(specs.size());
+    for (size_t c = 0; c < specs.size(); ++c)
+        batch.columns[c].offsets.assign(specs[c].listDepth, vector<int32_t>(1, 0));
+}
+
+bool BatchBuilder::add(int64_t timestamp, const uint8_t* data, uint32_t len)
+{
+    mark();
+    nodes.clear();
+    types.clear();
+    if (reader.read(layout.type(), data, len, *this) < 0) {
+        rollback();
+        return false;
+    }
+    batch.timestamps.push_back(timestamp);
+    batch.rows++;
+    return true;
+}
+
+void BatchBuilder::mark()
+{
+    marks.clear();
+    for (auto& col : batch.columns) {
+        for (auto& offs : col.offsets) marks.push_back(offs.size());
+        marks.push_back(col.values.size());
+        marks.push_back(col.indices.size());
+    }
+}
+
+void BatchBuilder::rollback()
+{
+    size_t i = 0;
+    for (auto& col : batch.columns) {
+        for (auto& offs : col.offsets) offs.resize(marks[i++]);
+        col.values.resize(marks[i++]);
+        col.indices.resize(marks[i++]);
+    }
+}
+
+void BatchBuilder::beginStruct(const zcm_type_desc_t& type, const zcm_field_desc_t* field)
+{
+    nodes.push_back(field ? &node(*field) : &layout.root());
+    types.push_back(&type);
+}
+
+void BatchBuilder::endStruct(const zcm_type_desc_t&, const zcm_field_desc_t*)
+{
+    nodes.pop_back();
+    types.pop_back();
+}
+
+void BatchBuilder::beginArray(const zcm_field_desc_t& field, uint32_t dim, uint32_t n)
+{
+    const ColumnLayout::Node& nd = node(field);
+    uint32_t level = nd.listDepth + dim;
+    for (uint32_t c = nd.firstColumn; c < nd.endColumn; ++c) {
+        auto& offs = batch.columns[c].offsets[level];
+        offs.push_back(offs.back() + n);
+    }
+}
+
+template <typename T>
+void BatchBuilder::append(const zcm_field_desc_t& field, T v)
+{
+    auto& values = batch.columns[node(field).column].values;
+    size_t size = values.size();
+    values.resize(size + sizeof(T));
+    memcpy(&values[size], &v, sizeof(T));
+}
+
+void BatchBuilder::integer(const zcm_field_desc_t& field, int64_t v)
+{
+    switch (field.type) {
+        case ZCM_FIELD_INT16_T: append<int16_t>(field, v); break;
+        case ZCM_FIELD_INT32_T: append<int32_t>(field, v); break;
+        case ZCM_FIELD_INT64_T: append<int64_t>(field, v); break;
+        default:                append<uint8_t>(field, v); break;
+    }
+}
+
+void BatchBuilder::real(const zcm_field_desc_t& field, double v)
+{
+    if (field.type == ZCM_FIELD_FLOAT) append<float>(field, v);
+    else                               append<double>(field, v);
+}
+
+void BatchBuilder::text(const zcm_field_desc_t& field, const char* s, uint32_t len)
+{
+    ColumnData& col = batch.columns[node(field).column];
+    key.assign(s, len);
+    auto it = col.dictIndex.find(key);
+    if (it == col.dictIndex.end()) {
+        it = col.dictIndex.emplace(key, (int32_t) col.dict.size()).first;
+        col.dict.push_back(key);
+    }
+    col.indices.push_back(it->second);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <zcm/zcm_coretypes.h>
+#include <zcm/util/TypeDesc.hpp>
+
+// One column per primitive field of a zcmtype, nested types included, named by its path
+// ("pose.position"). Every array dimension on that path, whether of the field itself or
+// of an array of structs that contains it, wraps the column in one more level of list.
+struct ColumnSpec
+{
+    std::string      name;
+    zcm_field_type_t type;
+    uint32_t         listDepth;
+};
+
+class ColumnLayout
+{
+  public:
+    ColumnLayout(const zcm_type_desc_t& type);
+
+    const zcm_type_desc_t& type() const { return *desc; }
+    const std::vector<ColumnSpec>& columns() const { return specs; }
+
+    // Mirrors the fields of the type, nested types expanded
+    struct Node
+    {
+        std::vector<Node> children; // The subtype's fields, for nested types
+        int32_t  column = -1;       // For primitive fields
+        uint32_t firstColumn = 0;   // The columns under this node
+        uint32_t endColumn = 0;
+        uint32_t listDepth = 0;     // List levels above this field's own dimensions
+    };
+    const Node& root() const { return rootNode; }
+
+  private:
+    void add(Node& node, const zcm_type_desc_t& type, const std::string& prefix, uint32_t depth);
+
+    const zcm_type_desc_t* desc;
+    std::vector<ColumnSpec> specs;
+    Node rootNode;
+};
+
+struct ColumnData
+{
+    std::vector<std::vector<int32_t>> offsets; // Per list level, starting at 0
+    std::vector<uint8_t> values;               // Host byte order, one byte per boolean
+    std::vector<int32_t> indices;              // Strings, into dict
+    std::vector<std::string> dict;
+    std::unordered_map<std::string, int32_t> dictIndex;
+};
+
+// A run of messages of one type, column by column
+struct Batch
+{
+    uint32_t rows = 0;
+    std::vector<int64_t> timestamps;
+    std::vector<ColumnData> columns;
+};
+
+class BatchBuilder : public zcm::TypeDescVisitor
+{
+  public:
+    BatchBuilder(const ColumnLayout& layout, Batch& batch);
+
+    // Returns false, leaving the batch as it was, if the message is not of the layout's type
+    bool add(int64_t timestamp, const uint8_t* data, uint32_t len);
+
+    void beginStruct(const zcm_type_desc_t& type, const zcm_field_desc_t* field);
+    void endStruct(const zcm_type_desc_t& type, const zcm_field_desc_t* field);
+    void beginArray(const zcm_field_desc_t& field, uint32_t dim, uint32_t n);
+    void integer(const zcm_field_desc_t& field, int64_t v);
+    void real(const zcm_field_desc_t& field, double v);
+    void text(const zcm_field_desc_t& field, const char* s, uint32_t len);
+
+  private:
+    const ColumnLayout::Node& node(const zcm_field_desc_t& field) const
+    { return nodes.back()->children[&field - types.back()->fields]; }
+
+    template <typename T>
+    void append(const zcm_field_desc_t& field, T v);
+
+    void mark();
+    void rollback();
+
+    const ColumnLayout& layout;
+    Batch& batch;
+    zcm::TypeDescReader reader;
+    std::vector<const ColumnLayout::Node*> nodes;
+    std::vector<const zcm_type_desc_t*> types;
+    std::vector<size_t> marks;
+    std::string key;
+};
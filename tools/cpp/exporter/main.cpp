@@ -0,0 +1,282 @@
+#include <iostream>
+#include <getopt.h>
+#include <sys/stat.h>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+
+#include <zcm/zcm-cpp.hpp>
+
+#include "util/TypeDb.hpp"
+
+#include "ArrowWriter.hpp"
+#include "Columns.hpp"
+
+using namespace std;
+
+struct Args
+{
+    string logfile    = "";
+    string output     = "";
+    string type_path  = "";
+    size_t threads    = max(thread::hardware_concurrency(), 1u);
+    size_t batch_size = 65536;
+    bool debug        = false;
+
+    bool parse(int argc, char *argv[])
+    {
+        // set some defaults
+        const char *optstring = "l:o:t:j:b:h";
+        struct option long_opts[] = {
+            { "log",        required_argument, 0, 'l' },
+            { "output",     required_argument, 0, 'o' },
+            { "type-path",  required_argument, 0, 't' },
+            { "threads",    required_argument, 0, 'j' },
+            { "batch-size", required_argument, 0, 'b' },
+            { "debug",      no_argument,       0,  0  },
+            { "help",       no_argument,       0, 'h' },
+            { 0, 0, 0, 0 }
+        };
+
+        int c;
+        int option_index;
+        while ((c = getopt_long(argc, argv, optstring, long_opts, &option_index)) >= 0) {
+            switch (c) {
+                case 'l': logfile    = string(optarg); break;
+                case 'o': output     = string(optarg); break;
+                case 't': type_path  = string(optarg); break;
+                case 'j': threads    = max(atoi(optarg), 1); break;
+                case 'b': batch_size = max(atoi(optarg), 1); break;
+                case  0:
+                    if (string(long_opts[option_index].name) == "debug") debug = true;
+                    break;
+                case 'h': default: usage(); return false;
+            };
+        }
+
+        if (logfile == "") {
+            cerr << "Please specify logfile input" << endl;
+            return false;
+        }
+
+        if (output == "") {
+            cerr << "Please specify output directory" << endl;
+            return false;
+        }
+
+        const char* type_path_env = getenv("ZCM_LOG_EXPORTER_ZCMTYPES_PATH");
+        if (type_path == "" && type_path_env) type_path = type_path_env;
+        if (type_path == "") {
+            cerr << "Please specify a zcmtypes.so path either through -t TYPE_PATH "
+                    "or through the env var ZCM_LOG_EXPORTER_ZCMTYPES_PATH" << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void usage()
+    {
+        cout << "usage: zcm-log-exporter [options]" << endl
+             << "" << endl
+             << "    Convert a log file to one Arrow IPC file per channel, with a column" << endl
+             << "    per zcmtype field, for analysis with pyarrow, pandas, polars," << endl
+             << "    DuckDB and the like. Messages are decoded on several threads." << endl
+             << "" << endl
+             << "Example:" << endl
+             << "    zcm-log-exporter -l zcm.log -o zcm-log-arrow -t path/to/zcmtypes.so" << endl
+             << "" << endl
+             << "Options:" << endl
+             << "" << endl
+             << "  -h, --help              Shows this help text and exits" << endl
+             << "  -l, --log=logfile       Input log to export" << endl
+             << "  -o, --output=dir        Directory to write the .arrow files into" << endl
+             << "  -t, --type-path=path    Path to shared library containing the zcmtypes," << endl
+             << "                          generated with --c-typeinfo" << endl
+             << "                          Can also be specified via the environment variable" << endl
+             << "                          ZCM_LOG_EXPORTER_ZCMTYPES_PATH" << endl
+             << "  -j, --threads=n         Number of threads to decode with" << endl
+             << "                          Defaults to the number of cores" << endl
+             << "  -b, --batch-size=n      Messages per record batch. Defaults to 65536" << endl
+             << "      --debug             Print debugging information about loaded types" << endl
+             << endl << endl;
+    }
+};
+
+// Messages waiting to be decoded into a batch
+struct Chunk
+{
+    vector<uint8_t>  data;
+    vector<uint32_t> offsets { 0 };
+    vector<int64_t>  timestamps;
+};
+
+// One file, for the messages of one type on one channel
+struct Output
+{
+    string path;
+    unique_ptr<ColumnLayout> layout;
+    unique_ptr<ArrowFileWriter> writer;
+    Chunk chunk;
+    uint64_t messages = 0;
+    uint64_t rows     = 0;
+};
+
+static string fileName(const string& s)
+{
+    string name = s;
+    for (char& c : name)
+        if (!isalnum(c) && c != '-' && c != '_' && c != '.') c = '_';
+    return name;
+}
+
+// Channels that sanitize to the same name (e.g. "A/B" and "A_B") get a numbered suffix
+static string uniqueFileName(const string& name, set<string>& used)
+{
+    string unique = name;
+    for (size_t n = 2; !used.insert(unique).second; ++n)
+        unique = name + "-" + to_string(n);
+    return unique;
+}
+
+static Batch decode(const ColumnLayout& layout, const Chunk& chunk)
+{
+    Batch batch;
+    BatchBuilder builder(layout, batch);
+    for (size_t i = 0; i < chunk.timestamps.size(); ++i)
+        builder.add(chunk.timestamps[i], &chunk.data[chunk.offsets[i]],
+                    chunk.offsets[i + 1] - chunk.offsets[i]);
+    return batch;
+}
+
+int main(int argc, char* argv[])
+{
+    Args args;
+    if (!args.parse(argc, argv)) return 1;
+
+    zcm::LogFile log(args.logfile, "r");
+    if (!log.good()) {
+        cerr << "Unable to open logfile: " << args.logfile << endl;
+        return 1;
+    }
+    fseeko(log.getFilePtr(), 0, SEEK_END);
+    off_t logSize = ftello(log.getFilePtr());
+    fseeko(log.getFilePtr(), 0, SEEK_SET);
+
+    TypeDb types(args.type_path, args.debug);
+    if (!types.good()) {
+        cerr << "Unable to load zcmtypes from " << args.type_path << endl;
+        return 1;
+    }
+
+    if (mkdir(args.output.c_str(), 0755) != 0 && errno != EEXIST) {
+        cerr << "Unable to create output directory: " << args.output << endl;
+        return 1;
+    }
+
+    map<pair<string, int64_t>, unique_ptr<Output>> outputs;
+    map<string, size_t> typesPerChannel;
+    set<string> fileNames;
+    map<string, bool> skippedTypes;
+    uint64_t numUnknown = 0;
+
+    // Chunks decode on their own threads but are written in the order they were read
+    deque<pair<Output*, future<Batch>>> pending;
+    auto writeOldest = [&]() {
+        Output* out = pending.front().first;
+        Batch batch = pending.front().second.get();
+        pending.pop_front();
+        out->rows += batch.rows;
+        if (batch.rows > 0 && !out->writer->write(batch))
+            cerr << "Failed to write " << out->path << endl;
+    };
+    auto submit = [&](Output& out) {
+        shared_ptr<Chunk> chunk = make_shared<Chunk>(move(out.chunk));
+        out.chunk = Chunk();
+        const ColumnLayout* layout = out.layout.get();
+        pending.emplace_back(&out, async(launch::async, [layout, chunk]() {
+            return decode(*layout, *chunk);
+        }));
+        while (pending.size() > 2 * args.threads) writeOldest();
+    };
+
+    while (true) {
+        off_t offset = ftello(log.getFilePtr());
+        static int lastPrintPercent = 0;
+        int percent = (100.0 * offset / max<off_t>(logSize, 1)) * 100;
+        if (percent != lastPrintPercent) {
+            cout << "\r" << "Percent Complete: " << (percent / 100) << flush;
+            lastPrintPercent = percent;
+        }
+
+        const zcm::LogEvent* evt = log.readNextEvent();
+        if (evt == nullptr) break;
+
+        int64_t hash;
+        if (__int64_t_decode_array(evt->data, 0, evt->datalen, &hash, 1) < 0) {
+            numUnknown++;
+            continue;
+        }
+
+        auto& out = outputs[make_pair(evt->channel, hash)];
+        if (!out) {
+            out.reset(new Output());
+            const TypeMetadata* md = types.getByHash(hash);
+            if (md && md->desc) {
+                string name = fileName(evt->channel);
+                if (typesPerChannel[evt->channel]++ > 0) name += "." + md->name;
+                string unique = uniqueFileName(name, fileNames);
+                if (unique != name)
+                    cerr << endl << "Channel " << evt->channel << " (" << md->name
+                         << ") is written to " << unique << ".arrow, since "
+                         << name << ".arrow is taken" << endl;
+                out->path = args.output + "/" + unique + ".arrow";
+                out->layout.reset(new ColumnLayout(*md->desc));
+                out->writer.reset(new ArrowFileWriter(out->path, out->layout->columns()));
+                if (!out->writer->good()) {
+                    cerr << "Unable to open output file: " << out->path << endl;
+                    return 1;
+                }
+            } else if (md) {
+                skippedTypes[md->name] = true;
+            }
+        }
+        if (!out->layout) {
+            numUnknown++;
+            continue;
+        }
+
+        Chunk& chunk = out->chunk;
+        chunk.data.insert(chunk.data.end(), evt->data, evt->data + evt->datalen);
+        chunk.offsets.push_back(chunk.data.size());
+        chunk.timestamps.push_back(evt->timestamp);
+        out->messages++;
+        if (chunk.timestamps.size() >= args.batch_size) submit(*out);
+    }
+    cout << endl;
+
+    for (auto& it : outputs)
+        if (it.second->layout && !it.second->chunk.timestamps.empty()) submit(*it.second);
+    while (!pending.empty()) writeOldest();
+
+    int ret = 0;
+    for (auto& it : outputs) {
+        Output& out = *it.second;
+        if (!out.writer) continue;
+        if (!out.writer->close()) {
+            cerr << "Failed to write " << out.path << endl;
+            ret = 1;
+        }
+        cout << out.path << ": " << out.rows << " messages";
+        if (out.messages > out.rows) cout << ", " << out.messages - out.rows << " failed to decode";
+        cout << endl;
+    }
+    for (auto& it : skippedTypes)
+        cerr << "Skipped " << it.first << ", which was not generated with type descriptors" << endl;
+    if (numUnknown) cout << "Skipped " << numUnknown << " messages of unknown types" << endl;
+
+    return ret;
+}
@@ -150,6 +150,10 @@ bool TypeDb::loadtypes(const string& libname, void* lib)
         md.name = nm;
         md.info = typeinfo;
 
+        const zcm_type_desc_t* (*get_type_desc)(void) = nullptr;
+        *((void **) &get_type_desc) = dlsym(lib, (nm + "_get_type_desc").c_str());
+        md.desc = get_type_desc ? get_type_desc() : nullptr;
+
         hashToType[md.hash] = md;
         nameToHash[md.name] = md.hash;
 
@@ -12,6 +12,7 @@ struct TypeMetadata
     int64_t hash;
     std::string name;
     const zcm_type_info_t* info;
+    const zcm_type_desc_t* desc; // nullptr for types generated before type descriptors
 };
 
 class TypeDb
@@ -3,6 +3,7 @@
 #include "zcm/blocking.h"
 #include "zcm/transport.h"
 #include "zcm/util/threadsafe_queue.hpp"
+#include "zcm/util/dispatch_pool.hpp"
 #include "zcm/util/debug.h"
 
 #include "util/TimeUtil.hpp"
@@ -11,6 +12,7 @@
 #include <cassert>
 #include <cstring>
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -22,6 +24,7 @@
 using namespace std;
 
 #define RECV_TIMEOUT 100
+#define RECV_BATCH_MAX 32
 
 // Define a macro to set thread names. The function call is
 // different for some operating systems
@@ -54,6 +57,21 @@ struct Msg
 
     Msg(zcm_msg_t* msg) : Msg(msg->utime, msg->channel, msg->len, msg->buf) {}
 
+    // NOTE: gathers the provided buffers into this object
+    Msg(uint64_t utime, const char* channel, const zcm_iovec_t* iov, uint32_t niov)
+    {
+        msg.utime = utime;
+        msg.channel = strdup(channel);
+        msg.len = 0;
+        for (uint32_t i = 0; i < niov; ++i) msg.len += iov[i].len;
+        msg.buf = (uint8_t*)malloc(msg.len);
+        size_t off = 0;
+        for (uint32_t i = 0; i < niov; ++i) {
+            memcpy(msg.buf + off, iov[i].base, iov[i].len);
+            off += iov[i].len;
+        }
+    }
+
     ~Msg()
     {
         if (msg.channel)
@@ -68,6 +86,14 @@ struct Msg
         return &msg;
     }
 
+    // Hands ownership of the channel and buffer to the caller, who must free() them
+    zcm_msg_t release()
+    {
+        zcm_msg_t ret = msg;
+        memset(&msg, 0, sizeof(msg));
+        return ret;
+    }
+
   private:
     // Disable all copying and moving
     Msg(const Msg& other) = delete;
@@ -76,6 +102,50 @@ struct Msg
     Msg& operator=(Msg&& other) = delete;
 };
 
+// The single message slot of a conflating (ZCM_QUEUE_KEEP_LATEST) subscription.
+// The recvThread copies every message over the "pending" buffers in place and the
+// subscription's handler swaps them with its own "dispatch" buffers, so once both
+// have grown to the largest message seen, neither side allocates anymore.
+struct LatestSlot
+{
+    mutex mut;
+    bool  enabled = false; // protected by the zcm_blocking subRecvMutex
+    bool  pending = false;
+
+    uint64_t        utime = 0;
+    string          channel;
+    vector<uint8_t> buf;
+
+    // Only touched by the (single) thread running the subscription's handler
+    uint64_t        dispUtime = 0;
+    string          dispChannel;
+    vector<uint8_t> dispBuf;
+
+    // Returns true if this overwrote a message that was not dispatched yet
+    bool write(const zcm_msg_t* msg)
+    {
+        unique_lock<mutex> lk(mut);
+        utime = msg->utime;
+        channel.assign(msg->channel);
+        buf.assign(msg->buf, msg->buf + msg->len);
+        bool overwrote = pending;
+        pending = true;
+        return overwrote;
+    }
+
+    // Returns false if there was no message waiting
+    bool take()
+    {
+        unique_lock<mutex> lk(mut);
+        if (!pending) return false;
+        pending = false;
+        dispUtime = utime;
+        channel.swap(dispChannel);
+        buf.swap(dispBuf);
+        return true;
+    }
+};
+
 static bool isRegexChannel(const string& channel)
 {
     // These chars are considered regex
@@ -95,6 +165,8 @@ struct zcm_blocking
 {
   private:
     using SubList = vector<zcm_sub_t*>;
+    using MsgPtr = shared_ptr<Msg>;
+    using DispPool = DispatchPool<MsgPtr>;
 
   public:
     zcm_blocking(zcm_t* z, zcm_trans_t* zt_);
@@ -109,27 +181,36 @@ struct zcm_blocking
     void resume();
 
     int publish(const string& channel, const uint8_t* data, uint32_t len);
-    zcm_sub_t* subscribe(const string& channel, zcm_msg_handler_t cb, void* usr, bool block);
+    int publishv(const string& channel, const zcm_iovec_t* iov, uint32_t niov);
+    zcm_sub_t* subscribe(const string& channel, zcm_msg_handler_t cb, void* usr,
+                         const zcm_sub_opts_t* opts, bool block);
     int unsubscribe(zcm_sub_t* sub, bool block);
     int flush(bool block);
 
     int setQueueSize(uint32_t numMsgs, bool block);
+    int setSendQueueLimit(uint32_t numMsgs);
+    int setDispatchThreads(uint32_t nthreads);
+    int setSubQueue(zcm_sub_t* sub, uint32_t depth, zcm_queue_policy policy);
+    int getSubStats(zcm_sub_t* sub, zcm_sub_stats_t* stats);
 
   private:
     void sendThreadFunc();
     void recvThreadFunc();
     void hndlThreadFunc();
+    void dispThreadFunc(size_t idx);
 
-    void dispatchMsg(zcm_msg_t* msg);
-    bool dispatchOneMessage(bool returnIfPaused);
-    bool sendOneMessage(bool returnIfPaused);
+    void queueMsg(zcm_msg_t* msg);
+    void dispatchToSub(zcm_sub_t* sub, MsgPtr& m);
+    void dispatchLatestToSub(zcm_sub_t* sub);
+    size_t sendMessages(size_t maxMsgs, bool returnIfPaused);
 
-    // Mutexes protecting the ...OneMessage() functions
+    // Mutexes protecting handle() and the sendMessages() function
     mutex dispOneMutex;
     mutex sendOneMutex;
 
     bool deleteSubEntry(zcm_sub_t* sub, size_t nentriesleft);
-    bool deleteFromSubList(SubList& slist, zcm_sub_t* sub);
+    SubList* findSubList(zcm_sub_t* sub);
+    void removeFromSubList(SubList& slist, zcm_sub_t* sub);
 
     zcm_t* z;
     zcm_trans_t* zt;
@@ -145,7 +226,35 @@ struct zcm_blocking
 
     static constexpr size_t QUEUE_SIZE = 16;
     ThreadsafeQueue<Msg> sendQueue {QUEUE_SIZE};
-    ThreadsafeQueue<Msg> recvQueue {QUEUE_SIZE};
+
+    // publish() grows a full sendQueue up to this many messages before giving up
+    static constexpr size_t SEND_QUEUE_LIMIT = 1024;
+    atomic<size_t> sendQueueLimit {SEND_QUEUE_LIMIT};
+
+    // The sendThread hands up to this many queued messages to the transport at once
+    static constexpr size_t SEND_BATCH_MAX = 64;
+    vector<zcm_msg_t> sendBatch; // protected by sendOneMutex
+
+    // If the transport has sendmsgv_concurrent(), publish() hands messages to it directly
+    // unless messages are waiting in the sendQueue (or sending is paused), in which case
+    // they queue behind those so that each publisher's messages stay in order.
+    // sendQueued counts messages from being pushed until the sendThread has sent them.
+    bool sendDirect {false};
+    atomic<bool> sendPaused {false};
+    atomic<size_t> sendQueued {0};
+
+    // Every subscription owns a bounded dispatch queue (a strand of the dispPool). The
+    // recvThread hands each message to the queue of every matching subscription and the
+    // hndlThread, plus (numDispThreads - 1) extra threads, drain those queues. In
+    // RECV_MODE_HANDLE the queues are drained by the callers of handle() instead.
+    DispPool dispPool {QUEUE_SIZE};
+    uint32_t numDispThreads {0};
+    vector<thread> dispThreads;
+    vector<DispPool::StrandPtr> dispTargets; // only used by the recvThread
+
+    // Conflating subscriptions skip the shared Msg copy: the recvThread overwrites their
+    // LatestSlot and queues an empty MsgPtr that tells the handler to go look at it
+    vector<DispPool::StrandPtr> latestTargets; // only used by the recvThread
 
     typedef enum {
         RECV_MODE_NONE = 0,
@@ -180,17 +289,18 @@ struct zcm_blocking
     mutex recvStateMutex;
     mutex hndlStateMutex;
 
-    // Flag and condition variables used to pause the sendThread (use sendStateMutex)
-    // and hndlThread (use hndlStateMutex)
+    // Flag and condition variable used to pause the sendThread (use sendStateMutex)
+    // Note: the dispatch threads are paused through the dispPool
     bool               paused {false};
     condition_variable sendPauseCond;
-    condition_variable hndlPauseCond;
 };
 
-zcm_blocking_t::zcm_blocking(zcm_t* z, zcm_trans_t* zt_)
+zcm_blocking_t::zcm_blocking(zcm_t* z_, zcm_trans_t* zt_)
 {
+    z = z_;
     zt = zt_;
     mtu = zcm_trans_get_mtu(zt);
+    sendDirect = zt->vtbl->sendmsgv_concurrent != NULL;
 }
 
 zcm_blocking_t::~zcm_blocking()
@@ -204,11 +314,13 @@ zcm_blocking_t::~zcm_blocking()
     // Need to delete all subs
     for (auto& it : subs) {
         for (auto& sub : it.second) {
+            delete (LatestSlot*) sub->latestobj;
             delete sub;
         }
     }
     for (auto& sub : subRegex) {
         delete (regex*) sub->regexobj;
+        delete (LatestSlot*) sub->latestobj;
         delete sub;
     }
 }
@@ -227,7 +339,7 @@ void zcm_blocking_t::run()
         unique_lock<mutex> lk2(hndlStateMutex);
         lk1.unlock();
         hndlThreadState = THREAD_STATE_RUNNING;
-        recvQueue.enable();
+        dispPool.enable();
     }
     hndlThreadFunc();
 
@@ -250,7 +362,7 @@ void zcm_blocking_t::start()
     lk1.unlock();
     // Start the hndl thread
     hndlThreadState = THREAD_STATE_RUNNING;
-    recvQueue.enable();
+    dispPool.enable();
     hndlThread = thread{&zcm_blocking::hndlThreadFunc, this};
 }
 
@@ -263,9 +375,8 @@ int zcm_blocking_t::stop(bool block)
         unique_lock<mutex> lk2(hndlStateMutex);
         if (hndlThreadState == THREAD_STATE_RUNNING) {
             hndlThreadState = THREAD_STATE_HALTING;
-            recvQueue.disable();
+            dispPool.halt();
             lk2.unlock();
-            hndlPauseCond.notify_all();
             if (block && recvMode == RECV_MODE_SPAWN) {
                 hndlThread.join();
                 lk2.lock();
@@ -278,7 +389,8 @@ int zcm_blocking_t::stop(bool block)
         unique_lock<mutex> lk2(recvStateMutex);
         if (recvThreadState == THREAD_STATE_RUNNING) {
             recvThreadState = THREAD_STATE_HALTING;
-            recvQueue.disable();
+            dispPool.halt();
+            dispPool.disable();
             lk2.unlock();
             if (block) {
                 recvThread.join();
@@ -359,13 +471,13 @@ int zcm_blocking_t::handle()
             lk1.unlock();
             // Spawn the recv thread
             recvThreadState = THREAD_STATE_RUNNING;
-            recvQueue.enable();
+            dispPool.enable();
             recvThread = thread{&zcm_blocking::recvThreadFunc, this};
         }
     }
 
     unique_lock<mutex> lk(dispOneMutex);
-    return dispatchOneMessage(true) ? ZCM_EOK : ZCM_EAGAIN;
+    return dispPool.handleOne() ? ZCM_EOK : ZCM_EAGAIN;
 }
 
 void zcm_blocking_t::pause()
@@ -373,6 +485,8 @@ void zcm_blocking_t::pause()
     unique_lock<mutex> lk1(sendStateMutex);
     unique_lock<mutex> lk2(hndlStateMutex);
     paused = true;
+    sendPaused = true;
+    dispPool.pause();
 }
 
 void zcm_blocking_t::resume()
@@ -380,21 +494,36 @@ void zcm_blocking_t::resume()
     unique_lock<mutex> lk1(sendStateMutex);
     unique_lock<mutex> lk2(hndlStateMutex);
     paused = false;
+    sendPaused = false;
+    dispPool.resume();
     lk2.unlock();
     lk1.unlock();
     sendPauseCond.notify_all();
-    hndlPauseCond.notify_all();
 }
 
 // Note: We use a lock on publish() to make sure it can be
 // called concurrently. Without the lock, there is a potential
 // race to block on sendQueue.push()
 int zcm_blocking_t::publish(const string& channel, const uint8_t* data, uint32_t len)
+{
+    zcm_iovec_t iov = { data, len };
+    return publishv(channel, &iov, 1);
+}
+
+int zcm_blocking_t::publishv(const string& channel, const zcm_iovec_t* iov, uint32_t niov)
 {
     // Check the validity of the request
+    size_t len = 0;
+    for (uint32_t i = 0; i < niov; ++i) len += iov[i].len;
     if (len > mtu) return ZCM_EINVALID;
     if (channel.size() > ZCM_CHANNEL_MAXLEN) return ZCM_EINVALID;
 
+    // A transport that can't take the message right now gets it from the sendThread
+    if (sendDirect && !sendPaused && sendQueued == 0) {
+        int ret = zt->vtbl->sendmsgv_concurrent(zt, channel.c_str(), iov, niov);
+        if (ret != ZCM_EAGAIN) return ret;
+    }
+
     // If needed: spawn the send thread
     {
         unique_lock<mutex> lk(sendStateMutex);
@@ -404,8 +533,13 @@ int zcm_blocking_t::publish(const string& channel, const uint8_t* data, uint32_t
         }
     }
 
-    bool success = sendQueue.pushIfRoom(TimeUtil::utime(), channel.c_str(), len, data);
-    if (!success) ZCM_DEBUG("sendQueue has no free space");
+    ++sendQueued;
+    bool success = sendQueue.pushOrGrow(sendQueueLimit, TimeUtil::utime(),
+                                        channel.c_str(), iov, niov);
+    if (!success) {
+        --sendQueued;
+        ZCM_DEBUG("sendQueue has no free space");
+    }
     return success ? ZCM_EOK : ZCM_EAGAIN;
 }
 
@@ -414,7 +548,7 @@ int zcm_blocking_t::publish(const string& channel, const uint8_t* data, uint32_t
 // on modifying and reading the 'subs' and 'subRegex' containers
 zcm_sub_t* zcm_blocking_t::subscribe(const string& channel,
                                      zcm_msg_handler_t cb, void* usr,
-                                     bool block)
+                                     const zcm_sub_opts_t* opts, bool block)
 {
     unique_lock<mutex> lk1(subDispMutex, std::defer_lock);
     unique_lock<mutex> lk2(subRecvMutex, std::defer_lock);
@@ -450,6 +584,18 @@ zcm_sub_t* zcm_blocking_t::subscribe(const string& channel,
     sub->regexobj = nullptr;
     sub->callback = cb;
     sub->usr = usr;
+    zcm_queue_policy policy = opts ? opts->queue_policy : ZCM_QUEUE_BLOCK;
+    sub->dispatchobj = dispPool.addStrand([this, sub](MsgPtr& m) {
+                                              if (m) dispatchToSub(sub, m);
+                                              else   dispatchLatestToSub(sub);
+                                          },
+                                          opts ? opts->queue_depth : 0, policy).get();
+    sub->latestobj = nullptr;
+    if (policy == ZCM_QUEUE_KEEP_LATEST) {
+        LatestSlot* slot = new LatestSlot();
+        slot->enabled = true;
+        sub->latestobj = slot;
+    }
     if (regex) {
         sub->regexobj = (void*) new std::regex(sub->channel);
         ZCM_ASSERT(sub->regexobj);
@@ -475,22 +621,32 @@ int zcm_blocking_t::unsubscribe(zcm_sub_t* sub, bool block)
         return ZCM_EAGAIN;
     }
 
-    bool success = true;
-    if (sub->regex) {
-        success = deleteFromSubList(subRegex, sub);
-    } else {
-        auto it = subs.find(sub->channel);
-        if (it == subs.end()) {
-            ZCM_DEBUG("failed to find the subscription channel in unsubscribe()");
-            return ZCM_EINVALID;
-        }
+    SubList* slist = findSubList(sub);
+    if (!slist) {
+        ZCM_DEBUG("failed to find the subscription entry in unsubscribe()");
+        return ZCM_EINVALID;
+    }
+
+    // Make sure no dispatch thread is (or will be) running this subscription's handler.
+    // Without blocking, nothing changes if the handler is running right now.
+    DispPool::Strand* strand = (DispPool::Strand*) sub->dispatchobj;
+    if (!block && !dispPool.removeStrand(strand, false))
+        return ZCM_EAGAIN;
+
+    // Once it is out of the lists, the recvThread queues nothing more for the subscription
+    removeFromSubList(*slist, sub);
 
-        SubList& slist = it->second;
-        success = deleteFromSubList(slist, sub);
+    // Note: The running handler may itself (un)subscribe, so wait for it without the locks
+    if (block) {
+        lk2.unlock();
+        lk1.unlock();
+        dispPool.removeStrand(strand, true);
+        lk1.lock();
+        lk2.lock();
     }
 
-    if (!success) {
-        ZCM_DEBUG("failed to find the subscription entry in unsubscribe()");
+    if (!deleteSubEntry(sub, subRegex.size())) {
+        ZCM_DEBUG("failed to disable the subscription's channel in unsubscribe()");
         return ZCM_EINVALID;
     }
 
@@ -514,23 +670,23 @@ int zcm_blocking_t::flush(bool block)
 
         sendQueue.enable();
         n = sendQueue.numMessages();
-        for (size_t i = 0; i < n; ++i) sendOneMessage(false);
+        while (n > 0) {
+            size_t sent = sendMessages(n, false);
+            if (sent == 0) break;
+            n -= sent;
+        }
     }
 
     {
-        recvQueue.disable();
+        // Wake up a handle() that is waiting for messages
+        dispPool.wakeup();
 
         unique_lock<mutex> lk(dispOneMutex, defer_lock);
 
         if (block) lk.lock();
-        else if (!lk.try_lock()) {
-            recvQueue.enable();
-            return ZCM_EAGAIN;
-        }
+        else if (!lk.try_lock()) return ZCM_EAGAIN;
 
-        recvQueue.enable();
-        n = recvQueue.numMessages();
-        for (size_t i = 0; i < n; ++i) dispatchOneMessage(false);
+        dispPool.flush();
     }
 
     return ZCM_EOK;
@@ -550,26 +706,59 @@ int zcm_blocking_t::setQueueSize(uint32_t numMsgs, bool block)
             return ZCM_EAGAIN;
         }
 
+        // Shrinking drops the newest messages
+        size_t before = sendQueue.numMessages();
         sendQueue.setCapacity(numMsgs);
+        sendQueued -= before - sendQueue.numMessages();
         sendQueue.enable();
     }
+    if (sendQueueLimit < numMsgs) sendQueueLimit = numMsgs;
 
-    if (recvQueue.getCapacity() != numMsgs) {
-
-        recvQueue.disable();
+    // Resizes every subscription queue that did not pick its own depth
+    dispPool.setDefaultDepth(numMsgs);
 
-        unique_lock<mutex> lk(dispOneMutex, defer_lock);
+    return ZCM_EOK;
+}
 
-        if (block) lk.lock();
-        else if (!lk.try_lock()) {
-            recvQueue.enable();
-            return ZCM_EAGAIN;
-        }
+int zcm_blocking_t::setSendQueueLimit(uint32_t numMsgs)
+{
+    if (numMsgs == 0) return ZCM_EINVALID;
+    sendQueueLimit = numMsgs;
+    return ZCM_EOK;
+}
 
-        recvQueue.setCapacity(numMsgs);
-        recvQueue.enable();
+int zcm_blocking_t::setDispatchThreads(uint32_t nthreads)
+{
+    unique_lock<mutex> lk(recvModeMutex);
+    if (recvMode != RECV_MODE_NONE) {
+        ZCM_DEBUG("Err: call to setDispatchThreads() when 'recvMode != RECV_MODE_NONE'");
+        return ZCM_EINVALID;
     }
+    numDispThreads = nthreads;
+    dispPool.setNumWorkers(nthreads);
+    return ZCM_EOK;
+}
+
+int zcm_blocking_t::setSubQueue(zcm_sub_t* sub, uint32_t depth, zcm_queue_policy policy)
+{
+    if (!sub) return ZCM_EINVALID;
+
+    // Switch the recvThread over to (or away from) the subscription's LatestSlot first.
+    // A message still waiting in the slot is dispatched normally afterwards.
+    unique_lock<mutex> lk(subRecvMutex);
+    bool conflate = policy == ZCM_QUEUE_KEEP_LATEST;
+    if (conflate && !sub->latestobj) sub->latestobj = new LatestSlot();
+    if (sub->latestobj) ((LatestSlot*) sub->latestobj)->enabled = conflate;
+    lk.unlock();
+
+    dispPool.configureStrand((DispPool::Strand*) sub->dispatchobj, depth, policy);
+    return ZCM_EOK;
+}
 
+int zcm_blocking_t::getSubStats(zcm_sub_t* sub, zcm_sub_stats_t* stats)
+{
+    if (!sub || !stats) return ZCM_EINVALID;
+    dispPool.getStats((DispPool::Strand*) sub->dispatchobj, stats);
     return ZCM_EOK;
 }
 
@@ -587,7 +776,7 @@ void zcm_blocking_t::sendThreadFunc()
             if (sendThreadState == THREAD_STATE_HALTING) break;
         }
         unique_lock<mutex> lk(sendOneMutex);
-        sendOneMessage(true);
+        sendMessages(SEND_BATCH_MAX, true);
     }
 
     unique_lock<mutex> lk(sendStateMutex);
@@ -604,34 +793,15 @@ void zcm_blocking_t::recvThreadFunc()
             unique_lock<mutex> lk(recvStateMutex);
             if (recvThreadState == THREAD_STATE_HALTING) break;
         }
-        zcm_msg_t msg;
-        int rc = zcm_trans_recvmsg(zt, &msg, RECV_TIMEOUT);
-        if (rc == ZCM_EOK) {
-            {
-                unique_lock<mutex> lk(subRecvMutex);
-
-                // Check if message matches a non regex channel
-                auto it = subs.find(msg.channel);
-                if (it == subs.end()) {
-                    // Check if message matches a regex channel
-                    bool foundRegex = false;
-                    for (zcm_sub_t* sub : subRegex) {
-                        regex* r = (regex*)sub->regexobj;
-                        if (regex_match(msg.channel, *r)) {
-                            foundRegex = true;
-                            break;
-                        }
-                    }
-                    // No subscription actually wants the message
-                    if (!foundRegex) continue;
-                }
-            }
-
-            // Note: After this returns, you have either successfully pushed a message
-            //       into the queue, or the queue was disabled and you will quit out of
-            //       this loop when you re-check the running condition
-            recvQueue.push(&msg);
-        }
+        zcm_msg_t msgs[RECV_BATCH_MAX];
+        size_t nmsgs = 0;
+        int rc = zcm_trans_recvmsg_batch(zt, msgs, RECV_BATCH_MAX, &nmsgs, RECV_TIMEOUT);
+        // Note: After this returns, you have either queued the messages for every
+        //       subscription that wants them (or applied their queue policies), or the
+        //       dispPool was disabled and you will quit out of this loop when you
+        //       re-check the running condition
+        if (rc == ZCM_EOK)
+            for (size_t i = 0; i < nmsgs; ++i) queueMsg(&msgs[i]);
     }
     unique_lock<mutex> lk(recvStateMutex);
     recvThreadState = THREAD_STATE_HALTED;
@@ -649,24 +819,18 @@ void zcm_blocking_t::hndlThreadFunc()
         recvThread = thread{&zcm_blocking::recvThreadFunc, this};
     }
 
-    // Become the handle thread
-    while (true) {
-        {
-            unique_lock<mutex> lk(hndlStateMutex);
-            hndlPauseCond.wait(lk, [&]{
-                return !paused || hndlThreadState == THREAD_STATE_HALTING;
-            });
-            if (hndlThreadState == THREAD_STATE_HALTING) break;
-        }
-        unique_lock<mutex> lk(dispOneMutex);
-        dispatchOneMessage(true);
-    }
+    // Become dispatch thread 0 and spawn the others
+    for (size_t i = 1; i < numDispThreads; ++i)
+        dispThreads.emplace_back(&zcm_blocking::dispThreadFunc, this, i);
+    dispPool.work(0);
+    for (auto& t : dispThreads) t.join();
+    dispThreads.clear();
 
     {
         // Shutdown recv thread
         unique_lock<mutex> lk(recvStateMutex);
         recvThreadState = THREAD_STATE_HALTING;
-        recvQueue.disable();
+        dispPool.disable();
         lk.unlock();
         recvThread.join();
     }
@@ -675,73 +839,121 @@ void zcm_blocking_t::hndlThreadFunc()
     hndlThreadState = THREAD_STATE_HALTED;
 }
 
-void zcm_blocking_t::dispatchMsg(zcm_msg_t* msg)
+void zcm_blocking_t::dispThreadFunc(size_t idx)
 {
-    zcm_recv_buf_t rbuf;
-    rbuf.recv_utime = msg->utime;
-    rbuf.zcm = z;
-    rbuf.data = msg->buf;
-    rbuf.data_size = msg->len;
+    // Name the dispatch thread
+    SET_THREAD_NAME("ZeroCM_dispatch");
 
-    // Note: We use a lock on dispatch to ensure there is not
-    // a race on modifying and reading the 'subs' container.
-    // This means users cannot call zcm_subscribe or
-    // zcm_unsubscribe from a callback without deadlocking.
+    dispPool.work(idx);
+}
+
+void zcm_blocking_t::queueMsg(zcm_msg_t* msg)
+{
     {
-        unique_lock<mutex> lk(subDispMutex);
+        unique_lock<mutex> lk(subRecvMutex);
+
+        auto addTarget = [&](zcm_sub_t* sub) {
+            auto* s = (DispPool::Strand*) sub->dispatchobj;
+            LatestSlot* slot = (LatestSlot*) sub->latestobj;
+            if (slot && slot->enabled) {
+                slot->write(msg);
+                latestTargets.push_back(s->shared_from_this());
+            } else {
+                dispTargets.push_back(s->shared_from_this());
+            }
+        };
 
-        // dispatch to a non regex channel
         auto it = subs.find(msg->channel);
         if (it != subs.end()) {
-            for (zcm_sub_t* sub : it->second) {
-                sub->callback(&rbuf, msg->channel, sub->usr);
-            }
+            for (zcm_sub_t* sub : it->second) addTarget(sub);
         }
 
-        // dispatch to any regex channels
         for (zcm_sub_t* sub : subRegex) {
             regex* r = (regex*)sub->regexobj;
-            if (regex_match(msg->channel, *r)) {
-                sub->callback(&rbuf, msg->channel, sub->usr);
-            }
+            if (regex_match(msg->channel, *r)) addTarget(sub);
         }
     }
+
+    // Note: Pushing is done without holding subRecvMutex so that a subscription with a
+    //       full ZCM_QUEUE_BLOCK queue cannot stall subscribe() or unsubscribe()
+    // Note: The strand of a conflating subscription holds at most one empty MsgPtr, so
+    //       the handler runs at most once for any number of overwrites of its slot
+    for (auto& s : latestTargets) dispPool.push(s, MsgPtr());
+    latestTargets.clear();
+
+    // No other subscription wants the message
+    if (dispTargets.empty()) return;
+
+    // Note: The message is copied once and shared by every subscription it is queued on
+    MsgPtr m = make_shared<Msg>(msg);
+    for (auto& s : dispTargets) dispPool.push(s, m);
+    dispTargets.clear();
 }
 
-bool zcm_blocking_t::dispatchOneMessage(bool returnIfPaused)
+void zcm_blocking_t::dispatchToSub(zcm_sub_t* sub, MsgPtr& m)
 {
-    Msg* m = recvQueue.top();
-    // If the Queue was forcibly woken-up, recheck the
-    // running condition, and then retry.
-    if (m == nullptr) return false;
+    zcm_msg_t* msg = m->get();
 
-    if (returnIfPaused) {
-        unique_lock<mutex> lk(hndlStateMutex);
-        if (paused || hndlThreadState == THREAD_STATE_HALTING) return false;
-    }
+    zcm_recv_buf_t rbuf;
+    rbuf.recv_utime = msg->utime;
+    rbuf.zcm = z;
+    rbuf.data = msg->buf;
+    rbuf.data_size = msg->len;
 
-    dispatchMsg(m->get());
-    recvQueue.pop();
-    return true;
+    sub->callback(&rbuf, msg->channel, sub->usr);
 }
 
-bool zcm_blocking_t::sendOneMessage(bool returnIfPaused)
+void zcm_blocking_t::dispatchLatestToSub(zcm_sub_t* sub)
 {
-    Msg* m = sendQueue.top();
-    // If the Queue was forcibly woken-up, recheck the
-    // running condition, and then retry.
-    if (m == nullptr) return false;
+    LatestSlot* slot = (LatestSlot*) sub->latestobj;
+    // The slot was already dispatched by an earlier wakeup of this subscription
+    if (!slot->take()) return;
+
+    zcm_recv_buf_t rbuf;
+    rbuf.recv_utime = slot->dispUtime;
+    rbuf.zcm = z;
+    rbuf.data = slot->dispBuf.data();
+    rbuf.data_size = slot->dispBuf.size();
+
+    sub->callback(&rbuf, slot->dispChannel.c_str(), sub->usr);
+}
+
+// Returns the number of messages taken off of the sendQueue
+size_t zcm_blocking_t::sendMessages(size_t maxMsgs, bool returnIfPaused)
+{
+    // Wait for a message. If the Queue was forcibly woken-up,
+    // recheck the running condition, and then retry.
+    if (sendQueue.top() == nullptr) return 0;
 
     if (returnIfPaused) {
         unique_lock<mutex> lk(sendStateMutex);
-        if (paused || sendThreadState == THREAD_STATE_HALTING) return false;
+        if (paused || sendThreadState == THREAD_STATE_HALTING) return 0;
     }
 
-    zcm_msg_t* msg = m->get();
-    int ret = zcm_trans_sendmsg(zt, *msg);
-    if (ret != ZCM_EOK) ZCM_DEBUG("zcm_trans_sendmsg() returned error, dropping the msg!");
-    sendQueue.pop();
-    return true;
+    // Take everything that is queued (up to the batch limit) in one go. The messages are
+    // moved out of the sendQueue so publish() is free to grow it while we are sending.
+    sendQueue.popBatch(std::min(maxMsgs, SEND_BATCH_MAX),
+                       [&](Msg& m) { sendBatch.push_back(m.release()); });
+
+    size_t n = sendBatch.size();
+    size_t i = 0;
+    while (i < n) {
+        size_t nsent = 0;
+        int ret = zcm_trans_sendmsg_batch(zt, &sendBatch[i], n - i, &nsent);
+        i += nsent;
+        if (ret != ZCM_EOK) {
+            ZCM_DEBUG("zcm_trans_sendmsg() returned error, dropping the msg!");
+            ++i;
+        }
+    }
+
+    for (auto& msg : sendBatch) {
+        free((void*) msg.channel);
+        free(msg.buf);
+    }
+    sendBatch.clear();
+    sendQueued -= n;
+    return n;
 }
 
 bool zcm_blocking_t::deleteSubEntry(zcm_sub_t* sub, size_t nentriesleft)
@@ -755,11 +967,25 @@ bool zcm_blocking_t::deleteSubEntry(zcm_sub_t* sub, size_t nentriesleft)
     } else {
         rc = zcm_trans_recvmsg_enable(zt, sub->channel, false);
     }
+    delete (LatestSlot*) sub->latestobj;
     delete sub;
     return rc == ZCM_EOK;
 }
 
-bool zcm_blocking_t::deleteFromSubList(SubList& slist, zcm_sub_t* sub)
+zcm_blocking_t::SubList* zcm_blocking_t::findSubList(zcm_sub_t* sub)
+{
+    SubList* slist = &subRegex;
+    if (!sub->regex) {
+        auto it = subs.find(sub->channel);
+        if (it == subs.end()) return nullptr;
+        slist = &it->second;
+    }
+    for (zcm_sub_t* s : *slist)
+        if (s == sub) return slist;
+    return nullptr;
+}
+
+void zcm_blocking_t::removeFromSubList(SubList& slist, zcm_sub_t* sub)
 {
     for (size_t i = 0; i < slist.size(); i++) {
         if (slist[i] == sub) {
@@ -767,11 +993,9 @@ bool zcm_blocking_t::deleteFromSubList(SubList& slist, zcm_sub_t* sub)
             size_t last = slist.size()-1;
             slist[i] = slist[last];
             slist.resize(last);
-            // delete the element
-            return deleteSubEntry(sub, slist.size());
+            return;
         }
     }
-    return false;
 }
 
 /////////////// C Interface Functions ////////////////
@@ -792,16 +1016,29 @@ int zcm_blocking_publish(zcm_blocking_t* zcm, const char* channel, const uint8_t
     return zcm->publish(channel, data, len);
 }
 
+int zcm_blocking_publishv(zcm_blocking_t* zcm, const char* channel,
+                          const zcm_iovec_t* iov, uint32_t niov)
+{
+    return zcm->publishv(channel, iov, niov);
+}
+
 zcm_sub_t* zcm_blocking_subscribe(zcm_blocking_t* zcm, const char* channel,
                                   zcm_msg_handler_t cb, void* usr)
 {
-    return zcm->subscribe(channel, cb, usr, true);
+    return zcm->subscribe(channel, cb, usr, nullptr, true);
 }
 
 zcm_sub_t* zcm_blocking_try_subscribe(zcm_blocking_t* zcm, const char* channel,
                                       zcm_msg_handler_t cb, void* usr)
 {
-    return zcm->subscribe(channel, cb, usr, false);
+    return zcm->subscribe(channel, cb, usr, nullptr, false);
+}
+
+zcm_sub_t* zcm_blocking_subscribe_opts(zcm_blocking_t* zcm, const char* channel,
+                                       zcm_msg_handler_t cb, void* usr,
+                                       const zcm_sub_opts_t* opts)
+{
+    return zcm->subscribe(channel, cb, usr, opts, true);
 }
 
 int zcm_blocking_unsubscribe(zcm_blocking_t* zcm, zcm_sub_t* sub)
@@ -869,4 +1106,25 @@ int  zcm_blocking_try_set_queue_size(zcm_blocking_t* zcm, uint32_t sz)
     return zcm->setQueueSize(sz, false);
 }
 
+int  zcm_blocking_set_send_queue_limit(zcm_blocking_t* zcm, uint32_t numMsgs)
+{
+    return zcm->setSendQueueLimit(numMsgs);
+}
+
+int  zcm_blocking_set_dispatch_threads(zcm_blocking_t* zcm, uint32_t nthreads)
+{
+    return zcm->setDispatchThreads(nthreads);
+}
+
+int  zcm_blocking_set_sub_queue(zcm_blocking_t* zcm, zcm_sub_t* sub, uint32_t depth,
+                                zcm_queue_policy policy)
+{
+    return zcm->setSubQueue(sub, depth, policy);
+}
+
+int  zcm_blocking_get_sub_stats(zcm_blocking_t* zcm, zcm_sub_t* sub, zcm_sub_stats_t* stats)
+{
+    return zcm->getSubStats(sub, stats);
+}
+
 }
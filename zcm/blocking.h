@@ -14,11 +14,16 @@ void            zcm_blocking_destroy(zcm_blocking_t* zcm);
 
 int zcm_blocking_publish(zcm_blocking_t* zcm, const char* channel,
                          const uint8_t* data, uint32_t len);
+int zcm_blocking_publishv(zcm_blocking_t* zcm, const char* channel,
+                          const zcm_iovec_t* iov, uint32_t niov);
 
 zcm_sub_t* zcm_blocking_subscribe(zcm_blocking_t* zcm, const char* channel,
                                   zcm_msg_handler_t cb, void* usr);
 zcm_sub_t* zcm_blocking_try_subscribe(zcm_blocking_t* zcm, const char* channel,
                                       zcm_msg_handler_t cb, void* usr);
+zcm_sub_t* zcm_blocking_subscribe_opts(zcm_blocking_t* zcm, const char* channel,
+                                       zcm_msg_handler_t cb, void* usr,
+                                       const zcm_sub_opts_t* opts);
 
 int zcm_blocking_unsubscribe(zcm_blocking_t* zcm, zcm_sub_t* sub);
 int zcm_blocking_try_unsubscribe(zcm_blocking_t* zcm, zcm_sub_t* sub);
@@ -35,6 +40,11 @@ void zcm_blocking_resume(zcm_blocking_t* zcm);
 int  zcm_blocking_handle(zcm_blocking_t* zcm);
 void zcm_blocking_set_queue_size(zcm_blocking_t* zcm, uint32_t numMsgs);
 int  zcm_blocking_try_set_queue_size(zcm_blocking_t* zcm, uint32_t numMsgs);
+int  zcm_blocking_set_send_queue_limit(zcm_blocking_t* zcm, uint32_t numMsgs);
+int  zcm_blocking_set_dispatch_threads(zcm_blocking_t* zcm, uint32_t nthreads);
+int  zcm_blocking_set_sub_queue(zcm_blocking_t* zcm, zcm_sub_t* sub, uint32_t depth,
+                                enum zcm_queue_policy policy);
+int  zcm_blocking_get_sub_stats(zcm_blocking_t* zcm, zcm_sub_t* sub, zcm_sub_stats_t* stats);
 
 #ifdef __cplusplus
 }
@@ -18,7 +18,12 @@ public class ZCM
 
     static ZCM singleton;
 
-    ZCMDataOutputStream encodeBuffer = new ZCMDataOutputStream(new byte[1024]);
+    // Per thread, so that publish() needs no lock
+    ThreadLocal<ZCMDataOutputStream> encodeBuffers = new ThreadLocal<ZCMDataOutputStream>() {
+        protected ZCMDataOutputStream initialValue() {
+            return new ZCMDataOutputStream(new byte[1024]);
+        }
+    };
     ZCMJNI zcmjni;
 
     /** Create a new ZCM object, connecting to one or more URLs. If
@@ -70,11 +75,12 @@ public class ZCM
     /** Publish an ZCM-defined type on a channel. If more than one URL was
      * specified, the message will be sent on each.
      **/
-    public synchronized void publish(String channel, ZCMEncodable e)
+    public void publish(String channel, ZCMEncodable e)
     {
         if (this.closed) throw new IllegalStateException();
 
         try {
+            ZCMDataOutputStream encodeBuffer = encodeBuffers.get();
             encodeBuffer.reset();
 
             e.encode(encodeBuffer);
@@ -0,0 +1,10 @@
+{
+  "targets": [
+    {
+      "target_name": "zcm_node",
+      "sources": [ "zcm_node.cc" ],
+      "libraries": [ "-lzcm" ],
+      "cflags_cc": [ "-std=c++11" ]
+    }
+  ]
+}
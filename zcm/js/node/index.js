@@ -1,60 +1,76 @@
 /*******************************************************
- * NodeJS FFI bindings to ZCM
- * --------------------------
- * Could/Should be more efficent, but it should
- * suffice in the short-term
+ * NodeJS bindings to ZCM
+ * ----------------------
+ * Uses the native addon (zcm_node.cc) when it has
+ * been built and ffi otherwise
  ******************************************************/
-var ffi = require('ffi');
-var ref = require('ref');
-var StructType = require('ref-struct');
-var ArrayType = require('ref-array');
 var bigint = require('big-integer');
 var assert = require('assert');
 
-// Define some types
-var voidRef = ref.refType('void')
-var charRef = ref.refType('char')
-
-var recvBuf = StructType({
-    // Note: it is VERY important that this struct match the zcm_recv_buf_t struct in zcm.h
-    utime: ref.types.uint64,
-    zcm:   voidRef,
-    data:  charRef,
-    len:   ref.types.uint32,
-});
-var recvBufRef = ref.refType(recvBuf);
-
-var subscription = StructType({
-    // Note: it is VERY important that this struct match the zcm_sub_t struct in zcm.h
-    channel:  ArrayType(ref.types.char),
-    callback: voidRef,
-    usr:      voidRef,
-});
-var subscriptionRef = ref.refType(subscription);
-
-// Define our Foreign Function Interface to the zcm library
-var libzcm = new ffi.Library('libzcm', {
-    'zcm_retcode_name_to_enum': ['int',     ['string']],
-    'zcm_create':               ['pointer', ['string']],
-    'zcm_destroy':              ['void',    ['pointer']],
-    'zcm_publish':              ['int',     ['pointer', 'string', 'pointer', 'int']],
-    'zcm_try_subscribe':        ['pointer', ['pointer', 'string', 'pointer', 'pointer']],
-    'zcm_try_unsubscribe':      ['int',     ['pointer', 'pointer']],
-    'zcm_start':                ['void',    ['pointer']],
-    'zcm_try_stop':             ['int',     ['pointer']],
-    'zcm_try_flush':            ['int',     ['pointer']],
-    'zcm_pause':                ['void',    ['pointer']],
-    'zcm_resume':               ['void',    ['pointer']],
-    'zcm_try_set_queue_size':   ['int',     ['pointer', 'int']],
-});
-
-var ZCM_EOK              = libzcm.zcm_retcode_name_to_enum("ZCM_EOK");
-var ZCM_EINVALID         = libzcm.zcm_retcode_name_to_enum("ZCM_EINVALID");
-var ZCM_EAGAIN           = libzcm.zcm_retcode_name_to_enum("ZCM_EAGAIN");
-var ZCM_ECONNECT         = libzcm.zcm_retcode_name_to_enum("ZCM_ECONNECT");
-var ZCM_EINTR            = libzcm.zcm_retcode_name_to_enum("ZCM_EINTR");
-var ZCM_EUNKNOWN         = libzcm.zcm_retcode_name_to_enum("ZCM_EUNKNOWN");
-var ZCM_NUM_RETURN_CODES = libzcm.zcm_retcode_name_to_enum("ZCM_NUM_RETURN_CODES");
+// Prefer the native addon, which hands received messages to JS in batches and
+// publishes without going through ffi. Fall back to ffi when it isn't built.
+var native = null;
+try {
+    native = require('./build/Release/zcm_node.node');
+} catch (e) {}
+
+if (!native) {
+    var ffi = require('ffi');
+    var ref = require('ref');
+    var StructType = require('ref-struct');
+    var ArrayType = require('ref-array');
+
+    // Define some types
+    var voidRef = ref.refType('void')
+    var charRef = ref.refType('char')
+
+    var recvBuf = StructType({
+        // Note: it is VERY important that this struct match the zcm_recv_buf_t struct in zcm.h
+        utime: ref.types.uint64,
+        zcm:   voidRef,
+        data:  charRef,
+        len:   ref.types.uint32,
+    });
+    var recvBufRef = ref.refType(recvBuf);
+
+    var subscription = StructType({
+        // Note: it is VERY important that this struct match the zcm_sub_t struct in zcm.h
+        channel:  ArrayType(ref.types.char),
+        callback: voidRef,
+        usr:      voidRef,
+    });
+    var subscriptionRef = ref.refType(subscription);
+
+    // Define our Foreign Function Interface to the zcm library
+    var libzcm = new ffi.Library('libzcm', {
+        'zcm_retcode_name_to_enum': ['int',     ['string']],
+        'zcm_create':               ['pointer', ['string']],
+        'zcm_destroy':              ['void',    ['pointer']],
+        'zcm_publish':              ['int',     ['pointer', 'string', 'pointer', 'int']],
+        'zcm_try_subscribe':        ['pointer', ['pointer', 'string', 'pointer', 'pointer']],
+        'zcm_try_unsubscribe':      ['int',     ['pointer', 'pointer']],
+        'zcm_start':                ['void',    ['pointer']],
+        'zcm_try_stop':             ['int',     ['pointer']],
+        'zcm_try_flush':            ['int',     ['pointer']],
+        'zcm_pause':                ['void',    ['pointer']],
+        'zcm_resume':               ['void',    ['pointer']],
+        'zcm_try_set_queue_size':   ['int',     ['pointer', 'int']],
+        'zcm_set_sub_queue':        ['int',     ['pointer', 'pointer', 'int', 'int']],
+    });
+}
+
+function retcode(name)
+{
+    return native ? native[name] : libzcm.zcm_retcode_name_to_enum(name);
+}
+
+var ZCM_EOK              = retcode("ZCM_EOK");
+var ZCM_EINVALID         = retcode("ZCM_EINVALID");
+var ZCM_EAGAIN           = retcode("ZCM_EAGAIN");
+var ZCM_ECONNECT         = retcode("ZCM_ECONNECT");
+var ZCM_EINTR            = retcode("ZCM_EINTR");
+var ZCM_EUNKNOWN         = retcode("ZCM_EUNKNOWN");
+var ZCM_NUM_RETURN_CODES = retcode("ZCM_NUM_RETURN_CODES");
 
 exports.ZCM_EOK              = ZCM_EOK;
 exports.ZCM_EINVALID         = ZCM_EINVALID;
@@ -64,6 +80,12 @@ exports.ZCM_EINTR            = ZCM_EINTR;
 exports.ZCM_EUNKNOWN         = ZCM_EUNKNOWN;
 exports.ZCM_NUM_RETURN_CODES = ZCM_NUM_RETURN_CODES;
 
+// Subscription queue policies, as in zcm.h
+exports.ZCM_QUEUE_BLOCK       = 0;
+exports.ZCM_QUEUE_DROP_OLDEST = 1;
+exports.ZCM_QUEUE_DROP_NEWEST = 2;
+exports.ZCM_QUEUE_KEEP_LATEST = 3;
+
 /**
  * Callback that handles data received on the zcm transport which this program has subscribed to
  * @callback dispatchRawCallback
@@ -128,12 +150,32 @@ function zcm(zcmtypes, zcmurl)
     }
     rehashTypes(zcmtypes);
 
-    var z = libzcm.zcm_create(zcmurl);
-    if (z.isNull()) {
-        return null;
+    // Native subscriptions deliver messages through dispatchBatch, by subscription id
+    var subCallbacks = {};
+    var nextSubId = 0;
+
+    function dispatchBatch(subIds, channels, buffers)
+    {
+        for (var i = 0; i < subIds.length; ++i) {
+            var cb = subCallbacks[subIds[i]];
+            if (cb) cb(channels[i], buffers[i]);
+        }
     }
 
-    libzcm.zcm_start(z);
+    var z;
+    if (native) {
+        z = native.create(zcmurl, dispatchBatch);
+        if (z === null) {
+            return null;
+        }
+        native.start(z);
+    } else {
+        z = libzcm.zcm_create(zcmurl);
+        if (z.isNull()) {
+            return null;
+        }
+        libzcm.zcm_start(z);
+    }
 
     /**
      * Publishes a zcm message on the created transport
@@ -154,7 +196,27 @@ function zcm(zcmtypes, zcmurl)
      */
     function publish_raw(channel, data)
     {
-        libzcm.zcm_publish.async(z, channel, data, data.length, function (err, res) {});
+        if (native) {
+            native.publish(z, channel, data);
+        } else {
+            libzcm.zcm_publish.async(z, channel, data, data.length, function (err, res) {});
+        }
+    }
+
+    /**
+     * Publishes many zcm messages on the created transport in one call
+     * @param {string[]} channels - the zcm channel to publish each message on
+     * @param {zcmtype[]} msgs - the decoded messages (must be zcmtypes)
+     * @returns {number} the number of leading messages that were queued for publishing
+     */
+    function publishBatch(channels, msgs)
+    {
+        var datas = msgs.map(function (msg) {
+            return zcmtypeHashMap[msg.__hash].encode(msg);
+        });
+        if (native) return native.publishBatch(z, channels, datas);
+        for (var i = 0; i < datas.length; ++i) publish_raw(channels[i], datas[i]);
+        return datas.length;
     }
 
     /**
@@ -164,8 +226,12 @@ function zcm(zcmtypes, zcmurl)
      *                        type from zcmtypes.js)
      * @param {dispatchDecodedCallback} cb - callback to handle received messages
      * @param {successCb} successCb - callback for successful subscription
+     * @param {Object} [opts] - the subscription's dispatch queue: queueDepth (0 follows
+     *                          setQueueSize) and queuePolicy (one of the ZCM_QUEUE_*
+     *                          exports), which decides what happens to messages that
+     *                          arrive while that many are waiting for this process
      */
-    function subscribe(channel, _type, cb, successCb)
+    function subscribe(channel, _type, cb, successCb, opts)
     {
         if (_type) {
             // Note: this lookup is because the type that is given by a client doesn't have
@@ -175,9 +241,9 @@ function zcm(zcmtypes, zcmurl)
             var sub = subscribe_raw(channel, function (channel, data) {
                 var msg = type.decode(data)
                 if (msg != null) cb(channel, msg);
-            }, successCb);
+            }, successCb, opts);
         } else {
-            var sub = subscribe_raw(channel, cb, successCb);
+            var sub = subscribe_raw(channel, cb, successCb, opts);
         }
     }
 
@@ -186,10 +252,27 @@ function zcm(zcmtypes, zcmurl)
      * @param {string} channel - the zcm channel to subscribe to
      * @param {dispatchRawCallback} cb - callback to handle received messages
      * @param {successCb} successCb - callback for successful subscription
+     * @param {Object} [opts] - the subscription's dispatch queue, as in subscribe()
      */
-    function subscribe_raw(channel, cb, successCb)
+    function subscribe_raw(channel, cb, successCb, opts)
     {
         if (!successCb) assert(false, "subcribe requires a success callback to be specified");
+        var depth  = (opts && opts.queueDepth)  || 0;
+        var policy = (opts && opts.queuePolicy) || exports.ZCM_QUEUE_BLOCK;
+        if (native) {
+            var subId = nextSubId++;
+            subCallbacks[subId] = cb;
+            setTimeout(function sub() {
+                var subs = native.trySubscribe(z, channel, subId, depth, policy);
+                if (subs === null) {
+                    setTimeout(sub, 0);
+                    return;
+                }
+                successCb({"subscription" : subs,
+                           "subId"        : subId});
+            }, 0);
+            return;
+        }
         var dispatcher = makeDispatcher(cb);
         var funcPtr = ffi.Callback('void', [recvBufRef, 'string', 'pointer'], dispatcher);
         setTimeout(function sub() {
@@ -198,6 +281,8 @@ function zcm(zcmtypes, zcmurl)
                 setTimeout(sub, 0);
                 return;
             }
+            if (depth != 0 || policy != exports.ZCM_QUEUE_BLOCK)
+                libzcm.zcm_set_sub_queue(z, subs, depth, policy);
             successCb({"subscription"      : subs,
                        "nativeCallbackPtr" : funcPtr,
                        "dispatcher"        : dispatcher});
@@ -212,11 +297,13 @@ function zcm(zcmtypes, zcmurl)
     function unsubscribe(subscription, successCb)
     {
         setTimeout(function unsub() {
-            var ret = libzcm.zcm_try_unsubscribe(z, subscription.subscription);
+            var ret = native ? native.tryUnsubscribe(z, subscription.subscription)
+                             : libzcm.zcm_try_unsubscribe(z, subscription.subscription);
             if (ret != ZCM_EOK) {
                 setTimeout(unsub, 0);
                 return;
             }
+            if (native) delete subCallbacks[subscription.subId];
             if (successCb) successCb();
         }, 0)
     }
@@ -228,7 +315,7 @@ function zcm(zcmtypes, zcmurl)
     function flush(doneCb)
     {
         setTimeout(function f() {
-            var ret = libzcm.zcm_try_flush(z);
+            var ret = native ? native.tryFlush(z) : libzcm.zcm_try_flush(z);
             if (ret != ZCM_EOK) {
                 setTimeout(f, 0);
                 return;
@@ -242,7 +329,8 @@ function zcm(zcmtypes, zcmurl)
      */
     function start()
     {
-        libzcm.zcm_start(z);
+        if (native) native.start(z);
+        else libzcm.zcm_start(z);
     }
 
     /**
@@ -252,7 +340,7 @@ function zcm(zcmtypes, zcmurl)
     function stop(stoppedCb)
     {
         setTimeout(function s() {
-            var ret = libzcm.zcm_try_stop(z);
+            var ret = native ? native.tryStop(z) : libzcm.zcm_try_stop(z);
             if (ret != ZCM_EOK) {
                 setTimeout(s, 0);
                 return;
@@ -266,7 +354,8 @@ function zcm(zcmtypes, zcmurl)
      */
     function pause()
     {
-        libzcm.zcm_pause(z);
+        if (native) native.pause(z);
+        else libzcm.zcm_pause(z);
     }
 
     /**
@@ -274,7 +363,8 @@ function zcm(zcmtypes, zcmurl)
      */
     function resume()
     {
-        libzcm.zcm_resume(z);
+        if (native) native.resume(z);
+        else libzcm.zcm_resume(z);
     }
 
     /**
@@ -283,7 +373,8 @@ function zcm(zcmtypes, zcmurl)
     function setQueueSize(sz, cb)
     {
         setTimeout(function s() {
-            var ret = libzcm.zcm_try_set_queue_size(z, sz);
+            var ret = native ? native.trySetQueueSize(z, sz)
+                             : libzcm.zcm_try_set_queue_size(z, sz);
             if (ret != ZCM_EOK) {
                 setTimeout(s, 0);
                 return;
@@ -294,6 +385,7 @@ function zcm(zcmtypes, zcmurl)
 
     return {
         publish:        publish,
+        publishBatch:   publishBatch,
         subscribe:      subscribe,
         unsubscribe:    unsubscribe,
         flush:          flush,
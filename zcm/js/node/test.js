@@ -0,0 +1,86 @@
+/*******************************************************
+ * Publish / subscribe smoke test of the native addon
+ * --------------------------------------------------
+ * Run with "npm test" once the addon has been built
+ ******************************************************/
+var assert = require('assert');
+
+require('./build/Release/zcm_node.node');
+var zcm = require('./index.js');
+
+// Stands in for a generated zcmtype: the message is its own encoding
+function raw_t() {}
+raw_t.__get_hash_recursive = function () { return '1'; };
+raw_t.encode = function (msg) { return msg.data; };
+
+function message(seq)
+{
+    var data = Buffer.alloc(16);
+    data.writeUInt32LE(seq, 0);
+    return { __hash: '1', data: data };
+}
+
+// Every message published in batches arrives once and in order
+function testInOrder(z, done)
+{
+    var N = 20000;
+    var next = 0;
+    var sub;
+    z.subscribe('IN_ORDER', null, function (channel, data) {
+        assert.equal(channel, 'IN_ORDER');
+        assert.equal(data.length, 16);
+        assert.equal(data.readUInt32LE(0), next++);
+        if (next == N) z.unsubscribe(sub, done);
+    }, function (s) {
+        sub = s;
+        var sent = 0;
+        (function publish() {
+            var channels = [], msgs = [];
+            for (var i = sent; i < N && i < sent + 1000; ++i) {
+                channels.push('IN_ORDER');
+                msgs.push(message(i));
+            }
+            sent += z.publishBatch(channels, msgs);
+            if (sent < N) setImmediate(publish);
+        })();
+    });
+}
+
+// While JS is busy, a subscription only buffers a bounded number of messages and its
+// queue policy decides which of the rest survive
+function testBounded(z, done)
+{
+    var N = 5000;
+    var received = [];
+    var sub;
+    z.subscribe('BOUNDED', null, function (channel, data) {
+        received.push(data.readUInt32LE(0));
+        if (received[received.length - 1] != N - 1) return;
+        assert(received.length < N, 'no message was dropped');
+        for (var i = 1; i < received.length; ++i) assert(received[i] > received[i - 1]);
+        z.unsubscribe(sub, done);
+    }, function (s) {
+        sub = s;
+        for (var i = 0; i < N; ++i) assert.equal(z.publishBatch(['BOUNDED'], [message(i)]), 1);
+        // Keep the JS thread from taking any messages until all of them were received
+        var until = Date.now() + 500;
+        while (Date.now() < until) {}
+    }, { queueDepth: 16, queuePolicy: zcm.ZCM_QUEUE_DROP_OLDEST });
+}
+
+var z = zcm.create({ raw_t: raw_t }, 'block-inproc');
+assert(z, 'unable to create zcm');
+
+var timeout = setTimeout(function () {
+    console.log('Timed out');
+    process.exit(1);
+}, 20000);
+
+testInOrder(z, function () {
+    testBounded(z, function () {
+        z.stop(function () {
+            clearTimeout(timeout);
+            console.log('Success!');
+        });
+    });
+});
@@ -0,0 +1,441 @@
+/*******************************************************
+ * Native NodeJS bindings to ZCM
+ * -----------------------------
+ * Messages are copied once off of the zcm dispatch thread
+ * and handed to JS in batches, one call per event loop
+ * tick, as Buffers over that native memory. Publishing
+ * goes straight to zcm_publish(), optionally many
+ * messages per call.
+ *
+ * The copy is needed because zcm only lends a message to
+ * its handler until the handler returns, while JS reads
+ * it some time later on another thread. Holding the
+ * handler until then would hand JS one message per tick.
+ ******************************************************/
+#define NAPI_VERSION 4
+#include <node_api.h>
+
+#include <zcm/zcm.h>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Most messages of one subscription that may wait for JS. Past this, its handler waits
+// too, so further messages back up in the subscription's zcm dispatch queue, whose
+// depth and policy decide what happens to them.
+#define PENDING_MAX 1024
+
+#define NAPI_CALL(env, call)                                        \
+    do {                                                            \
+        if ((call) != napi_ok) {                                    \
+            napi_throw_error((env), NULL, "zcm: " #call " failed"); \
+            return NULL;                                            \
+        }                                                           \
+    } while (0)
+
+struct Instance;
+
+struct Sub
+{
+    Instance*  inst;
+    uint32_t   id;
+    zcm_sub_t* sub;
+    uint32_t   npending; // protected by the Instance's pendingLock
+};
+
+struct Msg
+{
+    uint32_t subId;
+    string   channel;
+    uint8_t* data;
+    uint32_t len;
+};
+
+struct Instance
+{
+    zcm_t* zcm;
+    napi_threadsafe_function tsfn;
+
+    // Filled by the dispatch thread, emptied by the JS thread once per batch
+    mutex              pendingLock;
+    condition_variable pendingTaken;
+    vector<Msg>        pending;
+    bool               closing = false;
+
+    set<Sub*> subs;
+};
+
+static void freeData(napi_env env, void* data, void* hint)
+{
+    free(data);
+}
+
+// zcm dispatch thread: copy the message and schedule a batch if there isn't one already
+static void handler(const zcm_recv_buf_t* rbuf, const char* channel, void* usr)
+{
+    Sub* sub = (Sub*) usr;
+    Instance* inst = sub->inst;
+
+    Msg msg;
+    msg.subId = sub->id;
+    msg.channel = channel;
+    msg.len = rbuf->data_size;
+    msg.data = (uint8_t*) malloc(msg.len > 0 ? msg.len : 1);
+    if (!msg.data) return;
+    memcpy(msg.data, rbuf->data, msg.len);
+
+    bool first;
+    {
+        unique_lock<mutex> lk(inst->pendingLock);
+        inst->pendingTaken.wait(lk, [&]() {
+            return inst->closing || sub->npending < PENDING_MAX;
+        });
+        if (inst->closing) {
+            free(msg.data);
+            return;
+        }
+        first = inst->pending.empty();
+        inst->pending.push_back(std::move(msg));
+        ++sub->npending;
+    }
+    if (first) napi_call_threadsafe_function(inst->tsfn, NULL, napi_tsfn_nonblocking);
+}
+
+// JS thread: hand everything pending to the JS dispatcher as
+// onBatch(subIds, channels, buffers)
+static void callJs(napi_env env, napi_value onBatch, void* context, void* data)
+{
+    Instance* inst = (Instance*) context;
+
+    vector<Msg> msgs;
+    {
+        unique_lock<mutex> lk(inst->pendingLock);
+        msgs.swap(inst->pending);
+        for (auto s : inst->subs) s->npending = 0;
+    }
+    inst->pendingTaken.notify_all();
+    if (env == NULL || msgs.empty()) {
+        for (auto& m : msgs) free(m.data);
+        return;
+    }
+
+    napi_value subIds, channels, buffers;
+    napi_create_array_with_length(env, msgs.size(), &subIds);
+    napi_create_array_with_length(env, msgs.size(), &channels);
+    napi_create_array_with_length(env, msgs.size(), &buffers);
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        napi_value v;
+        napi_create_uint32(env, msgs[i].subId, &v);
+        napi_set_element(env, subIds, i, v);
+        napi_create_string_utf8(env, msgs[i].channel.c_str(), msgs[i].channel.size(), &v);
+        napi_set_element(env, channels, i, v);
+        if (napi_create_external_buffer(env, msgs[i].len, msgs[i].data,
+                                        freeData, NULL, &v) != napi_ok) {
+            free(msgs[i].data);
+            napi_get_null(env, &v);
+        }
+        napi_set_element(env, buffers, i, v);
+    }
+
+    napi_value undefined, argv[3] = { subIds, channels, buffers };
+    napi_get_undefined(env, &undefined);
+    napi_call_function(env, undefined, onBatch, 3, argv, NULL);
+}
+
+static void destroyInstance(Instance* inst)
+{
+    if (inst->zcm) {
+        // Handlers waiting for JS to make room give up, and none run once zcm is destroyed
+        {
+            unique_lock<mutex> lk(inst->pendingLock);
+            inst->closing = true;
+        }
+        inst->pendingTaken.notify_all();
+        zcm_destroy(inst->zcm);
+        inst->zcm = NULL;
+        napi_release_threadsafe_function(inst->tsfn, napi_tsfn_abort);
+        for (auto s : inst->subs) delete s;
+        inst->subs.clear();
+        for (auto& m : inst->pending) free(m.data);
+        inst->pending.clear();
+    }
+}
+
+static void finalizeInstance(napi_env env, void* data, void* hint)
+{
+    Instance* inst = (Instance*) data;
+    destroyInstance(inst);
+    delete inst;
+}
+
+/********************** ARGUMENT HELPERS **********************/
+static Instance* getInstance(napi_env env, napi_value v)
+{
+    void* inst = NULL;
+    if (napi_get_value_external(env, v, &inst) != napi_ok || !inst) {
+        napi_throw_type_error(env, NULL, "zcm: expected a zcm instance");
+        return NULL;
+    }
+    if (!((Instance*) inst)->zcm) {
+        napi_throw_error(env, NULL, "zcm: instance has been destroyed");
+        return NULL;
+    }
+    return (Instance*) inst;
+}
+
+static bool getString(napi_env env, napi_value v, string& out)
+{
+    size_t len;
+    if (napi_get_value_string_utf8(env, v, NULL, 0, &len) != napi_ok) {
+        napi_throw_type_error(env, NULL, "zcm: expected a string");
+        return false;
+    }
+    out.resize(len + 1);
+    napi_get_value_string_utf8(env, v, &out[0], len + 1, &len);
+    out.resize(len);
+    return true;
+}
+
+static napi_value makeInt(napi_env env, int32_t i)
+{
+    napi_value ret;
+    napi_create_int32(env, i, &ret);
+    return ret;
+}
+
+// Gets the zcm instance out of argv[0] of a function called with up to N arguments
+#define GET_ARGS(N)                                                 \
+    size_t argc = N;                                                \
+    napi_value argv[N];                                             \
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL)); \
+    Instance* inst = getInstance(env, argv[0]);                     \
+    if (!inst) return NULL
+
+/********************** METHODS **********************/
+
+// create(url, onBatch) -> instance or null
+static napi_value create(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    napi_valuetype urlType;
+    NAPI_CALL(env, napi_typeof(env, argv[0], &urlType));
+    string url;
+    if (urlType != napi_null && urlType != napi_undefined && !getString(env, argv[0], url))
+        return NULL;
+
+    napi_value ret;
+    zcm_t* z = zcm_create(url.empty() ? NULL : url.c_str());
+    if (!z) {
+        NAPI_CALL(env, napi_get_null(env, &ret));
+        return ret;
+    }
+    // Blocking zcm publishes by queueing for its send thread, so publish() never waits
+    // on the transport from the JS thread. Nonblocking transports would.
+    if (z->type != ZCM_BLOCKING) {
+        zcm_destroy(z);
+        napi_throw_error(env, NULL, "zcm: only blocking transports are supported");
+        return NULL;
+    }
+
+    Instance* inst = new Instance();
+    inst->zcm = z;
+
+    napi_value name;
+    NAPI_CALL(env, napi_create_string_utf8(env, "zcm", NAPI_AUTO_LENGTH, &name));
+    if (napi_create_threadsafe_function(env, argv[1], NULL, name, 0, 1, NULL, NULL,
+                                        inst, callJs, &inst->tsfn) != napi_ok) {
+        zcm_destroy(z);
+        delete inst;
+        napi_throw_error(env, NULL, "zcm: unable to create the dispatch function");
+        return NULL;
+    }
+    // Only keep node running while there are subscriptions, like a listening socket
+    napi_unref_threadsafe_function(env, inst->tsfn);
+
+    NAPI_CALL(env, napi_create_external(env, inst, finalizeInstance, NULL, &ret));
+    return ret;
+}
+
+static napi_value destroy(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(1);
+    destroyInstance(inst);
+    return NULL;
+}
+
+static napi_value start(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(1);
+    zcm_start(inst->zcm);
+    return NULL;
+}
+
+static napi_value tryStop(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(1);
+    return makeInt(env, zcm_try_stop(inst->zcm));
+}
+
+static napi_value pause(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(1);
+    zcm_pause(inst->zcm);
+    return NULL;
+}
+
+static napi_value resume(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(1);
+    zcm_resume(inst->zcm);
+    return NULL;
+}
+
+static napi_value tryFlush(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(1);
+    return makeInt(env, zcm_try_flush(inst->zcm));
+}
+
+static napi_value trySetQueueSize(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(2);
+    uint32_t sz;
+    NAPI_CALL(env, napi_get_value_uint32(env, argv[1], &sz));
+    return makeInt(env, zcm_try_set_queue_size(inst->zcm, sz));
+}
+
+// trySubscribe(zcm, channel, subId, queueDepth, queuePolicy)
+//     -> subscription or null if zcm is busy
+static napi_value trySubscribe(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(5);
+    string channel;
+    if (!getString(env, argv[1], channel)) return NULL;
+    uint32_t id, depth, policy;
+    NAPI_CALL(env, napi_get_value_uint32(env, argv[2], &id));
+    NAPI_CALL(env, napi_get_value_uint32(env, argv[3], &depth));
+    NAPI_CALL(env, napi_get_value_uint32(env, argv[4], &policy));
+    if (policy > ZCM_QUEUE_KEEP_LATEST) {
+        napi_throw_range_error(env, NULL, "zcm: invalid queue policy");
+        return NULL;
+    }
+
+    Sub* sub = new Sub { inst, id, NULL, 0 };
+    sub->sub = zcm_try_subscribe(inst->zcm, channel.c_str(), handler, sub);
+
+    napi_value ret;
+    if (!sub->sub) {
+        delete sub;
+        NAPI_CALL(env, napi_get_null(env, &ret));
+        return ret;
+    }
+    if (depth != 0 || policy != ZCM_QUEUE_BLOCK)
+        zcm_set_sub_queue(inst->zcm, sub->sub, depth, (enum zcm_queue_policy) policy);
+    if (inst->subs.empty()) napi_ref_threadsafe_function(env, inst->tsfn);
+    inst->subs.insert(sub);
+    NAPI_CALL(env, napi_create_external(env, sub, NULL, NULL, &ret));
+    return ret;
+}
+
+static napi_value tryUnsubscribe(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(2);
+    void* p;
+    NAPI_CALL(env, napi_get_value_external(env, argv[1], &p));
+    Sub* sub = (Sub*) p;
+    if (!inst->subs.count(sub)) return makeInt(env, ZCM_EINVALID);
+
+    int ret = zcm_try_unsubscribe(inst->zcm, sub->sub);
+    if (ret == ZCM_EOK) {
+        inst->subs.erase(sub);
+        delete sub;
+        if (inst->subs.empty()) napi_unref_threadsafe_function(env, inst->tsfn);
+    }
+    return makeInt(env, ret);
+}
+
+static bool publishOne(napi_env env, Instance* inst, napi_value chan, napi_value buf,
+                       int* ret)
+{
+    string channel;
+    if (!getString(env, chan, channel)) return false;
+    void* data;
+    size_t len;
+    if (napi_get_buffer_info(env, buf, &data, &len) != napi_ok) {
+        napi_throw_type_error(env, NULL, "zcm: expected a Buffer");
+        return false;
+    }
+    *ret = zcm_publish(inst->zcm, channel.c_str(), (const uint8_t*) data, len);
+    return true;
+}
+
+// publish(zcm, channel, buffer) -> return code
+static napi_value publish(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(3);
+    int ret;
+    if (!publishOne(env, inst, argv[1], argv[2], &ret)) return NULL;
+    return makeInt(env, ret);
+}
+
+// publishBatch(zcm, channels, buffers) -> number of leading messages that were published
+static napi_value publishBatch(napi_env env, napi_callback_info info)
+{
+    GET_ARGS(3);
+    uint32_t n, nbufs;
+    NAPI_CALL(env, napi_get_array_length(env, argv[1], &n));
+    NAPI_CALL(env, napi_get_array_length(env, argv[2], &nbufs));
+    if (nbufs < n) n = nbufs;
+
+    uint32_t i;
+    for (i = 0; i < n; ++i) {
+        napi_value chan, buf;
+        NAPI_CALL(env, napi_get_element(env, argv[1], i, &chan));
+        NAPI_CALL(env, napi_get_element(env, argv[2], i, &buf));
+        int ret;
+        if (!publishOne(env, inst, chan, buf, &ret)) return NULL;
+        if (ret != ZCM_EOK) break;
+    }
+    return makeInt(env, i);
+}
+
+static napi_value init(napi_env env, napi_value exports)
+{
+    napi_property_descriptor props[] = {
+        { "create",          NULL, create,          NULL, NULL, NULL, napi_default, NULL },
+        { "destroy",         NULL, destroy,         NULL, NULL, NULL, napi_default, NULL },
+        { "start",           NULL, start,           NULL, NULL, NULL, napi_default, NULL },
+        { "tryStop",         NULL, tryStop,         NULL, NULL, NULL, napi_default, NULL },
+        { "pause",           NULL, pause,           NULL, NULL, NULL, napi_default, NULL },
+        { "resume",          NULL, resume,          NULL, NULL, NULL, napi_default, NULL },
+        { "tryFlush",        NULL, tryFlush,        NULL, NULL, NULL, napi_default, NULL },
+        { "trySetQueueSize", NULL, trySetQueueSize, NULL, NULL, NULL, napi_default, NULL },
+        { "trySubscribe",    NULL, trySubscribe,    NULL, NULL, NULL, napi_default, NULL },
+        { "tryUnsubscribe",  NULL, tryUnsubscribe,  NULL, NULL, NULL, napi_default, NULL },
+        { "publish",         NULL, publish,         NULL, NULL, NULL, napi_default, NULL },
+        { "publishBatch",    NULL, publishBatch,    NULL, NULL, NULL, napi_default, NULL },
+        { "ZCM_EOK",         NULL, NULL, NULL, NULL, makeInt(env, ZCM_EOK),      napi_default, NULL },
+        { "ZCM_EINVALID",    NULL, NULL, NULL, NULL, makeInt(env, ZCM_EINVALID), napi_default, NULL },
+        { "ZCM_EAGAIN",      NULL, NULL, NULL, NULL, makeInt(env, ZCM_EAGAIN),   napi_default, NULL },
+        { "ZCM_ECONNECT",    NULL, NULL, NULL, NULL, makeInt(env, ZCM_ECONNECT), napi_default, NULL },
+        { "ZCM_EINTR",       NULL, NULL, NULL, NULL, makeInt(env, ZCM_EINTR),    napi_default, NULL },
+        { "ZCM_EUNKNOWN",    NULL, NULL, NULL, NULL, makeInt(env, ZCM_EUNKNOWN), napi_default, NULL },
+        { "ZCM_NUM_RETURN_CODES", NULL, NULL, NULL, NULL,
+          makeInt(env, ZCM_NUM_RETURN_CODES), napi_default, NULL },
+    };
+    NAPI_CALL(env, napi_define_properties(env, exports,
+                                          sizeof(props) / sizeof(props[0]), props));
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, init)
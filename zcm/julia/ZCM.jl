@@ -54,9 +54,58 @@ function decode(::Type{AbstractZcmType}, data::Vector{UInt8}) end
 function getHash(::Type{AbstractZcmType}) end
 function _get_hash_recursive(::Type{AbstractZcmType}, parents::Array{String}) end
 function _encode_one(msg::AbstractZcmType, buf) end
-function _decode_one(::Type{AbstractZcmType}, buf) end
+# Decodes the message starting at data[pos], returning it and the position just after it
+function _decode_one(::Type{AbstractZcmType}, data::Vector{UInt8}, pos::Int) end
 # TODO: would be nice to have getEncodedSize() and _getEncodedSizeNoHash()
 
+function _decode_one{T <: AbstractZcmType}(::Type{T}, buf::IOBuffer)
+    # buf.data can run past the bytes that buf holds
+    data = length(buf.data) == buf.size ? buf.data : buf.data[1:buf.size]
+    msg, pos = _decode_one(T, data, position(buf) + 1)
+    seek(buf, pos - 1)
+    return msg
+end
+
+# Helpers for the decoders of generated types, which read straight out of the
+# message rather than through an IOBuffer
+# A message that ends before the n bytes at data[pos] fails like any other bad message
+@inline function _check_bounds(data::Vector{UInt8}, pos::Int, n::Integer)
+    if pos + n - 1 > length(data)
+        throw("Decode error: message too short")
+    end
+end
+
+# Lengths and array dimensions as read off the wire
+@inline function _check_length(n::Integer)
+    if n < 0
+        throw("Decode error: negative length")
+    end
+end
+
+# Does not check bounds
+@inline function _load{T}(::Type{T}, data::Vector{UInt8}, pos::Int)
+    return unsafe_load(convert(Ptr{T}, pointer(data, pos)))
+end
+
+# The n values starting at data[pos], with swap (ntoh or ltoh) applied to each
+function _load_array{T}(::Type{T}, swap, data::Vector{UInt8}, pos::Int, n::Integer)
+    _check_bounds(data, pos, n * sizeof(T))
+    a = Array{T}(n)
+    unsafe_copy!(pointer(a), convert(Ptr{T}, pointer(data, pos)), n)
+    if sizeof(T) > 1
+        map!(swap, a, a)
+    end
+    return a
+end
+
+function _load_array(::Type{Bool}, swap, data::Vector{UInt8}, pos::Int, n::Integer)
+    _check_bounds(data, pos, n)
+    a = Array{Bool}(n)
+    @inbounds for i = 1:n
+        a[i] = data[pos + i - 1] != 0x00
+    end
+    return a
+end
 
 # Note: Julia requires that the memory layout of the C structs is consistent
 #       between their definitions in zcm headers and this file
@@ -180,19 +229,36 @@ then they will also be passed to the handler each time it is called. So:
 will cause `handler()` to be invoked with:
 
     handler(rbuf, channel, msgdata, X, Y, Z)
+
+By default, the zcm thread that dispatches a message waits until the Julia event
+loop has run `handler`. With `queued=true` the message is copied into a queue
+instead and the event loop handles every queued message each time it wakes up,
+so a slow handler no longer holds up the zcm threads. The zcm thread only waits
+once `max_queued` messages are outstanding, at which point the subscription's
+own queue policy takes over.
 """
 function subscribe(zcm::Zcm, channel::AbstractString,
                    handler,
                    msgtype=Void,
-                   additional_args...)
+                   additional_args...;
+                   queued::Bool=false,
+                   max_queued::Integer=1024)
     callback = typed_handler(handler, msgtype, additional_args...)
     c_handler = cfunction(handler_wrapper, Void,
                           (Ref{Native.RecvBuf}, Cstring, Ref{typeof(callback)}))
-    uv_wrapper = ccall(("uv_zcm_msg_handler_create", "libzcmjulia"),
-                       Ptr{Native.UvSub},
-                       (Ptr{Void}, Ptr{Void}),
-                       c_handler, Ref(callback))
-    uv_handler = cglobal(("uv_zcm_msg_handler_trigger", "libzcmjulia"))
+    if queued
+        uv_wrapper = ccall(("uv_zcm_msg_handler_create_queued", "libzcmjulia"),
+                           Ptr{Native.UvSub},
+                           (Ptr{Void}, Ptr{Void}, Csize_t),
+                           c_handler, Ref(callback), max_queued)
+        uv_handler = cglobal(("uv_zcm_msg_handler_trigger_queued", "libzcmjulia"))
+    else
+        uv_wrapper = ccall(("uv_zcm_msg_handler_create", "libzcmjulia"),
+                           Ptr{Native.UvSub},
+                           (Ptr{Void}, Ptr{Void}),
+                           c_handler, Ref(callback))
+        uv_handler = cglobal(("uv_zcm_msg_handler_trigger", "libzcmjulia"))
+    end
     try_sub = () -> ccall(("zcm_try_subscribe", "libzcm"), Ptr{Native.Sub},
                           (Ptr{Native.Zcm}, Cstring, Ptr{Void}, Ptr{Native.UvSub}),
                           zcm, channel, uv_handler, uv_wrapper)
@@ -2,11 +2,25 @@
 
 #include <iostream>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
 #include <thread>
 #include "julia/uv.h"
 
 using namespace std;
 
+// A message copied off of the dispatch thread in queued mode. The channel and the
+// payload live in the same allocation, right after the struct.
+struct uv_zcm_queued_msg_t
+{
+    uv_zcm_queued_msg_t* next;
+    zcm_recv_buf_t rbuf;
+    const char* channel;
+};
+
 struct uv_zcm_msg_handler_t
 {
     zcm_msg_handler_t cb;
@@ -17,8 +31,47 @@ struct uv_zcm_msg_handler_t
 	uv_barrier_t blocker;
     uv_async_t handle;
     std::thread::id main_thread_id;
+
+    // Queued mode: the dispatch thread pushes copies onto "pending" (newest first) and
+    // only wakes the julia loop when the list was empty. The loop takes the whole list
+    // per wake-up. Once maxQueued messages are outstanding the dispatch thread waits,
+    // which hands the back-pressure to the subscription's zcm queue policy.
+    bool queued;
+    std::atomic<uv_zcm_queued_msg_t*> pending;
+    std::atomic<size_t> numQueued;
+    size_t maxQueued;
+    std::mutex fullLock;
+    std::condition_variable fullCond;
 };
 
+static void uv_zcm_msg_handler_drain(uv_async_t* handle)
+{
+    uv_zcm_msg_handler_t* uvCb = (uv_zcm_msg_handler_t*) handle->data;
+
+    uv_zcm_queued_msg_t* msgs = uvCb->pending.exchange(nullptr, std::memory_order_acquire);
+
+    // Put the batch back in publish order
+    uv_zcm_queued_msg_t* ordered = nullptr;
+    while (msgs) {
+        uv_zcm_queued_msg_t* next = msgs->next;
+        msgs->next = ordered;
+        ordered = msgs;
+        msgs = next;
+    }
+
+    while (ordered) {
+        uv_zcm_queued_msg_t* msg = ordered;
+        ordered = msg->next;
+        uvCb->cb(&msg->rbuf, msg->channel, uvCb->usr);
+        free(msg);
+
+        if (uvCb->numQueued.fetch_sub(1) >= uvCb->maxQueued) {
+            std::unique_lock<std::mutex> lk(uvCb->fullLock);
+            uvCb->fullCond.notify_all();
+        }
+    }
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,6 +83,7 @@ uv_zcm_msg_handler_t* uv_zcm_msg_handler_create(zcm_msg_handler_t cb, void* usr)
     ret->usr = usr;
     ret->rbuf = nullptr;
     ret->channel = nullptr;
+    ret->queued = false;
 
     // Set the usr pointer of the async handler to be the "this" pointer
 	ret->handle.data = ret;
@@ -39,6 +93,21 @@ uv_zcm_msg_handler_t* uv_zcm_msg_handler_create(zcm_msg_handler_t cb, void* usr)
     return ret;
 }
 
+uv_zcm_msg_handler_t* uv_zcm_msg_handler_create_queued(zcm_msg_handler_t cb, void* usr,
+                                                       size_t max_queued)
+{
+    uv_zcm_msg_handler_t* ret = uv_zcm_msg_handler_create(cb, usr);
+    ret->queued = true;
+    ret->pending = nullptr;
+    ret->numQueued = 0;
+    ret->maxQueued = max_queued > 0 ? max_queued : 1;
+
+    // One async handle for the life of the subscription
+    uv_async_init(uv_default_loop(), &ret->handle, uv_zcm_msg_handler_drain);
+
+    return ret;
+}
+
 void uv_zcm_msg_handler_trigger(const zcm_recv_buf_t* rbuf, const char* channel, void* _uvCb)
 {
     uv_zcm_msg_handler_t* uvCb = (uv_zcm_msg_handler_t*) _uvCb;
@@ -80,8 +149,64 @@ void uv_zcm_msg_handler_trigger(const zcm_recv_buf_t* rbuf, const char* channel,
     uv_barrier_destroy(&uvCb->blocker);
 }
 
+void uv_zcm_msg_handler_trigger_queued(const zcm_recv_buf_t* rbuf, const char* channel,
+                                       void* _uvCb)
+{
+    uv_zcm_msg_handler_t* uvCb = (uv_zcm_msg_handler_t*) _uvCb;
+
+    if (std::this_thread::get_id() == uvCb->main_thread_id) {
+		uvCb->cb(rbuf, channel, uvCb->usr);
+        return;
+    }
+
+    if (uvCb->numQueued >= uvCb->maxQueued) {
+        std::unique_lock<std::mutex> lk(uvCb->fullLock);
+        uvCb->fullCond.wait(lk, [&](){ return uvCb->numQueued < uvCb->maxQueued; });
+    }
+
+    size_t chanLen = strlen(channel);
+    uv_zcm_queued_msg_t* msg = (uv_zcm_queued_msg_t*)
+        malloc(sizeof(uv_zcm_queued_msg_t) + chanLen + 1 + rbuf->data_size);
+    char* chan = (char*) (msg + 1);
+    memcpy(chan, channel, chanLen + 1);
+    uint8_t* data = (uint8_t*) chan + chanLen + 1;
+    memcpy(data, rbuf->data, rbuf->data_size);
+
+    msg->rbuf = *rbuf;
+    msg->rbuf.data = data;
+    msg->channel = chan;
+
+    ++uvCb->numQueued;
+    uv_zcm_queued_msg_t* head = uvCb->pending.load(std::memory_order_relaxed);
+    do {
+        msg->next = head;
+    } while (!uvCb->pending.compare_exchange_weak(head, msg, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+
+    // The loop drains everything per wake-up, so only the first message of a batch
+    // needs to schedule one
+    if (head == nullptr) uv_async_send(&uvCb->handle);
+}
+
 void uv_zcm_msg_handler_destroy(uv_zcm_msg_handler_t* uvCb)
-{ delete uvCb; }
+{
+    if (!uvCb->queued) {
+        delete uvCb;
+        return;
+    }
+
+    // The handle can only be freed once the loop is done with it
+    uv_close((uv_handle_t*)&uvCb->handle, [](uv_handle_t* handle){
+        uv_zcm_msg_handler_t* uvCb = (uv_zcm_msg_handler_t*) handle->data;
+        uv_zcm_queued_msg_t* msg = uvCb->pending.exchange(nullptr);
+        while (msg) {
+            uv_zcm_queued_msg_t* next = msg->next;
+            free(msg);
+            msg = next;
+        }
+        delete uvCb;
+    });
+}
 
 #ifdef __cplusplus
 }
@@ -9,9 +9,21 @@ extern "C" {
 
 struct uv_zcm_msg_handler_t;
 
+/* Each message is handed to the julia loop and the dispatching thread waits until the
+ * callback has run. Subscribe with uv_zcm_msg_handler_trigger as the handler. */
 uv_zcm_msg_handler_t* uv_zcm_msg_handler_create(zcm_msg_handler_t cb, void* usr);
 void                  uv_zcm_msg_handler_trigger(const zcm_recv_buf_t* rbuf,
                                                  const char* channel, void* _uvCb);
+
+/* Messages are copied into a queue that the julia loop drains in batches, so the
+ * dispatching thread only waits once 'max_queued' messages are outstanding. Must be
+ * created on the julia loop's thread. Subscribe with uv_zcm_msg_handler_trigger_queued
+ * as the handler. */
+uv_zcm_msg_handler_t* uv_zcm_msg_handler_create_queued(zcm_msg_handler_t cb, void* usr,
+                                                       size_t max_queued);
+void                  uv_zcm_msg_handler_trigger_queued(const zcm_recv_buf_t* rbuf,
+                                                        const char* channel, void* _uvCb);
+
 void                  uv_zcm_msg_handler_destroy(uv_zcm_msg_handler_t* uvCb);
 
 #ifdef __cplusplus
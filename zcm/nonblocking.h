@@ -14,9 +14,17 @@ void               zcm_nonblocking_destroy(zcm_nonblocking_t* zcm);
 
 int        zcm_nonblocking_publish(zcm_nonblocking_t* zcm, const char* channel,
                                    const uint8_t* data, uint32_t len);
+int        zcm_nonblocking_publishv(zcm_nonblocking_t* zcm, const char* channel,
+                                    const zcm_iovec_t* iov, uint32_t niov);
 zcm_sub_t* zcm_nonblocking_subscribe(zcm_nonblocking_t* zcm, const char* channel,
                                      zcm_msg_handler_t cb, void* usr);
 int        zcm_nonblocking_unsubscribe(zcm_nonblocking_t* zcm, zcm_sub_t* sub);
+#ifndef ZCM_EMBEDDED
+/* Only honors opts->queue_policy == ZCM_QUEUE_KEEP_LATEST */
+zcm_sub_t* zcm_nonblocking_subscribe_opts(zcm_nonblocking_t* zcm, const char* channel,
+                                          zcm_msg_handler_t cb, void* usr,
+                                          const zcm_sub_opts_t* opts);
+#endif
 
 /* Returns 1 if a message was dispatched, and 0 otherwise */
 int zcm_nonblocking_handle_nonblock(zcm_nonblocking_t* zcm);
@@ -1,10 +1,29 @@
 from libc.stdint cimport int64_t, int32_t, uint32_t, uint8_t
+from libc.stdlib cimport malloc, realloc, free
+from libc.string cimport memcpy, strlen
 from posix.unistd cimport off_t
+from cpython.buffer cimport PyBuffer_FillInfo
+import threading
 import time
+import traceback
 
 cdef extern from "Python.h":
     void PyEval_InitThreads()
 
+cdef extern from "pthread.h" nogil:
+    ctypedef struct pthread_mutex_t:
+        pass
+    ctypedef struct pthread_cond_t:
+        pass
+    int pthread_mutex_init(pthread_mutex_t* mutex, const void* attr)
+    int pthread_mutex_destroy(pthread_mutex_t* mutex)
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    int pthread_mutex_unlock(pthread_mutex_t* mutex)
+    int pthread_cond_init(pthread_cond_t* cond, const void* attr)
+    int pthread_cond_destroy(pthread_cond_t* cond)
+    int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex)
+    int pthread_cond_broadcast(pthread_cond_t* cond)
+
 cdef extern from "zcm/zcm.h":
     cdef enum zcm_return_codes:
         ZCM_EOK,
@@ -84,6 +103,160 @@ cdef void handler_cb_raw(const zcm_recv_buf_t* rbuf, const char* channel, void*
     subs = (<ZCMSubscription>usr)
     subs.handler(channel.decode('utf-8'), rbuf.data[:rbuf.data_size])
 
+# Batched subscriptions: the zcm dispatch thread appends each message to the "fill"
+# buffer without touching the GIL. A python thread per subscription swaps the two
+# buffers and hands everything that accumulated to the handler in one call, as
+# memoryviews into the swapped out buffer. The buffers are reused for the life of
+# the subscription, unless the handler kept a view of one alive past its return.
+cdef struct batch_rec_t:
+    uint32_t chanlen
+    uint32_t datalen
+
+cdef struct batch_buf_t:
+    uint8_t* data
+    size_t   size
+    size_t   cap
+    uint32_t nmsgs
+
+cdef struct batch_queue_t:
+    pthread_mutex_t lock
+    pthread_cond_t  cond
+    batch_buf_t     bufs[2]
+    int             fill
+    size_t          maxbytes
+    bint            stopping
+
+cdef void handler_cb_batch(const zcm_recv_buf_t* rbuf, const char* channel, void* usr) nogil:
+    cdef batch_queue_t* q = <batch_queue_t*> usr
+    cdef uint32_t chanlen = strlen(channel)
+    # records are kept 8-byte aligned
+    cdef size_t reclen = (sizeof(batch_rec_t) + chanlen + rbuf.data_size + 7) & ~(<size_t>7)
+    cdef batch_buf_t* buf
+    cdef batch_rec_t* rec
+    cdef uint8_t* newdata
+    pthread_mutex_lock(&q.lock)
+    # back-pressure: wait for the python thread to catch up (the subscription's zcm
+    # queue policy applies meanwhile)
+    while q.bufs[q.fill].size > 0 and q.bufs[q.fill].size + reclen > q.maxbytes \
+            and not q.stopping:
+        pthread_cond_wait(&q.cond, &q.lock)
+    buf = &q.bufs[q.fill]
+    if buf.size + reclen > buf.cap:
+        newdata = <uint8_t*> realloc(buf.data, max(2 * buf.cap, buf.size + reclen))
+        if newdata == NULL:
+            pthread_mutex_unlock(&q.lock)
+            return
+        buf.data = newdata
+        buf.cap = max(2 * buf.cap, buf.size + reclen)
+    rec = <batch_rec_t*> (buf.data + buf.size)
+    rec.chanlen = chanlen
+    rec.datalen = rbuf.data_size
+    memcpy(buf.data + buf.size + sizeof(batch_rec_t), channel, chanlen)
+    memcpy(buf.data + buf.size + sizeof(batch_rec_t) + chanlen, rbuf.data, rbuf.data_size)
+    buf.size += reclen
+    buf.nmsgs += 1
+    if buf.nmsgs == 1:
+        pthread_cond_broadcast(&q.cond)
+    pthread_mutex_unlock(&q.lock)
+
+# Owns a swapped out buffer while its memoryviews are in use. When views outlive
+# the handler call, the buffer is left to this object and freed with the last view.
+cdef class _BatchBlock:
+    cdef uint8_t* data
+    cdef size_t size
+    cdef int exports
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        PyBuffer_FillInfo(buffer, self, self.data, self.size, 1, flags)
+        self.exports += 1
+    def __releasebuffer__(self, Py_buffer* buffer):
+        self.exports -= 1
+    def __dealloc__(self):
+        free(self.data)
+
+cdef class ZCMBatchSubscription(ZCMSubscription):
+    cdef batch_queue_t* queue
+    cdef object thread
+    def __cinit__(self):
+        self.queue = <batch_queue_t*> malloc(sizeof(batch_queue_t))
+        pthread_mutex_init(&self.queue.lock, NULL)
+        pthread_cond_init(&self.queue.cond, NULL)
+        for i in range(2):
+            self.queue.bufs[i].data = NULL
+            self.queue.bufs[i].size = 0
+            self.queue.bufs[i].cap = 0
+            self.queue.bufs[i].nmsgs = 0
+        self.queue.fill = 0
+        self.queue.stopping = False
+    def __dealloc__(self):
+        pthread_mutex_destroy(&self.queue.lock)
+        pthread_cond_destroy(&self.queue.cond)
+        free(self.queue.bufs[0].data)
+        free(self.queue.bufs[1].data)
+        free(self.queue)
+    def _deliver(self):
+        cdef batch_queue_t* q = self.queue
+        cdef batch_buf_t* buf
+        cdef batch_rec_t* rec
+        cdef size_t off, start
+        cdef bint done
+        while True:
+            with nogil:
+                pthread_mutex_lock(&q.lock)
+                while q.bufs[q.fill].nmsgs == 0 and not q.stopping:
+                    pthread_cond_wait(&q.cond, &q.lock)
+                done = q.bufs[q.fill].nmsgs == 0
+                buf = &q.bufs[q.fill]
+                # the other buffer was handled last time around, so it is free to refill
+                q.fill = 1 - q.fill
+                q.bufs[q.fill].size = 0
+                q.bufs[q.fill].nmsgs = 0
+                pthread_cond_broadcast(&q.cond)
+                pthread_mutex_unlock(&q.lock)
+            if done:
+                return
+            block = _BatchBlock()
+            block.data = buf.data
+            block.size = buf.size
+            view = memoryview(block)
+            views = []
+            try:
+                batch = []
+                off = 0
+                for i in range(buf.nmsgs):
+                    rec = <batch_rec_t*> (buf.data + off)
+                    start = off + sizeof(batch_rec_t)
+                    channel = (<char*> (buf.data + start))[:rec.chanlen].decode('utf-8')
+                    data = view[start + rec.chanlen:start + rec.chanlen + rec.datalen]
+                    views.append(data)
+                    if self.msgtype is not None:
+                        data = self.msgtype.decode(data)
+                    batch.append((channel, data))
+                    off = (start + rec.chanlen + rec.datalen + 7) & ~(<size_t>7)
+                self.handler(batch)
+            except Exception:
+                # a failed batch must not stop delivery of the ones after it
+                traceback.print_exc()
+            batch = data = None
+            for v in views:
+                try:
+                    v.release()
+                except BufferError:
+                    pass # re-exported by the handler, e.g. through numpy.frombuffer
+            view.release()
+            if block.exports == 0:
+                block.data = NULL
+            else:
+                buf.data = NULL
+                buf.cap = 0
+    def _stop(self):
+        with nogil:
+            pthread_mutex_lock(&self.queue.lock)
+            self.queue.stopping = True
+            pthread_cond_broadcast(&self.queue.cond)
+            pthread_mutex_unlock(&self.queue.lock)
+        if self.thread is not threading.current_thread():
+            self.thread.join()
+
 cdef class ZCM:
     cdef zcm_t* zcm
     cdef object subscriptions
@@ -126,9 +299,35 @@ cdef class ZCM:
                 self.subscriptions.append(subs)
                 return subs
             time.sleep(0) # yield the gil
+    def subscribe_batch_raw(self, str channel, handler, size_t maxBytes=16 << 20):
+        return self.subscribe_batch(channel, None, handler, maxBytes)
+    def subscribe_batch(self, str channel, msgtype, handler, size_t maxBytes=16 << 20):
+        """Like subscribe(), but messages are queued without taking the GIL and
+        handler(batch) gets a list of (channel, msg) for everything that queued up
+        since its last call. Raw messages are read-only memoryviews that are released
+        when the handler returns; a buffer the handler exported from one of them
+        (e.g. with numpy.frombuffer) stays valid. Exceptions raised by the handler
+        are printed and delivery continues. The zcm dispatch thread waits once
+        maxBytes are queued."""
+        cdef ZCMBatchSubscription subs = ZCMBatchSubscription()
+        subs.handler = handler
+        subs.msgtype = msgtype
+        subs.queue.maxbytes = maxBytes
+        subs.thread = threading.Thread(target=subs._deliver)
+        subs.thread.daemon = True
+        subs.thread.start()
+        while True:
+            subs.sub = zcm_try_subscribe(self.zcm, channel.encode('utf-8'), handler_cb_batch,
+                                         <void*> subs.queue)
+            if subs.sub != NULL:
+                self.subscriptions.append(subs)
+                return subs
+            time.sleep(0) # yield the gil
     def unsubscribe(self, ZCMSubscription subs):
         while zcm_try_unsubscribe(self.zcm, subs.sub) != ZCM_EOK:
             time.sleep(0) # yield the gil
+        if isinstance(subs, ZCMBatchSubscription):
+            (<ZCMBatchSubscription>subs)._stop()
         self.subscriptions.remove(subs)
     def publish(self, str channel, object msg):
         _data = msg.encode()
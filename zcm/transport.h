@@ -176,6 +176,52 @@
  *      --------------------------------------------------------------------
  *         Close the transport and cleanup any resources used.
  *
+ *******************************************************************************
+ * Optional Batched Transport API (both modes):
+ *
+ *      General Note: An implementation is allowed to set any of these fields
+ *                    to NULL (or leave them off the end of its vtbl). Callers
+ *                    must go through the zcm_trans_...() helpers below, which
+ *                    fall back to sendmsg() and recvmsg(). Each of these
+ *                    follows the blocking or non-blocking semantics of the
+ *                    method it batches. They exist so that a transport can
+ *                    move a whole burst of messages with one lock and one
+ *                    system call (e.g. sendmmsg(), writev() or a multipart send).
+ *
+ *      int sendmsg_batch(zcm_trans_t* zt, zcm_msg_t* msgs, size_t nmsgs, size_t* nsent)
+ *      --------------------------------------------------------------------
+ *         Sends 'nmsgs' messages, in order, with the same semantics as
+ *         sendmsg() for each of them. Returns ZCM_EOK once all messages have
+ *         been sent. On failure, '*nsent' is the number of leading messages
+ *         that were sent and the return code applies to 'msgs[*nsent]'.
+ *
+ *      int recvmsg_batch(zcm_trans_t* zt, zcm_msg_t* msgs, size_t maxmsgs,
+ *                        size_t* nrecv, int timeout)
+ *      --------------------------------------------------------------------
+ *         Receives between 1 and 'maxmsgs' messages into 'msgs', setting
+ *         '*nrecv' to the number received. Only the wait for the first message
+ *         follows the 'timeout' rules of recvmsg(): the rest are the messages
+ *         that are already available. Returns ZCM_EOK if at least one message
+ *         was received. All of the received messages remain valid until the
+ *         next call to recvmsg() or recvmsg_batch().
+ *
+ *      int sendmsgv(zcm_trans_t* zt, const char* channel,
+ *                   const zcm_iovec_t* iov, size_t niov)
+ *      --------------------------------------------------------------------
+ *         Same as sendmsg(), but the payload is the concatenation of the
+ *         'niov' buffers in 'iov', so that the transport can write them out
+ *         (e.g. with writev()) without the caller gathering them first.
+ *
+ *      int sendmsgv_concurrent(zcm_trans_t* zt, const char* channel,
+ *                              const zcm_iovec_t* iov, size_t niov)
+ *      --------------------------------------------------------------------
+ *         Blocking mode only, and without a fallback. Same as sendmsgv(), but
+ *         may be called from any number of threads at once, concurrently with
+ *         all other methods, and must never block (return ZCM_EAGAIN instead).
+ *         When a transport provides it, zcm_publish() hands messages straight
+ *         to it from the publishing thread rather than through the send thread.
+ *         Messages that it returns ZCM_EAGAIN for go through the send thread.
+ *
  ******************************************************************************/
 
 #ifdef __cplusplus
@@ -184,6 +230,7 @@ extern "C" {
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "zcm/zcm.h"
@@ -195,6 +242,11 @@ extern "C" {
 # define INLINE
 #endif
 
+/* Payloads up to this size are gathered on the stack when a transport has no sendmsgv() */
+#ifndef ZCM_TRANS_SENDMSGV_STACK_SIZE
+#define ZCM_TRANS_SENDMSGV_STACK_SIZE 512
+#endif
+
 typedef struct zcm_msg_t zcm_msg_t;
 typedef struct zcm_trans_methods_t zcm_trans_methods_t;
 
@@ -223,6 +275,14 @@ struct zcm_trans_methods_t
     int     (*recvmsg)(zcm_trans_t* zt, zcm_msg_t* msg, int timeout);
     int     (*update)(zcm_trans_t* zt);
     void    (*destroy)(zcm_trans_t* zt);
+    /* Optional, see above */
+    int     (*sendmsg_batch)(zcm_trans_t* zt, zcm_msg_t* msgs, size_t nmsgs, size_t* nsent);
+    int     (*recvmsg_batch)(zcm_trans_t* zt, zcm_msg_t* msgs, size_t maxmsgs,
+                             size_t* nrecv, int timeout);
+    int     (*sendmsgv)(zcm_trans_t* zt, const char* channel,
+                        const zcm_iovec_t* iov, size_t niov);
+    int     (*sendmsgv_concurrent)(zcm_trans_t* zt, const char* channel,
+                                   const zcm_iovec_t* iov, size_t niov);
 };
 
 /* Helper functions to make the VTbl dispatch cleaner */
@@ -244,6 +304,69 @@ static INLINE int zcm_trans_update(zcm_trans_t* zt)
 static INLINE void zcm_trans_destroy(zcm_trans_t* zt)
 { return zt->vtbl->destroy(zt); }
 
+static INLINE int zcm_trans_sendmsg_batch(zcm_trans_t* zt, zcm_msg_t* msgs,
+                                          size_t nmsgs, size_t* nsent)
+{
+    size_t i;
+    int ret;
+    if (zt->vtbl->sendmsg_batch) return zt->vtbl->sendmsg_batch(zt, msgs, nmsgs, nsent);
+    for (i = 0; i < nmsgs; ++i) {
+        if ((ret = zt->vtbl->sendmsg(zt, msgs[i])) != ZCM_EOK) {
+            *nsent = i;
+            return ret;
+        }
+    }
+    *nsent = nmsgs;
+    return ZCM_EOK;
+}
+
+static INLINE int zcm_trans_recvmsg_batch(zcm_trans_t* zt, zcm_msg_t* msgs, size_t maxmsgs,
+                                          size_t* nrecv, int timeout)
+{
+    int ret;
+    if (zt->vtbl->recvmsg_batch)
+        return zt->vtbl->recvmsg_batch(zt, msgs, maxmsgs, nrecv, timeout);
+    ret = zt->vtbl->recvmsg(zt, msgs, timeout);
+    *nrecv = ret == ZCM_EOK ? 1 : 0;
+    return ret;
+}
+
+static INLINE int zcm_trans_sendmsgv(zcm_trans_t* zt, const char* channel,
+                                     const zcm_iovec_t* iov, size_t niov)
+{
+    zcm_msg_t msg;
+    uint8_t stackbuf[ZCM_TRANS_SENDMSGV_STACK_SIZE];
+    size_t i;
+    int ret;
+    if (zt->vtbl->sendmsgv) return zt->vtbl->sendmsgv(zt, channel, iov, niov);
+
+    msg.utime = 0;
+    msg.channel = channel;
+    msg.len = 0;
+    for (i = 0; i < niov; ++i) msg.len += iov[i].len;
+
+    /* Only gather the payload if the caller actually scattered it */
+    if (niov == 1) {
+        msg.buf = (uint8_t*) iov[0].base;
+        return zt->vtbl->sendmsg(zt, msg);
+    }
+
+    if (msg.len <= sizeof(stackbuf)) {
+        msg.buf = stackbuf;
+    } else {
+        msg.buf = (uint8_t*) malloc(msg.len);
+        if (!msg.buf) return ZCM_EMEMORY;
+    }
+    msg.len = 0;
+    for (i = 0; i < niov; ++i) {
+        memcpy(msg.buf + msg.len, iov[i].base, iov[i].len);
+        msg.len += iov[i].len;
+    }
+    ret = zt->vtbl->sendmsg(zt, msg);
+    if (msg.buf != stackbuf) free(msg.buf);
+    return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,19 @@
 //   sum1(*chan, *data)
 //   sum2(*chan, *data)
 #define FRAME_BYTES 9
+#define HEADER_BYTES (FRAME_BYTES - 2)
+
+// Defining ZCM_GENERIC_SERIAL_STATIC_MTU selects a build with no heap use at all:
+// every transport's buffers are sized at compile time and instances come from a
+// static pool of ZCM_GENERIC_SERIAL_STATIC_INSTANCES.
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+#ifndef ZCM_GENERIC_SERIAL_STATIC_BUFSIZE
+#define ZCM_GENERIC_SERIAL_STATIC_BUFSIZE (2 * (FRAME_BYTES + ZCM_GENERIC_SERIAL_STATIC_MTU))
+#endif
+#ifndef ZCM_GENERIC_SERIAL_STATIC_INSTANCES
+#define ZCM_GENERIC_SERIAL_STATIC_INSTANCES 1
+#endif
+#endif
 
 // Note: there is little to no error checking in this, misuse will cause problems
 typedef struct circBuffer_t circBuffer_t;
@@ -34,6 +47,15 @@ struct circBuffer_t
     size_t back;
 };
 
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+void cb_init_static(circBuffer_t* cb, uint8_t* data, size_t sz)
+{
+    cb->data = data;
+    cb->capacity = sz;
+    cb->front = 0;
+    cb->back  = 0;
+}
+#else
 bool cb_init(circBuffer_t* cb, size_t sz)
 {
     cb->capacity = sz;
@@ -54,6 +76,7 @@ void cb_deinit(circBuffer_t* cb)
     cb->data = NULL;
     cb->capacity = 0;
 }
+#endif
 
 size_t cb_size(circBuffer_t* cb)
 {
@@ -160,22 +183,100 @@ size_t cb_flush_in(circBuffer_t* cb, size_t bytes,
     cb->back += n;
     return bytesRead;
 }
-#undef MIN
 
-static uint16_t fletcherUpdate(uint8_t b, uint16_t prevSum)
+// NOTE: This function should never be called w/ num > cb_room(cb)
+void cb_push_bytes(circBuffer_t* cb, const uint8_t* d, size_t num)
 {
-    uint16_t sumHigh = (prevSum >> 8) & 0xff;
-    uint16_t sumLow  =  prevSum       & 0xff;
-    sumHigh += sumLow += b;
+    ASSERT((num <= cb_room(cb)) && "cb_push_bytes 1");
+    size_t contiguous = MIN(cb->capacity - cb->back, num);
+    memcpy(cb->data + cb->back, d, contiguous);
+    memcpy(cb->data, d + contiguous, num - contiguous);
+    cb->back += num;
+    if (cb->back >= cb->capacity) cb->back -= cb->capacity;
+}
 
-    sumLow  = (sumLow  & 0xff) + (sumLow  >> 8);
-    sumHigh = (sumHigh & 0xff) + (sumHigh >> 8);
+// Pushes d, doubling every escape char. Runs between escape chars are found with
+// memchr and copied in bulk.
+// NOTE: This function should never be called w/ num + (number of escapes) > cb_room(cb)
+void cb_push_escaped(circBuffer_t* cb, const uint8_t* d, size_t num)
+{
+    while (num > 0) {
+        const uint8_t* esc = memchr(d, ZCM_GENERIC_SERIAL_ESCAPE_CHAR, num);
+        size_t run = esc ? (size_t)(esc - d) + 1 : num;
+        cb_push_bytes(cb, d, run);
+        if (esc) cb_push(cb, ZCM_GENERIC_SERIAL_ESCAPE_CHAR);
+        d   += run;
+        num -= run;
+    }
+}
+
+#define CB_READ_OK         0
+#define CB_READ_AGAIN      1
+#define CB_READ_BAD_ESCAPE 2
+
+// Unescapes bytes into d until *nread reaches num, starting *offset bytes past the
+// front of the buffer and never looking at or past byte 'avail'. Both *offset and
+// *nread are advanced past everything read, so a call that returns CB_READ_AGAIN can
+// be picked up where it left off once more data arrives. On CB_READ_BAD_ESCAPE,
+// *offset is left pointing at the offending escape char.
+int cb_read_escaped(circBuffer_t* cb, size_t* offset, size_t avail,
+                    uint8_t* d, size_t* nread, size_t num)
+{
+    d   += *nread;
+    num -= *nread;
+    while (num > 0) {
+        if (*offset >= avail) return CB_READ_AGAIN;
+
+        size_t idx = cb->front + *offset;
+        if (idx >= cb->capacity) idx -= cb->capacity;
+        size_t span = MIN(MIN(cb->capacity - idx, avail - *offset), num);
+
+        const uint8_t* src = cb->data + idx;
+        const uint8_t* esc = memchr(src, ZCM_GENERIC_SERIAL_ESCAPE_CHAR, span);
+        size_t run = esc ? (size_t)(esc - src) : span;
+        memcpy(d, src, run);
+        d       += run;
+        num     -= run;
+        *nread  += run;
+        *offset += run;
+
+        if (esc) {
+            if (*offset + 1 >= avail) return CB_READ_AGAIN;
+            if (cb_top(cb, *offset + 1) != ZCM_GENERIC_SERIAL_ESCAPE_CHAR)
+                return CB_READ_BAD_ESCAPE;
+            *d++ = ZCM_GENERIC_SERIAL_ESCAPE_CHAR;
+            --num;
+            ++*nread;
+            *offset += 2;
+        }
+    }
+    return CB_READ_OK;
+}
+#undef MIN
 
-    // Note: double reduction to ensure no overflow after first
-    sumLow  = (sumLow  & 0xff) + (sumLow  >> 8);
-    sumHigh = (sumHigh & 0xff) + (sumHigh >> 8);
+// Fletcher-16 with end-around carry. Folding after every byte keeps both sums in
+// [1, 255] (they start at 0xff and never reach 0), which is just v mod 255 with 255
+// standing in for 0. So the sums can be accumulated in 32 bits and folded once per
+// block instead; 4096 bytes is the largest block sumHigh can take without overflowing.
+#define FLETCHER_BLOCK 4096
 
-    return (sumHigh << 8) | sumLow;
+static uint16_t fletcherUpdate(const uint8_t* d, size_t num, uint16_t prevSum)
+{
+    uint32_t sumHigh = (prevSum >> 8) & 0xff;
+    uint32_t sumLow  =  prevSum       & 0xff;
+
+    while (num > 0) {
+        size_t n = num < FLETCHER_BLOCK ? num : FLETCHER_BLOCK;
+        num -= n;
+        while (n--) {
+            sumLow  += *d++;
+            sumHigh += sumLow;
+        }
+        sumLow  = 1 + (sumLow  - 1) % 255;
+        sumHigh = 1 + (sumHigh - 1) % 255;
+    }
+
+    return (uint16_t)((sumHigh << 8) | sumLow);
 }
 
 typedef struct zcm_trans_generic_serial_t zcm_trans_generic_serial_t;
@@ -189,6 +290,21 @@ struct zcm_trans_generic_serial_t
     size_t       mtu;
     uint8_t*     recvMsgData;
 
+    // Incremental parse of the frame at the front of recvBuffer. recvOffset counts the
+    // bytes past the front that have already been validated (0 until a header has been
+    // accepted) and recvNRead counts the unescaped chan + data bytes copied out so far.
+    size_t       recvOffset;
+    size_t       recvNRead;
+    uint8_t      recvChanLen;
+    uint32_t     recvLen;
+
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+    bool         inUse;
+    uint8_t      sendData[ZCM_GENERIC_SERIAL_STATIC_BUFSIZE];
+    uint8_t      recvData[ZCM_GENERIC_SERIAL_STATIC_BUFSIZE];
+    uint8_t      recvMsgStorage[ZCM_GENERIC_SERIAL_STATIC_MTU];
+#endif
+
     size_t (*get)(uint8_t* data, size_t nData, void* usr);
     size_t (*put)(const uint8_t* data, size_t nData, void* usr);
     void* put_get_usr;
@@ -202,67 +318,47 @@ static zcm_trans_generic_serial_t *cast(zcm_trans_t *zt);
 size_t serial_get_mtu(zcm_trans_generic_serial_t *zt)
 { return zt->mtu; }
 
+static size_t countEscapes(const uint8_t* d, size_t num)
+{
+    size_t n = 0;
+    const uint8_t* esc;
+    while ((esc = memchr(d, ZCM_GENERIC_SERIAL_ESCAPE_CHAR, num)) != NULL) {
+        ++n;
+        num -= (size_t)(esc - d) + 1;
+        d = esc + 1;
+    }
+    return n;
+}
+
 int serial_sendmsg(zcm_trans_generic_serial_t *zt, zcm_msg_t msg)
 {
+    const uint8_t* chan = (const uint8_t*) msg.channel;
     size_t chan_len = strlen(msg.channel);
-    size_t nPushed = 0;
 
     if (chan_len > ZCM_CHANNEL_MAXLEN)                               return ZCM_EINVALID;
     if (msg.len > zt->mtu)                                           return ZCM_EINVALID;
     if (FRAME_BYTES + chan_len + msg.len > cb_room(&zt->sendBuffer)) return ZCM_EAGAIN;
 
-    cb_push(&zt->sendBuffer, ZCM_GENERIC_SERIAL_ESCAPE_CHAR); ++nPushed;
-    cb_push(&zt->sendBuffer, 0x00);                           ++nPushed;
-    cb_push(&zt->sendBuffer, chan_len);                       ++nPushed;
+    // Escape chars go out twice, so only start pushing once the whole frame is known to fit
+    size_t nEscapes = countEscapes(chan, chan_len) + countEscapes(msg.buf, msg.len);
+    if (FRAME_BYTES + chan_len + msg.len + nEscapes > cb_room(&zt->sendBuffer))
+        return ZCM_EAGAIN;
 
     uint32_t len = (uint32_t)msg.len;
-    cb_push(&zt->sendBuffer, (len>>24)&0xff); ++nPushed;
-    cb_push(&zt->sendBuffer, (len>>16)&0xff); ++nPushed;
-    cb_push(&zt->sendBuffer, (len>> 8)&0xff); ++nPushed;
-    cb_push(&zt->sendBuffer, (len>> 0)&0xff); ++nPushed;
+    uint8_t header[FRAME_BYTES - 2] = {
+        ZCM_GENERIC_SERIAL_ESCAPE_CHAR, 0x00, (uint8_t) chan_len,
+        (len>>24)&0xff, (len>>16)&0xff, (len>>8)&0xff, (len>>0)&0xff,
+    };
+    cb_push_bytes(&zt->sendBuffer, header, sizeof(header));
+    cb_push_escaped(&zt->sendBuffer, chan, chan_len);
+    cb_push_escaped(&zt->sendBuffer, msg.buf, msg.len);
 
     uint16_t checksum = 0xffff;
-    size_t i;
-    for (i = 0; i < chan_len; ++i) {
-        uint8_t c = (uint8_t) msg.channel[i];
-
-        cb_push(&zt->sendBuffer, c); ++nPushed;
-
-        if (c == ZCM_GENERIC_SERIAL_ESCAPE_CHAR) {
-        	// the escape character doesn't count, so we have chan_len - i characters
-        	// remaining in channel + the msg + the checksum.
-            if (cb_room(&zt->sendBuffer) > chan_len - i + msg.len + 1) {
-                cb_push(&zt->sendBuffer, c); ++nPushed;
-            } else {
-                cb_pop(&zt->sendBuffer, nPushed);
-                return ZCM_EAGAIN;
-            }
-        }
-
-        checksum = fletcherUpdate(c, checksum);
-    }
-
-    for (i = 0; i < msg.len; ++i) {
-        uint8_t c = (uint8_t) msg.buf[i];
-
-        cb_push(&zt->sendBuffer, c); ++nPushed;
-
-        if (c == ZCM_GENERIC_SERIAL_ESCAPE_CHAR) {
-        	// the escape character doesn't count, so we have msg.len - i characters
-        	// remaining in the msg + the checksum.
-            if (cb_room(&zt->sendBuffer) > msg.len - i + 1) {
-                cb_push(&zt->sendBuffer, c); ++nPushed;
-            } else {
-                cb_pop(&zt->sendBuffer, nPushed);
-                return ZCM_EAGAIN;
-            }
-        }
+    checksum = fletcherUpdate(chan, chan_len, checksum);
+    checksum = fletcherUpdate(msg.buf, msg.len, checksum);
 
-        checksum = fletcherUpdate(c, checksum);
-    }
-
-    cb_push(&zt->sendBuffer, (checksum >> 8) & 0xff); ++nPushed;
-    cb_push(&zt->sendBuffer,  checksum       & 0xff); ++nPushed;
+    cb_push(&zt->sendBuffer, (checksum >> 8) & 0xff);
+    cb_push(&zt->sendBuffer,  checksum       & 0xff);
 
     return ZCM_EOK;
 }
@@ -275,101 +371,87 @@ int serial_recvmsg_enable(zcm_trans_generic_serial_t *zt, const char *channel, b
     return ZCM_EOK;
 }
 
+// Drops the first n received bytes along with any partially parsed frame
+static void serial_recv_resync(zcm_trans_generic_serial_t *zt, size_t n)
+{
+    cb_pop(&zt->recvBuffer, n);
+    zt->recvOffset = 0;
+    zt->recvNRead  = 0;
+}
+
 int serial_recvmsg(zcm_trans_generic_serial_t *zt, zcm_msg_t *msg, int timeout)
 {
     uint64_t utime = zt->time(zt->time_usr);
-    size_t incomingSize = cb_size(&zt->recvBuffer);
-    if (incomingSize < FRAME_BYTES)
-        return ZCM_EAGAIN;
-
-    size_t consumed = 0;
-    uint8_t chan_len = 0;
-    uint16_t checksum = 0;
-    uint8_t expectedHighCS = 0;
-    uint8_t expectedLowCS  = 0;
-    uint16_t receivedCS = 0;
-
-    // Sync
-    if (cb_top(&zt->recvBuffer, consumed++) != ZCM_GENERIC_SERIAL_ESCAPE_CHAR) goto fail;
-    if (cb_top(&zt->recvBuffer, consumed++) != 0x00)                           goto fail;
-
-    // Msg sizes
-    chan_len  = cb_top(&zt->recvBuffer, consumed++);
-    msg->len  = cb_top(&zt->recvBuffer, consumed++) << 24;
-    msg->len |= cb_top(&zt->recvBuffer, consumed++) << 16;
-    msg->len |= cb_top(&zt->recvBuffer, consumed++) << 8;
-    msg->len |= cb_top(&zt->recvBuffer, consumed++);
-
-    if (chan_len > ZCM_CHANNEL_MAXLEN)     goto fail;
-    if (msg->len > zt->mtu)                goto fail;
-
-    if (incomingSize < FRAME_BYTES + chan_len + msg->len) return ZCM_EAGAIN;
+    circBuffer_t* cb = &zt->recvBuffer;
 
-    memset(&zt->recvChanName, '\0', ZCM_CHANNEL_MAXLEN);
+    for (;;) {
+        size_t incomingSize = cb_size(cb);
 
-    checksum = 0xffff;
-    int i;
-    for (i = 0; i < chan_len; ++i) {
+        if (zt->recvOffset == 0) {
+            if (incomingSize < FRAME_BYTES) return ZCM_EAGAIN;
 
-        uint8_t c = cb_top(&zt->recvBuffer, consumed++);
+            // Sync
+            if (cb_top(cb, 0) != ZCM_GENERIC_SERIAL_ESCAPE_CHAR) { serial_recv_resync(zt, 1); continue; }
+            if (cb_top(cb, 1) != 0x00)                           { serial_recv_resync(zt, 2); continue; }
 
-        if (c == ZCM_GENERIC_SERIAL_ESCAPE_CHAR) {
-        	// the escape character doesn't count, so we have chan_len - i characters
-        	// remaining in channel + the msg + the checksum.
-            if (consumed + chan_len - i + msg->len + 2 > incomingSize) return ZCM_EAGAIN;
+            // Msg sizes
+            zt->recvChanLen  = cb_top(cb, 2);
+            zt->recvLen      = (uint32_t) cb_top(cb, 3) << 24;
+            zt->recvLen     |= (uint32_t) cb_top(cb, 4) << 16;
+            zt->recvLen     |= (uint32_t) cb_top(cb, 5) << 8;
+            zt->recvLen     |= (uint32_t) cb_top(cb, 6);
 
-            c = cb_top(&zt->recvBuffer, consumed++);
-
-            if (c != ZCM_GENERIC_SERIAL_ESCAPE_CHAR) {
-                consumed-=2;
-                goto fail;
+            if (zt->recvChanLen > ZCM_CHANNEL_MAXLEN || zt->recvLen > zt->mtu) {
+                serial_recv_resync(zt, HEADER_BYTES);
+                continue;
             }
-        }
-
-        zt->recvChanName[i] = c;
-        checksum = fletcherUpdate(c, checksum);
-    }
-
-    zt->recvChanName[chan_len] = '\0';
 
-    for (i = 0; i < msg->len; ++i) {
-        if (consumed > incomingSize) return ZCM_EAGAIN;
+            zt->recvOffset = HEADER_BYTES;
+            zt->recvNRead  = 0;
+        }
 
-        uint8_t c = cb_top(&zt->recvBuffer, consumed++);
+        // Channel, then data. Only the bytes that arrived since the last call are scanned.
+        int ret = CB_READ_OK;
+        if (zt->recvNRead < zt->recvChanLen) {
+            ret = cb_read_escaped(cb, &zt->recvOffset, incomingSize,
+                                  zt->recvChanName, &zt->recvNRead, zt->recvChanLen);
+        }
+        if (ret == CB_READ_OK) {
+            size_t nData = zt->recvNRead - zt->recvChanLen;
+            ret = cb_read_escaped(cb, &zt->recvOffset, incomingSize,
+                                  zt->recvMsgData, &nData, zt->recvLen);
+            zt->recvNRead = zt->recvChanLen + nData;
+        }
+        if (ret == CB_READ_AGAIN) return ZCM_EAGAIN;
+        if (ret == CB_READ_BAD_ESCAPE) {
+            serial_recv_resync(zt, zt->recvOffset);
+            continue;
+        }
 
-        if (c == ZCM_GENERIC_SERIAL_ESCAPE_CHAR) {
-        	// the escape character doesn't count, so we have msg.len - i characters
-        	// remaining in the msg + the checksum.
-            if (consumed + msg->len - i + 2 > incomingSize) return ZCM_EAGAIN;
+        // Checksum (never escaped)
+        if (zt->recvOffset + 2 > incomingSize) return ZCM_EAGAIN;
 
-            c = cb_top(&zt->recvBuffer, consumed++);
+        uint16_t checksum = 0xffff;
+        checksum = fletcherUpdate(zt->recvChanName, zt->recvChanLen, checksum);
+        checksum = fletcherUpdate(zt->recvMsgData, zt->recvLen, checksum);
 
-            if (c != ZCM_GENERIC_SERIAL_ESCAPE_CHAR) {
-                consumed-=2;
-                goto fail;
-            }
+        uint16_t receivedCS = (cb_top(cb, zt->recvOffset) << 8) |
+                               cb_top(cb, zt->recvOffset + 1);
+        size_t consumed = zt->recvOffset + 2;
+        if (receivedCS != checksum) {
+            serial_recv_resync(zt, consumed);
+            continue;
         }
 
-        zt->recvMsgData[i] = c;
-        checksum = fletcherUpdate(c, checksum);
-    }
-
-    expectedHighCS = cb_top(&zt->recvBuffer, consumed++);
-    expectedLowCS  = cb_top(&zt->recvBuffer, consumed++);
-    receivedCS = (expectedHighCS << 8) | expectedLowCS;
-    if (receivedCS == checksum) {
+        zt->recvChanName[zt->recvChanLen] = '\0';
         msg->channel = (char*) zt->recvChanName;
         msg->buf     = zt->recvMsgData;
+        msg->len     = zt->recvLen;
         msg->utime   = utime;
-        cb_pop(&zt->recvBuffer, consumed);
+        serial_recv_resync(zt, consumed);
+        // Note: because this is a nonblocking transport, timeout is ignored
         return ZCM_EOK;
     }
-
-  fail:
-    cb_pop(&zt->recvBuffer, consumed);
-    // Note: because this is a nonblocking transport, timeout is ignored, so we don't need
-    //       to subtract the time used here
-    return serial_recvmsg(zt, msg, timeout);
 }
 
 int serial_update_rx(zcm_trans_t *_zt)
@@ -421,6 +503,10 @@ static zcm_trans_generic_serial_t *cast(zcm_trans_t *zt)
     return (zcm_trans_generic_serial_t*)zt;
 }
 
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+static zcm_trans_generic_serial_t instances[ZCM_GENERIC_SERIAL_STATIC_INSTANCES];
+#endif
+
 zcm_trans_t *zcm_trans_generic_serial_create(
         size_t (*get)(uint8_t* data, size_t nData, void* usr),
         size_t (*put)(const uint8_t* data, size_t nData, void* usr),
@@ -431,6 +517,26 @@ zcm_trans_t *zcm_trans_generic_serial_create(
         size_t bufSize)
 {
     if (MTU == 0 || bufSize < FRAME_BYTES + MTU) return NULL;
+
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+    if (MTU > ZCM_GENERIC_SERIAL_STATIC_MTU)         return NULL;
+    if (bufSize > ZCM_GENERIC_SERIAL_STATIC_BUFSIZE) return NULL;
+
+    zcm_trans_generic_serial_t *zt = NULL;
+    size_t i;
+    for (i = 0; i < ZCM_GENERIC_SERIAL_STATIC_INSTANCES; ++i) {
+        if (!instances[i].inUse) {
+            zt = &instances[i];
+            break;
+        }
+    }
+    if (zt == NULL) return NULL;
+    zt->inUse = true;
+    zt->mtu = MTU;
+    zt->recvMsgData = zt->recvMsgStorage;
+    cb_init_static(&zt->sendBuffer, zt->sendData, bufSize);
+    cb_init_static(&zt->recvBuffer, zt->recvData, bufSize);
+#else
     zcm_trans_generic_serial_t *zt = malloc(sizeof(zcm_trans_generic_serial_t));
     if (zt == NULL) return NULL;
     zt->mtu = MTU;
@@ -440,8 +546,6 @@ zcm_trans_t *zcm_trans_generic_serial_create(
         return NULL;
     }
 
-    zt->trans.trans_type = ZCM_NONBLOCKING;
-    zt->trans.vtbl = &methods;
     if (!cb_init(&zt->sendBuffer, bufSize)) {
         free(zt->recvMsgData);
         free(zt);
@@ -453,6 +557,13 @@ zcm_trans_t *zcm_trans_generic_serial_create(
         free(zt);
         return NULL;
     }
+#endif
+
+    zt->trans.trans_type = ZCM_NONBLOCKING;
+    zt->trans.vtbl = &methods;
+
+    zt->recvOffset = 0;
+    zt->recvNRead = 0;
 
     zt->get = get;
     zt->put = put;
@@ -467,8 +578,12 @@ zcm_trans_t *zcm_trans_generic_serial_create(
 void zcm_trans_generic_serial_destroy(zcm_trans_t* _zt)
 {
     zcm_trans_generic_serial_t *zt = cast(_zt);
+#ifdef ZCM_GENERIC_SERIAL_STATIC_MTU
+    zt->inUse = false;
+#else
     cb_deinit(&zt->recvBuffer);
     cb_deinit(&zt->sendBuffer);
     free(zt->recvMsgData);
     free(zt);
+#endif
 }
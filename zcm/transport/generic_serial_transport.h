@@ -10,6 +10,11 @@ extern "C" {
 #include "zcm/zcm.h"
 #include "zcm/transport.h"
 
+// When built with ZCM_GENERIC_SERIAL_STATIC_MTU defined, the transport makes no heap
+// allocations. Instances come from a static pool of ZCM_GENERIC_SERIAL_STATIC_INSTANCES
+// (default 1) with buffers of ZCM_GENERIC_SERIAL_STATIC_BUFSIZE bytes (default
+// 2 * (9 + ZCM_GENERIC_SERIAL_STATIC_MTU)). Create returns NULL if MTU or bufSize exceed
+// those limits or the pool is exhausted; destroy returns the instance to the pool.
 zcm_trans_t *zcm_trans_generic_serial_create(
         size_t (*get)(uint8_t* data, size_t nData, void* usr),
         size_t (*put)(const uint8_t* data, size_t nData, void* usr),
@@ -10,15 +10,23 @@
 #include "util/TimeUtil.hpp"
 
 #include <cstdio>
+#include <cstdlib>
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <unistd.h>
 #include <limits.h>
 
 #define ZCM_TRANS_CLASSNAME TransportFile
 #define MTU (SSIZE_MAX)
 
+// Default number of events read ahead of playback, and a cap on the bytes they may hold
+#define PREFETCH_EVENTS 1024
+#define PREFETCH_BYTES_MAX (64 * 1024 * 1024)
+
 using namespace std;
 
 struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
@@ -28,9 +36,37 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
     string mode = "r";
     double speed = 1.0;
-
-    u64 lastMsgUtime = 0;
-    u64 lastDispatchUtime = 0;
+    bool maxSpeed = false; // speed=max: no pacing, only back-pressure from the receiver
+    u64 startUtime = 0;
+    u64 endUtime = 0;
+
+    // Playback is paced against the log time and wall time of an anchor event so that
+    // sleep overshoot doesn't accumulate. Running late by more than PACING_SLACK_US
+    // (e.g. receiver back-pressure) or the log going back in time moves the anchor.
+    static constexpr u64 PACING_SLACK_US = 10000;
+    u64 anchorMsgUtime = 0;
+    u64 anchorLocalUtime = 0;
+
+    // When reading, the readerThread copies events off of the disk into a ring of slots
+    // ahead of playback so that disk stalls don't show up as jitter. Slots (and their
+    // buffers) are reused. Events handed out by recvmsg() stay "held" in the ring
+    // until the next call.
+    struct Event
+    {
+        u64             utime;
+        string          channel;
+        vector<uint8_t> data;
+    };
+    vector<Event> ring;
+    size_t ringFront = 0;
+    size_t ringCount = 0; // includes the held events
+    size_t ringBytes = 0;
+    size_t numHeld = 0;
+    bool readerDone = false;
+    bool readerStop = false;
+    mutex ringLock;
+    condition_variable ringCond;
+    thread readerThread;
 
     string *findOption(const string& s)
     {
@@ -50,10 +86,27 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             options[opts->name[i]] = opts->value[i];
 
         string* speedStr = findOption("speed");
-        if (speedStr) {
+        if (speedStr && *speedStr == "max") {
+            maxSpeed = true;
+        } else if (speedStr) {
             speed = atof(speedStr->c_str());
             if (speed <= 0) {
-                ZCM_DEBUG("Expected double argument for 'speed'");
+                ZCM_DEBUG("Expected double argument or 'max' for 'speed'");
+                return;
+            }
+        }
+
+        string* startStr = findOption("start");
+        if (startStr) startUtime = strtoull(startStr->c_str(), nullptr, 10);
+        string* endStr = findOption("end");
+        if (endStr) endUtime = strtoull(endStr->c_str(), nullptr, 10);
+
+        size_t prefetch = PREFETCH_EVENTS;
+        string* prefetchStr = findOption("prefetch");
+        if (prefetchStr) {
+            prefetch = atoi(prefetchStr->c_str());
+            if (prefetch < 1) {
+                ZCM_DEBUG("Expected positive integer argument for 'prefetch'");
                 return;
             }
         }
@@ -74,13 +127,90 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             fprintf(stderr, "Unable to open logfile %s\n", filename);
             return;
         }
+
+        if (mode == "r") {
+            // The search can come up empty near the end of the log; the reader skips
+            // anything before the start time anyway, so fall back to the beginning
+            if (startUtime != 0 && log->seekToTimestamp(startUtime) != 0)
+                fseeko(log->getFilePtr(), 0, SEEK_SET);
+            ring.resize(prefetch);
+            readerThread = thread(&ZCM_TRANS_CLASSNAME::readerThreadFunc, this);
+        }
     }
 
     ~ZCM_TRANS_CLASSNAME()
     {
+        stopReader();
         if (log) delete log;
     }
 
+    void stopReader()
+    {
+        {
+            unique_lock<mutex> lk(ringLock);
+            readerStop = true;
+        }
+        ringCond.notify_all();
+        if (readerThread.joinable()) readerThread.join();
+    }
+
+    void readerThreadFunc()
+    {
+        while (true) {
+            const zcm::LogEvent* le = log->readNextEvent();
+            if (le && (u64) le->timestamp < startUtime) continue;
+            if (le && endUtime != 0 && (u64) le->timestamp > endUtime) le = nullptr;
+
+            unique_lock<mutex> lk(ringLock);
+            ringCond.wait(lk, [&](){
+                return readerStop ||
+                       (ringCount < ring.size() &&
+                        (ringCount == 0 || ringBytes < PREFETCH_BYTES_MAX));
+            });
+            if (readerStop) return;
+            if (!le) {
+                readerDone = true;
+                lk.unlock();
+                ringCond.notify_all();
+                return;
+            }
+
+            // The free slot isn't visible to recvmsg() until ringCount covers it
+            Event& ev = ring[(ringFront + ringCount) % ring.size()];
+            lk.unlock();
+            ev.utime = le->timestamp;
+            ev.channel = le->channel;
+            ev.data.assign(le->data, le->data + le->datalen);
+
+            lk.lock();
+            ++ringCount;
+            ringBytes += ev.data.size();
+            lk.unlock();
+            ringCond.notify_all();
+        }
+    }
+
+    // How long to wait before dispatching a message logged at msgUtime
+    u64 pacingDelay(u64 msgUtime, u64 now)
+    {
+        if (maxSpeed) return 0;
+
+        if (anchorLocalUtime == 0 || msgUtime < anchorMsgUtime) {
+            anchorMsgUtime = msgUtime;
+            anchorLocalUtime = now;
+            return 0;
+        }
+
+        u64 target = anchorLocalUtime + (u64) ((msgUtime - anchorMsgUtime) / this->speed);
+        if (target >= now) return target - now;
+
+        if (now - target > PACING_SLACK_US) {
+            anchorMsgUtime = msgUtime;
+            anchorLocalUtime = now;
+        }
+        return 0;
+    }
+
     bool good()
     {
         return log ? log->good() : false;
@@ -117,8 +247,17 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
     }
 
     int recvmsg(zcm_msg_t *msg, int timeout)
+    {
+        size_t nrecv;
+        return recvmsg_batch(msg, 1, &nrecv, timeout);
+    }
+
+    // Hands out the next event once it is due, plus any prefetched events right behind
+    // it that are due as well
+    int recvmsg_batch(zcm_msg_t *msgs, size_t maxmsgs, size_t *nrecv, int timeout)
     {
         assert(mode == "r");
+        *nrecv = 0;
         if (!good()) {
             // TODO Build in a way for a transport to tell zcm that an "error"
             //      has occurred. Not sure what to do here since this function
@@ -128,36 +267,45 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             return ZCM_ECONNECT;
         }
 
-        const zcm::LogEvent* le = log->readNextEvent();
-        if (!le) {
+        size_t avail;
+        {
+            unique_lock<mutex> lk(ringLock);
+            for (size_t i = 0; i < numHeld; ++i) {
+                ringBytes -= ring[ringFront].data.size();
+                ringFront = (ringFront + 1) % ring.size();
+            }
+            ringCount -= numHeld;
+            numHeld = 0;
+            ringCond.notify_all();
+
+            ringCond.wait_for(lk, chrono::milliseconds(timeout),
+                              [&](){ return ringCount > 0 || readerDone; });
+            avail = ringCount;
+        }
+        if (avail == 0) {
+            if (!readerDone) return ZCM_EAGAIN;
+            stopReader();
             delete log;
             log = nullptr;
             return ZCM_ECONNECT;
         }
 
-        msg->utime = le->timestamp;
-        msg->channel = le->channel.c_str();
-        msg->len = le->datalen;
-        msg->buf = le->data;
-
-        u64 now = TimeUtil::utime();
-
-        if (lastMsgUtime == 0)
-            lastMsgUtime = msg->utime;
-
-        if (lastDispatchUtime == 0)
-            lastDispatchUtime = now;
-
-        u64 localDiff = now - lastDispatchUtime;
-        u64 logDiff = msg->utime - lastMsgUtime;
-        u64 logDiffSpeed = logDiff / this->speed;
-        u64 diff = logDiffSpeed > localDiff ? logDiffSpeed - localDiff : 0;
-
-        if (diff > 0)
-            usleep(diff);
+        // Only this thread consumes, so the first 'avail' slots can't change under us
+        for (size_t i = 0; i < avail && i < maxmsgs; ++i) {
+            Event& ev = ring[(ringFront + i) % ring.size()];
+            u64 diff = pacingDelay(ev.utime, TimeUtil::utime());
+            if (diff > 0) {
+                if (i > 0) break;
+                usleep(diff);
+            }
 
-        lastDispatchUtime = TimeUtil::utime();
-        lastMsgUtime = msg->utime;
+            zcm_msg_t& msg = msgs[i];
+            msg.utime = ev.utime;
+            msg.channel = ev.channel.c_str();
+            msg.len = ev.data.size();
+            msg.buf = ev.data.data();
+            *nrecv = numHeld = i + 1;
+        }
 
         return ZCM_EOK;
     }
@@ -185,6 +333,10 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
     static void _destroy(zcm_trans_t *zt)
     { delete cast(zt); }
 
+    static int _recvmsg_batch(zcm_trans_t *zt, zcm_msg_t *msgs, size_t maxmsgs,
+                              size_t *nrecv, int timeout)
+    { return cast(zt)->recvmsg_batch(msgs, maxmsgs, nrecv, timeout); }
+
     static const TransportRegister reg;
 };
 
@@ -195,6 +347,8 @@ zcm_trans_methods_t ZCM_TRANS_CLASSNAME::methods = {
     &ZCM_TRANS_CLASSNAME::_recvmsg,
     NULL,
     &ZCM_TRANS_CLASSNAME::_destroy,
+    NULL,
+    &ZCM_TRANS_CLASSNAME::_recvmsg_batch,
 };
 
 static zcm_trans_t *create(zcm_url_t *url)
@@ -208,4 +362,5 @@ static zcm_trans_t *create(zcm_url_t *url)
 }
 
 const TransportRegister ZCM_TRANS_CLASSNAME::reg(
-    "file", "Interact with zcm log file (e.g. 'file://vehicle.log?speed=2.0)", create);
+    "file", "Interact with zcm log file (e.g. 'file://vehicle.log?speed=2.0'). Playback options: "
+    "speed=<factor>|max, start=<utime>, end=<utime>, prefetch=<events>", create);
@@ -6,113 +6,362 @@
 #include "util/TimeUtil.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
-#include <deque>
+#include <memory>
+#include <vector>
 #include <mutex>
+#include <thread>
 #include <condition_variable>
 
 #define ZCM_TRANS_CLASSNAME TransportNonblockInproc
 #define MTU (1<<28)
 
+// Number of preallocated message nodes, and the largest payload buffer a node keeps
+// around for reuse once its message has been handled
+#define POOL_SIZE 4096
+#define BUF_KEEP_MAX (64 * 1024)
+
+// At most this many messages wait for the receiver. Beyond that, publishing returns
+// ZCM_EAGAIN, except that the blocking send thread first waits up to SEND_TIMEOUT ms
+// for the receiver to make room.
+#define QUEUE_MAX POOL_SIZE
+#define SEND_TIMEOUT 100
+
 using namespace std;
 
 struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 {
-    // Messages are queued into a deque and then dispatched one at a time through recvmsg
-    // using the "inFlight" pointers to store their memory until the next message is dispatched
-    // Note: Have to use free() to clean up chan memory in these because we create them via strdup
-    deque<zcm_msg_t*> msgs;
-    const char*    inFlightChanMem = nullptr;
-          uint8_t* inFlightDataMem = nullptr;
-
+    // Every message lives in a Node. Nodes come from a fixed pool with a lock-free free
+    // list and keep their payload buffer across uses, so steady state publishing does
+    // not allocate. When the pool runs dry, messages go into nodes on the heap.
+    struct Node
+    {
+        atomic<Node*>    next {nullptr};
+        zcm_msg_t        msg;
+        char             channel[ZCM_CHANNEL_MAXLEN + 1];
+        uint8_t*         buf = nullptr;
+        size_t           cap = 0;
+        bool             pooled = false;
+        atomic<uint32_t> freeNext {0}; // index + 1 of the next free pool node, 0 for none
+
+        ~Node() { delete[] buf; }
+    };
+
+    unique_ptr<Node[]> pool;
+    // Low 32 bits: index + 1 of the first free node. High 32 bits: a tag bumped on every
+    // change so that a stale compare_exchange can't succeed (ABA)
+    atomic<uint64_t> freeHead {0};
+
+    // Intrusive multi-producer single-consumer queue (D. Vyukov). Publishers only swap
+    // the head pointer; the receiving thread owns the tail. The stub node keeps the
+    // queue from ever being truly empty so neither end needs a lock.
+    atomic<Node*> head;
+    Node*         tail;
+    Node          stub;
+
+    // Messages handed out by recvmsg or recvmsg_batch point into their nodes, which
+    // are held in "inFlight" until the next message(s) are dispatched
+    vector<Node*> inFlight;
+
+    // Messages pushed but not yet handed out by the receiver. Reserved before a push
+    atomic<size_t> numQueued {0};
+
+    // Only touched when the receiver or the (blocking) sender is about to sleep
+    atomic<bool>       rxWaiting {false};
+    atomic<bool>       txWaiting {false};
     condition_variable msgCond;
-    mutex msgLock;
+    condition_variable spaceCond;
+    mutex              msgLock;
+
+    // Set when the sender gave up waiting for room, so that it doesn't wait again
+    // until the receiver has taken something off the queue
+    atomic<bool>       rxStalled {false};
 
     ZCM_TRANS_CLASSNAME(zcm_url_t *url, bool blocking)
     {
         trans_type = blocking ? ZCM_BLOCKING : ZCM_NONBLOCKING;
         vtbl = &methods;
+
+        pool.reset(new Node[POOL_SIZE]);
+        for (size_t i = 0; i < POOL_SIZE; ++i) {
+            pool[i].pooled = true;
+            pool[i].freeNext = i + 1 < POOL_SIZE ? i + 2 : 0;
+        }
+        freeHead = 1;
+
+        head = &stub;
+        tail = &stub;
     }
 
     ~ZCM_TRANS_CLASSNAME()
     {
-        for (auto msg: msgs) {
-            free((void*) msg->channel);
-            delete [] msg->buf;
-            delete msg;
-        }
-        msgs.clear();
-
-        free((void*) inFlightChanMem);
-        delete [] inFlightDataMem;
+        Node* n;
+        while ((n = pop()) != nullptr) freeNode(n);
+        for (auto n : inFlight) freeNode(n);
+        inFlight.clear();
     }
 
     bool good() { return true; }
 
-    /********************** METHODS **********************/
-    size_t get_mtu() { return MTU; }
+    /********************** NODES **********************/
+    Node* allocNode()
+    {
+        uint64_t h = freeHead.load(memory_order_acquire);
+        while ((uint32_t) h != 0) {
+            Node* n = &pool[(uint32_t) h - 1];
+            uint64_t next = (((h >> 32) + 1) << 32) | n->freeNext.load(memory_order_relaxed);
+            if (freeHead.compare_exchange_weak(h, next, memory_order_acquire))
+                return n;
+        }
+        return new Node();
+    }
 
-    int sendmsg(zcm_msg_t msg)
+    // Only called by the receiving thread (or on destruction)
+    void freeNode(Node* n)
+    {
+        if (!n->pooled) {
+            delete n;
+            return;
+        }
+        if (n->cap > BUF_KEEP_MAX) {
+            delete[] n->buf;
+            n->buf = nullptr;
+            n->cap = 0;
+        }
+        uint32_t idx = n - pool.get();
+        uint64_t h = freeHead.load(memory_order_relaxed);
+        uint64_t next;
+        do {
+            n->freeNext.store((uint32_t) h, memory_order_relaxed);
+            next = (((h >> 32) + 1) << 32) | (idx + 1);
+        } while (!freeHead.compare_exchange_weak(h, next, memory_order_release,
+                                                 memory_order_relaxed));
+    }
+
+    // Gathers the payload into a node
+    int copyMsg(const char* channel, const zcm_iovec_t* iov, size_t niov, Node** out)
     {
         size_t chanLen = 0;
         for (; chanLen < ZCM_CHANNEL_MAXLEN + 1; ++chanLen) {
-            if (msg.channel[chanLen] == '\0') break;
+            if (channel[chanLen] == '\0') break;
         }
         if (chanLen > ZCM_CHANNEL_MAXLEN) {
             ZCM_DEBUG("nonblock_inproc_send failed: invalid channel length");
             return ZCM_EINVALID;
         }
-        if (msg.len > MTU) {
+        size_t len = 0;
+        for (size_t i = 0; i < niov; ++i) len += iov[i].len;
+        if (len > MTU) {
             ZCM_DEBUG("nonblock_inproc_send failed: msg larger than MTU");
             return ZCM_EINVALID;
         }
 
-        zcm_msg_t *newMsg = new zcm_msg_t();
-        newMsg->utime = msg.utime;
-        newMsg->len = msg.len;
-        newMsg->channel = strdup(msg.channel);
-        newMsg->buf = new uint8_t[msg.len];
-        std::copy_n(msg.buf, msg.len, newMsg->buf);
-
-        std::unique_lock<mutex> lk(msgLock, defer_lock);
-        if (trans_type == ZCM_BLOCKING) lk.lock();
-        msgs.push_back(newMsg);
-        if (trans_type == ZCM_BLOCKING) {
-            lk.unlock();
-            msgCond.notify_all();
+        Node* n = allocNode();
+        if (n->cap < len) {
+            delete[] n->buf;
+            n->buf = new uint8_t[len];
+            n->cap = len;
         }
+        memcpy(n->channel, channel, chanLen + 1);
+        uint8_t* dst = n->buf;
+        for (size_t i = 0; i < niov; ++i) dst = std::copy_n(iov[i].base, iov[i].len, dst);
+
+        n->msg.utime = 0;
+        n->msg.len = len;
+        n->msg.channel = n->channel;
+        n->msg.buf = n->buf;
+        *out = n;
+        return ZCM_EOK;
+    }
+
+    /********************** QUEUE **********************/
+    void push(Node* n)
+    {
+        n->next.store(nullptr, memory_order_relaxed);
+        Node* prev = head.exchange(n);
+        prev->next.store(n, memory_order_release);
+    }
 
+    // Receiving thread only. May return nullptr while a push is half done; see empty()
+    Node* pop()
+    {
+        Node* t = tail;
+        Node* next = t->next.load(memory_order_acquire);
+        if (t == &stub) {
+            if (!next) return nullptr;
+            tail = t = next;
+            next = next->next.load(memory_order_acquire);
+        }
+        if (next) {
+            tail = next;
+            return t;
+        }
+        if (t != head.load()) return nullptr;
+        push(&stub);
+        next = t->next.load(memory_order_acquire);
+        if (next) {
+            tail = next;
+            return t;
+        }
+        return nullptr;
+    }
+
+    // Receiving thread only
+    bool empty() { return tail == &stub && head.load() == &stub; }
+
+    bool reserve()
+    {
+        size_t n = numQueued.load();
+        do {
+            if (n >= QUEUE_MAX) return false;
+        } while (!numQueued.compare_exchange_weak(n, n + 1));
+        return true;
+    }
+
+    // Blocking sender only (that is the send thread, or a flush): waits for room when
+    // reserve() fails. Like notify() and waitForMsg(), the seq_cst operations on
+    // numQueued and txWaiting make sure that the receiver sees the waiting sender or
+    // the sender sees the room made.
+    bool waitForSpace()
+    {
+        if (trans_type != ZCM_BLOCKING || rxStalled) return false;
+
+        unique_lock<mutex> lk(msgLock);
+        txWaiting = true;
+        bool available = spaceCond.wait_for(lk, chrono::milliseconds(SEND_TIMEOUT),
+                                            [&](){ return reserve(); });
+        txWaiting = false;
+        if (!available) rxStalled = true;
+        return available;
+    }
+
+    // Receiving thread only
+    void release(size_t n)
+    {
+        numQueued -= n;
+        rxStalled = false;
+        if (!txWaiting.load()) return;
+        unique_lock<mutex> lk(msgLock);
+        spaceCond.notify_all();
+    }
+
+    // Wakes the receiver if it is (about to be) asleep. The seq_cst exchange in push()
+    // and load here pair with the store and loads in waitForMsg() so that either the
+    // receiver sees the new node or we see that it is waiting.
+    void notify()
+    {
+        if (trans_type != ZCM_BLOCKING || !rxWaiting.load()) return;
+        unique_lock<mutex> lk(msgLock);
+        msgCond.notify_all();
+    }
+
+    bool waitForMsg(int timeout)
+    {
+        if (!empty()) return true;
+        if (trans_type != ZCM_BLOCKING) return false;
+
+        unique_lock<mutex> lk(msgLock);
+        rxWaiting = true;
+        bool available = msgCond.wait_for(lk, chrono::milliseconds(timeout),
+                                          [&](){ return !empty(); });
+        rxWaiting = false;
+        return available;
+    }
+
+    /********************** METHODS **********************/
+    size_t get_mtu() { return MTU; }
+
+    int sendmsg(zcm_msg_t msg)
+    {
+        zcm_iovec_t iov = { msg.buf, (uint32_t) msg.len };
+        return sendmsgv(msg.channel, &iov, 1);
+    }
+
+    // Reserves room for and queues one message, without waking the receiver
+    int enqueue(const char* channel, const zcm_iovec_t* iov, size_t niov, bool wait)
+    {
+        if (!reserve() && (!wait || !waitForSpace())) {
+            ZCM_DEBUG("nonblock_inproc_send failed: queue is full");
+            return ZCM_EAGAIN;
+        }
+        Node* n;
+        int ret = copyMsg(channel, iov, niov, &n);
+        if (ret != ZCM_EOK) {
+            --numQueued;
+            return ret;
+        }
+        push(n);
         return ZCM_EOK;
     }
 
-    int recvmsg_enable(const char *channel, bool enable) { return ZCM_EOK; }
+    int sendmsgv(const char* channel, const zcm_iovec_t* iov, size_t niov)
+    {
+        int ret = enqueue(channel, iov, niov, true);
+        if (ret == ZCM_EOK) notify();
+        return ret;
+    }
 
-    int recvmsg(zcm_msg_t *msg, int timeout)
+    // Safe to call from any number of threads at once; never blocks
+    int sendmsgv_concurrent(const char* channel, const zcm_iovec_t* iov, size_t niov)
     {
-        std::unique_lock<mutex> lk(msgLock, defer_lock);
+        int ret = enqueue(channel, iov, niov, false);
+        if (ret == ZCM_EOK) notify();
+        return ret;
+    }
 
-        if (trans_type == ZCM_BLOCKING) {
-            lk.lock();
-            bool available = msgCond.wait_for(lk, chrono::milliseconds(timeout),
-                                              [&](){ return !msgs.empty(); });
-            if (!available) return ZCM_EAGAIN;
-        } else {
-            if (msgs.empty()) return ZCM_EAGAIN;
+    // Queues the whole batch with a single wakeup of the receiver, unless it has to wait
+    // for the receiver to make room
+    int sendmsg_batch(zcm_msg_t* msgs, size_t nmsgs, size_t* nsent)
+    {
+        size_t i;
+        int ret = ZCM_EOK;
+        for (i = 0; i < nmsgs; ++i) {
+            zcm_iovec_t iov = { msgs[i].buf, (uint32_t) msgs[i].len };
+            if (i > 0 && numQueued >= QUEUE_MAX) notify();
+            ret = enqueue(msgs[i].channel, &iov, 1, true);
+            if (ret != ZCM_EOK) break;
         }
+        *nsent = i;
+        if (i > 0) notify();
+        return ret;
+    }
 
-        // Clean up memory from last message
-        free((void*) inFlightChanMem);
-        delete [] inFlightDataMem;
+    int recvmsg_enable(const char *channel, bool enable) { return ZCM_EOK; }
 
-        // Steal the dynamic memory from the front of the queue, but hang onto the
-        // ptrs via the "inFlight" ptrs so we can clean it up later
-        *msg = *(msgs.front());
-        msg->utime = TimeUtil::utime();
-        inFlightChanMem = msg->channel;
-        inFlightDataMem = msg->buf;
+    int recvmsg(zcm_msg_t *msg, int timeout)
+    {
+        size_t nrecv;
+        return recvmsg_batch(msg, 1, &nrecv, timeout);
+    }
 
-        delete msgs.front();
-        msgs.pop_front();
+    int recvmsg_batch(zcm_msg_t *out, size_t maxmsgs, size_t *nrecv, int timeout)
+    {
+        *nrecv = 0;
+        if (!waitForMsg(timeout)) return ZCM_EAGAIN;
+
+        // Clean up memory from the last messages
+        for (auto n : inFlight) freeNode(n);
+        inFlight.clear();
+
+        // Hand out the messages at the front of the queue, but hang onto them
+        // via "inFlight" so we can recycle them later
+        uint64_t utime = TimeUtil::utime();
+        while (*nrecv < maxmsgs) {
+            Node* n = pop();
+            if (!n) {
+                // A publisher is midway through a push; it completes momentarily
+                if (*nrecv == 0 && !empty()) {
+                    this_thread::yield();
+                    continue;
+                }
+                break;
+            }
+            n->msg.utime = utime;
+            out[(*nrecv)++] = n->msg;
+            inFlight.push_back(n);
+        }
+        if (*nrecv > 0) release(*nrecv);
 
         return ZCM_EOK;
     }
@@ -145,6 +394,21 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
     static void _destroy(zcm_trans_t *zt)
     { delete cast(zt); }
 
+    static int _sendmsg_batch(zcm_trans_t *zt, zcm_msg_t *msgs, size_t nmsgs, size_t *nsent)
+    { return cast(zt)->sendmsg_batch(msgs, nmsgs, nsent); }
+
+    static int _recvmsg_batch(zcm_trans_t *zt, zcm_msg_t *msgs, size_t maxmsgs,
+                              size_t *nrecv, int timeout)
+    { return cast(zt)->recvmsg_batch(msgs, maxmsgs, nrecv, timeout); }
+
+    static int _sendmsgv(zcm_trans_t *zt, const char *channel,
+                         const zcm_iovec_t *iov, size_t niov)
+    { return cast(zt)->sendmsgv(channel, iov, niov); }
+
+    static int _sendmsgv_concurrent(zcm_trans_t *zt, const char *channel,
+                                    const zcm_iovec_t *iov, size_t niov)
+    { return cast(zt)->sendmsgv_concurrent(channel, iov, niov); }
+
     static const TransportRegister regBlocking;
     static const TransportRegister regNonblocking;
 };
@@ -156,6 +420,10 @@ zcm_trans_methods_t ZCM_TRANS_CLASSNAME::methods = {
     &ZCM_TRANS_CLASSNAME::_recvmsg,
     &ZCM_TRANS_CLASSNAME::_update,
     &ZCM_TRANS_CLASSNAME::_destroy,
+    &ZCM_TRANS_CLASSNAME::_sendmsg_batch,
+    &ZCM_TRANS_CLASSNAME::_recvmsg_batch,
+    &ZCM_TRANS_CLASSNAME::_sendmsgv,
+    &ZCM_TRANS_CLASSNAME::_sendmsgv_concurrent,
 };
 
 static zcm_trans_t *create_blocking(zcm_url_t *url)
@@ -11,16 +11,22 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include <linux/serial.h>
 #include <linux/usbdevice_fs.h>
 
 #include <cassert>
 #include <cstring>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 using namespace std;
 
@@ -36,6 +42,10 @@ using namespace std;
 
 #define SERIAL_TIMEOUT_US 1e5 // u-seconds
 
+// Size of the ring the I/O thread reads into and of each read it attempts
+#define IO_RING_SIZE (MTU * 16)
+#define IO_READ_MAX  (1<<16)
+
 #define US_TO_MS(a) (a)/1e3
 
 using u8  = uint8_t;
@@ -48,9 +58,13 @@ struct Serial
     Serial(){}
     ~Serial() { close(); }
 
-    bool open(const string& port, int baud, bool hwFlowControl);
+    // With nonblock set the fd is opened O_NONBLOCK for use with poll() and the driver
+    // is asked (best effort) for low latency mode
+    bool open(const string& port, int baud, bool hwFlowControl,
+              int vmin, int vtime, bool nonblock);
     bool isOpen() { return fd > 0; };
     void close();
+    int fileno() { return fd; }
 
     int write(const u8* buf, size_t sz);
     int read(u8* buf, size_t sz, u64 timeoutMs);
@@ -67,7 +81,8 @@ struct Serial
     int fd = -1;
 };
 
-bool Serial::open(const string& port_, int baud, bool hwFlowControl)
+bool Serial::open(const string& port_, int baud, bool hwFlowControl,
+                  int vmin, int vtime, bool nonblock)
 {
     if (baud == 0) {
         fprintf(stderr, "Serial baud rate not specified in url. "
@@ -85,6 +100,7 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
     this->port = port_;
 
     int flags = O_RDWR | O_NOCTTY | O_SYNC;
+    if (nonblock) flags |= O_NONBLOCK;
     fd = ::open(port.c_str(), flags, 0);
     if (fd < 0) {
         ZCM_DEBUG("failed to open serial device (%s): %s", port.c_str(), strerror(errno));
@@ -115,8 +131,9 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
     opts.c_cflag |= CS8;
     opts.c_cflag &= ~PARENB;
     if (hwFlowControl) opts.c_cflag |= CRTSCTS;
-    opts.c_cc[VTIME]    = 1;
-    opts.c_cc[VMIN]     = 30;
+    // Note: with VTIME = 0, VMIN also sets how many bytes poll() waits for
+    opts.c_cc[VTIME]    = vtime;
+    opts.c_cc[VMIN]     = vmin;
 
     // set the new termios config
     if (tcsetattr(fd, TCSANOW, &opts)) {
@@ -126,6 +143,16 @@ bool Serial::open(const string& port_, int baud, bool hwFlowControl)
 
     tcflush(fd, TCIOFLUSH);
 
+    if (nonblock) {
+        // Stops drivers (e.g. ftdi_sio) from holding received bytes back for up to
+        // their latency timer. Not every device supports this, so failure is ignored.
+        struct serial_struct ss;
+        if (ioctl(fd, TIOCGSERIAL, &ss) == 0) {
+            ss.flags |= ASYNC_LOW_LATENCY;
+            ioctl(fd, TIOCSSERIAL, &ss);
+        }
+    }
+
     return true;
 
  fail:
@@ -164,6 +191,13 @@ int Serial::write(const u8* buf, size_t sz)
 {
     assert(this->isOpen());
     int ret = ::write(fd, buf, sz);
+    if (ret == -1 && errno == EAGAIN) {
+        // Only happens on a nonblocking fd: wait for the tx buffer to drain a bit
+        struct pollfd pfd = { fd, POLLOUT, 0 };
+        if (::poll(&pfd, 1, US_TO_MS(SERIAL_TIMEOUT_US)) > 0)
+            ret = ::write(fd, buf, sz);
+        if (ret == -1 && errno == EAGAIN) return 0;
+    }
     if (ret == -1) {
         ZCM_DEBUG("ERR: write failed: %s", strerror(errno));
         return -1;
@@ -246,10 +280,26 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
     unordered_map<string, string> options;
 
-    zcm_trans_t* gst;
+    zcm_trans_t* gst = nullptr;
 
     uint64_t timeoutLeft;
 
+    // I/O thread mode: a dedicated thread polls the tty and does large nonblocking reads
+    // into rxRing, so the recv thread only ever waits on rxCond and never on the tty.
+    // The I/O thread is the only writer of rxBack and the recv thread the only writer of
+    // rxFront, so each side copies to or from the ring outside of rxLock.
+    bool ioThread;
+    int vmin;
+    int vtime;
+    std::thread rxThread;
+    int wakeFds[2] = { -1, -1 };
+    std::atomic<bool> rxRunning {false};
+    std::unique_ptr<u8[]> rxRing;
+    size_t rxFront = 0;
+    size_t rxBack  = 0;
+    std::mutex rxLock;
+    std::condition_variable rxCond;
+
     string* findOption(const string& s)
     {
         auto it = options.find(s);
@@ -321,8 +371,53 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             }
         }
 
+        ioThread = false;
+        auto* ioThreadStr = findOption("io_thread");
+        if (ioThreadStr) {
+            if (*ioThreadStr == "true") {
+                ioThread = true;
+            } else if (*ioThreadStr == "false") {
+                ioThread = false;
+            } else {
+                ZCM_DEBUG("expected boolean argument for 'io_thread'");
+                return;
+            }
+        }
+
+        // The I/O thread wants poll() to wake on the first byte; a blocking read
+        // is better off waiting for a few bytes or a short gap in the data
+        vmin  = ioThread ? 1 : 30;
+        vtime = ioThread ? 0 : 1;
+        auto* vminStr = findOption("vmin");
+        if (vminStr) {
+            vmin = atoi(vminStr->c_str());
+            if (vmin < 0 || vmin > 255) {
+                ZCM_DEBUG("expected integer argument in [0, 255] for 'vmin'");
+                return;
+            }
+        }
+        auto* vtimeStr = findOption("vtime");
+        if (vtimeStr) {
+            vtime = atoi(vtimeStr->c_str());
+            if (vtime < 0 || vtime > 255) {
+                ZCM_DEBUG("expected integer argument in [0, 255] for 'vtime'");
+                return;
+            }
+        }
+
         address = zcm_url_address(url);
-        ser.open(address, baud, hwFlowControl);
+        if (!ser.open(address, baud, hwFlowControl, vmin, vtime, ioThread)) return;
+
+        if (ioThread) {
+            if (pipe(wakeFds) != 0) {
+                ZCM_DEBUG("failed to create I/O thread wakeup pipe: %s", strerror(errno));
+                ser.close();
+                return;
+            }
+            rxRing.reset(new u8[IO_RING_SIZE]);
+            rxRunning = true;
+            rxThread = std::thread(&ZCM_TRANS_CLASSNAME::rxThreadFunc, this);
+        }
 
         if (raw) {
             rawBuf.reset(new uint8_t[rawSize]);
@@ -339,6 +434,19 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
     ~ZCM_TRANS_CLASSNAME()
     {
+        if (rxThread.joinable()) {
+            rxRunning = false;
+            {
+                unique_lock<mutex> lk(rxLock);
+                rxCond.notify_all();
+            }
+            u8 b = 0;
+            if (::write(wakeFds[1], &b, 1) != 1)
+                ZCM_DEBUG("failed to wake serial I/O thread: %s", strerror(errno));
+            rxThread.join();
+        }
+        if (wakeFds[0] >= 0) ::close(wakeFds[0]);
+        if (wakeFds[1] >= 0) ::close(wakeFds[1]);
         ser.close();
         if (gst) zcm_trans_generic_serial_destroy(gst);
     }
@@ -348,9 +456,89 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         return ser.isOpen();
     }
 
+    void rxThreadFunc()
+    {
+        struct pollfd pfds[2] = {
+            { ser.fileno(), POLLIN, 0 },
+            { wakeFds[0],   POLLIN, 0 },
+        };
+
+        while (rxRunning) {
+            // Wait for room in the ring before asking the tty for more
+            size_t room;
+            {
+                unique_lock<mutex> lk(rxLock);
+                rxCond.wait(lk, [&](){
+                    return !rxRunning || rxBack - rxFront < IO_RING_SIZE;
+                });
+                if (!rxRunning) break;
+                room = IO_RING_SIZE - (rxBack - rxFront);
+            }
+
+            int ret = ::poll(pfds, 2, -1);
+            if (ret < 0) {
+                if (errno == EINTR) continue;
+                ZCM_DEBUG("ERR: serial poll failed: %s", strerror(errno));
+                break;
+            }
+            if (pfds[1].revents) break;
+            if (!pfds[0].revents) continue;
+
+            // Read straight into the ring, up to its wrap point
+            size_t idx = rxBack % IO_RING_SIZE;
+            size_t n = min(min(room, IO_RING_SIZE - idx), (size_t)IO_READ_MAX);
+            ssize_t nread = ::read(ser.fileno(), rxRing.get() + idx, n);
+            if (nread < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+            if (nread <= 0) {
+                ZCM_DEBUG("ERR: serial device closed or unplugged");
+                break;
+            }
+
+            unique_lock<mutex> lk(rxLock);
+            rxBack += nread;
+            rxCond.notify_all();
+        }
+    }
+
+    // Returns whether any received bytes are waiting in the I/O thread's ring
+    bool waitForRx(uint64_t timeoutUs)
+    {
+        unique_lock<mutex> lk(rxLock);
+        auto ready = [&](){ return rxBack != rxFront; };
+        if (timeoutUs == numeric_limits<uint64_t>::max()) {
+            rxCond.wait(lk, ready);
+        } else {
+            rxCond.wait_for(lk, std::chrono::microseconds(timeoutUs), ready);
+        }
+        return rxBack != rxFront;
+    }
+
+    // Never blocks: hands the generic serial core whatever the I/O thread has read
+    size_t getFromRing(uint8_t* data, size_t nData)
+    {
+        size_t avail;
+        {
+            unique_lock<mutex> lk(rxLock);
+            avail = rxBack - rxFront;
+        }
+
+        size_t n = min(avail, nData);
+        size_t idx = rxFront % IO_RING_SIZE;
+        size_t contiguous = min(n, IO_RING_SIZE - idx);
+        memcpy(data, rxRing.get() + idx, contiguous);
+        memcpy(data + contiguous, rxRing.get(), n - contiguous);
+
+        unique_lock<mutex> lk(rxLock);
+        rxFront += n;
+        rxCond.notify_all();
+        return n;
+    }
+
     static size_t get(uint8_t* data, size_t nData, void* usr)
     {
         ZCM_TRANS_CLASSNAME* me = cast((zcm_trans_t*) usr);
+        if (me->ioThread) return me->getFromRing(data, nData);
+
         uint64_t startUtime = TimeUtil::utime();
         int ret = me->ser.read(data, nData, me->timeoutLeft);
         uint64_t diff = TimeUtil::utime() - startUtime;
@@ -395,6 +583,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         timeoutLeft = timeoutMs > 0 ? timeoutMs * 1e3 : numeric_limits<uint64_t>::max();
 
         if (raw) {
+            if (ioThread && !waitForRx(timeoutLeft)) return ZCM_EAGAIN;
             size_t sz = get(rawBuf.get(), rawSize, this);
             if (sz == 0 || rawChan.empty()) return ZCM_EAGAIN;
 
@@ -421,6 +610,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
                 //       `get` knows how long it has to exit
                 timeoutLeft = timeoutLeft > diff ? timeoutLeft - diff : 0;
 
+                if (ioThread && !waitForRx(timeoutLeft)) return ZCM_EAGAIN;
                 serial_update_rx(this->gst);
 
                 diff = TimeUtil::utime() - startUtime;
@@ -482,6 +672,8 @@ static zcm_trans_t* create(zcm_url_t* url)
 const TransportRegister ZCM_TRANS_CLASSNAME::reg(
     "serial", "Transfer data via a serial connection "
               "(e.g. 'serial:///dev/ttyUSB0?baud=115200&hw_flow_control=true' or "
-              "'serial:///dev/pts/10?raw=true&raw_channel=RAW_SERIAL')",
+              "'serial:///dev/pts/10?raw=true&raw_channel=RAW_SERIAL'). "
+              "Set 'io_thread=true' to read the device from a dedicated I/O thread; "
+              "'vmin' and 'vtime' override the termios VMIN and VTIME settings",
     create);
 #endif
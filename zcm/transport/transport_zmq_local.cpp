@@ -11,6 +11,8 @@
 
 #include <unistd.h>
 #include <dirent.h>
+#include <signal.h>
+#include <sys/inotify.h>
 
 #include <cstdio>
 #include <cstring>
@@ -19,6 +21,8 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <sys/stat.h>
@@ -32,6 +36,13 @@ using namespace std;
 #define START_BUF_SIZE (1 << 20)
 #define ZMQ_IO_THREADS 1
 #define IPC_NAME_PREFIX "zcm-channel-zmq-ipc-"
+#define IPC_PROC_PREFIX "zcm-proc-zmq-ipc-"
+#define PEER_SCAN_PERIOD_US 100000
+// A publisher's socket file appears (and is reported by inotify) just before it starts
+// listening, so subscribers retry refused connections quickly instead of after zmq's
+// default 100ms
+#define SUB_RECONNECT_IVL_MS 5
+#define SUB_RECONNECT_IVL_MAX_MS 1000
 
 enum Type { IPC, INPROC, };
 
@@ -56,6 +67,26 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
     // concurrently
     mutex mut;
 
+    // Single socket mode ('single_socket=true'): each transport binds one PUB socket
+    // (procPub) and connects one SUB socket (procSub) to the PUB socket of every
+    // transport on the subnet. Messages are sent as [channel '\0'][data], so ZMQ's
+    // topic prefix filtering on the first frame selects exactly the subscribed channels
+    // and neither the fd count nor the poll cost grows with the number of channels.
+    bool singleSocket = false;
+    void *procPub = nullptr;
+    void *procSub = nullptr;
+    string procAddress;
+    unordered_set<string> procPeers;
+    uint64_t lastPeerScanUtime = 0;
+    // ZMQ sockets are not thread safe, so (un)subscribes requested by recvmsgEnable()
+    // are queued here (guarded by 'mut') and applied to procSub by the recv thread
+    vector<pair<string, bool>> pendingTopics;
+
+    // inotify watch on the ipc directory. recvmsg() polls it alongside the sockets, so
+    // new publishers are connected as soon as they bind and the recv path never scans
+    // the directory. If the watch can't be created, discovery falls back to rescanning.
+    int dirWatch = -1;
+
     ZCM_TRANS_CLASSNAME(Type type_, zcm_url_t *url)
     {
         trans_type = ZCM_BLOCKING;
@@ -72,6 +103,27 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         ctx = zmq_init(ZMQ_IO_THREADS);
         assert(ctx != nullptr);
         type = type_;
+
+        auto *opts = zcm_url_opts(url);
+        for (size_t i = 0; i < opts->numopts; ++i) {
+            if (string(opts->name[i]) == "single_socket") {
+                if (string(opts->value[i]) == "true") {
+                    singleSocket = true;
+                } else if (string(opts->value[i]) != "false") {
+                    ZCM_DEBUG("expected boolean argument for 'single_socket'");
+                }
+            }
+        }
+
+        if (type == IPC) ipcWatchCreate();
+
+        if (singleSocket) {
+            if (!procSocketsCreate()) {
+                ZCM_DEBUG("failed to create single socket mode sockets");
+            } else if (type == IPC) {
+                procScanForPeers();
+            }
+        }
     }
 
     ~ZCM_TRANS_CLASSNAME()
@@ -94,6 +146,23 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             }
         }
 
+        if (procSub) {
+            for (auto& peer : procPeers) zmq_disconnect(procSub, peer.c_str());
+            rc = zmq_close(procSub);
+            if (rc == -1) {
+                ZCM_DEBUG("failed to close subsock: %s", zmq_strerror(errno));
+            }
+        }
+        if (procPub) {
+            zmq_unbind(procPub, procAddress.c_str());
+            rc = zmq_close(procPub);
+            if (rc == -1) {
+                ZCM_DEBUG("failed to close pubsock: %s", zmq_strerror(errno));
+            }
+            // Not every libzmq removes the socket file, and peers would keep finding it
+            if (type == IPC) unlink(procAddress.c_str() + strlen("ipc://"));
+        }
+
         // Clean up all subscribe sockets
         for (auto it = subsocks.begin(); it != subsocks.end(); ++it) {
             address = getAddress(it->first);
@@ -109,6 +178,8 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             }
         }
 
+        if (dirWatch >= 0) close(dirWatch);
+
         // Clean up the zmq context
         rc = zmq_ctx_term(ctx);
         if (rc == -1) {
@@ -173,6 +244,15 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         return sock;
     }
 
+    void subsockSetReconnect(void *sock)
+    {
+        int ivl = SUB_RECONNECT_IVL_MS, ivlMax = SUB_RECONNECT_IVL_MAX_MS;
+        if (zmq_setsockopt(sock, ZMQ_RECONNECT_IVL, &ivl, sizeof(ivl)) == -1 ||
+            zmq_setsockopt(sock, ZMQ_RECONNECT_IVL_MAX, &ivlMax, sizeof(ivlMax)) == -1) {
+            ZCM_DEBUG("failed to set reconnect interval on subsock: %s", zmq_strerror(errno));
+        }
+    }
+
     // May return null if it cannot create a new subsock
     void *subsockFindOrCreate(const string& channel, bool subExplicit)
     {
@@ -186,6 +266,7 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             ZCM_DEBUG("failed to create subsock: %s", zmq_strerror(errno));
             return nullptr;
         }
+        subsockSetReconnect(sock);
         string address = getAddress(channel);
         int rc;
         rc = zmq_connect(sock, address.c_str());
@@ -227,6 +308,72 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         closedir(d);
     }
 
+    void ipcWatchCreate()
+    {
+        dirWatch = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (dirWatch < 0) {
+            ZCM_DEBUG("failed to create inotify instance: %s", strerror(errno));
+            return;
+        }
+        string dir = "/tmp/" + subnet;
+        if (inotify_add_watch(dirWatch, dir.c_str(),
+                              IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM) < 0) {
+            ZCM_DEBUG("failed to watch %s: %s", dir.c_str(), strerror(errno));
+            close(dirWatch);
+            dirWatch = -1;
+        }
+    }
+
+    // Reads everything pending on dirWatch. Must be called with 'mut' held.
+    void ipcHandleDirEvents()
+    {
+        const char *chanPrefix = IPC_NAME_PREFIX;
+        size_t chanPrefixLen = strlen(IPC_NAME_PREFIX);
+        const char *procPrefix = IPC_PROC_PREFIX;
+        size_t procPrefixLen = strlen(IPC_PROC_PREFIX);
+
+        char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        ssize_t len;
+        while ((len = read(dirWatch, buf, sizeof(buf))) > 0) {
+            const struct inotify_event *ev;
+            for (char *p = buf; p < buf + len; p += sizeof(*ev) + ev->len) {
+                ev = (const struct inotify_event*) p;
+                if (ev->len == 0) continue;
+                bool added = ev->mask & (IN_CREATE | IN_MOVED_TO);
+
+                if (singleSocket) {
+                    if (strncmp(ev->name, procPrefix, procPrefixLen) != 0) continue;
+                    string address = "ipc:///tmp/" + subnet + "/" + ev->name;
+                    if (address == procAddress) continue;
+                    if (added) {
+                        if (procPeers.count(address)) continue;
+                        if (zmq_connect(procSub, address.c_str()) == -1) {
+                            ZCM_DEBUG("failed to connect subsock: %s", zmq_strerror(errno));
+                            continue;
+                        }
+                        procPeers.insert(address);
+                    } else if (procPeers.erase(address)) {
+                        zmq_disconnect(procSub, address.c_str());
+                    }
+                } else if (added) {
+                    if (strncmp(ev->name, chanPrefix, chanPrefixLen) != 0) continue;
+                    string channel(ev->name + chanPrefixLen);
+                    auto it = subsocks.find(channel);
+                    if (it != subsocks.end()) {
+                        // A restarted publisher: reconnect now rather than on zmq's timer
+                        string address = getAddress(channel);
+                        zmq_disconnect(it->second.first, address.c_str());
+                        zmq_connect(it->second.first, address.c_str());
+                    } else if (recvAllChannels &&
+                               subsockFindOrCreate(channel, false) == nullptr) {
+                        ZCM_DEBUG("failed to open subsock for new channel (%s)",
+                                  channel.c_str());
+                    }
+                }
+            }
+        }
+    }
+
     // Note: This only works for channels within this instance! Creating another
     //       ZCM instance using 'inproc' will cause this scan to miss some channels!
     //       Need to implement a better technique. Should use a globally shared datastruct.
@@ -241,6 +388,193 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         }
     }
 
+    bool procSocketsCreate()
+    {
+        static std::atomic<int> instanceCount {0};
+        string name = string(IPC_PROC_PREFIX) + to_string(getpid()) + "-" +
+                      to_string(instanceCount++);
+        switch (type) {
+            case IPC:    procAddress = "ipc:///tmp/" + subnet + "/" + name; break;
+            case INPROC: procAddress = "inproc://" + subnet + "/" + name;   break;
+        }
+
+        procPub = zmq_socket(ctx, ZMQ_PUB);
+        procSub = zmq_socket(ctx, ZMQ_SUB);
+        if (procPub == nullptr || procSub == nullptr) {
+            ZCM_DEBUG("failed to create socket: %s", zmq_strerror(errno));
+            return false;
+        }
+        subsockSetReconnect(procSub);
+        if (zmq_bind(procPub, procAddress.c_str()) == -1) {
+            ZCM_DEBUG("failed to bind pubsock: %s", zmq_strerror(errno));
+            return false;
+        }
+        // Always hear our own messages, even before the first scan
+        if (zmq_connect(procSub, procAddress.c_str()) == -1) {
+            ZCM_DEBUG("failed to connect subsock: %s", zmq_strerror(errno));
+            return false;
+        }
+        procPeers.insert(procAddress);
+        return true;
+    }
+
+    // Connects procSub to new transports on the subnet and drops the ones that have gone
+    // away. Only the constructor and the recv thread may call this.
+    void procScanForPeers()
+    {
+        string dir = "/tmp/" + subnet;
+        DIR *d = opendir(dir.c_str());
+        if (!d) return;
+
+        const char *prefix = IPC_PROC_PREFIX;
+        size_t prefixLen = strlen(IPC_PROC_PREFIX);
+        unordered_set<string> seen;
+        seen.insert(procAddress);
+
+        dirent *ent;
+        while ((ent = readdir(d)) != nullptr) {
+            if (strncmp(ent->d_name, prefix, prefixLen) != 0) continue;
+
+            // Sockets left behind by processes that died without cleaning up
+            int pid = atoi(ent->d_name + prefixLen);
+            if (pid > 0 && kill((pid_t)pid, 0) < 0 && errno == ESRCH) {
+                unlink((dir + "/" + ent->d_name).c_str());
+                continue;
+            }
+
+            string address = "ipc://" + dir + "/" + ent->d_name;
+            seen.insert(address);
+            if (procPeers.count(address)) continue;
+            if (zmq_connect(procSub, address.c_str()) == -1) {
+                ZCM_DEBUG("failed to connect subsock: %s", zmq_strerror(errno));
+                continue;
+            }
+            procPeers.insert(address);
+        }
+        closedir(d);
+
+        for (auto it = procPeers.begin(); it != procPeers.end(); ) {
+            if (seen.count(*it)) {
+                ++it;
+            } else {
+                zmq_disconnect(procSub, it->c_str());
+                it = procPeers.erase(it);
+            }
+        }
+    }
+
+    int procSendmsg(const zcm_msg_t& msg)
+    {
+        if (procPub == nullptr)
+            return ZCM_ECONNECT;
+        // The topic frame includes the terminating null so "A" doesn't match "AB"
+        int topicLen = strlen(msg.channel) + 1;
+        int rc = zmq_send(procPub, msg.channel, topicLen, ZMQ_SNDMORE);
+        if (rc == topicLen)
+            rc = zmq_send(procPub, msg.buf, msg.len, 0);
+        if (rc == (int)msg.len)
+            return ZCM_EOK;
+        ZCM_DEBUG("zmq_send failed with: %s", zmq_strerror(errno));
+        return ZCM_EUNKNOWN;
+    }
+
+    int procRecvmsgEnable(const char *channel, bool enable)
+    {
+        unique_lock<mutex> lk(mut);
+        if (channel == NULL) {
+            // Only one recv-all subscription is ever held on procSub
+            if (enable == recvAllChannels) return ZCM_EOK;
+            recvAllChannels = enable;
+            pendingTopics.emplace_back(string(), enable);
+        } else {
+            pendingTopics.emplace_back(string(channel, strlen(channel) + 1), enable);
+        }
+        return ZCM_EOK;
+    }
+
+    int procRecvmsg(zcm_msg_t *msg, int timeout)
+    {
+        if (procSub == nullptr)
+            return ZCM_ECONNECT;
+
+        {
+            unique_lock<mutex> lk(mut);
+            for (auto& t : pendingTopics) {
+                int rc = zmq_setsockopt(procSub, t.second ? ZMQ_SUBSCRIBE : ZMQ_UNSUBSCRIBE,
+                                        t.first.data(), t.first.size());
+                if (rc == -1) {
+                    ZCM_DEBUG("failed to setsockopt on subsock: %s", zmq_strerror(errno));
+                }
+            }
+            pendingTopics.clear();
+        }
+
+        if (type == IPC && dirWatch < 0) {
+            uint64_t now = TimeUtil::utime();
+            if (now - lastPeerScanUtime >= PEER_SCAN_PERIOD_US) {
+                lastPeerScanUtime = now;
+                procScanForPeers();
+            }
+            // Wake up in time for the next peer scan
+            if (timeout < 0 || timeout > PEER_SCAN_PERIOD_US / 1000)
+                timeout = PEER_SCAN_PERIOD_US / 1000;
+        }
+
+        zmq_pollitem_t pitems[2];
+        memset(pitems, 0, sizeof(pitems));
+        pitems[0].socket = procSub;
+        pitems[0].events = ZMQ_POLLIN;
+        pitems[1].fd = dirWatch;
+        pitems[1].events = ZMQ_POLLIN;
+
+        int rc = zmq_poll(pitems, dirWatch >= 0 ? 2 : 1, timeout);
+        if (rc == -1) ZCM_DEBUG("zmq_poll failed with: %s", zmq_strerror(errno));
+        if (rc > 0 && pitems[1].revents) {
+            unique_lock<mutex> lk(mut);
+            ipcHandleDirEvents();
+        }
+        if (rc <= 0 || !pitems[0].revents)
+            return ZCM_EAGAIN;
+
+        char topic[ZCM_CHANNEL_MAXLEN + 2];
+        int topicLen = zmq_recv(procSub, topic, sizeof(topic), ZMQ_DONTWAIT);
+        if (topicLen == -1)
+            return ZCM_EAGAIN;
+
+        int more = 0;
+        size_t moreSize = sizeof(more);
+        zmq_getsockopt(procSub, ZMQ_RCVMORE, &more, &moreSize);
+        if (!more) {
+            ZCM_DEBUG("dropping message without a data frame");
+            return ZCM_EAGAIN;
+        }
+
+        // See the notes on zmq_recv() truncation in recvmsg() below
+        rc = zmq_recv(procSub, recvmsgBuffer, recvmsgBufferSize, 0);
+        msg->utime = TimeUtil::utime();
+        if (rc == -1) {
+            ZCM_DEBUG("zmq_recv failed with: %s", zmq_strerror(errno));
+            return ZCM_EAGAIN;
+        }
+        if (rc > (int)recvmsgBufferSize) {
+            ZCM_DEBUG("Reallocating recv buffer to handle larger messages. Size is now %d", rc);
+            recvmsgBufferSize = rc * 2;
+            delete[] recvmsgBuffer;
+            recvmsgBuffer = new uint8_t[recvmsgBufferSize];
+            return ZCM_EAGAIN;
+        }
+        if (topicLen < 2 || topicLen > ZCM_CHANNEL_MAXLEN + 1 || topic[topicLen - 1] != '\0') {
+            ZCM_DEBUG("dropping message with a malformed channel");
+            return ZCM_EAGAIN;
+        }
+
+        recvmsgChannel.assign(topic, topicLen - 1);
+        msg->channel = recvmsgChannel.c_str();
+        msg->len = rc;
+        msg->buf = recvmsgBuffer;
+        return ZCM_EOK;
+    }
+
     /********************** METHODS **********************/
     size_t getMtu()
     {
@@ -255,6 +589,9 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         if (msg.len > MTU)
             return ZCM_EINVALID;
 
+        if (singleSocket)
+            return procSendmsg(msg);
+
         void *sock = pubsockFindOrCreate(channel);
         if (sock == nullptr)
             return ZCM_ECONNECT;
@@ -268,6 +605,9 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
     int recvmsgEnable(const char *channel, bool enable)
     {
+        if (singleSocket)
+            return procRecvmsgEnable(channel, enable);
+
         // Mutex used to protect 'subsocks' while allowing
         // recvmsgEnable() and recvmsg() to be called
         // concurrently
@@ -277,6 +617,8 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
         if (channel == NULL) {
             if (enable) {
                 recvAllChannels = enable;
+                // From here on dirWatch reports new channels, so this is the only scan
+                if (dirWatch >= 0) ipcScanForNewChannels();
             } else {
                 for (auto it = subsocks.begin(); it != subsocks.end(); ) {
                     if (!it->second.second) { // This channel is only subscribed to implicitly
@@ -334,6 +676,9 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
 
     int recvmsg(zcm_msg_t *msg, int timeout)
     {
+        if (singleSocket)
+            return procRecvmsg(msg, timeout);
+
         // Build up a list of poll items
         vector<zmq_pollitem_t> pitems;
         vector<string> pchannels;
@@ -344,10 +689,8 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             unique_lock<mutex> lk(mut);
 
             if (recvAllChannels) {
-                switch (type) {
-                    case IPC: ipcScanForNewChannels();
-                    case INPROC: inprocScanForNewChannels();
-                }
+                if (type == IPC && dirWatch < 0) ipcScanForNewChannels();
+                inprocScanForNewChannels();
             }
 
             pitems.resize(subsocks.size());
@@ -362,6 +705,14 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
                 pchannels.emplace_back(channel);
                 ++i;
             }
+
+            if (dirWatch >= 0) {
+                zmq_pollitem_t p;
+                memset(&p, 0, sizeof(p));
+                p.fd = dirWatch;
+                p.events = ZMQ_POLLIN;
+                pitems.push_back(p);
+            }
         }
 
         timeout = (timeout >= 0) ? timeout : -1;
@@ -373,8 +724,12 @@ struct ZCM_TRANS_CLASSNAME : public zcm_trans_t
             ZCM_DEBUG("zmq_poll failed with: %s", zmq_strerror(errno));
             return ZCM_EAGAIN;
         }
+        if (rc > 0 && dirWatch >= 0 && pitems.back().revents) {
+            unique_lock<mutex> lk(mut);
+            ipcHandleDirEvents();
+        }
         if (rc >= 0) {
-            for (size_t i = 0; i < pitems.size(); ++i) {
+            for (size_t i = 0; i < pchannels.size(); ++i) {
                 auto& p = pitems[i];
                 if (p.revents != 0) {
                     // NOTE: zmq_recv can return an integer > the len parameter passed in
@@ -470,12 +825,15 @@ static zcm_trans_t *createInproc(zcm_url_t *url)
 // Register this transport with ZCM
 #ifdef USING_TRANS_IPC
 const TransportRegister ZCM_TRANS_CLASSNAME::regIpc(
-    "ipc",    "Transfer data via Inter-process Communication (e.g. 'ipc')", createIpc);
+    "ipc",    "Transfer data via Inter-process Communication (e.g. 'ipc'). "
+              "Use 'ipc?single_socket=true' for one socket pair per process "
+              "filtered by channel", createIpc);
 #endif
 
 #ifdef USING_TRANS_INPROC
 const TransportRegister ZCM_TRANS_CLASSNAME::regInproc(
-    "inproc", "Transfer data via Internal process memory (e.g. 'inproc')",  createInproc);
+    "inproc", "Transfer data via Internal process memory (e.g. 'inproc'). "
+              "Supports 'single_socket=true' like 'ipc'", createInproc);
 #endif
 
 #endif
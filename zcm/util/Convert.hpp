@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace zcm {
+
+// Member-wise conversion between versions of a zcmtype, used by the _convertFrom()
+// that zcm-gen --cpp-convert generates. Each member of the destination that the source
+// also has under the same name is converted with convert::field(), which handles:
+//
+//  - numbers, booleans and bytes of any width, with a static_cast
+//  - anything directly assignable, such as identical nested types and strings
+//  - strings stored in different string types
+//  - arrays, element by element, whether constant or variable length. Constant-length
+//    destinations take as many elements as fit, the rest are left untouched.
+//  - nested types that differ, through their own _convertFrom()
+//
+// Members whose types do not fit any of the above fail to compile, as the versions are
+// then not field-compatible.
+namespace convert {
+
+template <int N> struct Priority : Priority<N - 1> {};
+template <> struct Priority<0> {};
+
+template <typename T, size_t N>
+inline size_t size(const T (&)[N]) { return N; }
+
+template <typename C>
+inline auto size(const C& c) -> decltype((size_t) c.size()) { return c.size(); }
+
+// Returns the number of elements the destination ended up with
+template <typename T, size_t N>
+inline size_t resize(T (&)[N], size_t n) { return n < N ? n : N; }
+
+template <typename C>
+inline auto resize(C& c, size_t n) -> decltype(c.resize(n), (size_t) 0)
+{
+    if (n > (size_t) c.max_size()) n = c.max_size();
+    c.resize(n);
+    return n;
+}
+
+template <typename To, typename From>
+inline void field(To& to, const From& from);
+
+template <typename To, typename From>
+inline auto field(To& to, const From& from, Priority<5>)
+    -> typename std::enable_if<std::is_arithmetic<To>::value &&
+                               std::is_arithmetic<From>::value>::type
+{ to = static_cast<To>(from); }
+
+template <typename To, typename From>
+inline auto field(To& to, const From& from, Priority<4>)
+    -> typename std::enable_if<!std::is_array<To>::value && !std::is_arithmetic<From>::value &&
+                               std::is_assignable<To&, const From&>::value>::type
+{ to = from; }
+
+template <typename To, typename From>
+inline auto field(To& to, const From& from, Priority<3>)
+    -> decltype(to.assign(from.data(), (size_t) from.size()), void())
+{ to.assign(from.data(), from.size()); }
+
+template <typename To, typename From>
+inline auto field(To& to, const From& from, Priority<2>)
+    -> decltype(to._convertFrom(from), void())
+{ to._convertFrom(from); }
+
+template <typename To, typename From>
+inline auto field(To& to, const From& from, Priority<1>)
+    -> decltype(size(from), resize(to, 0), to[0], from[0], void())
+{
+    size_t n = resize(to, size(from));
+    for (size_t i = 0; i < n; ++i)
+        field(to[i], from[i]);
+}
+
+template <typename To, typename From>
+inline void field(To&, const From&, Priority<0>)
+{
+    static_assert(sizeof(To) == 0, "member types of the two zcmtype versions are not compatible");
+}
+
+template <typename To, typename From>
+inline void field(To& to, const From& from)
+{
+    field(to, from, Priority<5>());
+}
+
+}
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace zcm {
+
+// Containers with inline, fixed capacity storage for zcmtypes generated with
+// zcm-gen --cpp-fixed-capacity. They follow the parts of the std::vector and
+// std::string interfaces that generated code and typical user code rely on, but
+// never touch the heap. Decoding a message that does not fit fails instead.
+//
+// Elements past size() are kept around rather than destroyed, so when a message
+// is decoded into the same instance again, nested containers are reused as is.
+
+template <typename T, size_t N>
+class FixedVector
+{
+    T      elems[N];
+    size_t n;
+
+  public:
+    typedef T         value_type;
+    typedef size_t    size_type;
+    typedef T&        reference;
+    typedef const T&  const_reference;
+    typedef T*        iterator;
+    typedef const T*  const_iterator;
+
+    FixedVector() : n(0) {}
+
+    FixedVector(size_t count) : n(0) { resize(count); }
+
+    // Only the live elements are copied
+    FixedVector(const FixedVector& other) : n(0) { *this = other; }
+
+    FixedVector& operator=(const FixedVector& other)
+    {
+        if (this == &other) return *this;
+        for (size_t i = 0; i < other.n; ++i) elems[i] = other.elems[i];
+        n = other.n;
+        return *this;
+    }
+
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    static size_t capacity() { return N; }
+    static size_t max_size() { return N; }
+
+    void resize(size_t count)
+    {
+        assert(count <= N && "FixedVector capacity exceeded");
+        if (count > N) count = N;
+        for (size_t i = n; i < count; ++i) elems[i] = T();
+        n = count;
+    }
+
+    void resize(size_t count, const T& value)
+    {
+        assert(count <= N && "FixedVector capacity exceeded");
+        if (count > N) count = N;
+        for (size_t i = n; i < count; ++i) elems[i] = value;
+        n = count;
+    }
+
+    void clear() { n = 0; }
+
+    void push_back(const T& value)
+    {
+        assert(n < N && "FixedVector capacity exceeded");
+        if (n < N) elems[n++] = value;
+    }
+
+    void pop_back() { if (n > 0) --n; }
+
+    T& operator[](size_t i) { return elems[i]; }
+    const T& operator[](size_t i) const { return elems[i]; }
+
+    T& front() { return elems[0]; }
+    const T& front() const { return elems[0]; }
+    T& back() { return elems[n - 1]; }
+    const T& back() const { return elems[n - 1]; }
+
+    T* data() { return elems; }
+    const T* data() const { return elems; }
+
+    iterator begin() { return elems; }
+    const_iterator begin() const { return elems; }
+    iterator end() { return elems + n; }
+    const_iterator end() const { return elems + n; }
+
+    bool operator==(const FixedVector& other) const
+    {
+        if (n != other.n) return false;
+        for (size_t i = 0; i < n; ++i)
+            if (!(elems[i] == other.elems[i])) return false;
+        return true;
+    }
+
+    bool operator!=(const FixedVector& other) const { return !(*this == other); }
+};
+
+template <size_t N>
+class FixedString
+{
+    char   buf[N + 1];
+    size_t n;
+
+  public:
+    typedef char        value_type;
+    typedef size_t      size_type;
+    typedef char*       iterator;
+    typedef const char* const_iterator;
+
+    FixedString() : n(0) { buf[0] = '\0'; }
+    FixedString(const char* s) : n(0) { assign(s, strlen(s)); }
+    FixedString(const std::string& s) : n(0) { assign(s.data(), s.size()); }
+    FixedString(const FixedString& other) : n(0) { assign(other.buf, other.n); }
+
+    FixedString& operator=(const FixedString& other)
+    {
+        if (this != &other) assign(other.buf, other.n);
+        return *this;
+    }
+    FixedString& operator=(const char* s) { return assign(s, strlen(s)); }
+    FixedString& operator=(const std::string& s) { return assign(s.data(), s.size()); }
+
+    FixedString& assign(const char* s, size_t len)
+    {
+        assert(len <= N && "FixedString capacity exceeded");
+        if (len > N) len = N;
+        memmove(buf, s, len);
+        buf[len] = '\0';
+        n = len;
+        return *this;
+    }
+
+    size_t size() const { return n; }
+    size_t length() const { return n; }
+    bool empty() const { return n == 0; }
+    static size_t capacity() { return N; }
+    static size_t max_size() { return N; }
+
+    void clear() { n = 0; buf[0] = '\0'; }
+
+    const char* c_str() const { return buf; }
+    const char* data() const { return buf; }
+    std::string str() const { return std::string(buf, n); }
+
+    char& operator[](size_t i) { return buf[i]; }
+    const char& operator[](size_t i) const { return buf[i]; }
+
+    iterator begin() { return buf; }
+    const_iterator begin() const { return buf; }
+    iterator end() { return buf + n; }
+    const_iterator end() const { return buf + n; }
+
+    bool operator==(const FixedString& other) const
+    { return n == other.n && memcmp(buf, other.buf, n) == 0; }
+    bool operator!=(const FixedString& other) const { return !(*this == other); }
+    bool operator==(const char* s) const { return strcmp(buf, s) == 0; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+};
+
+}
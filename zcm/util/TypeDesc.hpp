@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "zcm/zcm_coretypes.h"
+
+namespace zcm {
+
+// Walks encoded zcmtypes described by the zcm_type_desc_t tables that zcm-gen --c-typeinfo
+// generates, so tools can handle any type they are given without decoding it into its C
+// struct first. The walk reads the message in wire order and hands every value to a
+// visitor. The visitor is a template parameter, so its calls are resolved at compile time
+// rather than made through function pointers, and nothing is allocated once the reader
+// has seen the deepest type it is used with.
+//
+// Derive visitors from TypeDescVisitor and hide the callbacks you need.
+struct TypeDescVisitor
+{
+    // A nested zcmtype and the field holding it, which is nullptr for the message itself
+    void beginStruct(const zcm_type_desc_t&, const zcm_field_desc_t*) {}
+    void endStruct(const zcm_type_desc_t&, const zcm_field_desc_t*) {}
+
+    // One dimension of an array field, by index, and its number of elements
+    void beginArray(const zcm_field_desc_t&, uint32_t, uint32_t) {}
+    void endArray(const zcm_field_desc_t&, uint32_t) {}
+
+    // Integers, bytes and booleans
+    void integer(const zcm_field_desc_t&, int64_t) {}
+    // Floats and doubles
+    void real(const zcm_field_desc_t&, double) {}
+    // Strings, which are not null terminated, and their length
+    void text(const zcm_field_desc_t&, const char*, uint32_t) {}
+};
+
+class TypeDescReader
+{
+  public:
+    // Walks a whole message, hash included. Returns the number of bytes read, or a
+    // negative number if the message is not of the given type or is cut short.
+    template <typename Visitor>
+    int read(const zcm_type_desc_t& type, const void* buf, uint32_t len, Visitor& v)
+    {
+        const uint8_t* data = (const uint8_t*) buf;
+        littleEndian = type.little_endian;
+        if (len < 8 || (int64_t) load<uint64_t>(data) != type.get_hash()) return -1;
+
+        uint32_t pos = 8;
+        sizes.clear();
+        v.beginStruct(type, nullptr);
+        if (!readStruct(type, data, len, pos, v)) return -1;
+        v.endStruct(type, nullptr);
+        return pos;
+    }
+
+  private:
+    template <typename T>
+    T load(const uint8_t* p) const
+    {
+        T v = 0;
+        if (littleEndian)
+            for (size_t i = 0; i < sizeof(T); ++i) v |= (T) p[i] << (8 * i);
+        else
+            for (size_t i = 0; i < sizeof(T); ++i) v = (v << 8) | p[i];
+        return v;
+    }
+
+    static uint32_t wireSize(zcm_field_type_t type)
+    {
+        switch (type) {
+            case ZCM_FIELD_INT8_T:
+            case ZCM_FIELD_BYTE:
+            case ZCM_FIELD_BOOLEAN: return 1;
+            case ZCM_FIELD_INT16_T: return 2;
+            case ZCM_FIELD_INT32_T:
+            case ZCM_FIELD_FLOAT:   return 4;
+            case ZCM_FIELD_INT64_T:
+            case ZCM_FIELD_DOUBLE:  return 8;
+            default:                return 0;
+        }
+    }
+
+    template <typename Visitor>
+    bool readStruct(const zcm_type_desc_t& type, const uint8_t* data, uint32_t len,
+                    uint32_t& pos, Visitor& v)
+    {
+        // Scalar integers of this struct, for the arrays that they are the size of
+        size_t frame = sizes.size();
+        sizes.resize(frame + type.num_fields);
+
+        for (uint32_t i = 0; i < type.num_fields; ++i) {
+            const zcm_field_desc_t& field = type.fields[i];
+            bool ok = field.num_dim == 0 ?
+                      readElements(field, 1, data, len, pos, v, &sizes[frame + i]) :
+                      readArray(field, 0, frame, data, len, pos, v);
+            if (!ok) return false;
+        }
+
+        sizes.resize(frame);
+        return true;
+    }
+
+    template <typename Visitor>
+    bool readArray(const zcm_field_desc_t& field, uint32_t dim, size_t frame,
+                   const uint8_t* data, uint32_t len, uint32_t& pos, Visitor& v)
+    {
+        const zcm_dim_desc_t& d = field.dims[dim];
+        int64_t n = d.is_variable ? sizes[frame + d.size] : d.size;
+        if (n < 0 || n > UINT32_MAX) return false;
+
+        v.beginArray(field, dim, (uint32_t) n);
+        if (dim + 1 == field.num_dim) {
+            if (!readElements(field, (uint32_t) n, data, len, pos, v, nullptr)) return false;
+        } else {
+            for (int64_t i = 0; i < n; ++i)
+                if (!readArray(field, dim + 1, frame, data, len, pos, v)) return false;
+        }
+        v.endArray(field, dim);
+        return true;
+    }
+
+    // Reads n consecutive elements of the field's type. If size is set, n is 1 and size
+    // receives the value of an integer
+    template <typename Visitor>
+    bool readElements(const zcm_field_desc_t& field, uint32_t n, const uint8_t* data,
+                      uint32_t len, uint32_t& pos, Visitor& v, int64_t* size)
+    {
+        uint32_t width = wireSize(field.type);
+        if (width != 0 && (uint64_t) n * width > len - pos) return false;
+        const uint8_t* p = data + pos;
+
+        switch (field.type) {
+            case ZCM_FIELD_INT8_T:
+            case ZCM_FIELD_BOOLEAN:
+                for (uint32_t i = 0; i < n; ++i) {
+                    int64_t val = (int8_t) p[i];
+                    if (size) *size = val;
+                    v.integer(field, val);
+                }
+                break;
+            case ZCM_FIELD_BYTE:
+                for (uint32_t i = 0; i < n; ++i) v.integer(field, p[i]);
+                break;
+            case ZCM_FIELD_INT16_T:
+                for (uint32_t i = 0; i < n; ++i) {
+                    int64_t val = (int16_t) load<uint16_t>(p + 2 * i);
+                    if (size) *size = val;
+                    v.integer(field, val);
+                }
+                break;
+            case ZCM_FIELD_INT32_T:
+                for (uint32_t i = 0; i < n; ++i) {
+                    int64_t val = (int32_t) load<uint32_t>(p + 4 * i);
+                    if (size) *size = val;
+                    v.integer(field, val);
+                }
+                break;
+            case ZCM_FIELD_INT64_T:
+                for (uint32_t i = 0; i < n; ++i) {
+                    int64_t val = (int64_t) load<uint64_t>(p + 8 * i);
+                    if (size) *size = val;
+                    v.integer(field, val);
+                }
+                break;
+            case ZCM_FIELD_FLOAT:
+                for (uint32_t i = 0; i < n; ++i) {
+                    uint32_t bits = load<uint32_t>(p + 4 * i);
+                    float val;
+                    memcpy(&val, &bits, sizeof(val));
+                    v.real(field, val);
+                }
+                break;
+            case ZCM_FIELD_DOUBLE:
+                for (uint32_t i = 0; i < n; ++i) {
+                    uint64_t bits = load<uint64_t>(p + 8 * i);
+                    double val;
+                    memcpy(&val, &bits, sizeof(val));
+                    v.real(field, val);
+                }
+                break;
+            case ZCM_FIELD_STRING:
+                for (uint32_t i = 0; i < n; ++i) {
+                    // The length on the wire counts the null terminator
+                    if (len - pos < 4) return false;
+                    int32_t length = (int32_t) load<uint32_t>(data + pos);
+                    if (length < 1 || (uint32_t) length > len - pos - 4) return false;
+                    v.text(field, (const char*) data + pos + 4, length - 1);
+                    pos += 4 + length;
+                }
+                return true;
+            case ZCM_FIELD_USER_TYPE:
+                if (!field.subtype) return false;
+                for (uint32_t i = 0; i < n; ++i) {
+                    v.beginStruct(*field.subtype, &field);
+                    if (!readStruct(*field.subtype, data, len, pos, v)) return false;
+                    v.endStruct(*field.subtype, &field);
+                }
+                return true;
+            default:
+                return false;
+        }
+
+        pos += n * width;
+        return true;
+    }
+
+  private:
+    bool littleEndian = false;
+    std::vector<int64_t> sizes;
+};
+
+}
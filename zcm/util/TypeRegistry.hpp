@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "zcm/zcm-cpp.hpp"
+#include "zcm/zcm_coretypes.h"
+#include "zcm/util/Convert.hpp"
+
+namespace zcm {
+
+// Lets subscribers accept prior versions of a zcmtype along with its current one. The
+// generated decode() rejects a message whose hash differs from its own, so a publisher
+// still on an older version is normally dropped. Registering that version here makes
+// its messages decode as the version they were published with and then convert into the
+// current one, either through the _convertFrom() of types generated with
+// zcm-gen --cpp-convert or through a function of your own.
+//
+// A Decoder remembers how it decoded its last message, and each subscription made here
+// has its own, so every channel looks its hash up once and again only if it changes.
+//
+// Register all versions before decoding, the registry is not locked. The registry has to
+// outlive its decoders and subscriptions.
+class TypeRegistry
+{
+  public:
+    // Decodes a whole message, hash included, into *out, which is of the current version.
+    // Returns the number of bytes decoded, or a negative number on error.
+    typedef std::function<int (const void* buf, uint32_t len, void* out)> DecodeFn;
+
+    template <typename Msg, typename Prior>
+    void addPriorVersion()
+    {
+        addPriorVersion<Msg, Prior>([](const Prior& prior, Msg& msg) { msg._convertFrom(prior); });
+    }
+
+    template <typename Msg, typename Prior>
+    void addPriorVersion(std::function<void (const Prior& prior, Msg& msg)> convert)
+    {
+        decoders[Key(Msg::getHash(), Prior::getHash())] =
+            [convert](const void* buf, uint32_t len, void* out) {
+                // Decoding into the same instance every time keeps its containers around
+                static thread_local Prior prior;
+                int ret = prior.decode(buf, 0, len);
+                if (ret < 0) return ret;
+                Msg& msg = *(Msg*) out;
+                msg = Msg();
+                convert(prior, msg);
+                return ret;
+            };
+    }
+
+    // Returns nullptr if no version of Msg with the given hash was registered
+    const DecodeFn* find(int64_t msgHash, int64_t hash) const
+    {
+        auto it = decoders.find(Key(msgHash, hash));
+        return it == decoders.end() ? nullptr : &it->second;
+    }
+
+    template <typename Msg>
+    class Decoder
+    {
+        const TypeRegistry& registry;
+        int64_t lastHash;
+        const DecodeFn* lastFn; // nullptr while messages are of the current version
+
+      public:
+        Decoder(const TypeRegistry& registry) :
+            registry(registry), lastHash(Msg::getHash()), lastFn(nullptr) {}
+
+        int decode(const void* buf, uint32_t len, Msg& out)
+        {
+            int64_t hash;
+            if (__int64_t_decode_array(buf, 0, len, &hash, 1) < 0) return -1;
+            if (hash != lastHash) {
+                const DecodeFn* fn = registry.find(Msg::getHash(), hash);
+                if (!fn && hash != Msg::getHash()) return -1;
+                lastHash = hash;
+                lastFn = fn;
+            }
+            return lastFn ? (*lastFn)(buf, len, &out) : out.decode(buf, 0, len);
+        }
+    };
+
+    // Like ZCM::subscribe(), but also accepts the prior versions of Msg registered here.
+    // Unsubscribe through unsubscribe() below.
+    template <typename Msg>
+    Subscription* subscribe(ZCM& zcm, const std::string& channel,
+                            std::function<void (const ReceiveBuffer* rbuf,
+                                                const std::string& channel,
+                                                const Msg* msg)> cb)
+    {
+        std::unique_ptr<TypedState<Msg>> state(new TypedState<Msg>(*this, std::move(cb)));
+        Subscription* sub = zcm.subscribe(channel, TypedState<Msg>::dispatch, state.get());
+        if (!sub) return nullptr;
+        subscriptions[sub] = std::move(state);
+        return sub;
+    }
+
+    void unsubscribe(ZCM& zcm, Subscription* sub)
+    {
+        zcm.unsubscribe(sub);
+        subscriptions.erase(sub);
+    }
+
+  private:
+    typedef std::pair<int64_t, int64_t> Key; // Hash of the current and of the prior version
+
+    struct State
+    {
+        virtual ~State() {}
+    };
+
+    template <typename Msg>
+    struct TypedState : public State
+    {
+        Decoder<Msg> decoder;
+        std::function<void (const ReceiveBuffer* rbuf,
+                            const std::string& channel,
+                            const Msg* msg)> cb;
+        Msg msgMem; // Memory to decode this message into
+
+        TypedState(const TypeRegistry& registry,
+                   std::function<void (const ReceiveBuffer* rbuf,
+                                       const std::string& channel,
+                                       const Msg* msg)> cb) :
+            decoder(registry), cb(std::move(cb)) {}
+
+        static void dispatch(const ReceiveBuffer* rbuf, const std::string& channel, void* usr)
+        {
+            TypedState* state = (TypedState*) usr;
+            int status = state->decoder.decode(rbuf->data, rbuf->data_size, state->msgMem);
+            if (status < 0) {
+                fprintf(stderr, "error %d decoding %s!!!\n", status, Msg::getTypeName());
+                return;
+            }
+            state->cb(rbuf, channel, &state->msgMem);
+        }
+    };
+
+    std::map<Key, DecodeFn> decoders;
+    std::map<Subscription*, std::unique_ptr<State>> subscriptions;
+};
+
+}
@@ -0,0 +1,500 @@
+#pragma once
+
+#include "zcm/zcm.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <functional>
+
+// A pool of dispatch workers that runs independent "strands" of work concurrently
+// while keeping the elements within each strand strictly ordered.
+//
+// Every strand owns a bounded ring of Elements and a handler. A strand is only
+// ever drained by one worker at a time, so its elements are handled in the
+// order they were pushed. Ready strands are placed on per-worker run queues;
+// a worker pops from the front of its own run queue and, when that runs dry,
+// steals from the back of the other workers' run queues.
+//
+// With a single worker, elements of all strands are handled one at a time in
+// the order they were pushed, as if there were only one queue.
+//
+// Note: the pool does not own any threads. Callers run work() on as many
+//       threads as they like (each with a distinct index) and call halt()
+//       to make all of them return.
+template<class Element>
+class DispatchPool
+{
+  public:
+    typedef std::function<void (Element& elt)> Handler;
+
+    class Strand : public std::enable_shared_from_this<Strand>
+    {
+        friend class DispatchPool;
+
+        Handler handler;
+
+        std::mutex mut;
+        std::condition_variable cond;
+
+        struct Slot
+        {
+            uint64_t seq;
+            Element elt;
+        };
+        std::vector<Slot> ring;
+        size_t front = 0;
+        size_t count = 0;
+        bool useDefaultDepth;
+        zcm_queue_policy policy;
+
+        uint64_t received = 0;
+        uint64_t handled = 0;
+        uint64_t dropped = 0;
+        size_t highWater = 0;
+
+        enum { IDLE, QUEUED, RUNNING } state = IDLE;
+        bool dead = false;
+
+        Strand(Handler handler, size_t depth, bool useDefaultDepth, zcm_queue_policy policy) :
+            handler(handler), ring(depth), useDefaultDepth(useDefaultDepth), policy(policy) {}
+
+        bool full() const { return count == ring.size(); }
+
+        void pushBack(const Element& elt, uint64_t seq)
+        {
+            size_t back = front + count;
+            if (back >= ring.size()) back -= ring.size();
+            ring[back].seq = seq;
+            ring[back].elt = elt;
+            ++count;
+            if (count > highWater) highWater = count;
+        }
+
+        void resize(size_t depth)
+        {
+            while (count > depth) {
+                popFront();
+                ++dropped;
+            }
+
+            size_t n = count;
+            std::vector<Slot> newRing(depth);
+            for (size_t i = 0; i < n; ++i) {
+                newRing[i].seq = ring[front].seq;
+                newRing[i].elt = popFront();
+            }
+            ring.swap(newRing);
+            front = 0;
+            count = n;
+        }
+
+        Element popFront()
+        {
+            Element elt = std::move(ring[front].elt);
+            ring[front].elt = Element();
+            if (++front == ring.size()) front = 0;
+            --count;
+            return elt;
+        }
+
+      public:
+        Strand(const Strand& other) = delete;
+        Strand& operator=(const Strand& other) = delete;
+    };
+    typedef std::shared_ptr<Strand> StrandPtr;
+
+  private:
+    struct RunQueue
+    {
+        std::mutex mut;
+        std::deque<StrandPtr> strands;
+    };
+    std::vector<std::unique_ptr<RunQueue>> runQueues;
+    std::atomic<size_t> nextRunQueue {0};
+
+    std::mutex regMut;
+    std::vector<StrandPtr> registry;
+    size_t defaultDepth;
+
+    // Protects the worker sleep/wake conditions below
+    std::mutex mut;
+    std::condition_variable cond;
+    size_t ready = 0;
+    bool halting = false;
+    uint64_t wakeups = 0;
+
+    std::atomic<bool> paused   {false};
+    std::atomic<bool> disabled {false};
+
+    // Order in which elements were pushed, across all strands
+    std::atomic<uint64_t> nextSeq {0};
+
+    // Number of elements a worker handles from one strand before giving
+    // other ready strands a chance to run on this worker. A single worker
+    // handles one at a time to keep elements in the order they were pushed.
+    static constexpr size_t STRAND_BATCH = 32;
+
+  public:
+    DispatchPool(size_t defaultDepth, size_t numWorkers = 1) :
+        defaultDepth(std::max<size_t>(defaultDepth, 1))
+    {
+        setNumWorkers(numWorkers);
+    }
+    ~DispatchPool() {}
+
+    // Must not be called while any thread is inside work()
+    void setNumWorkers(size_t numWorkers)
+    {
+        numWorkers = std::max<size_t>(numWorkers, 1);
+
+        std::deque<StrandPtr> queued;
+        for (auto& rq : runQueues)
+            for (auto& s : rq->strands) queued.push_back(std::move(s));
+
+        runQueues.clear();
+        for (size_t i = 0; i < numWorkers; ++i) runQueues.emplace_back(new RunQueue());
+
+        for (size_t i = 0; i < queued.size(); ++i)
+            runQueues[i % numWorkers]->strands.push_back(std::move(queued[i]));
+    }
+
+    size_t getNumWorkers() const { return runQueues.size(); }
+
+    // A depth of 0 makes the strand follow the pool's default depth
+    StrandPtr addStrand(Handler handler, size_t depth, zcm_queue_policy policy)
+    {
+        std::unique_lock<std::mutex> lk(regMut);
+        StrandPtr s {new Strand(handler, depth == 0 ? defaultDepth : depth,
+                                depth == 0, policy)};
+        registry.push_back(s);
+        return s;
+    }
+
+    // Resizes every strand that follows the default depth
+    void setDefaultDepth(size_t depth)
+    {
+        std::unique_lock<std::mutex> lk(regMut);
+        defaultDepth = std::max<size_t>(depth, 1);
+        for (auto& s : registry) {
+            std::unique_lock<std::mutex> lk2(s->mut);
+            if (!s->useDefaultDepth) continue;
+            s->resize(defaultDepth);
+            s->cond.notify_all();
+        }
+    }
+
+    size_t getDefaultDepth()
+    {
+        std::unique_lock<std::mutex> lk(regMut);
+        return defaultDepth;
+    }
+
+    // Discards all pending elements and guarantees the strand's handler will not be
+    // called again once this returns true. If the handler is currently running,
+    // this either waits for it to return (block) or returns false.
+    // Note: calling this from the strand's own handler with block == true deadlocks
+    bool removeStrand(Strand* s, bool block)
+    {
+        {
+            std::unique_lock<std::mutex> lk(s->mut);
+            if (!block && s->state == Strand::RUNNING) return false;
+            s->dead = true;
+            while (s->count > 0) s->popFront();
+            s->cond.notify_all();
+            s->cond.wait(lk, [&](){ return s->state != Strand::RUNNING; });
+        }
+
+        std::unique_lock<std::mutex> lk(regMut);
+        for (size_t i = 0; i < registry.size(); ++i) {
+            if (registry[i].get() == s) {
+                registry[i] = std::move(registry.back());
+                registry.pop_back();
+                break;
+            }
+        }
+        return true;
+    }
+
+    // Resizing keeps the newest elements if the new depth is smaller than the backlog.
+    // A depth of 0 makes the strand follow the pool's default depth
+    void configureStrand(Strand* s, size_t depth, zcm_queue_policy policy)
+    {
+        size_t dflt = getDefaultDepth();
+        std::unique_lock<std::mutex> lk(s->mut);
+        s->useDefaultDepth = depth == 0;
+        s->resize(depth == 0 ? dflt : depth);
+        s->policy = policy;
+        s->cond.notify_all();
+    }
+
+    void getStats(Strand* s, zcm_sub_stats_t* stats)
+    {
+        std::unique_lock<std::mutex> lk(s->mut);
+        stats->received   = s->received;
+        stats->dispatched = s->handled;
+        stats->dropped    = s->dropped;
+        stats->queued     = s->count;
+        stats->high_water = s->highWater;
+        stats->depth      = s->ring.size();
+    }
+
+    // Queue an element on the strand, applying its overflow policy if it is full.
+    // Returns true if the element was queued.
+    bool push(const StrandPtr& s, const Element& elt)
+    {
+        bool schedule = false;
+        {
+            std::unique_lock<std::mutex> lk(s->mut);
+            if (s->dead || disabled) return false;
+            ++s->received;
+            if (s->policy == ZCM_QUEUE_KEEP_LATEST) {
+                s->dropped += s->count;
+                while (s->count > 0) s->popFront();
+            } else if (s->full()) {
+                switch (s->policy) {
+                    case ZCM_QUEUE_BLOCK:
+                        s->cond.wait(lk, [&](){ return s->dead || disabled || !s->full(); });
+                        if (s->dead || disabled) {
+                            ++s->dropped;
+                            return false;
+                        }
+                        break;
+                    case ZCM_QUEUE_DROP_OLDEST:
+                        s->popFront();
+                        ++s->dropped;
+                        break;
+                    case ZCM_QUEUE_DROP_NEWEST:
+                    default:
+                        ++s->dropped;
+                        return false;
+                }
+            }
+            s->pushBack(elt, nextSeq++);
+            if (s->state == Strand::IDLE) {
+                s->state = Strand::QUEUED;
+                schedule = true;
+            }
+        }
+        if (schedule) enqueue(nextRunQueue++, s);
+        return true;
+    }
+
+    // Run strands until halt() is called. Each concurrent caller must use a distinct idx
+    void work(size_t idx)
+    {
+        idx %= runQueues.size();
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(mut);
+                cond.wait(lk, [&](){ return halting || (!paused && ready > 0); });
+                if (halting) break;
+            }
+            StrandPtr s;
+            if (take(idx, s)) runStrand(idx, s, batchSize(), true);
+        }
+    }
+
+    // Wait for a ready strand and handle one of its elements in the calling thread.
+    // Returns false without handling anything if woken up by halt(), wakeup() or
+    // while paused.
+    bool handleOne()
+    {
+        StrandPtr s;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(mut);
+                uint64_t gen = wakeups;
+                cond.wait(lk, [&](){ return halting || paused || ready > 0 || gen != wakeups; });
+                if (halting || paused || gen != wakeups) return false;
+            }
+            if (take(0, s)) return runStrand(0, s, 1, true) > 0;
+        }
+    }
+
+    // Handle, in the calling thread, every element that was queued on a strand that is
+    // not already being run by a worker. Ignores pause().
+    void flush()
+    {
+        size_t budget = 0;
+        {
+            std::unique_lock<std::mutex> lk(regMut);
+            for (auto& s : registry) {
+                std::unique_lock<std::mutex> lk2(s->mut);
+                budget += s->count;
+            }
+        }
+
+        StrandPtr s;
+        while (budget > 0 && take(0, s)) {
+            size_t n = runStrand(0, s, runQueues.size() == 1 ? 1 : budget, false);
+            budget -= std::min(budget, n);
+            s.reset();
+        }
+    }
+
+    // Makes all threads in work() return
+    void halt()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        halting = true;
+        cond.notify_all();
+    }
+
+    // Forcefully wakes up any thread waiting in handleOne()
+    void wakeup()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        ++wakeups;
+        cond.notify_all();
+    }
+
+    // Forcefully wakes up any push() blocked on a full strand and rejects new elements
+    void disable()
+    {
+        disabled = true;
+        std::unique_lock<std::mutex> lk(regMut);
+        for (auto& s : registry) {
+            std::unique_lock<std::mutex> lk2(s->mut);
+            s->cond.notify_all();
+        }
+    }
+
+    // Undoes halt() and disable()
+    void enable()
+    {
+        disabled = false;
+        std::unique_lock<std::mutex> lk(mut);
+        halting = false;
+    }
+
+    void pause()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        paused = true;
+        cond.notify_all();
+    }
+
+    void resume()
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        paused = false;
+        cond.notify_all();
+    }
+
+  private:
+    size_t batchSize() const { return runQueues.size() == 1 ? 1 : STRAND_BATCH; }
+
+    void enqueue(size_t idx, const StrandPtr& s)
+    {
+        RunQueue& rq = *runQueues[idx % runQueues.size()];
+        {
+            std::unique_lock<std::mutex> lk(rq.mut);
+            rq.strands.push_back(s);
+        }
+        std::unique_lock<std::mutex> lk(mut);
+        ++ready;
+        cond.notify_one();
+    }
+
+    bool take(size_t idx, StrandPtr& s)
+    {
+        size_t n = runQueues.size();
+        if (n == 1) return takeOldest(s);
+        for (size_t i = 0; i < n; ++i) {
+            RunQueue& rq = *runQueues[(idx + i) % n];
+            std::unique_lock<std::mutex> lk(rq.mut);
+            if (rq.strands.empty()) continue;
+            if (i == 0) {
+                s = std::move(rq.strands.front());
+                rq.strands.pop_front();
+            } else {
+                // Steal the most recently readied strand from another worker
+                s = std::move(rq.strands.back());
+                rq.strands.pop_back();
+            }
+            lk.unlock();
+
+            std::unique_lock<std::mutex> lk2(mut);
+            --ready;
+            return true;
+        }
+        return false;
+    }
+
+    // Takes the ready strand whose next element was pushed first. Strands that have
+    // nothing left, such as removed ones, go first so that they are retired.
+    bool takeOldest(StrandPtr& s)
+    {
+        RunQueue& rq = *runQueues[0];
+        std::unique_lock<std::mutex> lk(rq.mut);
+        if (rq.strands.empty()) return false;
+
+        size_t oldest = 0;
+        uint64_t oldestSeq = UINT64_MAX;
+        for (size_t i = 0; i < rq.strands.size(); ++i) {
+            Strand& st = *rq.strands[i];
+            std::unique_lock<std::mutex> lk2(st.mut);
+            uint64_t seq = st.count > 0 ? st.ring[st.front].seq : 0;
+            if (seq < oldestSeq) {
+                oldest = i;
+                oldestSeq = seq;
+            }
+        }
+        s = std::move(rq.strands[oldest]);
+        rq.strands.erase(rq.strands.begin() + oldest);
+        lk.unlock();
+
+        std::unique_lock<std::mutex> lk2(mut);
+        --ready;
+        return true;
+    }
+
+    // Returns the number of elements handled
+    size_t runStrand(size_t idx, const StrandPtr& s, size_t maxElts, bool honorPause)
+    {
+        {
+            std::unique_lock<std::mutex> lk(s->mut);
+            if (s->dead) {
+                s->state = Strand::IDLE;
+                return 0;
+            }
+            s->state = Strand::RUNNING;
+        }
+
+        size_t n = 0;
+        while (n < maxElts) {
+            Element elt;
+            {
+                std::unique_lock<std::mutex> lk(s->mut);
+                if (s->dead || s->count == 0) break;
+                if (honorPause && paused) break;
+                elt = s->popFront();
+                ++s->handled;
+                s->cond.notify_all();
+            }
+            s->handler(elt);
+            ++n;
+        }
+
+        bool requeue;
+        {
+            std::unique_lock<std::mutex> lk(s->mut);
+            requeue = !s->dead && s->count > 0;
+            s->state = requeue ? Strand::QUEUED : Strand::IDLE;
+            s->cond.notify_all();
+        }
+        if (requeue) enqueue(idx, s);
+        return n;
+    }
+
+    DispatchPool(const DispatchPool& other) = delete;
+    DispatchPool(DispatchPool&& other) = delete;
+    DispatchPool& operator=(const DispatchPool& other) = delete;
+    DispatchPool& operator=(DispatchPool&& other) = delete;
+};
@@ -53,13 +53,16 @@ class Queue
         uint8_t* newQueue = new uint8_t[capacity * sizeof(Element)];
         ZCM_ASSERT(newQueue);
 
+        // Note: a queue of capacity N holds at most N - 1 elements
         size_t newBack = 0;
-        while (hasMessage() && newBack < capacity) {
+        while (hasMessage() && newBack + 1 < capacity) {
             uint8_t* msg = (uint8_t*) &top();
             std::uninitialized_copy_n(msg, sizeof(Element), newQueue + newBack * sizeof(Element));
             front = incIdx(front);
             ++newBack;
         }
+        // Anything that no longer fits is dropped
+        while (hasMessage()) pop();
 
         delete[] ((uint8_t*) queue);
         queue = (Element*) newQueue;
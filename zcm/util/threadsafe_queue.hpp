@@ -5,6 +5,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <algorithm>
 
 // A thread-safe C++ queue implementation designed for efficiency.
 // No unneeded copies or initializations.
@@ -80,6 +81,25 @@ class ThreadsafeQueue
         return true;
     }
 
+    // Check for hasFreeSpace() and if there is none, double the capacity of the queue
+    // (up to maxCapacity) before pushing the new element
+    // Returns true if the value was pushed, returns false if no room
+    // Note: growing the queue invalidates any Element* previously returned by top()
+    template<class... Args>
+    bool pushOrGrow(size_t maxCapacity, Args&&... args)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        if (!queue.hasFreeSpace()) {
+            size_t capacity = queue.getCapacity();
+            if (capacity >= maxCapacity) return false;
+            queue.setCapacity(std::min(capacity * 2, maxCapacity));
+        }
+
+        queue.push(std::forward<Args>(args)...);
+        cond.notify_all();
+        return true;
+    }
+
     // Wait for hasMessage() and then return the top element
     // Always returns a valid Element* except when is was
     // forcibly awoken by forceWakeups(). In such a case
@@ -102,6 +122,22 @@ class ThreadsafeQueue
         cond.notify_all();
     }
 
+    // Hands up to maxElts elements (oldest first) to consume() and pops them, all
+    // under a single lock. Does not wait for messages.
+    // Returns the number of elements consumed
+    template<class F>
+    size_t popBatch(size_t maxElts, F consume)
+    {
+        std::unique_lock<std::mutex> lk(mut);
+        size_t n = 0;
+        for (; n < maxElts && queue.hasMessage(); ++n) {
+            consume(queue.top());
+            queue.pop();
+        }
+        if (n > 0) cond.notify_all();
+        return n;
+    }
+
     // Forcefully wakes up top() and push(). top() *will not* return a message from
     // the queue, even if one exists. push() *will* push the message if there is room.
     void disable()
@@ -116,6 +116,20 @@ inline void ZCM::setQueueSize(uint32_t sz)
 }
 #endif
 
+#ifndef ZCM_EMBEDDED
+inline int ZCM::setSendQueueLimit(uint32_t sz)
+{
+    return zcm_set_send_queue_limit(zcm, sz);
+}
+#endif
+
+#ifndef ZCM_EMBEDDED
+inline int ZCM::setDispatchThreads(uint32_t nthreads)
+{
+    return zcm_set_dispatch_threads(zcm, nthreads);
+}
+#endif
+
 inline int ZCM::handleNonblock()
 {
     return zcm_handle_nonblock(zcm);
@@ -415,6 +429,19 @@ inline void ZCM::unsubscribe(Subscription* sub)
     }
 }
 
+#ifndef ZCM_EMBEDDED
+inline int ZCM::setSubscriptionQueue(Subscription* sub, uint32_t depth,
+                                     zcm_queue_policy policy)
+{
+    return zcm_set_sub_queue(zcm, (zcm_sub_t*) sub->rawSub, depth, policy);
+}
+
+inline int ZCM::getSubscriptionStats(Subscription* sub, zcm_sub_stats_t* stats)
+{
+    return zcm_get_sub_stats(zcm, (zcm_sub_t*) sub->rawSub, stats);
+}
+#endif
+
 inline zcm_t* ZCM::getUnderlyingZCM()
 { return zcm; }
 
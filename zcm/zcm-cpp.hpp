@@ -43,6 +43,8 @@ class ZCM
     virtual inline void resume();
     virtual inline int  handle();
     virtual inline void setQueueSize(uint32_t sz);
+    virtual inline int  setSendQueueLimit(uint32_t sz);
+    virtual inline int  setDispatchThreads(uint32_t nthreads);
     #endif
     virtual inline int  handleNonblock();
     virtual inline void flush();
@@ -94,6 +96,11 @@ class ZCM
 
     inline void unsubscribe(Subscription* sub);
 
+    #ifndef ZCM_EMBEDDED
+    inline int setSubscriptionQueue(Subscription* sub, uint32_t depth, zcm_queue_policy policy);
+    inline int getSubscriptionStats(Subscription* sub, zcm_sub_stats_t* stats);
+    #endif
+
     virtual inline zcm_t* getUnderlyingZCM();
 
   protected:
@@ -187,6 +187,21 @@ int zcm_publish(zcm_t* zcm, const char* channel, const uint8_t* data, uint32_t l
     return zcm_nonblocking_publish(zcm->impl, channel, data, len);
 }
 
+int zcm_publishv(zcm_t* zcm, const char* channel, const zcm_iovec_t* iov, uint32_t niov)
+{
+#ifndef ZCM_EMBEDDED
+    switch (zcm->type) {
+        case ZCM_BLOCKING: {
+            zcm->err = zcm_blocking_publishv(zcm->impl, channel, iov, niov);
+            return zcm->err;
+        }
+        case ZCM_NONBLOCKING: return zcm_nonblocking_publishv(zcm->impl, channel, iov, niov);
+    }
+#endif
+    ZCM_ASSERT(zcm->type == ZCM_NONBLOCKING);
+    return zcm_nonblocking_publishv(zcm->impl, channel, iov, niov);
+}
+
 void zcm_flush(zcm_t* zcm)
 {
 #ifndef ZCM_EMBEDDED
@@ -236,6 +251,20 @@ zcm_sub_t* zcm_try_subscribe(zcm_t* zcm, const char* channel, zcm_msg_handler_t
     return zcm_nonblocking_subscribe(zcm->impl, channel, cb, usr);
 }
 
+#ifndef ZCM_EMBEDDED
+zcm_sub_t* zcm_subscribe_opts(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb,
+                              void* usr, const zcm_sub_opts_t* opts)
+{
+    switch (zcm->type) {
+        case ZCM_BLOCKING:
+            return zcm_blocking_subscribe_opts(zcm->impl, channel, cb, usr, opts);
+        case ZCM_NONBLOCKING:
+            return zcm_nonblocking_subscribe_opts(zcm->impl, channel, cb, usr, opts);
+    }
+    return NULL;
+}
+#endif
+
 int zcm_unsubscribe(zcm_t* zcm, zcm_sub_t* sub)
 {
 #ifndef ZCM_EMBEDDED
@@ -332,6 +361,39 @@ int  zcm_try_set_queue_size(zcm_t* zcm, uint32_t numMsgs)
 }
 #endif
 
+#ifndef ZCM_EMBEDDED
+int  zcm_set_send_queue_limit(zcm_t* zcm, uint32_t numMsgs)
+{
+    ZCM_ASSERT(zcm->type == ZCM_BLOCKING);
+    return zcm_blocking_set_send_queue_limit(zcm->impl, numMsgs);
+}
+#endif
+
+#ifndef ZCM_EMBEDDED
+int  zcm_set_dispatch_threads(zcm_t* zcm, uint32_t nthreads)
+{
+    ZCM_ASSERT(zcm->type == ZCM_BLOCKING);
+    return zcm_blocking_set_dispatch_threads(zcm->impl, nthreads);
+}
+#endif
+
+#ifndef ZCM_EMBEDDED
+int  zcm_set_sub_queue(zcm_t* zcm, zcm_sub_t* sub, uint32_t depth,
+                       enum zcm_queue_policy policy)
+{
+    ZCM_ASSERT(zcm->type == ZCM_BLOCKING);
+    return zcm_blocking_set_sub_queue(zcm->impl, sub, depth, policy);
+}
+#endif
+
+#ifndef ZCM_EMBEDDED
+int  zcm_get_sub_stats(zcm_t* zcm, zcm_sub_t* sub, zcm_sub_stats_t* stats)
+{
+    ZCM_ASSERT(zcm->type == ZCM_BLOCKING);
+    return zcm_blocking_get_sub_stats(zcm->impl, sub, stats);
+}
+#endif
+
 int zcm_handle_nonblock(zcm_t* zcm)
 {
     ZCM_ASSERT(zcm->type == ZCM_NONBLOCKING);
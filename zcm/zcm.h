@@ -38,11 +38,43 @@ enum zcm_return_codes {
     #undef X
 };
 
+#ifndef ZCM_EMBEDDED
+/* Overflow behavior of a subscription's dispatch queue once it is full */
+enum zcm_queue_policy {
+    ZCM_QUEUE_BLOCK,       /* stall the receiver until the handler makes room */
+    ZCM_QUEUE_DROP_OLDEST, /* discard the oldest queued message to make room */
+    ZCM_QUEUE_DROP_NEWEST, /* discard the incoming message */
+    ZCM_QUEUE_KEEP_LATEST  /* conflate: keep only the newest message, regardless of depth */
+};
+
+typedef struct zcm_sub_opts_t  zcm_sub_opts_t;
+typedef struct zcm_sub_stats_t zcm_sub_stats_t;
+
+/* Dispatch queue configuration of a single subscription */
+struct zcm_sub_opts_t
+{
+    uint32_t              queue_depth;  /* 0 means follow zcm_set_queue_size() */
+    enum zcm_queue_policy queue_policy;
+};
+
+/* Dispatch queue counters of a single subscription */
+struct zcm_sub_stats_t
+{
+    uint64_t received;   /* messages handed to this subscription by the transport */
+    uint64_t dispatched; /* messages delivered to the handler */
+    uint64_t dropped;    /* messages discarded by the queue policy */
+    uint32_t queued;     /* messages currently waiting for dispatch */
+    uint32_t high_water; /* most messages that were ever waiting at once */
+    uint32_t depth;      /* current bound of the queue */
+};
+#endif
+
 /* Forward typedef'd structs */
 typedef struct zcm_trans_t    zcm_trans_t;
 typedef struct zcm_t          zcm_t;
 typedef struct zcm_recv_buf_t zcm_recv_buf_t;
 typedef struct zcm_sub_t      zcm_sub_t;
+typedef struct zcm_iovec_t    zcm_iovec_t;
 
 /* Generic message handler function type */
 typedef void (*zcm_msg_handler_t)(const zcm_recv_buf_t* rbuf,
@@ -70,6 +102,13 @@ struct zcm_recv_buf_t
     uint32_t data_size;
 };
 
+/* One piece of a message payload that is scattered across several buffers */
+struct zcm_iovec_t
+{
+    const uint8_t* base;
+    uint32_t       len;
+};
+
 #ifndef ZCM_EMBEDDED
 int zcm_retcode_name_to_enum(const char* zcm_retcode_name);
 #endif
@@ -117,6 +156,19 @@ zcm_sub_t* zcm_subscribe(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb,
    Does NOT set zcm errno on failure */
 zcm_sub_t* zcm_try_subscribe(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb, void* usr);
 
+#ifndef ZCM_EMBEDDED
+/* Subscribe to zcm messages with a custom dispatch queue (NULL opts uses the defaults)
+   A ZCM_QUEUE_KEEP_LATEST subscription holds a single slot that each new message is
+   copied over in place, and its handler sees at most the newest message once per
+   dispatch. Nonblocking zcm only honors queue_policy, and only for ZCM_QUEUE_KEEP_LATEST:
+   zcm_handle_nonblock() then drains the transport each call and dispatches every such
+   subscription at most once.
+   Returns a subscription object on success, and NULL on failure
+   Does NOT set zcm errno on failure */
+zcm_sub_t* zcm_subscribe_opts(zcm_t* zcm, const char* channel, zcm_msg_handler_t cb,
+                              void* usr, const zcm_sub_opts_t* opts);
+#endif
+
 /* Unsubscribe to zcm messages, freeing the subscription object
    Returns ZCM_EOK on success, error code on failure
    Does NOT set zcm errno on failure */
@@ -135,6 +187,10 @@ int zcm_try_unsubscribe(zcm_t* zcm, zcm_sub_t* sub);
    Sets zcm errno on failure */
 int zcm_publish(zcm_t* zcm, const char* channel, const uint8_t* data, uint32_t len);
 
+/* Publish a message whose payload is the concatenation of 'niov' buffers, without
+   having to gather them into one buffer first. Same return values as zcm_publish() */
+int zcm_publishv(zcm_t* zcm, const char* channel, const zcm_iovec_t* iov, uint32_t niov);
+
 /* Block until all published messages have been sent even if the underlying
    transport is nonblocking. Additionally, dispatches all messages that have
    already been received sequentially in this thread. */
@@ -155,7 +211,8 @@ void zcm_pause(zcm_t* zcm); /* pauses message dispatch and publishing, not trans
 void zcm_resume(zcm_t* zcm);
 int  zcm_handle(zcm_t* zcm); /* returns ZCM_EOK normally, error code on failure. */
 /* Determines how many messages can be stored from the transport without being dispatched
-   As well as the number of messages that may be stored from the user without being
+   to each subscription (unless the subscription chose its own queue depth) as well as
+   the number of messages that may be stored from the user without being
    transmitted by the transport. Normal operation does not require the user to modify
    this, but if the user is using zcm_pause() and forcing dispatches/transmission through
    calls to zcm_flush(), it will be important to set an appropriate queue size based on
@@ -164,6 +221,30 @@ int  zcm_handle(zcm_t* zcm); /* returns ZCM_EOK normally, error code on failure.
    issues depending on the transport. */
 void zcm_set_queue_size(zcm_t* zcm, uint32_t numMsgs);
 int  zcm_try_set_queue_size(zcm_t* zcm, uint32_t numMsgs); /* returns ZCM_EOK or ZCM_EAGAIN */
+/* The queue of published messages starts at the zcm_set_queue_size() capacity and grows
+   on demand, so bursts of publishes do not immediately fail with ZCM_EAGAIN. This caps
+   how many messages it may grow to (default 1024; never less than zcm_set_queue_size()).
+   The send thread hands everything that is queued to the transport in one go.
+   Returns ZCM_EOK on success, ZCM_EINVALID if numMsgs is 0 */
+int  zcm_set_send_queue_limit(zcm_t* zcm, uint32_t numMsgs);
+/* Sets the number of threads used to dispatch messages to subscription handlers when
+   using zcm_run() or zcm_start(). The default (0) dispatches every message from a single
+   handler thread, in the order the messages arrived across all subscriptions. With
+   nthreads > 1, each subscription still receives its messages in order, but handlers of
+   different subscriptions may run concurrently, so any state shared between handlers
+   must be protected by the user. Idle dispatch threads steal work from busy ones. Can
+   only be called while zcm is not running.
+   Returns ZCM_EOK on success, ZCM_EINVALID if zcm is running */
+int  zcm_set_dispatch_threads(zcm_t* zcm, uint32_t nthreads);
+/* Every subscription has its own queue of messages waiting for dispatch, so a flood on
+   one channel cannot hold back the others. These bound the number of messages that may
+   be waiting for a subscription (depth 0 follows zcm_set_queue_size()) and choose what
+   happens when a message arrives while that many are waiting. Subscriptions default to
+   the zcm_set_queue_size() depth with ZCM_QUEUE_BLOCK.
+   Returns ZCM_EOK on success, ZCM_EINVALID on invalid arguments */
+int  zcm_set_sub_queue(zcm_t* zcm, zcm_sub_t* sub, uint32_t depth,
+                       enum zcm_queue_policy policy);
+int  zcm_get_sub_stats(zcm_t* zcm, zcm_sub_t* sub, zcm_sub_stats_t* stats);
 #endif
 
 /* Non-Blocking Mode Only: Functions checking and dispatching messages
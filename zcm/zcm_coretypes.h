@@ -27,6 +27,128 @@ static inline void zcm_free(void* mem)
     free(mem);
 }
 
+#ifndef ZCM_THREAD_LOCAL
+#  if defined(__cplusplus) && __cplusplus >= 201103L
+#    define ZCM_THREAD_LOCAL thread_local
+#  elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#    define ZCM_THREAD_LOCAL _Thread_local
+#  elif defined(__GNUC__)
+#    define ZCM_THREAD_LOCAL __thread
+#  else
+#    define ZCM_THREAD_LOCAL
+#  endif
+#endif
+
+/**
+ * A reusable bump allocator for decoding messages (see <type>_decode_arena(), which
+ * is generated with zcm-gen's --c-arena). Everything allocated from an arena is
+ * released at once by zcm_arena_reset(). Allocations that did not fit into the
+ * arena's block are made with zcm_malloc() until then, and the reset grows the
+ * block to what was asked for, so once the largest message has been decoded a
+ * reused arena no longer allocates.
+ */
+typedef union _zcm_arena_overflow_t zcm_arena_overflow_t;
+union _zcm_arena_overflow_t
+{
+    zcm_arena_overflow_t* next;
+    int64_t               align;
+    double                align_;
+};
+
+typedef struct _zcm_arena_t zcm_arena_t;
+struct _zcm_arena_t
+{
+    uint8_t*              data;
+    uint32_t              size;
+    uint32_t              used;
+    int                   owned;    /* data is freed by the arena */
+    uint32_t              needed;   /* bytes requested since the last reset */
+    zcm_arena_overflow_t* overflow; /* blocks that did not fit since the last reset */
+};
+
+/**
+ * Start an arena out on the caller's buffer (which must be 8-byte aligned and is
+ * never freed by the arena). Passing NULL and 0 starts empty.
+ */
+static inline void zcm_arena_init(zcm_arena_t* a, void* buf, uint32_t size)
+{
+    a->data = (uint8_t*) buf;
+    a->size = buf ? size : 0;
+    a->used = 0;
+    a->owned = 0;
+    a->needed = 0;
+    a->overflow = NULL;
+}
+
+static inline void* zcm_arena_alloc(zcm_arena_t* a, uint32_t sz)
+{
+    void* ret;
+    zcm_arena_overflow_t* ov;
+
+    if (sz == 0) return NULL;
+    sz = (sz + 7) & ~(uint32_t)7;
+    a->needed += sz;
+
+    if (a->size - a->used >= sz) {
+        ret = a->data + a->used;
+        a->used += sz;
+        return ret;
+    }
+
+    ov = (zcm_arena_overflow_t*) zcm_malloc(sizeof(zcm_arena_overflow_t) + sz);
+    if (!ov) return NULL;
+    ov->next = a->overflow;
+    a->overflow = ov;
+    return ov + 1;
+}
+
+/** Release everything allocated from the arena since the last reset */
+static inline void zcm_arena_reset(zcm_arena_t* a)
+{
+    uint8_t* data;
+
+    while (a->overflow) {
+        zcm_arena_overflow_t* next = a->overflow->next;
+        zcm_free(a->overflow);
+        a->overflow = next;
+    }
+
+    if (a->needed > a->size) {
+        data = (uint8_t*) zcm_malloc(a->needed);
+        if (data) {
+            if (a->owned) zcm_free(a->data);
+            a->data = data;
+            a->size = a->needed;
+            a->owned = 1;
+        }
+    }
+
+    a->used = 0;
+    a->needed = 0;
+}
+
+static inline void zcm_arena_destroy(zcm_arena_t* a)
+{
+    a->needed = 0;
+    zcm_arena_reset(a);
+    if (a->owned) zcm_free(a->data);
+    zcm_arena_init(a, NULL, 0);
+}
+
+/**
+ * The number of elements in an array, one dimension at a time, saturating at
+ * UINT64_MAX (as do negative dimensions). Decoders compare it to the bytes left in
+ * the buffer before allocating, so that a corrupt dimension fails the decode rather
+ * than growing the arena.
+ */
+static inline uint64_t __zcm_array_count(uint64_t count, int64_t dim)
+{
+    if (dim < 0) return UINT64_MAX;
+    if (count == 0 || dim == 0) return 0;
+    if ((uint64_t) dim > UINT64_MAX / count) return UINT64_MAX;
+    return count * (uint64_t) dim;
+}
+
 typedef struct ___zcm_hash_ptr __zcm_hash_ptr;
 struct ___zcm_hash_ptr
 {
@@ -696,6 +818,223 @@ static inline uint32_t __double_clone_array(const double *p, double *q, uint32_t
     return n;
 }
 
+/**
+ * SINGLE VALUES
+ *
+ * Unchecked conversions of one primitive to and from the bytes at b. Generated code checks
+ * the bounds of a whole run of constant-size members once and then converts every member
+ * with these at an offset from b known ahead of time, which compilers turn into whole-word
+ * loads and stores.
+ */
+static inline void __int8_t_store(uint8_t *b, int8_t v) { b[0] = (uint8_t) v; }
+static inline int8_t __int8_t_load(const uint8_t *b) { return (int8_t) b[0]; }
+#define __int8_t_store_little_endian __int8_t_store
+#define __int8_t_load_little_endian __int8_t_load
+
+#define __boolean_store __int8_t_store
+#define __boolean_load __int8_t_load
+#define __boolean_store_little_endian __int8_t_store
+#define __boolean_load_little_endian __int8_t_load
+
+static inline void __byte_store(uint8_t *b, uint8_t v) { b[0] = v; }
+static inline uint8_t __byte_load(const uint8_t *b) { return b[0]; }
+#define __byte_store_little_endian __byte_store
+#define __byte_load_little_endian __byte_load
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+/* Whole-word copies and byte swaps, which compilers also keep intact when vectorizing */
+#  if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#    define __zcm_swap16_be(u) __builtin_bswap16(u)
+#    define __zcm_swap32_be(u) __builtin_bswap32(u)
+#    define __zcm_swap64_be(u) __builtin_bswap64(u)
+#    define __zcm_swap16_le(u) (u)
+#    define __zcm_swap32_le(u) (u)
+#    define __zcm_swap64_le(u) (u)
+#  else
+#    define __zcm_swap16_be(u) (u)
+#    define __zcm_swap32_be(u) (u)
+#    define __zcm_swap64_be(u) (u)
+#    define __zcm_swap16_le(u) __builtin_bswap16(u)
+#    define __zcm_swap32_le(u) __builtin_bswap32(u)
+#    define __zcm_swap64_le(u) __builtin_bswap64(u)
+#  endif
+
+#define __ZCM_SINGLE_VALUE(TYPE, UTYPE, BITS, SUFFIX, ORDER) \
+    static inline void __##TYPE##_store##SUFFIX(uint8_t *b, TYPE v) \
+    { \
+        UTYPE u = __zcm_swap##BITS##_##ORDER((UTYPE) v); \
+        memcpy(b, &u, sizeof(u)); \
+    } \
+    static inline TYPE __##TYPE##_load##SUFFIX(const uint8_t *b) \
+    { \
+        UTYPE u; \
+        memcpy(&u, b, sizeof(u)); \
+        return (TYPE) __zcm_swap##BITS##_##ORDER(u); \
+    }
+
+__ZCM_SINGLE_VALUE(int16_t, uint16_t, 16, , be)
+__ZCM_SINGLE_VALUE(int16_t, uint16_t, 16, _little_endian, le)
+__ZCM_SINGLE_VALUE(int32_t, uint32_t, 32, , be)
+__ZCM_SINGLE_VALUE(int32_t, uint32_t, 32, _little_endian, le)
+__ZCM_SINGLE_VALUE(int64_t, uint64_t, 64, , be)
+__ZCM_SINGLE_VALUE(int64_t, uint64_t, 64, _little_endian, le)
+
+#undef __ZCM_SINGLE_VALUE
+#else
+static inline void __int16_t_store(uint8_t *b, int16_t v)
+{
+    uint16_t u = (uint16_t) v;
+    b[0] = (u >> 8) & 0xff;
+    b[1] = (u     ) & 0xff;
+}
+
+static inline int16_t __int16_t_load(const uint8_t *b)
+{
+    return (int16_t) (((uint16_t) b[0] << 8) | (uint16_t) b[1]);
+}
+
+static inline void __int16_t_store_little_endian(uint8_t *b, int16_t v)
+{
+    uint16_t u = (uint16_t) v;
+    b[0] = (u     ) & 0xff;
+    b[1] = (u >> 8) & 0xff;
+}
+
+static inline int16_t __int16_t_load_little_endian(const uint8_t *b)
+{
+    return (int16_t) ((uint16_t) b[0] | ((uint16_t) b[1] << 8));
+}
+
+static inline void __int32_t_store(uint8_t *b, int32_t v)
+{
+    uint32_t u = (uint32_t) v;
+    b[0] = (u >> 24) & 0xff;
+    b[1] = (u >> 16) & 0xff;
+    b[2] = (u >>  8) & 0xff;
+    b[3] = (u      ) & 0xff;
+}
+
+static inline int32_t __int32_t_load(const uint8_t *b)
+{
+    return (int32_t) (((uint32_t) b[0] << 24) | ((uint32_t) b[1] << 16) |
+                      ((uint32_t) b[2] <<  8) |  (uint32_t) b[3]);
+}
+
+static inline void __int32_t_store_little_endian(uint8_t *b, int32_t v)
+{
+    uint32_t u = (uint32_t) v;
+    b[0] = (u      ) & 0xff;
+    b[1] = (u >>  8) & 0xff;
+    b[2] = (u >> 16) & 0xff;
+    b[3] = (u >> 24) & 0xff;
+}
+
+static inline int32_t __int32_t_load_little_endian(const uint8_t *b)
+{
+    return (int32_t) ( (uint32_t) b[0]        | ((uint32_t) b[1] <<  8) |
+                      ((uint32_t) b[2] << 16) | ((uint32_t) b[3] << 24));
+}
+
+static inline void __int64_t_store(uint8_t *b, int64_t v)
+{
+    uint64_t u = (uint64_t) v;
+    b[0] = (u >> 56) & 0xff;
+    b[1] = (u >> 48) & 0xff;
+    b[2] = (u >> 40) & 0xff;
+    b[3] = (u >> 32) & 0xff;
+    b[4] = (u >> 24) & 0xff;
+    b[5] = (u >> 16) & 0xff;
+    b[6] = (u >>  8) & 0xff;
+    b[7] = (u      ) & 0xff;
+}
+
+static inline int64_t __int64_t_load(const uint8_t *b)
+{
+    return (int64_t) (((uint64_t) b[0] << 56) | ((uint64_t) b[1] << 48) |
+                      ((uint64_t) b[2] << 40) | ((uint64_t) b[3] << 32) |
+                      ((uint64_t) b[4] << 24) | ((uint64_t) b[5] << 16) |
+                      ((uint64_t) b[6] <<  8) |  (uint64_t) b[7]);
+}
+
+static inline void __int64_t_store_little_endian(uint8_t *b, int64_t v)
+{
+    uint64_t u = (uint64_t) v;
+    b[0] = (u      ) & 0xff;
+    b[1] = (u >>  8) & 0xff;
+    b[2] = (u >> 16) & 0xff;
+    b[3] = (u >> 24) & 0xff;
+    b[4] = (u >> 32) & 0xff;
+    b[5] = (u >> 40) & 0xff;
+    b[6] = (u >> 48) & 0xff;
+    b[7] = (u >> 56) & 0xff;
+}
+
+static inline int64_t __int64_t_load_little_endian(const uint8_t *b)
+{
+    return (int64_t) ( (uint64_t) b[0]        | ((uint64_t) b[1] <<  8) |
+                      ((uint64_t) b[2] << 16) | ((uint64_t) b[3] << 24) |
+                      ((uint64_t) b[4] << 32) | ((uint64_t) b[5] << 40) |
+                      ((uint64_t) b[6] << 48) | ((uint64_t) b[7] << 56));
+}
+#endif
+
+static inline void __float_store(uint8_t *b, float v)
+{
+    __zcm__float_uint32_t tmp;
+    tmp.flt = v;
+    __int32_t_store(b, (int32_t) tmp.uint);
+}
+
+static inline float __float_load(const uint8_t *b)
+{
+    __zcm__float_uint32_t tmp;
+    tmp.uint = (uint32_t) __int32_t_load(b);
+    return tmp.flt;
+}
+
+static inline void __float_store_little_endian(uint8_t *b, float v)
+{
+    __zcm__float_uint32_t tmp;
+    tmp.flt = v;
+    __int32_t_store_little_endian(b, (int32_t) tmp.uint);
+}
+
+static inline float __float_load_little_endian(const uint8_t *b)
+{
+    __zcm__float_uint32_t tmp;
+    tmp.uint = (uint32_t) __int32_t_load_little_endian(b);
+    return tmp.flt;
+}
+
+static inline void __double_store(uint8_t *b, double v)
+{
+    __zcm__double_uint64_t tmp;
+    tmp.dbl = v;
+    __int64_t_store(b, (int64_t) tmp.uint);
+}
+
+static inline double __double_load(const uint8_t *b)
+{
+    __zcm__double_uint64_t tmp;
+    tmp.uint = (uint64_t) __int64_t_load(b);
+    return tmp.dbl;
+}
+
+static inline void __double_store_little_endian(uint8_t *b, double v)
+{
+    __zcm__double_uint64_t tmp;
+    tmp.dbl = v;
+    __int64_t_store_little_endian(b, (int64_t) tmp.uint);
+}
+
+static inline double __double_load_little_endian(const uint8_t *b)
+{
+    __zcm__double_uint64_t tmp;
+    tmp.uint = (uint64_t) __int64_t_load_little_endian(b);
+    return tmp.dbl;
+}
+
 /**
  * STRING
  */
@@ -758,6 +1097,29 @@ static inline int __string_decode_array(const void *_buf, uint32_t offset, uint3
     return pos;
 }
 
+static inline int __string_decode_array_arena(const void *_buf, uint32_t offset, uint32_t maxlen, char **p, uint32_t elements,
+                                                 zcm_arena_t* arena)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+        int32_t length;
+
+        // read length including \0
+        thislen = __int32_t_decode_array(_buf, offset + pos, maxlen - pos, &length, 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        if (length < 0 || (uint32_t) length > maxlen - pos) return -1;
+        p[element] = (char*) zcm_arena_alloc(arena, length);
+        if (!p[element] && length > 0) return -1;
+        thislen = __int8_t_decode_array(_buf, offset + pos, maxlen - pos, (int8_t*) p[element], length);
+        if (thislen < 0) return thislen; else pos += thislen;
+    }
+
+    return pos;
+}
+
 // TODO: Figure out why "const char * const * p" doesn't work
 static inline int __string_encode_little_endian_array(void *_buf, uint32_t offset, uint32_t maxlen, char * const *p, uint32_t elements)
 {
@@ -797,6 +1159,29 @@ static inline int __string_decode_little_endian_array(const void *_buf, uint32_t
     return pos;
 }
 
+static inline int __string_decode_little_endian_array_arena(const void *_buf, uint32_t offset, uint32_t maxlen, char **p, uint32_t elements,
+                                                               zcm_arena_t* arena)
+{
+    uint32_t pos = 0, element;
+    int thislen;
+
+    for (element = 0; element < elements; ++element) {
+        int32_t length;
+
+        // read length including \0
+        thislen = __int32_t_decode_little_endian_array(_buf, offset + pos, maxlen - pos, &length, 1);
+        if (thislen < 0) return thislen; else pos += thislen;
+
+        if (length < 0 || (uint32_t) length > maxlen - pos) return -1;
+        p[element] = (char*) zcm_arena_alloc(arena, length);
+        if (!p[element] && length > 0) return -1;
+        thislen = __int8_t_decode_little_endian_array(_buf, offset + pos, maxlen - pos, (int8_t*) p[element], length);
+        if (thislen < 0) return thislen; else pos += thislen;
+    }
+
+    return pos;
+}
+
 // TODO: Figure out why "const char * const * p" doesn't work
 static inline uint32_t __string_clone_array(char * const *p, char **q, uint32_t elements)
 {
@@ -900,6 +1285,70 @@ struct _zcm_type_info_t
 
 };
 
+typedef struct _zcm_type_desc_t zcm_type_desc_t;
+
+/**
+ * Describes a single array dimension of a zcm_field_desc_t
+ */
+typedef struct _zcm_dim_desc_t zcm_dim_desc_t;
+struct _zcm_dim_desc_t
+{
+    /**
+     * the number of elements of a constant dimension, or for a variable one,
+     * the index of the (earlier) field that holds it
+     */
+    int32_t size;
+
+    /**
+     * a boolean describing whether the dimension is variable
+     */
+    int8_t  is_variable;
+};
+
+/**
+ * Describes a single zcmtype field. Unlike zcm_field_t, it does not depend on a
+ * message, so each type has a constant table of them.
+ */
+typedef struct _zcm_field_desc_t zcm_field_desc_t;
+struct _zcm_field_desc_t
+{
+    const char             *name;
+    zcm_field_type_t        type;
+    const char             *typestr;
+
+    /**
+     * offset of the field in the C struct of the type
+     */
+    uint32_t                offset;
+
+    uint32_t                num_dim;
+    const zcm_dim_desc_t   *dims;
+
+    /**
+     * the type of ZCM_FIELD_USER_TYPE fields, NULL for all others
+     */
+    const zcm_type_desc_t  *subtype;
+};
+
+/**
+ * Describes a zcmtype's fields with constant tables, for code that walks any type
+ * with one generic loop rather than a call per field (see zcm/util/TypeDesc.hpp)
+ */
+struct _zcm_type_desc_t
+{
+    const char             *name;
+    zcm_get_hash_t          get_hash;
+    uint32_t                struct_size;
+
+    /**
+     * a boolean describing whether the type was generated with little endian encoding
+     */
+    int8_t                  little_endian;
+
+    uint32_t                num_fields;
+    const zcm_field_desc_t *fields;
+};
+
 #ifdef __cplusplus
 }
 #endif
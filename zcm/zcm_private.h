@@ -14,6 +14,8 @@ struct zcm_sub_t
     char channel[ZCM_CHANNEL_MAXLEN + 1];
     int regex;  /* true(1) or false(0) */
     void *regexobj;
+    void *dispatchobj; /* blocking only: the per-subscription dispatch queue */
+    void *latestobj;   /* the in-place slot of a ZCM_QUEUE_KEEP_LATEST subscription */
     zcm_msg_handler_t callback;
     void *usr;
 };